@@ -13,26 +13,26 @@
 #include "hardware_hal.h"
 
 // Dynamische TFT Konfiguration basierend auf Hardware Profile
-// Dynamische TFT Konfiguration basierend auf Hardware Profile
-#if HW_DISPLAY_CONTROLLER == ILI9341
+// (HW_DISPLAY_CTRL_* aus hardware_profile.h - als Zahlen #if-fähig)
+#if HW_DISPLAY_CONTROLLER == HW_DISPLAY_CTRL_ILI9341
   #define ILI9341_2_DRIVER
   #if HARDWARE_PROFILE == ESP32_2432S028R
     #define TFT_RGB_ORDER TFT_BGR
     #define TFT_INVERSION_ON
-    #define TFT_WIDTH  HW_DISPLAY_WIDTH    // 320
-    #define TFT_HEIGHT HW_DISPLAY_HEIGHT   // 240
   #else
     #define TFT_RGB_ORDER TFT_RGB
     #define TFT_INVERSION_OFF
-    #define TFT_WIDTH  HW_DISPLAY_WIDTH
-    #define TFT_HEIGHT HW_DISPLAY_HEIGHT
   #endif
-#elif HW_DISPLAY_CONTROLLER == ST7789
+#elif HW_DISPLAY_CONTROLLER == HW_DISPLAY_CTRL_ST7789
   #define ST7789_DRIVER
   #define TFT_RGB_ORDER TFT_RGB
   #define TFT_INVERSION_OFF
-  #define TFT_WIDTH  HW_DISPLAY_WIDTH
-  #define TFT_HEIGHT HW_DISPLAY_HEIGHT
+#elif HW_DISPLAY_CONTROLLER == HW_DISPLAY_CTRL_ILI9488
+  #define ILI9488_DRIVER
+  #define TFT_RGB_ORDER TFT_RGB
+  #define TFT_INVERSION_OFF
+#else
+  #error "HW_DISPLAY_CONTROLLER: kein TFT_eSPI Treiber zugeordnet"
 #endif
 
 #define TFT_WIDTH  HW_DISPLAY_WIDTH
@@ -43,7 +43,15 @@
 #define TFT_CS     HW_DISPLAY_CS
 #define TFT_DC     HW_DISPLAY_DC
 #define TFT_RST    HW_DISPLAY_RST
-#define SPI_FREQUENCY HW_DISPLAY_SPI_FREQ
+
+// Laufzeit-Takte (display_clock.h): Profil-Werte oder Tuning aus NVS
+#define SPI_FREQUENCY      displayClockWriteHz
+#define SPI_READ_FREQUENCY displayClockReadHz
+
+// Ohne USE_HSPI_PORT nutzt TFT_eSPI das globale SPI (VSPI)
+#if HW_DISPLAY_SPI_BUS == HSPI
+  #define USE_HSPI_PORT
+#endif
 
 #define LOAD_GLCD
 #define LOAD_FONT2
@@ -0,0 +1,53 @@
+/**
+ * backlight_gamma.h - Helligkeit in Prozent nach LEDC-Duty (CIE 1976 L*)
+ *
+ * Das Auge nimmt Helligkeit etwa logarithmisch wahr: linear auf den
+ * Duty gemappt passiert fast die ganze sichtbare Änderung in den unteren
+ * 20 %. Die Tabelle behandelt Prozent als Lightness L* und liefert die
+ * zugehörige Leuchtdichte Y als Duty:
+ *
+ *   Y = ((L* + 16) / 116)^3     für L* > 8
+ *   Y = L* / 903,3              sonst
+ *
+ * Zur Compile-Zeit für die PWM-Auflösung des Profils berechnet
+ * (101 Einträge, keine Gleitkomma-Rechnung zur Laufzeit).
+ */
+
+#ifndef BACKLIGHT_GAMMA_H
+#define BACKLIGHT_GAMMA_H
+
+#include <stdint.h>
+
+#define BACKLIGHT_GAMMA_STEPS   101    // 0..100 %
+
+// Höchster LEDC-Zähltakt: Frequenz x 2^Auflösung (APB 80 MHz)
+#define BACKLIGHT_LEDC_CLOCK_HZ 80000000ULL
+
+struct BacklightGammaTable {
+  uint16_t duty[BACKLIGHT_GAMMA_STEPS];
+};
+
+constexpr float backlightCieLuminance(float lightness) {
+  if (lightness <= 8.0f) return lightness / 903.3f;
+  const float f = (lightness + 16.0f) / 116.0f;
+  return f * f * f;
+}
+
+constexpr BacklightGammaTable backlightGammaTable(uint8_t resolution) {
+  BacklightGammaTable table = {};
+  const uint32_t maxDuty = (1u << resolution) - 1;
+  for (int percent = 0; percent < BACKLIGHT_GAMMA_STEPS; percent++) {
+    const float duty = backlightCieLuminance((float)percent) * maxDuty + 0.5f;
+    table.duty[percent] = duty > maxDuty ? (uint16_t)maxDuty : (uint16_t)duty;
+  }
+  return table;
+}
+
+// Prozent (geklemmt) nach Duty, Invertierung: 0 % = voller Duty
+constexpr uint32_t backlightDuty(const BacklightGammaTable& table, uint8_t resolution,
+                                 bool inverted, int percent) {
+  const uint32_t duty = table.duty[percent < 0 ? 0 : percent > 100 ? 100 : percent];
+  return inverted ? ((1u << resolution) - 1) - duty : duty;
+}
+
+#endif // BACKLIGHT_GAMMA_H
@@ -0,0 +1,67 @@
+/**
+ * boot_sequence.h - Gestaffelter Start mit Zeitstempeln
+ *
+ * hardware.begin() bringt nur das Display hoch und überträgt sofort den
+ * ersten Frame (Backlight bis dahin aus). Touch, Kalibrierung, Start des
+ * Backlight Fade-In (LEDC-Hardware) und validateHardware() laufen danach
+ * im Boot-Task auf HW_IO_CORE; ohne Task (Host-Simulator) direkt am Ende
+ * von begin().
+ *
+ * Jede Stufe wird mit micros() seit Start der Anwendung gestempelt.
+ * ROM- und Bootloader-Zeit vor app_main sind darin nicht enthalten.
+ */
+
+#ifndef BOOT_SEQUENCE_H
+#define BOOT_SEQUENCE_H
+
+#include <stdint.h>
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define BOOT_FIRST_FRAME_BUDGET_US  300000   // Ziel: erster Frame < 300 ms
+#define BOOT_FADE_MS                200      // Backlight Fade-In nach dem ersten Frame
+#define BOOT_TASK_STACK             4096
+#define BOOT_TASK_PRIORITY          2        // Unter dem IO-Task, über dem Render-Task
+#define BOOT_WAIT_TIMEOUT_MS        2000
+
+// ============================================
+// DATENSTRUKTUREN
+// ============================================
+
+enum BootStage : uint8_t {
+  BOOT_STAGE_BEGIN,         // hardware.begin() aufgerufen
+  BOOT_STAGE_DETECT,        // Auto-Erkennung (nur HW_AUTO_DETECT)
+  BOOT_STAGE_DISPLAY,       // tft.init(), Init-Sequenz, DMA
+  BOOT_STAGE_FIRST_FRAME,   // Erster Frame übertragen - begin() kehrt zurück
+  BOOT_STAGE_TOUCH,         // Touch + NVS-Kalibrierung
+  BOOT_STAGE_BACKLIGHT,     // Fade-In abgeschlossen
+  BOOT_STAGE_VALIDATE,      // validateHardware()
+  BOOT_STAGE_READY,
+  BOOT_STAGE_COUNT
+};
+
+struct BootTimeline {
+  uint32_t stageUs[BOOT_STAGE_COUNT];   // micros() beim Erreichen, 0 = nicht erreicht
+  bool background;                      // true = Stufen ab Touch im Boot-Task
+  bool stripReady;                      // false = Strip-Puffer fehlen, Frames über den Band-Puffer
+  bool touchOk;
+  bool validated;
+};
+
+inline const char* bootStageName(uint8_t stage) {
+  switch (stage) {
+    case BOOT_STAGE_BEGIN:       return "begin()";
+    case BOOT_STAGE_DETECT:      return "Auto-Erkennung";
+    case BOOT_STAGE_DISPLAY:     return "Display";
+    case BOOT_STAGE_FIRST_FRAME: return "Erster Frame";
+    case BOOT_STAGE_TOUCH:       return "Touch";
+    case BOOT_STAGE_BACKLIGHT:   return "Backlight";
+    case BOOT_STAGE_VALIDATE:    return "Validierung";
+    case BOOT_STAGE_READY:       return "Bereit";
+    default:                     return "?";
+  }
+}
+
+#endif // BOOT_SEQUENCE_H
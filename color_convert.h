@@ -0,0 +1,211 @@
+/**
+ * color_convert.h - Pixel-Konvertierung nach RGB565, zur Compile-Zeit spezialisiert
+ *
+ * Statt color565() pro Pixel wandeln die Kernel ganze Puffer: RGB888,
+ * ARGB8888 (Alpha wird ignoriert) und 8-Bit Graustufen nach RGB565,
+ * vier Pixel pro Schleifendurchlauf, zwei Pixel pro 32-Bit-Schreibzugriff.
+ * Farbreihenfolge, Inversion und Byte-Reihenfolge sind Template-Parameter.
+ * Gamma und Helligkeit stecken in drei constexpr-Kanaltabellen, in die
+ * auch Reihenfolge, Inversion und Byte-Tausch schon eingerechnet sind:
+ *
+ *   Pixel = R[r] | G[g] | B[b]
+ *
+ * Ohne Gamma/Helligkeit (10, 100) entfallen die Tabellen, dann bleibt
+ * reines Schieben und Maskieren. Reines C++ ohne Arduino, damit der
+ * Host-Test (simulator/tools/color_bench.cpp) dieselben Kernel prüft.
+ */
+
+#ifndef COLOR_CONVERT_H
+#define COLOR_CONVERT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// ============================================
+// KANAL-TABELLEN (constexpr)
+// ============================================
+
+constexpr double colorLn(double x) {
+  int k = 0;
+  while (x >= 2.0) { x /= 2.0; k++; }
+  while (x < 1.0) { x *= 2.0; k--; }
+  // ln(x) = 2 atanh((x - 1) / (x + 1)), |t| <= 1/3
+  const double t = (x - 1.0) / (x + 1.0);
+  double term = t, sum = 0.0;
+  for (int n = 1; n < 40; n += 2) {
+    sum += term / n;
+    term *= t * t;
+  }
+  return 2.0 * sum + k * 0.69314718055994531;
+}
+
+constexpr double colorExp(double x) {
+  int k = 0;
+  while (x > 0.5) { x -= 0.69314718055994531; k++; }
+  while (x < -0.5) { x += 0.69314718055994531; k--; }
+  double term = 1.0, sum = 1.0;
+  for (int n = 1; n < 20; n++) {
+    term *= x / n;
+    sum += term;
+  }
+  for (; k > 0; k--) sum *= 2.0;
+  for (; k < 0; k++) sum /= 2.0;
+  return sum;
+}
+
+// 8-Bit Kanalwert nach Gamma (x10, 10 = linear) und Helligkeit (%)
+constexpr uint8_t colorLevel(uint8_t value, uint8_t gammaX10, uint8_t brightness) {
+  if (gammaX10 == 10 && brightness == 100) return value;
+  if (value == 0) return 0;
+  const double linear = colorExp(colorLn(value / 255.0) * gammaX10 / 10.0);
+  const double level = linear * 255.0 * brightness / 100.0 + 0.5;
+  return level > 255.0 ? 255 : (uint8_t)level;
+}
+
+constexpr uint16_t colorSwap16(uint16_t value) {
+  return (uint16_t)((value << 8) | (value >> 8));
+}
+
+// Ein Kanal als fertiges Bitfeld: Position (RGB/BGR), invertiert, getauscht
+enum ColorChannel : uint8_t { COLOR_RED, COLOR_GREEN, COLOR_BLUE };
+
+constexpr uint16_t colorField(ColorChannel channel, uint8_t level, bool bgr, bool invert, bool swap) {
+  const bool high = (channel == COLOR_RED) != bgr;   // Bits 11-15
+  uint16_t field = channel == COLOR_GREEN ? (uint16_t)((level & 0xFC) << 3)
+                 : high ? (uint16_t)((level & 0xF8) << 8) : (uint16_t)(level >> 3);
+  const uint16_t mask = channel == COLOR_GREEN ? 0x07E0 : high ? 0xF800 : 0x001F;
+  if (invert) field ^= mask;
+  return swap ? colorSwap16(field) : field;
+}
+
+struct ColorChannelTables {
+  uint16_t red[256], green[256], blue[256];
+};
+
+constexpr ColorChannelTables colorChannelTables(bool bgr, bool invert, bool swap,
+                                                uint8_t gammaX10, uint8_t brightness) {
+  ColorChannelTables tables = {};
+  for (int value = 0; value < 256; value++) {
+    const uint8_t level = colorLevel((uint8_t)value, gammaX10, brightness);
+    tables.red[value] = colorField(COLOR_RED, level, bgr, invert, swap);
+    tables.green[value] = colorField(COLOR_GREEN, level, bgr, invert, swap);
+    tables.blue[value] = colorField(COLOR_BLUE, level, bgr, invert, swap);
+  }
+  return tables;
+}
+
+// ============================================
+// REFERENZ (ein Pixel, Schritt für Schritt)
+// ============================================
+
+// Weg wie bisher: color565(), dann Reihenfolge, Inversion, Byte-Tausch.
+// levels: colorLevel() je Kanalwert, nullptr = linear
+inline uint16_t colorConvertReference(uint8_t r, uint8_t g, uint8_t b, bool bgr, bool invert, bool swap,
+                                      const uint8_t* levels = nullptr) {
+  if (levels) {
+    r = levels[r];
+    g = levels[g];
+    b = levels[b];
+  }
+  if (bgr) {
+    const uint8_t t = r;
+    r = b;
+    b = t;
+  }
+  uint16_t color = (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+  if (invert) color = (uint16_t)~color;
+  return swap ? colorSwap16(color) : color;
+}
+
+// ============================================
+// KERNEL
+// ============================================
+
+// Bgr: Rot/Blau getauscht, Invert: vorinvertiert (Panel ohne INVON),
+// SwapBytes: Display-Byte-Reihenfolge für SPI (pushImage ohne setSwapBytes)
+template <bool Bgr, bool Invert, bool SwapBytes, uint8_t GammaX10 = 10, uint8_t Brightness = 100>
+struct ColorConverter {
+  static constexpr bool linear = GammaX10 == 10 && Brightness == 100;
+  static constexpr ColorChannelTables tables =
+    colorChannelTables(Bgr, Invert, SwapBytes, GammaX10, Brightness);
+
+  static inline uint16_t pixel(uint8_t r, uint8_t g, uint8_t b) {
+    if constexpr (linear) {
+      if constexpr (Bgr) {
+        const uint8_t t = r;
+        r = b;
+        b = t;
+      }
+      uint16_t color = (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+      if constexpr (Invert) color = (uint16_t)~color;
+      if constexpr (SwapBytes) color = colorSwap16(color);
+      return color;
+    } else {
+      return tables.red[r] | tables.green[g] | tables.blue[b];
+    }
+  }
+
+  // Zwei Pixel als ein 32-Bit-Store; memcpy statt uint32_t* (Strict
+  // Aliasing), der Compiler erzeugt trotzdem einen einzelnen Store
+  static inline uint16_t* store2(uint16_t* out, uint32_t w) {
+    memcpy(out, &w, 4);
+    return out + 2;
+  }
+
+  // Eingabe beliebig ausgerichtet, Wortzugriffe per memcpy (Little Endian: ESP32, Host)
+  static void fromRgb888(const uint8_t* in, uint16_t* out, size_t count) {
+    if (count && ((uintptr_t)out & 2)) {
+      *out++ = pixel(in[0], in[1], in[2]);
+      in += 3;
+      count--;
+    }
+    for (; count >= 4; count -= 4, in += 12) {
+      uint32_t w0, w1, w2;   // r0 g0 b0 r1 | g1 b1 r2 g2 | b2 r3 g3 b3
+      memcpy(&w0, in, 4);
+      memcpy(&w1, in + 4, 4);
+      memcpy(&w2, in + 8, 4);
+      out = store2(out, pixel(w0, w0 >> 8, w0 >> 16) | ((uint32_t)pixel(w0 >> 24, w1, w1 >> 8) << 16));
+      out = store2(out, pixel(w1 >> 16, w1 >> 24, w2) | ((uint32_t)pixel(w2 >> 8, w2 >> 16, w2 >> 24) << 16));
+    }
+    for (; count; count--, in += 3) *out++ = pixel(in[0], in[1], in[2]);
+  }
+
+  // 0xAARRGGBB als native 32-Bit-Werte
+  static void fromArgb8888(const uint32_t* in, uint16_t* out, size_t count) {
+    if (count && ((uintptr_t)out & 2)) {
+      *out++ = pixel(*in >> 16, *in >> 8, *in);
+      in++;
+      count--;
+    }
+    for (; count >= 4; count -= 4, in += 4) {
+      const uint32_t p0 = in[0], p1 = in[1], p2 = in[2], p3 = in[3];
+      out = store2(out, pixel(p0 >> 16, p0 >> 8, p0) | ((uint32_t)pixel(p1 >> 16, p1 >> 8, p1) << 16));
+      out = store2(out, pixel(p2 >> 16, p2 >> 8, p2) | ((uint32_t)pixel(p3 >> 16, p3 >> 8, p3) << 16));
+    }
+    for (; count; count--, in++) *out++ = pixel(*in >> 16, *in >> 8, *in);
+  }
+
+  static void fromGray8(const uint8_t* in, uint16_t* out, size_t count) {
+    if (count && ((uintptr_t)out & 2)) {
+      *out++ = pixel(*in, *in, *in);
+      in++;
+      count--;
+    }
+    for (; count >= 4; count -= 4, in += 4) {
+      uint32_t w;
+      memcpy(&w, in, 4);
+      const uint8_t g0 = w, g1 = w >> 8, g2 = w >> 16, g3 = w >> 24;
+      out = store2(out, pixel(g0, g0, g0) | ((uint32_t)pixel(g1, g1, g1) << 16));
+      out = store2(out, pixel(g2, g2, g2) | ((uint32_t)pixel(g3, g3, g3) << 16));
+    }
+    for (; count; count--, in++) *out++ = pixel(*in, *in, *in);
+  }
+};
+
+// Zielformat der Sprite-/DMA-Puffer. Farbreihenfolge (TFT_RGB_ORDER ->
+// MADCTL) und Inversion (colorsInverted -> INVON) gleicht der Treiber
+// aus, es bleibt der Byte-Tausch für SPI.
+typedef ColorConverter<false, false, true> DisplayColorConverter;
+
+#endif // COLOR_CONVERT_H
@@ -3,8 +3,28 @@
 #define CONFIG_H
 
 // *** WÄHLE DEIN HARDWARE PROFILE ***
+// (per -DHARDWARE_PROFILE=... überschreibbar, z.B. im Host-Simulator)
+#ifndef HARDWARE_PROFILE
 #define HARDWARE_PROFILE ESP32_2432S028R  // CYD USB-C Version 3 
 //#define HARDWARE_PROFILE ESP32_TZT_24
 //#define HARDWARE_PROFILE ESP32_GENERIC
+#endif
+
+// Touch, Backlight und Touch-Matrizen zur Laufzeit aus der Profil-Tabelle:
+// begin() übernimmt das erkannte Board (oder hardware.selectProfile()).
+// Display-Treiber und -Pins bleiben die von HARDWARE_PROFILE, nur
+// Einträge mit demselben Display sind wählbar
+//#define HW_RUNTIME_PROFILE true
+
+// Phasen-Tracing (hw_trace.h): Ring mit 512 Ereignissen, Export Taste 'e'
+//#define HW_TRACE true
+
+// Energiesparstufen (power_manager.h): ms ohne Eingabe, 0 = Stufe aus
+//#define HW_POWER_DIM_MS    60000
+//#define HW_POWER_OFF_MS    300000
+//#define HW_POWER_SLEEP_MS  600000
+
+// Frame-Takt der Tests (frame_scheduler.h), Taste 'v'
+//#define HW_FRAME_RATE 30
 
 #endif
\ No newline at end of file
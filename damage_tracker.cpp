@@ -0,0 +1,113 @@
+/**
+ * damage_tracker.cpp - Minimal-Window Flush
+ *
+ * Jedes Dirty-Rechteck wird bandweise in einen Sprite-Puffer gerendert
+ * und mit genau einem Adressfenster übertragen: setAddrWindow einmal,
+ * danach laufen die Bänder nacheinander in dasselbe Fenster. Nur wenn
+ * zwischen zwei Bändern ein Touch-Zugriff vorgelassen wird, wird das
+ * Fenster für den Rest des Rechtecks neu gesetzt.
+ */
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include "damage_tracker.h"
+#include "spi_arbiter.h"
+
+static TFT_eSprite* canvas = nullptr;
+static int16_t canvasWidth = 0;
+
+// Band-Puffer in voller Bildschirmbreite (einmalig, rotationsfest)
+static bool prepareCanvas(TFT_eSPI& tft, int16_t width) {
+  if (canvas && canvasWidth >= width) return true;
+  if (!canvas) canvas = new TFT_eSprite(&tft);
+
+  canvas->deleteSprite();
+  canvas->setColorDepth(16);
+  if (!canvas->createSprite(width, DAMAGE_BAND_ROWS)) {
+    canvasWidth = 0;
+    return false;
+  }
+  canvasWidth = width;
+  return true;
+}
+
+bool damageFlush(TFT_eSPI& tft, const SpiDevice& device, DamageTracker& damage,
+                 DamageRenderFn render, void* context, DamageFlushStats* stats) {
+  if (!damage.isDirty()) return true;
+
+  const uint32_t start = micros();
+  const int16_t width = tft.width() > tft.height() ? tft.width() : tft.height();
+  if (!prepareCanvas(tft, width)) {
+    Serial.printf("❌ Flush-Puffer (%d x %d) nicht verfügbar\n", width, DAMAGE_BAND_ROWS);
+    return false;
+  }
+  const uint16_t* pixels = (const uint16_t*)canvas->getPointer();
+
+  // Bytes und Fenster werden an den Aufrufstellen gezählt
+  uint32_t bytes = 0;
+  uint16_t windows = 0;
+  const bool swap = tft.getSwapBytes();
+  tft.setSwapBytes(false);  // Sprite-Puffer liegt bereits in Display-Byte-Reihenfolge
+  spiArbiter.acquire(device);
+  tft.startWrite();
+
+  for (uint8_t i = 0; i < damage.size(); i++) {
+    const DamageRect& rect = damage[i];
+    tft.setAddrWindow(rect.x, rect.y, rect.w, rect.h);
+    bytes += DAMAGE_WINDOW_BYTES;
+    windows++;
+
+    for (int16_t bandY = rect.y; bandY < rect.bottom(); bandY += DAMAGE_BAND_ROWS) {
+      // Chunk-Grenze: wartendes Touch-Sample vorlassen, Fenster für den Rest
+      // des Rechtecks neu setzen (wie fillSpans)
+      if (bandY > rect.y && spiArbiter.yieldRequested(device)) {
+        tft.endWrite();
+        spiArbiter.yield(device);
+        tft.startWrite();
+        tft.setAddrWindow(rect.x, bandY, rect.w, rect.bottom() - bandY);
+        bytes += DAMAGE_WINDOW_BYTES;
+        windows++;
+      }
+
+      const int16_t rows = min((int16_t)DAMAGE_BAND_ROWS, (int16_t)(rect.bottom() - bandY));
+
+      // Viewport: Ursprung auf (rect.x, bandY), Clip auf rect.w x rows
+      canvas->setViewport(-rect.x, -bandY, rect.x + rect.w, bandY + rows, true);
+      render(*canvas, context);
+      canvas->resetViewport();
+
+      if (rect.w == canvasWidth) {
+        tft.pushPixels(pixels, (uint32_t)rect.w * rows);
+      } else {
+        for (int16_t row = 0; row < rows; row++) {
+          tft.pushPixels(pixels + row * canvasWidth, rect.w);
+        }
+      }
+      bytes += (uint32_t)rect.w * rows * 2;
+    }
+  }
+
+  tft.endWrite();
+  spiArbiter.release(device);
+  tft.setSwapBytes(swap);
+
+  if (stats) {
+    stats->frames++;
+    stats->lastBytes = bytes;
+    stats->lastWindows = windows;
+    stats->lastMicros = micros() - start;
+    stats->fullFrameBytes = (uint32_t)tft.width() * tft.height() * 2 + DAMAGE_WINDOW_BYTES;
+    stats->totalBytes += bytes;
+  }
+
+  damage.clear();
+  return true;
+}
+
+void damageFlushRelease() {
+  if (!canvas) return;
+  canvas->deleteSprite();
+  delete canvas;
+  canvas = nullptr;
+  canvasWidth = 0;
+}
@@ -0,0 +1,174 @@
+/**
+ * damage_tracker.h - Dirty-Rectangle Verwaltung
+ *
+ * Sammelt die Bereiche, die sich seit dem letzten Flush geändert haben.
+ * Überlappende und benachbarte Rechtecke werden zusammengefasst, wenn
+ * das billiger ist als zwei getrennte Transaktionen:
+ *
+ *   Kosten(Rechteck) = Pixel * 2 Byte + DAMAGE_TRANSACTION_COST
+ *
+ * DAMAGE_TRANSACTION_COST bildet setAddrWindow (CASET/RASET/RAMWR) und
+ * den Transaktions-Overhead als Byte-Äquivalent ab.
+ * Reines C++ - auch auf dem Host verwendbar.
+ */
+
+#ifndef DAMAGE_TRACKER_H
+#define DAMAGE_TRACKER_H
+
+#include <stdint.h>
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define DAMAGE_MAX_RECTS         16
+#define DAMAGE_TRANSACTION_COST  48   // Byte-Äquivalent pro Adressfenster
+#define DAMAGE_WINDOW_BYTES      11   // CASET(1+4) + RASET(1+4) + RAMWR(1)
+
+#ifndef DAMAGE_BAND_ROWS
+  #define DAMAGE_BAND_ROWS       16   // Zeilen pro Render-Band (RAM: Breite*Zeilen*2)
+#endif
+
+// ============================================
+// RECHTECK
+// ============================================
+
+struct DamageRect {
+  int16_t x, y, w, h;
+
+  int32_t area() const { return (int32_t)w * h; }
+  bool empty() const { return w <= 0 || h <= 0; }
+  int16_t right() const { return x + w; }    // exklusiv
+  int16_t bottom() const { return y + h; }   // exklusiv
+
+  static DamageRect unite(const DamageRect& a, const DamageRect& b) {
+    int16_t l = a.x < b.x ? a.x : b.x;
+    int16_t t = a.y < b.y ? a.y : b.y;
+    int16_t r = a.right() > b.right() ? a.right() : b.right();
+    int16_t btm = a.bottom() > b.bottom() ? a.bottom() : b.bottom();
+    return DamageRect{ l, t, (int16_t)(r - l), (int16_t)(btm - t) };
+  }
+
+  static DamageRect intersect(const DamageRect& a, const DamageRect& b) {
+    int16_t l = a.x > b.x ? a.x : b.x;
+    int16_t t = a.y > b.y ? a.y : b.y;
+    int16_t r = a.right() < b.right() ? a.right() : b.right();
+    int16_t btm = a.bottom() < b.bottom() ? a.bottom() : b.bottom();
+    if (r <= l || btm <= t) return DamageRect{ 0, 0, 0, 0 };
+    return DamageRect{ l, t, (int16_t)(r - l), (int16_t)(btm - t) };
+  }
+};
+
+// ============================================
+// TRACKER
+// ============================================
+
+class DamageTracker {
+public:
+  DamageTracker() : count(0), bounds{ 0, 0, 0, 0 } {}
+
+  // Bildschirmgröße (nach Rotationswechsel erneut setzen)
+  void setBounds(int16_t width, int16_t height) {
+    bounds = DamageRect{ 0, 0, width, height };
+    clear();
+  }
+
+  void clear() { count = 0; }
+  bool isDirty() const { return count > 0; }
+  uint8_t size() const { return count; }
+  const DamageRect& operator[](uint8_t index) const { return rects[index]; }
+
+  void markAll() {
+    count = 0;
+    add(bounds);
+  }
+
+  void add(int16_t x, int16_t y, int16_t w, int16_t h) {
+    add(DamageRect{ x, y, w, h });
+  }
+
+  void add(DamageRect rect) {
+    rect = DamageRect::intersect(rect, bounds);
+    if (rect.empty()) return;
+
+    // Zusammenfassen solange es sich lohnt (ein Merge kann weitere auslösen)
+    bool merged = true;
+    while (merged) {
+      merged = false;
+      for (uint8_t i = 0; i < count; i++) {
+        DamageRect u = DamageRect::unite(rects[i], rect);
+        if (cost(u) <= cost(rects[i]) + cost(rect)) {
+          rect = u;
+          rects[i] = rects[--count];
+          merged = true;
+          break;
+        }
+      }
+    }
+
+    if (count < DAMAGE_MAX_RECTS) {
+      rects[count++] = rect;
+      return;
+    }
+
+    // Liste voll: mit dem Rechteck vereinen, das dabei am wenigsten wächst
+    uint8_t best = 0;
+    int32_t bestGrowth = INT32_MAX;
+    for (uint8_t i = 0; i < count; i++) {
+      int32_t growth = DamageRect::unite(rects[i], rect).area() - rects[i].area();
+      if (growth < bestGrowth) {
+        bestGrowth = growth;
+        best = i;
+      }
+    }
+    DamageRect u = DamageRect::unite(rects[best], rect);
+    rects[best] = rects[--count];
+    add(u);
+  }
+
+  // Summe der Pixel-Bytes aller Rechtecke (RGB565)
+  uint32_t pendingBytes() const {
+    uint32_t bytes = 0;
+    for (uint8_t i = 0; i < count; i++) bytes += rects[i].area() * 2;
+    return bytes;
+  }
+
+  static int32_t cost(const DamageRect& rect) {
+    return rect.area() * 2 + DAMAGE_TRANSACTION_COST;
+  }
+
+private:
+  DamageRect rects[DAMAGE_MAX_RECTS];
+  uint8_t count;
+  DamageRect bounds;
+};
+
+// ============================================
+// FLUSH (damage_tracker.cpp)
+// ============================================
+
+class TFT_eSPI;
+class TFT_eSprite;
+struct SpiDevice;
+
+// Zeichnet den Bildschirm in Bildschirmkoordinaten in 'canvas'.
+// Wird pro Band aufgerufen; alles außerhalb des Bands wird abgeschnitten.
+typedef void (*DamageRenderFn)(TFT_eSprite& canvas, void* context);
+
+struct DamageFlushStats {
+  uint32_t frames;          // Flushes mit mindestens einem Rechteck
+  uint32_t lastBytes;       // Gesendete SPI-Bytes des letzten Frames (Pixel + Adressfenster)
+  uint16_t lastWindows;     // Gesetzte Adressfenster des letzten Frames (inkl. nach Yield) 
+  uint32_t lastMicros;      // Dauer des letzten Flushes
+  uint32_t fullFrameBytes;  // Vergleich: kompletter Bildschirm
+  uint64_t totalBytes;
+};
+
+// Überträgt alle Dirty-Rechtecke (ein Adressfenster pro Rechteck) und
+// leert den Tracker. device: Display am Bus-Arbiter.
+// false = Band-Puffer konnte nicht angelegt werden.
+bool damageFlush(TFT_eSPI& tft, const SpiDevice& device, DamageTracker& damage,
+                 DamageRenderFn render, void* context, DamageFlushStats* stats);
+void damageFlushRelease();  // Band-Puffer freigeben
+
+#endif // DAMAGE_TRACKER_H
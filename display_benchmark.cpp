@@ -0,0 +1,308 @@
+/**
+ * display_benchmark.cpp - Reproduzierbare Display-Benchmarks
+ */
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <math.h>
+#include "display_benchmark.h"
+#include "span_fill.h"
+
+#define BENCH_IMAGE_SIZE 32
+
+static uint16_t benchImage[BENCH_IMAGE_SIZE * BENCH_IMAGE_SIZE];
+static const char* BENCH_TEXT = "Benchmark 0123";
+static SpanFiller* benchSpans = nullptr;   // Nur während der Suite (runDisplayBenchmark)
+static uint16_t benchGridColors[8];
+
+// ============================================
+// PRIMITIVE
+// ============================================
+
+// Ein Durchlauf eines Primitivs, liefert die gezeichneten Pixel
+typedef uint32_t (*BenchOp)(TFT_eSPI& tft, BenchRng& rng, uint32_t calls);
+
+struct BenchCase {
+  const char* name;
+  BenchOp op;
+  uint32_t calls;
+};
+
+static uint16_t benchColor(BenchRng& rng) {
+  return rng.next() & 0xFFFF;
+}
+
+static uint32_t opPixel(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  for (uint32_t i = 0; i < calls; i++) {
+    tft.drawPixel(rng.range(tft.width()), rng.range(tft.height()), benchColor(rng));
+  }
+  return calls;
+}
+
+static uint32_t opHLine(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  const int32_t len = tft.width() / 2;
+  for (uint32_t i = 0; i < calls; i++) {
+    tft.drawFastHLine(rng.range(tft.width() - len), rng.range(tft.height()), len, benchColor(rng));
+  }
+  return calls * len;
+}
+
+static uint32_t opVLine(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  const int32_t len = tft.height() / 2;
+  for (uint32_t i = 0; i < calls; i++) {
+    tft.drawFastVLine(rng.range(tft.width()), rng.range(tft.height() - len), len, benchColor(rng));
+  }
+  return calls * len;
+}
+
+static uint32_t opLine(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  uint32_t pixels = 0;
+  for (uint32_t i = 0; i < calls; i++) {
+    int32_t x0 = rng.range(tft.width()), y0 = rng.range(tft.height());
+    int32_t x1 = rng.range(tft.width()), y1 = rng.range(tft.height());
+    tft.drawLine(x0, y0, x1, y1, benchColor(rng));
+    pixels += max(abs(x1 - x0), abs(y1 - y0)) + 1;
+  }
+  return pixels;
+}
+
+static uint32_t fillRects(TFT_eSPI& tft, BenchRng& rng, uint32_t calls, int32_t size) {
+  for (uint32_t i = 0; i < calls; i++) {
+    tft.fillRect(rng.range(tft.width() - size + 1), rng.range(tft.height() - size + 1),
+                 size, size, benchColor(rng));
+  }
+  return calls * size * size;
+}
+
+static uint32_t opRect8(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) { return fillRects(tft, rng, calls, 8); }
+static uint32_t opRect32(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) { return fillRects(tft, rng, calls, 32); }
+static uint32_t opRect100(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) { return fillRects(tft, rng, calls, 100); }
+
+static uint32_t opFillScreen(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  for (uint32_t i = 0; i < calls; i++) {
+    tft.fillScreen(benchColor(rng));
+  }
+  return calls * tft.width() * tft.height();
+}
+
+static uint32_t opCircle(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  const int32_t r = 30;
+  for (uint32_t i = 0; i < calls; i++) {
+    tft.drawCircle(r + rng.range(tft.width() - 2 * r), r + rng.range(tft.height() - 2 * r), r, benchColor(rng));
+  }
+  return calls * (uint32_t)(2 * M_PI * r);   // Näherung: Umfang
+}
+
+static uint32_t opFillCircle(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  const int32_t r = 20;
+  for (uint32_t i = 0; i < calls; i++) {
+    tft.fillCircle(r + rng.range(tft.width() - 2 * r), r + rng.range(tft.height() - 2 * r), r, benchColor(rng));
+  }
+  return calls * (uint32_t)(M_PI * r * r);   // Näherung: Fläche
+}
+
+// Text mit Hintergrundfarbe: die Glyphen-Box wird komplett übertragen
+static uint32_t drawTexts(TFT_eSPI& tft, BenchRng& rng, uint32_t calls, uint8_t font) {
+  const int32_t w = tft.textWidth(BENCH_TEXT, font);
+  const int32_t h = tft.fontHeight(font);
+  for (uint32_t i = 0; i < calls; i++) {
+    tft.setTextColor(benchColor(rng), TFT_BLACK);
+    tft.drawString(BENCH_TEXT, rng.range(tft.width() - w), rng.range(tft.height() - h), font);
+  }
+  return calls * w * h;
+}
+
+static uint32_t opFont1(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) { return drawTexts(tft, rng, calls, 1); }
+static uint32_t opFont2(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) { return drawTexts(tft, rng, calls, 2); }
+static uint32_t opFont4(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) { return drawTexts(tft, rng, calls, 4); }
+
+static uint32_t opImage(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  for (uint32_t i = 0; i < calls; i++) {
+    tft.pushImage(rng.range(tft.width() - BENCH_IMAGE_SIZE), rng.range(tft.height() - BENCH_IMAGE_SIZE),
+                  BENCH_IMAGE_SIZE, BENCH_IMAGE_SIZE, benchImage);
+  }
+  return calls * BENCH_IMAGE_SIZE * BENCH_IMAGE_SIZE;
+}
+
+// Vollbild-Verlauf wie bisher (eine Linie pro Spalte) und als Spans
+static uint32_t opGradientLines(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  const int32_t w = tft.width();
+  for (uint32_t i = 0; i < calls; i++) {
+    const uint8_t r = rng.next(), g = rng.next();
+    for (int32_t x = 0; x < w; x++) {
+      tft.drawFastVLine(x, 0, tft.height(), tft.color565(r * x / w, g * x / w, 0));
+    }
+  }
+  return calls * w * tft.height();
+}
+
+static uint32_t opGradientSpan(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  for (uint32_t i = 0; i < calls; i++) {
+    const uint8_t r = rng.next(), g = rng.next();
+    benchSpans->fill(tft, 0, 0, tft.width(), tft.height(), spanGradientH(TFT_BLACK, tft.color565(r, g, 0)), false);
+  }
+  return calls * tft.width() * tft.height();
+}
+
+// 8x8 Farbraster wie im Farbtest: fillRect pro Zelle und als Spans
+static uint32_t opGridRects(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  const int32_t w = tft.width() / 8, h = tft.height() / 8;
+  for (uint32_t i = 0; i < calls; i++) {
+    const uint8_t shift = rng.range(8);
+    for (int32_t col = 0; col < 8; col++) {
+      for (int32_t row = 0; row < 8; row++) {
+        tft.fillRect(col * w, row * h, w, h, benchGridColors[(col + row + shift) % 8]);
+      }
+    }
+  }
+  return calls * 64 * w * h;
+}
+
+static uint32_t opGridSpan(TFT_eSPI& tft, BenchRng& rng, uint32_t calls) {
+  const int32_t w = tft.width() / 8, h = tft.height() / 8;
+  for (uint32_t i = 0; i < calls; i++) {
+    const uint8_t shift = rng.range(8);
+    uint16_t colors[8];
+    for (int32_t k = 0; k < 8; k++) colors[k] = benchGridColors[(k + shift) % 8];
+    benchSpans->fill(tft, 0, 0, 8 * w, 8 * h, spanGrid(colors, 8, w, h), false);
+  }
+  return calls * 64 * w * h;
+}
+
+// Aufrufzahlen so gewählt, dass jeder Durchlauf einige 10 ms dauert
+static const BenchCase BENCH_CASES[] = {
+  { "pixel",        opPixel,      2000 },
+  { "hline",        opHLine,      500 },
+  { "vline",        opVLine,      500 },
+  { "line",         opLine,       200 },
+  { "fill_rect_8",  opRect8,      1000 },
+  { "fill_rect_32", opRect32,     200 },
+  { "fill_rect_100",opRect100,    20 },
+  { "fill_screen",  opFillScreen, 3 },
+  { "circle",       opCircle,     100 },
+  { "fill_circle",  opFillCircle, 100 },
+  { "text_font1",   opFont1,      200 },
+  { "text_font2",   opFont2,      100 },
+  { "text_font4",   opFont4,      50 },
+  { "push_image",   opImage,      200 },
+  { "gradient_lines", opGradientLines, 3 },
+  { "gradient_span",  opGradientSpan,  3 },
+  { "grid_rects",   opGridRects,  3 },
+  { "grid_span",    opGridSpan,   3 }
+};
+
+#define BENCH_CASE_COUNT (sizeof(BENCH_CASES) / sizeof(BENCH_CASES[0]))
+
+// ============================================
+// MESSUNG
+// ============================================
+
+static BenchmarkResult measureCase(TFT_eSPI& tft, const BenchCase& bench, uint8_t index,
+                                   const BenchmarkConfig& config) {
+  BenchmarkResult result = { bench.name, bench.calls, 0, 0, 0, 0, 0 };
+  const uint8_t repeats = constrain(config.repeats, 1, BENCH_MAX_REPEATS);
+  float times[BENCH_MAX_REPEATS];
+
+  for (uint8_t run = 0; run < config.warmup + repeats; run++) {
+    BenchRng rng(config.seed ^ ((uint32_t)index * 0x9E3779B9UL));  // Jeder Durchlauf identisch
+    unsigned long start = micros();
+    result.pixels = bench.op(tft, rng, bench.calls);
+    unsigned long elapsed = micros() - start;
+    if (run >= config.warmup) times[run - config.warmup] = elapsed;
+  }
+
+  float sum = 0;
+  result.minUs = times[0];
+  result.maxUs = times[0];
+  for (uint8_t i = 0; i < repeats; i++) {
+    sum += times[i];
+    result.minUs = min(result.minUs, times[i]);
+    result.maxUs = max(result.maxUs, times[i]);
+  }
+  result.meanUs = sum / repeats;
+
+  float variance = 0;
+  for (uint8_t i = 0; i < repeats; i++) {
+    variance += (times[i] - result.meanUs) * (times[i] - result.meanUs);
+  }
+  result.stddevUs = repeats > 1 ? sqrtf(variance / (repeats - 1)) : 0;
+  return result;
+}
+
+// ============================================
+// AUSGABE
+// ============================================
+
+static void printResult(const BenchmarkResult& r, const BenchmarkConfig& config,
+                        BenchmarkFormat format, bool first) {
+  const float seconds = r.meanUs / 1000000.0f;
+  const float callsPerSec = seconds > 0 ? r.calls / seconds : 0;
+  const float pixelsPerSec = seconds > 0 ? r.pixels / seconds : 0;
+  const float bytesPerSec = pixelsPerSec * 2;
+  const float spiUtil = config.spiHz ? bytesPerSec * 8 * 100.0f / config.spiHz : 0;
+
+  if (format == BENCH_FORMAT_CSV) {
+    Serial.printf("%s,%lu,%s,%lu,%lu,%.1f,%.1f,%.1f,%.1f,%.0f,%.0f,%.0f,%.1f\n",
+                  config.profile, (unsigned long)config.spiHz, r.name,
+                  (unsigned long)r.calls, (unsigned long)r.pixels,
+                  r.meanUs, r.minUs, r.maxUs, r.stddevUs,
+                  callsPerSec, pixelsPerSec, bytesPerSec, spiUtil);
+  } else {
+    Serial.printf("%s    {\"primitive\": \"%s\", \"calls\": %lu, \"pixels\": %lu, "
+                  "\"mean_us\": %.1f, \"min_us\": %.1f, \"max_us\": %.1f, \"stddev_us\": %.1f, "
+                  "\"calls_per_s\": %.0f, \"pixels_per_s\": %.0f, \"bytes_per_s\": %.0f, "
+                  "\"spi_util_pct\": %.1f}",
+                  first ? "" : ",\n", r.name, (unsigned long)r.calls, (unsigned long)r.pixels,
+                  r.meanUs, r.minUs, r.maxUs, r.stddevUs,
+                  callsPerSec, pixelsPerSec, bytesPerSec, spiUtil);
+  }
+}
+
+void runDisplayBenchmark(TFT_eSPI& tft, const BenchmarkConfig& config, BenchmarkFormat format) {
+  // Bildinhalt ebenfalls aus dem Seed
+  BenchRng imageRng(config.seed);
+  for (auto& px : benchImage) px = imageRng.next() & 0xFFFF;
+  for (auto& color : benchGridColors) color = imageRng.next() & 0xFFFF;
+
+  if (format == BENCH_FORMAT_CSV) {
+    Serial.println("profile,spi_hz,primitive,calls,pixels,mean_us,min_us,max_us,stddev_us,"
+                   "calls_per_s,pixels_per_s,bytes_per_s,spi_util_pct");
+  } else {
+    Serial.printf("{\n  \"profile\": \"%s\", \"spi_hz\": %lu, \"seed\": %lu, \"warmup\": %d, "
+                  "\"repeats\": %d, \"width\": %d, \"height\": %d,\n  \"results\": [\n",
+                  config.profile, (unsigned long)config.spiHz, (unsigned long)config.seed,
+                  config.warmup, config.repeats, tft.width(), tft.height());
+  }
+
+  SpanFiller spans(*config.display);
+  benchSpans = &spans;
+  BenchmarkResult results[BENCH_CASE_COUNT];
+  for (uint8_t i = 0; i < BENCH_CASE_COUNT; i++) {
+    results[i] = measureCase(tft, BENCH_CASES[i], i, config);
+    printResult(results[i], config, format, i == 0);
+  }
+  spans.end();
+  benchSpans = nullptr;
+
+  // Span-Kernel gegen Linien bzw. Rechtecke (jeweils direkt davor gemessen)
+  if (format == BENCH_FORMAT_JSON) {
+    const BenchmarkResult& gradient = results[BENCH_CASE_COUNT - 3];
+    const BenchmarkResult& grid = results[BENCH_CASE_COUNT - 1];
+    Serial.printf("\n  ],\n  \"span_speedup\": {\"gradient\": %.1f, \"grid\": %.1f}\n}\n",
+                  gradient.meanUs > 0 ? results[BENCH_CASE_COUNT - 4].meanUs / gradient.meanUs : 0,
+                  grid.meanUs > 0 ? results[BENCH_CASE_COUNT - 2].meanUs / grid.meanUs : 0);
+  }
+  tft.fillScreen(TFT_BLACK);
+}
+
+uint32_t benchmarkLoadStep(TFT_eSPI& tft, const SpiDevice& display, BenchRng& rng) {
+  // Puffer bleiben für die Dauerlast belegt (erster Aufruf legt sie an)
+  static SpanFiller loadSpans(display);
+  
+  // Gleiche Primitive wie die Suite, Auswahl aus demselben Seed
+  const BenchCase& bench = BENCH_CASES[rng.range(BENCH_CASE_COUNT)];
+  benchSpans = &loadSpans;
+  const uint32_t pixels = bench.op(tft, rng, 1);
+  benchSpans = nullptr;
+  return pixels;
+}
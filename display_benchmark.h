@@ -0,0 +1,76 @@
+/**
+ * display_benchmark.h - Reproduzierbare Display-Benchmarks
+ *
+ * Jedes Primitiv wird einzeln gemessen: feste Aufrufzahl pro Durchlauf,
+ * Positionen/Farben aus einem geseedeten LCG (jeder Durchlauf identisch),
+ * Warm-up-Durchläufe ohne Wertung, danach Mittelwert/Min/Max/Streuung.
+ * Abgeleitet: Aufrufe/s, Pixel/s, Bytes/s (RGB565) und die SPI-Auslastung
+ * der Nutzdaten bezogen auf den aktiven Schreibtakt (display_clock.h).
+ *
+ * Ausgabe als CSV oder JSON über Serial, vergleichbar zwischen Profilen
+ * und Builds.
+ */
+
+#ifndef DISPLAY_BENCHMARK_H
+#define DISPLAY_BENCHMARK_H
+
+#include <stdint.h>
+
+class TFT_eSPI;
+struct SpiDevice;
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define BENCH_DEFAULT_SEED     0xC0FFEE
+#define BENCH_DEFAULT_WARMUP   1
+#define BENCH_DEFAULT_REPEATS  5
+#define BENCH_MAX_REPEATS      16
+
+enum BenchmarkFormat : uint8_t {
+  BENCH_FORMAT_CSV,
+  BENCH_FORMAT_JSON
+};
+
+struct BenchmarkConfig {
+  uint32_t seed;
+  uint8_t warmup;      // Durchläufe ohne Wertung
+  uint8_t repeats;     // Gewertete Durchläufe (max. BENCH_MAX_REPEATS)
+  uint32_t spiHz;      // Für die Auslastung
+  const char* profile;
+  const SpiDevice* display;   // Display am Bus-Arbiter (Span-Fälle)
+};
+
+struct BenchmarkResult {
+  const char* name;
+  uint32_t calls;      // Aufrufe pro Durchlauf
+  uint32_t pixels;     // Pixel pro Durchlauf
+  float meanUs, minUs, maxUs, stddevUs;   // Dauer eines Durchlaufs
+};
+
+// ============================================
+// DETERMINISTISCHER ZUFALL
+// ============================================
+
+struct BenchRng {
+  uint32_t state;
+  explicit BenchRng(uint32_t seed) : state(seed) {}
+  uint32_t next() {
+    state = state * 1664525UL + 1013904223UL;
+    return state >> 8;
+  }
+  int32_t range(int32_t limit) { return limit > 0 ? (int32_t)(next() % (uint32_t)limit) : 0; }
+};
+
+// ============================================
+// API (display_benchmark.cpp)
+// ============================================
+
+// Komplette Suite messen und im gewählten Format ausgeben
+void runDisplayBenchmark(TFT_eSPI& tft, const BenchmarkConfig& config, BenchmarkFormat format);
+
+// Eine Operation der deterministischen Dauerlast (Stress-Test), liefert Pixel
+uint32_t benchmarkLoadStep(TFT_eSPI& tft, const SpiDevice& display, BenchRng& rng);
+
+#endif // DISPLAY_BENCHMARK_H
@@ -0,0 +1,237 @@
+/**
+ * display_clock.cpp - Takt-Tuning mit Rücklese-Prüfung und NVS Persistenz
+ */
+
+#include "config.h"
+#include "TFT_Setup.h"  // VOR TFT_eSPI!
+#include <TFT_eSPI.h>
+#include "hardware_hal.h"
+#include "display_clock.h"
+#include <Preferences.h>
+
+#define DISPLAY_CLOCK_NVS_NAMESPACE "hw_display"
+#define DISPLAY_CLOCK_NVS_KEY       "clock"
+
+// Aktive Takte, bis loadDisplayClock()/Tuning die Profil-Werte ersetzt
+uint32_t displayClockWriteHz = HW_DISPLAY_SPI_FREQ;
+uint32_t displayClockReadHz = HW_DISPLAY_SPI_READ_FREQ;
+
+static uint16_t clockPattern[DISPLAY_CLOCK_BLOCK * DISPLAY_CLOCK_CHUNK_ROWS];
+static uint16_t clockReadback[DISPLAY_CLOCK_BLOCK * DISPLAY_CLOCK_CHUNK_ROWS];
+
+// ============================================
+// TESTMUSTER
+// ============================================
+
+enum ClockPattern : uint8_t {
+  PATTERN_TOGGLE,    // 0xAAAA/0x5555: jedes Bit wechselt bei jedem Pixel
+  PATTERN_STRIPES,   // Schwarz/Weiß spaltenweise: alle Leitungen gleichzeitig
+  PATTERN_WALK,      // Wandernde Eins: jedes Bit einzeln
+  PATTERN_RANDOM,    // Pseudozufall pro Durchlauf
+  PATTERN_COUNT
+};
+
+static uint16_t patternPixel(uint8_t pattern, int32_t x, int32_t y, uint32_t seed) {
+  switch (pattern) {
+    case PATTERN_TOGGLE:  return ((x + y) & 1) ? 0xAAAA : 0x5555;
+    case PATTERN_STRIPES: return (x & 1) ? 0xFFFF : 0x0000;
+    case PATTERN_WALK:    return (uint16_t)(1u << ((x + y + seed) & 15));
+    default: {
+      uint32_t h = ((uint32_t)y * DISPLAY_CLOCK_BLOCK + x) * 2654435761u ^ seed;
+      h ^= h >> 15;
+      h *= 0x2C1B3C6Du;
+      h ^= h >> 12;
+      return (uint16_t)h;
+    }
+  }
+}
+
+static void fillPattern(uint8_t pattern, int32_t y, uint32_t seed) {
+  for (int32_t row = 0; row < DISPLAY_CLOCK_CHUNK_ROWS; row++) {
+    for (int32_t x = 0; x < DISPLAY_CLOCK_BLOCK; x++) {
+      clockPattern[row * DISPLAY_CLOCK_BLOCK + x] = patternPixel(pattern, x, y + row, seed);
+    }
+  }
+}
+
+// ============================================
+// PRÜFUNG
+// ============================================
+
+// Block mit writeHz schreiben, mit readHz zurücklesen.
+// Liefert die fehlerhaften Pixel (mind. 1 bei abweichender CRC).
+static uint32_t checkPattern(TFT_eSPI& tft, int32_t x0, int32_t y0, uint8_t pattern,
+                             uint32_t seed, uint32_t writeHz, uint32_t readHz) {
+  const size_t chunkBytes = sizeof(clockPattern);
+
+  displayClockWriteHz = writeHz;
+  uint32_t expected = 0xFFFFFFFF;
+  for (int32_t y = 0; y < DISPLAY_CLOCK_BLOCK; y += DISPLAY_CLOCK_CHUNK_ROWS) {
+    fillPattern(pattern, y, seed);
+    expected = displayClockCrcUpdate(expected, (const uint8_t*)clockPattern, chunkBytes);
+    tft.pushImage(x0, y0 + y, DISPLAY_CLOCK_BLOCK, DISPLAY_CLOCK_CHUNK_ROWS, clockPattern);
+  }
+
+  // readRect liefert das Format von pushImage: direkt vergleichbar
+  displayClockReadHz = readHz;
+  uint32_t actual = 0xFFFFFFFF;
+  uint32_t errors = 0;
+  for (int32_t y = 0; y < DISPLAY_CLOCK_BLOCK; y += DISPLAY_CLOCK_CHUNK_ROWS) {
+    tft.readRect(x0, y0 + y, DISPLAY_CLOCK_BLOCK, DISPLAY_CLOCK_CHUNK_ROWS, clockReadback);
+    actual = displayClockCrcUpdate(actual, (const uint8_t*)clockReadback, chunkBytes);
+    fillPattern(pattern, y, seed);
+    for (size_t i = 0; i < DISPLAY_CLOCK_BLOCK * DISPLAY_CLOCK_CHUNK_ROWS; i++) {
+      if (clockReadback[i] != clockPattern[i]) errors++;
+    }
+  }
+
+  if (actual == expected) return 0;
+  return errors ? errors : 1;
+}
+
+// Alle Muster 'passes' mal, Zufallsmuster mit neuem Seed pro Durchlauf
+static uint32_t checkClock(TFT_eSPI& tft, int32_t x0, int32_t y0,
+                           uint32_t writeHz, uint32_t readHz, uint8_t passes) {
+  uint32_t errors = 0;
+  for (uint8_t pass = 0; pass < passes; pass++) {
+    const uint32_t seed = (pass + 1) * 0x9E3779B9u ^ writeHz ^ (readHz << 1);
+    for (uint8_t pattern = 0; pattern < PATTERN_COUNT; pattern++) {
+      errors += checkPattern(tft, x0, y0, pattern, seed, writeHz, readHz);
+    }
+  }
+  return errors;
+}
+
+// Stufen von DISPLAY_CLOCK_SAFE_HZ bis maxHz, Abbruch beim ersten Fehler.
+// Der andere Takt bleibt auf otherHz. Liefert den Teiler der höchsten
+// bestandenen Stufe (0 = keine), *failHz = erste fehlerhafte Stufe.
+static uint8_t rampClock(TFT_eSPI& tft, int32_t x0, int32_t y0, bool read,
+                         uint32_t otherHz, uint32_t maxHz, uint32_t* failHz) {
+  uint8_t passDivider = 0;
+  *failHz = 0;
+
+  for (int divider = DISPLAY_CLOCK_MIN_DIVIDER; divider >= displayClockDivider(maxHz); divider--) {
+    const uint32_t hz = displayClockStepHz((uint8_t)divider);
+    const uint32_t errors = read ? checkClock(tft, x0, y0, otherHz, hz, DISPLAY_CLOCK_PASSES)
+                                 : checkClock(tft, x0, y0, hz, otherHz, DISPLAY_CLOCK_PASSES);
+    Serial.printf("  %s %6.2f MHz: %s", read ? "Lesen    " : "Schreiben", hz / 1e6f,
+                  errors ? "❌" : "✅");
+    if (errors) {
+      Serial.printf(" (%u Pixelfehler)\n", (unsigned)errors);
+      *failHz = hz;
+      break;
+    }
+    Serial.println();
+    passDivider = (uint8_t)divider;
+  }
+  return passDivider;
+}
+
+static uint32_t stepDown(uint32_t hz) {
+  const uint8_t divider = displayClockDivider(hz);
+  return displayClockStepHz(divider < DISPLAY_CLOCK_MIN_DIVIDER ? divider + 1 : divider);
+}
+
+// ============================================
+// TUNING
+// ============================================
+
+bool displayClockTune(TFT_eSPI& tft, uint32_t maxWriteHz, uint32_t maxReadHz,
+                      DisplayClockResult* result) {
+  const uint32_t start = millis();
+  const uint32_t previousWriteHz = displayClockWriteHz;
+  const uint32_t previousReadHz = displayClockReadHz;
+  *result = DisplayClockResult();
+
+  const int32_t x0 = (tft.width() - DISPLAY_CLOCK_BLOCK) / 2;
+  const int32_t y0 = (tft.height() - DISPLAY_CLOCK_BLOCK) / 2;
+
+  // 1. Schreibtakt, Rücklesen auf der sicheren Stufe
+  Serial.printf("Schreibtakt (Rücklesen mit %.2f MHz):\n", DISPLAY_CLOCK_SAFE_HZ / 1e6f);
+  uint8_t divider = rampClock(tft, x0, y0, false, DISPLAY_CLOCK_SAFE_HZ, maxWriteHz,
+                              &result->writeFailHz);
+  uint32_t writeHz = divider ? displayClockWithMargin(divider, result->writeFailHz,
+                                                      DISPLAY_CLOCK_MARGIN_PCT) : 0;
+
+  // 2. Lesetakt, geschrieben mit dem gefundenen Schreibtakt
+  uint32_t readHz = 0;
+  if (writeHz) {
+    Serial.printf("Lesetakt (Schreiben mit %.2f MHz):\n", writeHz / 1e6f);
+    divider = rampClock(tft, x0, y0, true, writeHz, maxReadHz, &result->readFailHz);
+    readHz = divider ? displayClockWithMargin(divider, result->readFailHz,
+                                              DISPLAY_CLOCK_MARGIN_PCT) : 0;
+  }
+
+  // 3. Bestätigung mit beiden Takten, bei Fehlern je eine Stufe zurück
+  bool confirmed = false;
+  while (writeHz && readHz && !confirmed) {
+    const uint32_t errors = checkClock(tft, x0, y0, writeHz, readHz, DISPLAY_CLOCK_SOAK_PASSES);
+    Serial.printf("Bestätigung %.2f / %.2f MHz: %s\n", writeHz / 1e6f, readHz / 1e6f,
+                  errors ? "❌" : "✅");
+    confirmed = errors == 0;
+    if (!confirmed) {
+      result->soakErrors += errors;
+      if (writeHz == DISPLAY_CLOCK_SAFE_HZ && readHz == DISPLAY_CLOCK_SAFE_HZ) break;
+      writeHz = stepDown(writeHz);
+      readHz = stepDown(readHz);
+    }
+  }
+
+  displayClockWriteHz = confirmed ? writeHz : previousWriteHz;
+  displayClockReadHz = confirmed ? readHz : previousReadHz;
+  tft.fillRect(x0, y0, DISPLAY_CLOCK_BLOCK, DISPLAY_CLOCK_BLOCK, TFT_BLACK);
+
+  result->clock.marginPct = DISPLAY_CLOCK_MARGIN_PCT;
+  result->clock.writeHz = confirmed ? writeHz : 0;
+  result->clock.readHz = confirmed ? readHz : 0;
+  result->ok = confirmed;
+  result->durationMs = millis() - start;
+  return confirmed;
+}
+
+// ============================================
+// NVS PERSISTENZ
+// ============================================
+
+bool displayClockLoad(DisplayClockData* data, uint8_t profile, uint32_t maxHz) {
+  Preferences prefs;
+  if (!prefs.begin(DISPLAY_CLOCK_NVS_NAMESPACE, true)) {
+    return false;
+  }
+
+  size_t length = prefs.getBytes(DISPLAY_CLOCK_NVS_KEY, data, sizeof(DisplayClockData));
+  prefs.end();
+
+  if (length != sizeof(DisplayClockData)) {
+    return false;
+  }
+
+  if (!displayClockIsValid(*data, profile, maxHz)) {
+    Serial.println("Display-Takt in NVS ungültig (Version/Profil/CRC) - verwende Profil-Werte");
+    return false;
+  }
+  return true;
+}
+
+bool displayClockSave(DisplayClockData* data, uint8_t profile) {
+  data->version = DISPLAY_CLOCK_VERSION;
+  data->profile = profile;
+  data->crc = displayClockChecksum(*data);
+
+  Preferences prefs;
+  if (!prefs.begin(DISPLAY_CLOCK_NVS_NAMESPACE, false)) {
+    return false;
+  }
+
+  size_t written = prefs.putBytes(DISPLAY_CLOCK_NVS_KEY, data, sizeof(DisplayClockData));
+  prefs.end();
+  return written == sizeof(DisplayClockData);
+}
+
+void displayClockClear() {
+  Preferences prefs;
+  if (prefs.begin(DISPLAY_CLOCK_NVS_NAMESPACE, false)) {
+    prefs.remove(DISPLAY_CLOCK_NVS_KEY);
+    prefs.end();
+  }
+}
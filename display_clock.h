@@ -0,0 +1,143 @@
+/**
+ * display_clock.h - Display SPI-Takt: Auto-Tuning mit Rücklese-Prüfung
+ *
+ * Statt der Profil-Konstanten (HW_DISPLAY_SPI_FREQ / _READ_FREQ) läuft
+ * jedes Gerät mit dem Takt, den es nachweislich fehlerfrei schafft:
+ * Schreib- und Lesetakt werden stufenweise erhöht, Testmuster gezeichnet,
+ * per readRect() zurückgelesen und die CRC32 von Soll und Ist verglichen.
+ * Gewählt wird der höchste stabile Takt mit Abstand zum ersten Fehler.
+ *
+ * TFT_eSPI liest SPI_FREQUENCY / SPI_READ_FREQUENCY bei jeder Transaktion
+ * (TFT_Setup.h) - beide zeigen auf displayClockWriteHz / displayClockReadHz.
+ *
+ * Persistenz: NVS-Blob mit Version, Profil und CRC32 (display_clock.cpp).
+ */
+
+#ifndef DISPLAY_CLOCK_H
+#define DISPLAY_CLOCK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class TFT_eSPI;
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define DISPLAY_CLOCK_VERSION       1
+#define DISPLAY_CLOCK_BASE_HZ       80000000   // ESP32 SPI-Takt = 80 MHz / n
+#define DISPLAY_CLOCK_MIN_DIVIDER   16         // Unterste Stufe: 5 MHz
+#define DISPLAY_CLOCK_SAFE_HZ       (DISPLAY_CLOCK_BASE_HZ / DISPLAY_CLOCK_MIN_DIVIDER)
+#define DISPLAY_CLOCK_MARGIN_PCT    10         // Mindestabstand zum ersten Fehler
+#define DISPLAY_CLOCK_PASSES        3          // Durchläufe aller Muster pro Stufe
+#define DISPLAY_CLOCK_SOAK_PASSES   20         // Bestätigung des Ergebnisses
+#define DISPLAY_CLOCK_BLOCK         64         // Testblock 64x64 Pixel
+#define DISPLAY_CLOCK_CHUNK_ROWS    8          // Zeilen pro pushImage/readRect
+
+// ============================================
+// DATENSTRUKTUREN
+// ============================================
+
+// Persistierter Datensatz (NVS-Blob)
+struct DisplayClockData {
+  uint16_t version;
+  uint8_t profile;            // HARDWARE_PROFILE beim Tuning
+  uint8_t marginPct;
+  uint32_t writeHz;
+  uint32_t readHz;
+  uint32_t crc;               // CRC32 über alle vorherigen Bytes
+};
+
+struct DisplayClockResult {
+  DisplayClockData clock;     // Gewählte Takte
+  uint32_t writeFailHz;       // Erster fehlerhafter Schreibtakt, 0 = bis zur Obergrenze stabil
+  uint32_t readFailHz;        // Erster fehlerhafter Lesetakt, 0 = bis zur Obergrenze stabil
+  uint32_t soakErrors;        // Pixelfehler der verworfenen Bestätigungsläufe
+  uint32_t durationMs;
+  bool ok;
+};
+
+// ============================================
+// TAKTSTUFEN
+// ============================================
+
+// Erreichbare Takte: 80 MHz / n, n = 1..DISPLAY_CLOCK_MIN_DIVIDER
+inline uint32_t displayClockStepHz(uint8_t divider) {
+  return DISPLAY_CLOCK_BASE_HZ / divider;
+}
+
+// Kleinster Teiler (= höchster Takt), der 'hz' nicht überschreitet
+inline uint8_t displayClockDivider(uint32_t hz) {
+  if (hz == 0) return DISPLAY_CLOCK_MIN_DIVIDER;
+  uint32_t divider = DISPLAY_CLOCK_BASE_HZ / hz;
+  if (divider < 1) divider = 1;
+  if (DISPLAY_CLOCK_BASE_HZ / divider > hz) divider++;
+  if (divider > DISPLAY_CLOCK_MIN_DIVIDER) divider = DISPLAY_CLOCK_MIN_DIVIDER;
+  return (uint8_t)divider;
+}
+
+// Höchster bestandener Takt mit Reserve: Stufen unterhalb von 'passDivider'
+// bis failHz >= hz * (100 + margin) / 100. failHz 0 = kein Fehler gesehen.
+// Liefert 0, wenn keine Stufe den Abstand einhält.
+inline uint32_t displayClockWithMargin(uint8_t passDivider, uint32_t failHz, uint8_t marginPct) {
+  for (uint32_t divider = passDivider; divider <= DISPLAY_CLOCK_MIN_DIVIDER; divider++) {
+    const uint32_t hz = displayClockStepHz((uint8_t)divider);
+    if (failHz == 0 || (uint64_t)hz * (100 + marginPct) <= (uint64_t)failHz * 100) {
+      return hz;
+    }
+  }
+  return 0;
+}
+
+// ============================================
+// CRC & VALIDIERUNG
+// ============================================
+
+// Fortlaufende CRC32: Start mit 0xFFFFFFFF, Ergebnis invertieren
+inline uint32_t displayClockCrcUpdate(uint32_t crc, const uint8_t* data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return crc;
+}
+
+inline uint32_t displayClockChecksum(const DisplayClockData& data) {
+  return ~displayClockCrcUpdate(0xFFFFFFFF, (const uint8_t*)&data, offsetof(DisplayClockData, crc));
+}
+
+inline bool displayClockIsValid(const DisplayClockData& data, uint8_t profile, uint32_t maxHz) {
+  return data.version == DISPLAY_CLOCK_VERSION &&
+         data.profile == profile &&
+         data.writeHz >= DISPLAY_CLOCK_SAFE_HZ && data.writeHz <= maxHz &&
+         data.readHz >= DISPLAY_CLOCK_SAFE_HZ && data.readHz <= maxHz &&
+         data.crc == displayClockChecksum(data);
+}
+
+// ============================================
+// AKTIVE TAKTE (display_clock.cpp)
+// ============================================
+
+// Von TFT_eSPI pro Transaktion gelesen (SPI_FREQUENCY / SPI_READ_FREQUENCY)
+extern uint32_t displayClockWriteHz;
+extern uint32_t displayClockReadHz;
+
+// Schreib-/Lesetakt rampen, Ergebnis bestätigen und aktiv setzen.
+// Bei Fehler bleiben die vorherigen Takte aktiv. Zeichnet in einen
+// Testblock in der Bildschirmmitte; der Aufrufer hält den SPI-Bus.
+bool displayClockTune(TFT_eSPI& tft, uint32_t maxWriteHz, uint32_t maxReadHz,
+                      DisplayClockResult* result);
+
+// ============================================
+// NVS PERSISTENZ (display_clock.cpp)
+// ============================================
+
+// profile: HW_PROFILE_ID, maxHz: Obergrenze des Profils (HwDisplayConfig::tuneMaxHz)
+bool displayClockLoad(DisplayClockData* data, uint8_t profile, uint32_t maxHz);
+bool displayClockSave(DisplayClockData* data, uint8_t profile);  // Setzt Version, Profil + CRC
+void displayClockClear();
+
+#endif // DISPLAY_CLOCK_H
@@ -0,0 +1,124 @@
+/**
+ * frame_scheduler.cpp - Frame-Takt und Tearing-Effect Interrupt
+ */
+
+#include <Arduino.h>
+#include "frame_scheduler.h"
+
+// ============================================
+// FRAME-TAKT
+// ============================================
+
+FrameScheduler::FrameScheduler()
+  : frameRate(0), periodUs(0), nextSlotUs(0), dueUs(0), pending(false), inFrame(false),
+    frameStartUs(0), statsStartMs(0), counters() {
+  setRate(HW_FRAME_RATE);
+}
+
+void FrameScheduler::setRate(uint16_t hz) {
+  frameRate = constrain(hz, FRAME_RATE_MIN, FRAME_RATE_MAX);
+  periodUs = 1000000UL / frameRate;
+}
+
+void FrameScheduler::request(uint32_t nowUs, uint32_t delayUs) {
+  const uint32_t due = nowUs + delayUs;
+  counters.requests++;
+  if (pending && (int32_t)(due - dueUs) >= 0) {
+    counters.coalesced++;   // Früherer Frame zeichnet das mit
+    return;
+  }
+  dueUs = due;
+  pending = true;
+}
+
+uint32_t FrameScheduler::waitUs(uint32_t nowUs) const {
+  const int32_t remaining = (int32_t)(nextSlotUs - nowUs);
+  return remaining > 0 ? (uint32_t)remaining : 0;
+}
+
+bool FrameScheduler::startFrame(uint32_t nowUs, bool dirty) {
+  // Nächster Slot; nach einem zu langen Frame neu aufsetzen statt nachzuholen
+  nextSlotUs += periodUs;
+  if ((int32_t)(nowUs - nextSlotUs) >= 0) {
+    nextSlotUs = nowUs + periodUs;
+  }
+
+  const bool due = pending && (int32_t)(nowUs - dueUs) >= 0;
+  if (!due && !dirty) {
+    counters.skipped++;
+    return false;
+  }
+  if (due) pending = false;
+
+  inFrame = true;
+  frameStartUs = nowUs;
+  return true;
+}
+
+void FrameScheduler::alignFrame(uint32_t nowUs, bool teWaited, bool teOk) {
+  frameStartUs = nowUs;
+  if (!teWaited) return;
+  counters.teWaits++;
+  if (!teOk) counters.teTimeouts++;
+}
+
+void FrameScheduler::endFrame(uint32_t nowUs) {
+  if (!inFrame) return;
+  inFrame = false;
+
+  const uint32_t frameUs = nowUs - frameStartUs;
+  counters.frames++;
+  counters.totalFrameUs += frameUs;
+  if (frameUs > counters.maxFrameUs) counters.maxFrameUs = frameUs;
+  if (frameUs > periodUs) counters.missed++;
+}
+
+FrameStats FrameScheduler::stats(uint32_t nowMs) const {
+  FrameStats result = counters;
+  result.elapsedMs = nowMs - statsStartMs;
+  return result;
+}
+
+void FrameScheduler::resetStats(uint32_t nowMs) {
+  counters = FrameStats();
+  statsStartMs = nowMs;
+}
+
+// ============================================
+// TEARING-EFFECT
+// ============================================
+
+static SemaphoreHandle_t teSemaphore = nullptr;
+static volatile uint32_t teEdgeCount = 0;
+
+static void IRAM_ATTR teIrqHandler() {
+  BaseType_t woken = pdFALSE;
+  teEdgeCount++;
+  xSemaphoreGiveFromISR(teSemaphore, &woken);
+  if (woken) {
+    portYIELD_FROM_ISR();
+  }
+}
+
+bool frameTeBegin(int pin) {
+  if (pin < 0) return false;
+  if (!teSemaphore) {
+    teSemaphore = xSemaphoreCreateBinary();
+    if (!teSemaphore) return false;
+  }
+  pinMode(pin, INPUT);
+  attachInterrupt(digitalPinToInterrupt(pin), teIrqHandler, RISING);
+  Serial.printf("Tearing-Effect Sync aktiv: GPIO %d\n", pin);
+  return true;
+}
+
+bool frameTeWait(uint32_t timeoutMs) {
+  if (!teSemaphore) return false;
+  // Alte Flanke verwerfen: erst die nächste markiert den Beginn des V-Blanks
+  xSemaphoreTake(teSemaphore, 0);
+  return xSemaphoreTake(teSemaphore, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+uint32_t frameTeEdges() {
+  return teEdgeCount;
+}
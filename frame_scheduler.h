@@ -0,0 +1,101 @@
+/**
+ * frame_scheduler.h - Frame-Takt mit festem Budget und TE-Synchronisation
+ *
+ * Die UI zeichnet nicht mehr so schnell wie möglich, sondern in festen
+ * Slots (HW_FRAME_RATE). requestFrame() und markDirty()-Bereiche werden
+ * bis zum nächsten Slot gebündelt; liegt nichts an, wird der Slot
+ * übersprungen und die CPU schläft bis zum nächsten. Touch-Events fordern
+ * keinen Frame an: wer auf Touch reagiert, ruft requestFrame() selbst.
+ *
+ *   if (hardware.beginFrame()) {   // Wartet auf den Slot (und TE)
+ *     ... zeichnen ...
+ *     hardware.endFrame();
+ *   }
+ *   hardware.requestFrame(2000);   // Nächster Frame frühestens in 2 s
+ *
+ * Hat das Profil einen TE-Pin (HW_DISPLAY_TE), schaltet initDisplay()
+ * den Tearing-Effect Ausgang ein (TEON, nur V-Blank) und beginFrame()
+ * wartet zusätzlich auf dessen steigende Flanke: der Flush beginnt am
+ * Anfang des V-Blanks. Tearing-frei ist ein Vollbild nur, wenn die
+ * Übertragung der Scanline des Panels nicht überholt wird.
+ */
+
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <stdint.h>
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#ifndef HW_FRAME_RATE
+  #define HW_FRAME_RATE        30       // Frames pro Sekunde
+#endif
+
+#define FRAME_RATE_MIN         1
+#define FRAME_RATE_MAX         120
+#define FRAME_TE_TIMEOUT_MS    40       // > 2 Panel-Refreshes (60 Hz)
+#define FRAME_CMD_TEON         0x35     // MIPI DCS, Parameter 0 = nur V-Blank
+
+// ============================================
+// DATENSTRUKTUREN
+// ============================================
+
+struct FrameStats {
+  uint32_t frames;         // Gezeichnete Frames
+  uint32_t skipped;        // Slots ohne Anforderung
+  uint32_t missed;         // Frames über dem Budget (verpasste Deadline)
+  uint32_t requests;       // Nur requestFrame()-Aufrufe (markDirty() zählt nicht)
+  uint32_t coalesced;      // Davon in einen bereits angeforderten Frame gebündelt
+  uint32_t teWaits;        // Auf die TE-Flanke gewartet
+  uint32_t teTimeouts;     // Keine Flanke innerhalb FRAME_TE_TIMEOUT_MS
+  uint32_t maxFrameUs;
+  uint64_t totalFrameUs;   // Summe der Frame-Zeiten (Zeichnen + Flush)
+  uint32_t elapsedMs;      // Messzeitraum
+};
+
+// Reine Zeitlogik ohne Warten; Zeiten in micros()
+class FrameScheduler {
+public:
+  FrameScheduler();
+
+  void setRate(uint16_t hz);
+  uint16_t rate() const { return frameRate; }
+  uint32_t budgetUs() const { return periodUs; }
+
+  // Frühestens nach delayUs zeichnen; eine frühere Anforderung gewinnt
+  void request(uint32_t nowUs, uint32_t delayUs);
+
+  // Zeit bis zum nächsten Slot, 0 = jetzt
+  uint32_t waitUs(uint32_t nowUs) const;
+
+  // Slot beginnt: true = Frame fällig (angefordert oder dirty)
+  bool startFrame(uint32_t nowUs, bool dirty);
+  void alignFrame(uint32_t nowUs, bool teWaited, bool teOk);   // Nach der TE-Flanke
+  void endFrame(uint32_t nowUs);
+
+  FrameStats stats(uint32_t nowMs) const;
+  void resetStats(uint32_t nowMs);
+
+private:
+  uint16_t frameRate;
+  uint32_t periodUs;
+  uint32_t nextSlotUs;
+  uint32_t dueUs;          // Frühester angeforderter Zeitpunkt
+  bool pending;
+  bool inFrame;
+  uint32_t frameStartUs;
+  uint32_t statsStartMs;
+  FrameStats counters;
+};
+
+// ============================================
+// TEARING-EFFECT (frame_scheduler.cpp)
+// ============================================
+
+bool frameTeBegin(int pin);               // Interrupt auf steigende Flanke
+bool frameTeWait(uint32_t timeoutMs);     // Nächste Flanke, false = Timeout
+uint32_t frameTeEdges();
+
+#endif // FRAME_SCHEDULER_H
@@ -0,0 +1,261 @@
+/**
+ * glyph_atlas.cpp - Glyphen rastern, verdrängen und als Fenster übertragen
+ */
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <string.h>
+#include "glyph_atlas.h"
+#include "damage_tracker.h"  // DAMAGE_WINDOW_BYTES
+#include "spi_arbiter.h"
+
+#define GLYPH_NOT_CACHED  -2   // Passt nie in den Atlas: direkt zeichnen
+#define GLYPH_PINNED      -1   // Platz nur nach dem Übertragen des Abschnitts
+
+GlyphAtlas::GlyphAtlas(const SpiDevice& display)
+  : device(display), pool(nullptr), capacity(0), used(0), useClock(0), entries(), raster(nullptr),
+    rasterHeight(0), counters() {}
+
+bool GlyphAtlas::begin(uint32_t bytes) {
+  if (pool) return true;
+  pool = (uint16_t*)malloc(bytes);
+  if (!pool) return false;
+  capacity = bytes / 2;
+  clear();
+  return true;
+}
+
+void GlyphAtlas::end() {
+  clear();
+  free(pool);
+  pool = nullptr;
+  capacity = 0;
+  if (raster) {
+    raster->deleteSprite();
+    delete raster;
+    raster = nullptr;
+    rasterHeight = 0;
+  }
+}
+
+void GlyphAtlas::clear() {
+  for (GlyphAtlasEntry& entry : entries) entry.code = 0;
+  used = 0;
+}
+
+uint8_t GlyphAtlas::glyphCount() const {
+  uint8_t count = 0;
+  for (const GlyphAtlasEntry& entry : entries) {
+    if (entry.code) count++;
+  }
+  return count;
+}
+
+// ============================================
+// ATLAS
+// ============================================
+
+int GlyphAtlas::lookup(TFT_eSPI& tft, uint16_t code, uint8_t font, uint16_t fg, uint16_t bg, int16_t height) {
+  for (int i = 0; i < GLYPH_ATLAS_ENTRIES; i++) {
+    GlyphAtlasEntry& entry = entries[i];
+    if (entry.code == code && entry.font == font && entry.fg == fg && entry.bg == bg) {
+      entry.lastUse = useClock;
+      counters.hits++;
+      return i;
+    }
+  }
+  return rasterize(tft, code, font, fg, bg, height);
+}
+
+// Glyphe in den Sprite zeichnen und zeilenweise in den Pool kopieren
+int GlyphAtlas::rasterize(TFT_eSPI& tft, uint16_t code, uint8_t font, uint16_t fg, uint16_t bg, int16_t height) {
+  const char text[2] = { (char)code, '\0' };
+  const int16_t width = raster->textWidth(text, font);
+  if (width <= 0 || width > GLYPH_ATLAS_MAX_WIDTH || height > 255) return GLYPH_NOT_CACHED;
+
+  if (rasterHeight < height) {
+    raster->deleteSprite();
+    raster->setColorDepth(16);
+    if (!raster->createSprite(GLYPH_ATLAS_MAX_WIDTH, height)) {
+      rasterHeight = 0;
+      return GLYPH_NOT_CACHED;
+    }
+    rasterHeight = height;
+  }
+
+  const int slot = reserve((uint32_t)width * height);
+  if (slot < 0) return slot;
+
+  raster->fillSprite(bg);
+  raster->setTextColor(fg, bg);
+  raster->drawChar(code, 0, 0, font);
+  const uint16_t* pixels = (const uint16_t*)raster->getPointer();
+  for (int16_t row = 0; row < height; row++) {
+    memcpy(pool + used + row * width, pixels + row * GLYPH_ATLAS_MAX_WIDTH, width * 2);
+  }
+
+  GlyphAtlasEntry& entry = entries[slot];
+  entry.code = code;
+  entry.font = font;
+  entry.width = (uint8_t)width;
+  entry.height = (uint8_t)height;
+  entry.fg = fg;
+  entry.bg = bg;
+  entry.offset = used;
+  entry.lastUse = useClock;
+  used += (uint32_t)width * height;
+  counters.misses++;
+  return slot;
+}
+
+// Freien Eintrag mit 'pixels' Platz am Pool-Ende schaffen
+int GlyphAtlas::reserve(uint32_t pixels) {
+  if (pixels > capacity) return GLYPH_NOT_CACHED;
+
+  for (;;) {
+    int slot = -1;
+    uint32_t live = 0;
+    for (int i = 0; i < GLYPH_ATLAS_ENTRIES; i++) {
+      if (entries[i].code) {
+        live += (uint32_t)entries[i].width * entries[i].height;
+      } else if (slot < 0) {
+        slot = i;
+      }
+    }
+    if (slot >= 0 && live + pixels <= capacity) {
+      if (used + pixels > capacity) compact();
+      return slot;
+    }
+    if (!evictOldest()) return GLYPH_PINNED;
+  }
+}
+
+bool GlyphAtlas::evictOldest() {
+  int oldest = -1;
+  for (int i = 0; i < GLYPH_ATLAS_ENTRIES; i++) {
+    const GlyphAtlasEntry& entry = entries[i];
+    if (!entry.code || entry.lastUse == useClock) continue;
+    if (oldest < 0 || entry.lastUse < entries[oldest].lastUse) oldest = i;
+  }
+  if (oldest < 0) return false;
+  entries[oldest].code = 0;
+  counters.evictions++;
+  return true;
+}
+
+// Lebende Glyphen nach Offset aufsteigend an den Pool-Anfang schieben
+void GlyphAtlas::compact() {
+  uint32_t cursor = 0;
+  for (;;) {
+    int next = -1;
+    for (int i = 0; i < GLYPH_ATLAS_ENTRIES; i++) {
+      const GlyphAtlasEntry& entry = entries[i];
+      if (entry.code && entry.offset >= cursor && (next < 0 || entry.offset < entries[next].offset)) {
+        next = i;
+      }
+    }
+    if (next < 0) break;
+
+    GlyphAtlasEntry& entry = entries[next];
+    const uint32_t pixels = (uint32_t)entry.width * entry.height;
+    if (entry.offset != cursor) {
+      memmove(pool + cursor, pool + entry.offset, pixels * 2);
+      entry.offset = cursor;
+    }
+    cursor += pixels;
+  }
+  used = cursor;
+}
+
+// ============================================
+// ÜBERTRAGUNG
+// ============================================
+
+// Ein Fenster für den ganzen Abschnitt, Zeile für Zeile aus dem Pool.
+// Ragt er über den Rand, pro Glyphe mit Clipping (pushImage). Danach
+// sind die Glyphen des Abschnitts wieder verdrängbar.
+int16_t GlyphAtlas::pushRun(TFT_eSPI& tft, const uint8_t* run, uint8_t count,
+                            int32_t x, int32_t y, int16_t height) {
+  int16_t width = 0;
+  for (uint8_t i = 0; i < count; i++) width += entries[run[i]].width;
+
+  const bool swap = tft.getSwapBytes();
+  tft.setSwapBytes(false);  // Pool liegt bereits in Display-Byte-Reihenfolge
+  spiArbiter.acquire(device);
+  tft.startWrite();
+
+  if (x >= 0 && y >= 0 && x + width <= tft.width() && y + height <= tft.height()) {
+    tft.setAddrWindow(x, y, width, height);
+    for (int16_t row = 0; row < height; row++) {
+      for (uint8_t i = 0; i < count; i++) {
+        const GlyphAtlasEntry& entry = entries[run[i]];
+        tft.pushPixels(pool + entry.offset + row * entry.width, entry.width);
+      }
+    }
+    counters.windows++;
+    counters.bytes += (uint32_t)width * height * 2 + DAMAGE_WINDOW_BYTES;
+  } else {
+    int32_t glyphX = x;
+    for (uint8_t i = 0; i < count; i++) {
+      const GlyphAtlasEntry& entry = entries[run[i]];
+      tft.pushImage(glyphX, y, entry.width, entry.height, (const uint16_t*)(pool + entry.offset));
+      glyphX += entry.width;
+      counters.windows++;
+      counters.bytes += (uint32_t)entry.width * entry.height * 2 + DAMAGE_WINDOW_BYTES;
+    }
+  }
+
+  tft.endWrite();
+  spiArbiter.release(device);
+  tft.setSwapBytes(swap);
+  useClock++;
+  return width;
+}
+
+int16_t GlyphAtlas::drawString(TFT_eSPI& tft, const char* text, int32_t x, int32_t y,
+                               uint8_t font, uint16_t fg, uint16_t bg) {
+  if (!raster) raster = new TFT_eSprite(&tft);
+  if (!begin()) {
+    tft.setTextColor(fg, bg);
+    return tft.drawString(text, x, y, font);
+  }
+  raster->setTextSize(1);
+  const int16_t height = raster->fontHeight(font);
+  counters.strings++;
+
+  uint8_t run[GLYPH_ATLAS_RUN];
+  uint8_t count = 0;
+  int32_t cursor = x;
+  useClock++;
+
+  for (const char* p = text; *p; p++) {
+    const uint16_t code = (uint8_t)*p;
+    if (count == GLYPH_ATLAS_RUN) {
+      cursor += pushRun(tft, run, count, cursor, y, height);
+      count = 0;
+    }
+
+    int slot = lookup(tft, code, font, fg, bg, height);
+    if (slot == GLYPH_PINNED && count) {
+      cursor += pushRun(tft, run, count, cursor, y, height);
+      count = 0;
+      slot = lookup(tft, code, font, fg, bg, height);
+    }
+    if (slot < 0) {
+      if (count) {
+        cursor += pushRun(tft, run, count, cursor, y, height);
+        count = 0;
+      }
+      tft.setTextColor(fg, bg);
+      cursor += tft.drawChar(code, cursor, y, font);
+      counters.uncached++;
+      counters.windows++;
+      continue;
+    }
+    run[count++] = (uint8_t)slot;
+  }
+  if (count) {
+    cursor += pushRun(tft, run, count, cursor, y, height);
+  }
+  return (int16_t)(cursor - x);
+}
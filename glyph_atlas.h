@@ -0,0 +1,101 @@
+/**
+ * glyph_atlas.h - Cache für vorgerenderte Glyphen (FONT2, FONT4, GLCD)
+ *
+ * drawString() mit Hintergrund schreibt jede Glyphe in ein eigenes
+ * Adressfenster und dekodiert sie bei jedem Aufruf neu. Der Atlas
+ * rastert jede Kombination aus Zeichen, Font, Vorder- und
+ * Hintergrundfarbe einmal in einen Sprite und hält die RGB565-Pixel in
+ * einem festen Pool (Display-Byte-Reihenfolge). Ein String geht danach
+ * als ein Fenster über den Bus: Zeile für Zeile die Zeilen aller
+ * Glyphen hintereinander.
+ *
+ *   hardware.drawText("Fade auf 80%", 10, 40, 2, TFT_WHITE, TFT_BLACK);
+ *
+ * Ist der Pool (GLYPH_ATLAS_BYTES) oder die Eintragstabelle voll, wird
+ * die am längsten unbenutzte Glyphe verdrängt und der Pool kompaktiert.
+ * Glyphen des gerade gezeichneten Abschnitts sind gesperrt; reicht der
+ * Platz nicht, wird der Abschnitt vorher übertragen.
+ * Textgröße 1, Ursprung oben links (TL_DATUM), ohne Viewport.
+ */
+
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <stdint.h>
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#ifndef GLYPH_ATLAS_BYTES
+  #define GLYPH_ATLAS_BYTES    12288    // Pixel-Pool (≈ 16 FONT4- oder 48 FONT2-Glyphen)
+#endif
+
+#define GLYPH_ATLAS_ENTRIES    96       // Glyphen im Atlas
+#define GLYPH_ATLAS_MAX_WIDTH  32       // Breitere Glyphen direkt zeichnen
+#define GLYPH_ATLAS_RUN        48       // Glyphen pro Fenster
+
+// ============================================
+// DATENSTRUKTUREN
+// ============================================
+
+struct GlyphAtlasEntry {
+  uint16_t code;           // 0 = frei
+  uint8_t font;
+  uint8_t width, height;
+  uint16_t fg, bg;
+  uint32_t offset;         // Erstes Pixel im Pool
+  uint32_t lastUse;        // LRU-Zeitstempel (useClock)
+};
+
+struct GlyphAtlasStats {
+  uint32_t strings;        // drawString()-Aufrufe
+  uint32_t hits, misses;   // Glyphen aus dem Atlas / neu gerastert
+  uint32_t evictions;
+  uint32_t uncached;       // Direkt gezeichnet (zu breit, Pool zu klein)
+  uint32_t windows;        // Adressfenster (ohne Atlas: eines pro Glyphe)
+  uint64_t bytes;          // SPI-Bytes inkl. Fenster
+};
+
+class TFT_eSPI;
+class TFT_eSprite;
+struct SpiDevice;
+
+class GlyphAtlas {
+public:
+  explicit GlyphAtlas(const SpiDevice& display);   // Display am Bus-Arbiter
+
+  bool begin(uint32_t bytes = GLYPH_ATLAS_BYTES);   // Pool belegen
+  void end();
+  void clear();                                     // Alle Glyphen verwerfen
+
+  // Zeichnet 'text' ab (x, y) mit deckendem Hintergrund, liefert die Breite
+  int16_t drawString(TFT_eSPI& tft, const char* text, int32_t x, int32_t y,
+                     uint8_t font, uint16_t fg, uint16_t bg);
+
+  uint8_t glyphCount() const;
+  uint32_t usedBytes() const { return used * 2; }
+  uint32_t capacityBytes() const { return capacity * 2; }
+  const GlyphAtlasStats& stats() const { return counters; }
+  void resetStats() { counters = GlyphAtlasStats(); }
+
+private:
+  int lookup(TFT_eSPI& tft, uint16_t code, uint8_t font, uint16_t fg, uint16_t bg, int16_t height);
+  int rasterize(TFT_eSPI& tft, uint16_t code, uint8_t font, uint16_t fg, uint16_t bg, int16_t height);
+  int reserve(uint32_t pixels);   // Freier Eintrag, -1 = gesperrt, -2 = nie passend
+  bool evictOldest();
+  void compact();
+  int16_t pushRun(TFT_eSPI& tft, const uint8_t* run, uint8_t count, int32_t x, int32_t y, int16_t height);
+
+  const SpiDevice& device;
+  uint16_t* pool;
+  uint32_t capacity;       // Pixel
+  uint32_t used;           // Pixel, Pool ist bis hier belegt
+  uint32_t useClock;       // Einträge mit lastUse == useClock sind gesperrt
+  GlyphAtlasEntry entries[GLYPH_ATLAS_ENTRIES];
+  TFT_eSprite* raster;
+  int16_t rasterHeight;
+  GlyphAtlasStats counters;
+};
+
+#endif // GLYPH_ATLAS_H
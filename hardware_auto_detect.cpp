@@ -0,0 +1,284 @@
+/**
+ * hardware_auto_detect.cpp - Controller-Probes und Profilwahl
+ */
+
+#include "config.h"
+#include "hardware_hal.h"
+#include "hardware_auto_detect.h"
+#include <SPI.h>
+#include <Wire.h>
+
+// ============================================
+// KANDIDATEN
+// ============================================
+
+const DetectSpiPins detectDisplayPins[DETECT_DISPLAY_PIN_SETS] = {
+  { "HSPI 14/12/13 CS15 DC2", HSPI, 14, 12, 13, 15, 2 },   // TZT-24, 2432S028R
+  { "VSPI 18/19/23 CS15 DC2", VSPI, 18, 19, 23, 15, 2 },   // TFT_eSPI Standard-Verdrahtung
+};
+
+const DetectSpiPins detectTouchPins[DETECT_TOUCH_PIN_SETS] = {
+  { "HSPI 14/12/13 CS33", HSPI, 14, 12, 13, 33, -1 },      // TZT-24 (geteilt mit Display)
+  { "VSPI 25/39/32 CS33", VSPI, 25, 39, 32, 33, -1 },      // 2432S028R
+};
+
+const DetectI2cPins detectI2cPins[DETECT_I2C_PIN_SETS] = {
+  { "SDA21/SCL22", 21, 22 },                               // ESP32 Standard
+  { "SDA33/SCL32", 33, 32 },                               // 2432S028 kapazitive Variante
+};
+
+// Kandidaten sind die Profile mit HW_FEATURE_AUTO_DETECT (hardware_profiles.cpp)
+static_assert(DETECT_DISPLAY_ST7789 == HW_DISPLAY_CTRL_ST7789 &&
+              DETECT_DISPLAY_ILI9341 == HW_DISPLAY_CTRL_ILI9341 &&
+              DETECT_DISPLAY_ILI9488 == HW_DISPLAY_CTRL_ILI9488,
+              "DetectedDisplay muss den HW_DISPLAY_CTRL_* IDs entsprechen");
+
+// GT911 (beide Adressen), FT6236, CST816S. Der CST816S antwortet im
+// Auto-Sleep erst nach einer Berührung oder einem Reset.
+static const uint8_t i2cTouchAddresses[] = { 0x5D, 0x14, 0x38, 0x15 };
+
+#define XPT2046_CMD_TEMP0      0x87   // TEMP0, 12 Bit, single-ended, Referenz an
+#define XPT2046_CMD_POWERDOWN  0xD0   // X lesen, danach Power-Down (wie die Bibliothek)
+
+// ============================================
+// SPI
+// ============================================
+
+static void spiBegin(SPIClass& spi, const DetectSpiPins& pins) {
+  pinMode(pins.cs, OUTPUT);
+  digitalWrite(pins.cs, HIGH);
+  if (pins.dc >= 0) {
+    pinMode(pins.dc, OUTPUT);
+    digitalWrite(pins.dc, HIGH);
+  }
+  spi.begin(pins.sclk, pins.miso, pins.mosi, -1);
+  spi.beginTransaction(SPISettings(DETECT_SPI_HZ, MSBFIRST, SPI_MODE0));
+}
+
+static void spiEnd(SPIClass& spi) {
+  spi.endTransaction();
+  spi.end();
+}
+
+static void displayCommand(SPIClass& spi, const DetectSpiPins& pins, uint8_t cmd) {
+  digitalWrite(pins.dc, LOW);
+  spi.transfer(cmd);
+  digitalWrite(pins.dc, HIGH);
+}
+
+// Kommando + 4 Bytes lesen (Dummy + Parameter 1-3)
+static void readDisplayRegister(SPIClass& spi, const DetectSpiPins& pins, uint8_t cmd, uint8_t raw[4]) {
+  digitalWrite(pins.cs, LOW);
+  displayCommand(spi, pins, cmd);
+  for (int i = 0; i < 4; i++) raw[i] = spi.transfer(0x00);
+  digitalWrite(pins.cs, HIGH);
+}
+
+// ILI9341: Parameter einzeln über das Index-Register 0xD9 (wie TFT_eSPI readcommand8)
+static void readIndexedRegister(SPIClass& spi, const DetectSpiPins& pins, uint8_t cmd, uint8_t out[3]) {
+  for (uint8_t i = 0; i < 3; i++) {
+    digitalWrite(pins.cs, LOW);
+    displayCommand(spi, pins, 0xD9);
+    spi.transfer(0x10 + i + 1);
+    displayCommand(spi, pins, cmd);
+    out[i] = spi.transfer(0x00);
+    digitalWrite(pins.cs, HIGH);
+  }
+}
+
+// RDDID im seriellen Modus: je nach Controller ein Dummy-Byte oder nur
+// ein Dummy-Takt vor den 24 ID-Bits - beide Ausrichtungen prüfen
+static uint8_t probeDisplay(const DetectSpiPins& pins, uint8_t id[3]) {
+  SPIClass spi(pins.host);
+  spiBegin(spi, pins);
+
+  uint8_t raw[4];
+  readDisplayRegister(spi, pins, 0x04, raw);
+  const uint32_t word = ((uint32_t)raw[0] << 24) | ((uint32_t)raw[1] << 16) | ((uint32_t)raw[2] << 8) | raw[3];
+  const uint32_t shifted = (word >> 7) & 0xFFFFFF;
+  const uint8_t none[3] = { 0, 0, 0 };
+
+  uint8_t display = DETECT_DISPLAY_UNKNOWN;
+  const uint8_t byteAligned[3] = { raw[1], raw[2], raw[3] };
+  const uint8_t bitAligned[3] = { (uint8_t)(shifted >> 16), (uint8_t)(shifted >> 8), (uint8_t)shifted };
+  if (detectClassifyDisplay(byteAligned, none) == DETECT_DISPLAY_ST7789) {
+    memcpy(id, byteAligned, 3);
+    display = DETECT_DISPLAY_ST7789;
+  } else if (detectClassifyDisplay(bitAligned, none) == DETECT_DISPLAY_ST7789) {
+    memcpy(id, bitAligned, 3);
+    display = DETECT_DISPLAY_ST7789;
+  } else {
+    readIndexedRegister(spi, pins, 0xD3, id);
+    display = detectClassifyDisplay(none, id);
+  }
+
+  spiEnd(spi);
+  return display;
+}
+
+static bool probeXpt2046(const DetectSpiPins& pins, uint16_t* temp) {
+  SPIClass spi(pins.host);
+  spiBegin(spi, pins);
+
+  digitalWrite(pins.cs, LOW);
+  bool valid = true;
+  for (int sample = 0; sample < 2 && valid; sample++) {
+    spi.transfer(XPT2046_CMD_TEMP0);
+    uint16_t raw = (uint16_t)spi.transfer(0x00) << 8;
+    raw |= spi.transfer(0x00);
+    valid = detectXptSample(raw, temp);
+  }
+  spi.transfer(XPT2046_CMD_POWERDOWN);
+  spi.transfer(0x00);
+  spi.transfer(0x00);
+  digitalWrite(pins.cs, HIGH);
+
+  spiEnd(spi);
+  return valid;
+}
+
+// ============================================
+// I2C
+// ============================================
+
+static uint8_t scanI2cTouch(const DetectI2cPins& pins) {
+  uint8_t found = 0;
+  if (!Wire.begin(pins.sda, pins.scl, DETECT_I2C_HZ)) {
+    return 0;
+  }
+  Wire.setTimeOut(DETECT_I2C_TIMEOUT_MS);
+  for (uint8_t address : i2cTouchAddresses) {
+    Wire.beginTransmission(address);
+    if (Wire.endTransmission() == 0) {
+      found = address;
+      break;
+    }
+  }
+  Wire.end();
+  return found;
+}
+
+// ============================================
+// PROFILWAHL
+// ============================================
+
+static bool profileMatchesDisplay(const HardwareProfile& profile, const HardwareDetection& result) {
+  if (result.displayPins == DETECT_NONE) return false;
+  const DetectSpiPins& pins = detectDisplayPins[result.displayPins];
+  return profile.display.controller == result.display &&
+         profile.display.bus == pins.host && profile.display.sclk == pins.sclk &&
+         profile.display.cs == pins.cs && profile.display.dc == pins.dc;
+}
+
+static bool profileMatchesTouch(const HardwareProfile& profile, const HardwareDetection& result) {
+  switch (result.touch) {
+    case DETECT_TOUCH_XPT2046_HSPI:
+    case DETECT_TOUCH_XPT2046_VSPI:
+      return profile.touch.controller == HW_TOUCH_CTRL_XPT2046 &&
+             profile.touch.bus == detectTouchPins[result.touchPins].host &&
+             profile.touch.cs == detectTouchPins[result.touchPins].cs;
+    case DETECT_TOUCH_GT911:   return profile.touch.controller == HW_TOUCH_CTRL_GT911;
+    case DETECT_TOUCH_FT6236:  return profile.touch.controller == HW_TOUCH_CTRL_FT6236;
+    case DETECT_TOUCH_CST816S: return profile.touch.controller == HW_TOUCH_CTRL_CST816S;
+    default:                   return false;
+  }
+}
+
+// ============================================
+// ERKENNUNG
+// ============================================
+
+int detectHardwareProfile(HardwareDetection* result) {
+  *result = HardwareDetection();
+  result->displayPins = DETECT_NONE;
+  result->touchPins = DETECT_NONE;
+  const uint32_t start = micros();
+
+  // 1. Display-Controller über die Kandidaten-Pins
+  for (uint8_t i = 0; i < DETECT_DISPLAY_PIN_SETS && !result->display; i++) {
+    result->display = probeDisplay(detectDisplayPins[i], result->displayId);
+    if (result->display) result->displayPins = i;
+  }
+  const uint32_t displayDone = micros();
+  result->displayUs = displayDone - start;
+
+  // 2. XPT2046 auf HSPI und VSPI
+  for (uint8_t i = 0; i < DETECT_TOUCH_PIN_SETS && !result->touch; i++) {
+    if (probeXpt2046(detectTouchPins[i], &result->touchTemp)) {
+      result->touch = detectTouchPins[i].host == VSPI ? DETECT_TOUCH_XPT2046_VSPI
+                                                      : DETECT_TOUCH_XPT2046_HSPI;
+      result->touchPins = i;
+    }
+  }
+  const uint32_t touchDone = micros();
+  result->touchUs = touchDone - displayDone;
+
+  // 3. Kapazitiver Touch nur ohne XPT2046 (die I2C-Pins kreuzen dessen Leitungen)
+  if (!result->touch) {
+    for (uint8_t i = 0; i < DETECT_I2C_PIN_SETS && !result->touch; i++) {
+      result->i2cAddress = scanI2cTouch(detectI2cPins[i]);
+      result->touch = detectClassifyI2c(result->i2cAddress);
+      if (result->touch) result->touchPins = i;
+    }
+  }
+  result->i2cUs = micros() - touchDone;
+
+  // Profil: volle Übereinstimmung, sonst Display + Pins, sonst Generic
+  const HardwareProfile* match = nullptr;
+  for (const HardwareProfile& profile : hardwareProfiles) {
+    if (!profile.has(HW_FEATURE_AUTO_DETECT) || !profileMatchesDisplay(profile, *result)) continue;
+    if (profileMatchesTouch(profile, *result)) {
+      match = &profile;
+      break;
+    }
+    if (!match) match = &profile;
+  }
+  if (!match) match = hardwareProfileById(ESP32_GENERIC);
+  result->profile = match->id;
+  result->profileName = match->name;
+  result->totalUs = micros() - start;
+  return result->profile;
+}
+
+const char* detectDisplayName(uint8_t display) {
+  switch (display) {
+    case DETECT_DISPLAY_ST7789:  return "ST7789";
+    case DETECT_DISPLAY_ILI9341: return "ILI9341";
+    case DETECT_DISPLAY_ILI9488: return "ILI9488";
+    default:                     return "unbekannt";
+  }
+}
+
+const char* detectTouchName(uint8_t touch) {
+  switch (touch) {
+    case DETECT_TOUCH_XPT2046_HSPI: return "XPT2046 (HSPI)";
+    case DETECT_TOUCH_XPT2046_VSPI: return "XPT2046 (VSPI)";
+    case DETECT_TOUCH_GT911:        return "GT911";
+    case DETECT_TOUCH_FT6236:       return "FT6236";
+    case DETECT_TOUCH_CST816S:      return "CST816S";
+    default:                        return "unbekannt";
+  }
+}
+
+void printHardwareDetection(const HardwareDetection& result) {
+  Serial.printf("🔍 Hardware-Erkennung: %s (%.2f ms)\n", result.profileName, result.totalUs / 1000.0f);
+
+  Serial.printf("   Display: %s", detectDisplayName(result.display));
+  if (result.displayPins != DETECT_NONE) {
+    Serial.printf(" [%02X %02X %02X] auf %s", result.displayId[0], result.displayId[1],
+                  result.displayId[2], detectDisplayPins[result.displayPins].name);
+  }
+  Serial.printf(" | %.2f ms\n", result.displayUs / 1000.0f);
+
+  Serial.printf("   Touch:   %s", detectTouchName(result.touch));
+  if (result.i2cAddress) {
+    Serial.printf(" @0x%02X auf %s", result.i2cAddress, detectI2cPins[result.touchPins].name);
+  } else if (result.touchPins != DETECT_NONE) {
+    Serial.printf(" auf %s, TEMP0 %u", detectTouchPins[result.touchPins].name, result.touchTemp);
+  }
+  Serial.printf(" | SPI %.2f ms, I2C %.2f ms\n", result.touchUs / 1000.0f, result.i2cUs / 1000.0f);
+
+  if (result.totalUs > DETECT_BUDGET_US) {
+    Serial.printf("   ⚠️ Budget von %d ms überschritten\n", DETECT_BUDGET_US / 1000);
+  }
+}
@@ -0,0 +1,131 @@
+/**
+ * hardware_auto_detect.h - Hardware-Erkennung zur Laufzeit
+ *
+ * Erkennt das Board an seinen Controllern, bevor TFT_eSPI und der
+ * Touch-Treiber die Busse übernehmen:
+ *
+ * 1. Display: RDDID (0x04) bzw. RDID4 (0xD3) über die bekannten
+ *    Pin-Sätze lesen (ST7789: 85 85 52, ILI9341: 93 41, ILI9488: 94 88)
+ * 2. Touch XPT2046: Temperaturkanal auf HSPI- und VSPI-Pins lesen.
+ *    Echte Antworten haben Busy-Bit und drei Füllbits auf 0 und einen
+ *    plausiblen Wert - offener oder fremder MISO fällt dabei durch.
+ * 3. Nur ohne XPT2046: I2C-Scan nach GT911, FT6236, CST816S
+ *
+ * Aus Display, Touch und Pin-Satz wird das Profil gewählt. Jede Stufe
+ * wird gemessen, Budget DETECT_BUDGET_US für den gesamten Ablauf.
+ */
+
+#ifndef HARDWARE_AUTO_DETECT_H
+#define HARDWARE_AUTO_DETECT_H
+
+#include <stdint.h>
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define DETECT_SPI_HZ          1000000   // Register lesen: sicher für alle Controller
+#define DETECT_I2C_HZ          400000
+#define DETECT_I2C_TIMEOUT_MS  2
+#define DETECT_BUDGET_US       50000
+#define DETECT_NONE            0xFF      // Kein Pin-Satz / keine Adresse
+
+#define DETECT_DISPLAY_PIN_SETS  2
+#define DETECT_TOUCH_PIN_SETS    2
+#define DETECT_I2C_PIN_SETS      2
+
+// Plausibler XPT2046 Temperatur-Rohwert (TEMP0, 12 Bit): ~0,6 V bei
+// 2,5 V interner bzw. 3,3 V externer Referenz
+#define DETECT_XPT_TEMP_MIN    200
+#define DETECT_XPT_TEMP_MAX    2000
+
+// ============================================
+// DATENSTRUKTUREN
+// ============================================
+
+enum DetectedDisplay : uint8_t {
+  DETECT_DISPLAY_UNKNOWN = 0,
+  DETECT_DISPLAY_ST7789,
+  DETECT_DISPLAY_ILI9341,
+  DETECT_DISPLAY_ILI9488
+};
+
+enum DetectedTouch : uint8_t {
+  DETECT_TOUCH_UNKNOWN = 0,
+  DETECT_TOUCH_XPT2046_HSPI,
+  DETECT_TOUCH_XPT2046_VSPI,
+  DETECT_TOUCH_GT911,
+  DETECT_TOUCH_FT6236,
+  DETECT_TOUCH_CST816S
+};
+
+// Kandidaten-Pins eines SPI-Geräts (dc = -1: kein D/C, z.B. Touch)
+struct DetectSpiPins {
+  const char* name;
+  uint8_t host;              // HSPI / VSPI
+  int8_t sclk, miso, mosi, cs, dc;
+};
+
+struct DetectI2cPins {
+  const char* name;
+  int8_t sda, scl;
+};
+
+struct HardwareDetection {
+  int profile;               // ESP32_TZT_24, ESP32_2432S028R oder ESP32_GENERIC
+  const char* profileName;
+  uint8_t display;           // DetectedDisplay
+  uint8_t displayPins;       // Index in detectDisplayPins, DETECT_NONE = keiner
+  uint8_t displayId[3];      // RDDID bzw. RDID4 Parameter 1-3
+  uint8_t touch;             // DetectedTouch
+  uint8_t touchPins;         // Index in detectTouchPins bzw. detectI2cPins
+  uint8_t i2cAddress;        // 0 = kein I2C-Touch
+  uint16_t touchTemp;        // XPT2046 TEMP0 Rohwert
+  uint32_t displayUs, touchUs, i2cUs, totalUs;   // Messzeiten der Stufen
+};
+
+// ============================================
+// KLASSIFIZIERUNG
+// ============================================
+
+// rddid: Antwort auf 0x04, rdid4: Antwort auf 0xD3 (je Parameter 1-3)
+inline uint8_t detectClassifyDisplay(const uint8_t rddid[3], const uint8_t rdid4[3]) {
+  if (rddid[0] == 0x85 && rddid[2] == 0x52) return DETECT_DISPLAY_ST7789;
+  if (rdid4[1] == 0x93 && rdid4[2] == 0x41) return DETECT_DISPLAY_ILI9341;
+  if (rdid4[1] == 0x94 && rdid4[2] == 0x88) return DETECT_DISPLAY_ILI9488;
+  return DETECT_DISPLAY_UNKNOWN;
+}
+
+// 16 Takte nach dem Kommando: Busy (0), 12 Datenbits, 3 Füllbits (0)
+inline bool detectXptSample(uint16_t raw, uint16_t* value) {
+  if (raw & 0x8007) return false;
+  *value = raw >> 3;
+  return *value >= DETECT_XPT_TEMP_MIN && *value <= DETECT_XPT_TEMP_MAX;
+}
+
+inline uint8_t detectClassifyI2c(uint8_t address) {
+  switch (address) {
+    case 0x5D: case 0x14: return DETECT_TOUCH_GT911;
+    case 0x38:            return DETECT_TOUCH_FT6236;
+    case 0x15:            return DETECT_TOUCH_CST816S;
+    default:              return DETECT_TOUCH_UNKNOWN;
+  }
+}
+
+const char* detectDisplayName(uint8_t display);
+const char* detectTouchName(uint8_t touch);
+
+// ============================================
+// ERKENNUNG (hardware_auto_detect.cpp)
+// ============================================
+
+extern const DetectSpiPins detectDisplayPins[DETECT_DISPLAY_PIN_SETS];
+extern const DetectSpiPins detectTouchPins[DETECT_TOUCH_PIN_SETS];
+extern const DetectI2cPins detectI2cPins[DETECT_I2C_PIN_SETS];
+
+// Vor tft.init()/touch.begin() aufrufen: konfiguriert die Hosts selbst
+// und gibt sie danach wieder frei. Liefert das gewählte Profil.
+int detectHardwareProfile(HardwareDetection* result);
+void printHardwareDetection(const HardwareDetection& result);
+
+#endif // HARDWARE_AUTO_DETECT_H
@@ -25,14 +25,15 @@
 #include <XPT2046_Touchscreen.h>
 #include "config.h"
 #include "hardware_hal.h"
+#include "display_benchmark.h"
+#include "hw_trace.h"
 
 // ============================================
 // EXTERNAL DECLARATIONS
 // ============================================
 
-// TFT und Touch Instanzen aus hardware_manager.cpp
+// TFT Instanz aus hardware_manager.cpp (Touch gehört dem HardwareManager)
 extern TFT_eSPI tft;
-extern XPT2046_Touchscreen touch;
 
 // ============================================
 // TEST CONFIGURATION
@@ -40,7 +41,6 @@ extern XPT2046_Touchscreen touch;
 
 #define SERIAL_BAUD 115200
 #define TEST_TIMEOUT 30000  // 30s pro Test
-#define TOUCH_DEBOUNCE 100  // 100ms Debounce
 
 // Test-Modi
 enum TestMode {
@@ -60,66 +60,96 @@ enum TestMode {
 TestMode currentTest = TEST_MENU;
 unsigned long testStartTime = 0;
 bool testRunning = false;
+bool stressStartedSampler = false;  // Stress-Test hat das IRQ-Sampling selbst gestartet
 
-// Touch-Kalibrierung
-struct TouchCalibration {
-  int minX = 9999, maxX = 0;
-  int minY = 9999, maxY = 0;
-  int samples = 0;
+// Touch-Kalibrierung (geführt, 3 oder 5 Zielpunkte)
+struct TouchCalibrationRun {
+  int pointCount = TOUCH_CAL_MAX_POINTS;
+  int target = -1;               // -1 = Neustart erforderlich
+  int samples = 0;               // Rohwerte für den aktuellen Zielpunkt
+  bool pressed = false;
+  int16_t rawX[TOUCH_CAL_MAX_SAMPLES];
+  int16_t rawY[TOUCH_CAL_MAX_SAMPLES];
+  TouchCalPoint points[TOUCH_CAL_MAX_POINTS];
 } touchCal;
 
+// Stress-Test: Last aus festem Seed (display_benchmark.h)
+BenchRng stressRng(BENCH_DEFAULT_SEED);
+
+// Statuszeilen der Touch-Tests: nur geänderte Zeichen (text_label.h)
+TextLabel touchTitleLabel(10, 10, 2, TFT_WHITE, TFT_BLACK);
+TextLabel touchModeLabel(10, 28, 1, TFT_WHITE, TFT_BLACK);
+TextLabel touchStatusLabel(10, 38, 1, TFT_YELLOW, TFT_BLACK);
+TextLabel calSamplesLabel(10, 0, 2, TFT_YELLOW, TFT_BLACK);
+unsigned long touchEventCount = 0;
+
 // ============================================
 // SETUP & MAIN LOOP
 // ============================================
 
 void setup() {
   Serial.begin(SERIAL_BAUD);
-  delay(2000);
   
-  printHeader();
-  
-  // Hardware initialisieren
-  if (!hardware.begin()) {
+  // Hardware initialisieren: Startbild sofort, Touch/Backlight im Hintergrund
+  if (!hardware.begin(renderBootScreen)) {
     Serial.println("❌ HARDWARE INIT FAILED!");
     while(1) delay(1000);
   }
   
-  // DIREKT-TEST: Vollbild-Farben
-  Serial.println("Teste Display-Grenzen...");
-  tft.fillScreen(TFT_RED);
-  delay(1000);
-  tft.fillScreen(TFT_GREEN);
-  delay(1000);
-  tft.fillScreen(TFT_BLUE);
-  delay(1000);
-  
-  // Test: Rahmen um ganzes Display
-  tft.fillScreen(TFT_BLACK);
-  tft.drawRect(0, 0, 320, 240, TFT_WHITE);
-  delay(2000);
-  
-  Serial.printf("TFT Größe: %dx%d\n", tft.width(), tft.height());
+  printHeader();
+}
+
+// Startbild, von begin() als erster Frame übertragen
+void renderBootScreen(TFT_eSprite& canvas, void* context) {
+  canvas.fillRect(0, 0, tft.width(), tft.height(), TFT_BLACK);
+  canvas.setTextColor(TFT_WHITE);
+  canvas.drawString("Hardware Commissioning", 10, 10, 2);
+  canvas.drawString(hardware.getProfileName(), 10, 35, 2);
+  canvas.setTextColor(TFT_DARKGREY);
+  canvas.drawString("Serial-Menü: 0", 10, 60, 1);
 }
 
 void loop() {
-  // Serial Kommandos verarbeiten
-  if (Serial.available()) {
-    char cmd = Serial.read();
+  // Dual-Core: runFrame() läuft im Render-Task
+  if (hardware.isTaskSplitActive()) {
+    delay(100);
+    return;
+  }
+  
+  // Dimmen, Display aus, Light-Sleep (im Dual-Core Betrieb der IO-Task)
+  hardware.updatePower();
+  runFrame(nullptr);
+  delay(10);
+}
+
+// Ein Durchlauf: Kommandos verarbeiten und aktiven Test ausführen.
+// Läuft in loop() oder im Render-Task (Taste 'x').
+void runFrame(void* context) {
+  HW_TRACE_SCOPE("runFrame");
+  
+  // Serial Kommandos verarbeiten (im Dual-Core Betrieb liest der IO-Task)
+  char cmd;
+  if (hardware.readSerialCommand(&cmd)) {
     handleSerialCommand(cmd);
   }
   
-  // Aktiver Test verarbeiten
+  // Aktiver Test im Frame-Takt, hält das Display wach. Tests fordern
+  // ihren nächsten Frame selbst an (requestFrame), sonst bleibt der Slot leer.
   if (testRunning) {
-    switch(currentTest) {
-      case TEST_DISPLAY: runDisplayTest(); break;
-      case TEST_COLORS: runColorTest(); break;
-      case TEST_BACKLIGHT: runBacklightTest(); break;
-      case TEST_TOUCH_SINGLE: runSingleTouchTest(); break;
-      case TEST_TOUCH_MULTI: runMultiTouchTest(); break;
-      case TEST_TOUCH_CALIBRATION: runTouchCalibration(); break;
-      case TEST_ORIENTATION: runOrientationTest(); break;
-      case TEST_STRESS: runStressTest(); break;
-      default: testRunning = false; break;
+    hardware.notifyActivity();
+    if (hardware.beginFrame()) {
+      switch(currentTest) {
+        case TEST_DISPLAY: runDisplayTest(); break;
+        case TEST_COLORS: runColorTest(); break;
+        case TEST_BACKLIGHT: runBacklightTest(); break;
+        case TEST_TOUCH_SINGLE: runSingleTouchTest(); break;
+        case TEST_TOUCH_MULTI: runMultiTouchTest(); break;
+        case TEST_TOUCH_CALIBRATION: runTouchCalibration(); break;
+        case TEST_ORIENTATION: runOrientationTest(); break;
+        case TEST_STRESS: runStressTest(); break;
+        default: testRunning = false; break;
+      }
+      hardware.endFrame();
     }
     
     // Timeout prüfen
@@ -128,8 +158,19 @@ void loop() {
       stopTest();
     }
   }
-  
-  delay(10);
+}
+
+void toggleTaskSplit() {
+  if (hardware.isTaskSplitActive()) {
+    Serial.println("🔀 Dual-Core wird beendet...");
+    hardware.stopTaskSplit();
+    if (stressStartedSampler && !testRunning) {
+      hardware.stopTouchSampling();  // Vom beendeten Stress-Test übrig
+      stressStartedSampler = false;
+    }
+  } else {
+    hardware.startTaskSplit(runFrame);
+  }
 }
 
 // ============================================
@@ -154,8 +195,21 @@ void showMainMenu() {
   Serial.println("7 - Orientierungs Test");
   Serial.println("8 - Stress Test");
   Serial.println("9 - Hardware Info");
+  Serial.println("t - Touch-Transform Benchmark");
+  Serial.println("f - Touch-Filter Benchmark");
+  Serial.println("d - DMA Strip Benchmark");
+  Serial.println("b - Display Benchmark (CSV)");
+  Serial.println("j - Display Benchmark (JSON)");
+  Serial.println("s - SPI-Bus Statistik");
+  Serial.println("k - Display-Takt Tuning (Rücklese-Prüfung, NVS)");
+  Serial.println("l - Display-Takt zurück auf Profil-Werte");
+  Serial.println("x - Dual-Core Modus an/aus (Render-/IO-Task)");
+  Serial.println("p - Selbsttest (Farbflächen, Rahmen, Validierung)");
+  Serial.println("e - Trace als Chrome JSON (E = binär, HW_TRACE)");
+  Serial.println("w - Energie-Statistik (Zeit je Stufe, Aufwachen)");
+  Serial.println("v - Frame-Statistik (Takt, Budget, Leerlauf)");
   Serial.println("0 - Menü wiederholen");
-  Serial.println("\nWähle Test (1-9, 0): ");
+  Serial.println("\nWähle Test (1-9, 0, t, f, d, b, j, s, k, l, x, p, e, w, v): ");
 }
 
 void handleSerialCommand(char cmd) {
@@ -170,6 +224,20 @@ void handleSerialCommand(char cmd) {
     case '7': startTest(TEST_ORIENTATION); break;
     case '8': startTest(TEST_STRESS); break;
     case '9': printDetailedInfo(); break;
+    case 't': runTouchTransformBenchmark(); break;
+    case 'f': runTouchFilterBenchmark(); break;
+    case 'd': runStripBenchmark(); break;
+    case 'b': runPrimitiveBenchmark(BENCH_FORMAT_CSV); break;
+    case 'j': runPrimitiveBenchmark(BENCH_FORMAT_JSON); break;
+    case 's': printSpiBusStats(); break;
+    case 'k': runDisplayClockTuning(); break;
+    case 'l': resetDisplayClock(); break;
+    case 'x': toggleTaskSplit(); break;
+    case 'p': runPowerOnSelfTest(); break;
+    case 'e': dumpTrace(HW_TRACE_FORMAT_JSON); break;
+    case 'E': dumpTrace(HW_TRACE_FORMAT_BINARY); break;
+    case 'w': hardware.printPowerStats(); break;
+    case 'v': hardware.printFrameStats(); break;
     case 'q': case 'Q': stopTest(); break;
     default: 
       if (testRunning) handleTestCommand(cmd);
@@ -185,6 +253,36 @@ void startTest(TestMode test) {
   currentTest = test;
   testStartTime = millis();
   testRunning = true;
+  hardware.requestFrame();  // Erster Frame im nächsten Slot
+  
+  if (test == TEST_TOUCH_CALIBRATION) {
+    touchCal.target = -1;
+  }
+  
+  if (test == TEST_TOUCH_SINGLE) {
+    // Bildschirminhalt unbekannt: erste Aktualisierung zeichnet vollständig
+    touchTitleLabel.invalidate();
+    touchModeLabel.invalidate();
+    touchStatusLabel.invalidate();
+    touchEventCount = 0;
+  }
+  
+  if (test == TEST_BACKLIGHT) {
+    hardware.markDisplayDirty();  // Erster Frame komplett, danach nur Änderungen
+  }
+  
+  if (test == TEST_STRESS) {
+    stressRng = BenchRng(BENCH_DEFAULT_SEED);  // Jeder Lauf mit derselben Last
+    
+    // Zeitgestempelte Samples für die Latenzmessung, nur eigenes Sampling
+    // wird bei 'q' wieder beendet
+    if (!hardware.isTouchSamplingActive()) {
+      stressStartedSampler = hardware.startTouchSampling();
+    }
+    hardware.getTouchLatency(true);
+    hardware.getFrameStats(true);
+    Serial.println("Finger auflegen für die Touch-Latenz, 'x' = Dual-Core an/aus");
+  }
   
   Serial.println("\n🚀 Starte Test: " + getTestName(test));
   Serial.println("Drücke 'q' zum Beenden");
@@ -192,6 +290,18 @@ void startTest(TestMode test) {
 
 void stopTest() {
   testRunning = false;
+  if (currentTest == TEST_BACKLIGHT) {
+    hardware.fadeDisplayBrightness(hardware.getProfile().backlight.defaultPercent, BOOT_FADE_MS);
+  }
+  if (currentTest == TEST_STRESS && stressStartedSampler) {
+    if (hardware.isTaskSplitActive()) {
+      // Der IO-Task liest jetzt aus dem Sampler, toggleTaskSplit() beendet es danach
+      Serial.println("Im Dual-Core Modus bleibt IRQ-Sampling aktiv");
+    } else {
+      hardware.stopTouchSampling();
+      stressStartedSampler = false;
+    }
+  }
   Serial.println("\n✋ Test beendet");
   showMainMenu();
 }
@@ -216,10 +326,6 @@ String getTestName(TestMode test) {
 
 void runDisplayTest() {
   static int phase = 0;
-  static unsigned long lastUpdate = 0;
-  
-  if (millis() - lastUpdate < 2000) return;
-  lastUpdate = millis();
   
   switch(phase) {
     case 0:
@@ -250,6 +356,7 @@ void runDisplayTest() {
       return;
   }
   phase++;
+  hardware.requestFrame(2000);
 }
 
 void drawGeometryTest() {
@@ -285,16 +392,10 @@ void drawTextTest() {
   tft.drawString("Green Text", 10, 120, 2);
 }
 
+// Verläufe über den Span-Kernel: ein Adressfenster statt einer Linie pro Spalte/Zeile
 void drawGradientTest() {
-  for(int x = 0; x < tft.width(); x++) {
-    uint16_t color = tft.color565(x * 255 / tft.width(), 0, 0);
-    tft.drawFastVLine(x, 0, tft.height()/3, color);
-  }
-  
-  for(int y = 0; y < tft.height()/3; y++) {
-    uint16_t color = tft.color565(0, y * 255 / (tft.height()/3), 0);
-    tft.drawFastHLine(0, tft.height()/3 + y, tft.width(), color);
-  }
+  hardware.fillSpans(0, 0, tft.width(), tft.height()/3, spanGradientH(TFT_BLACK, TFT_RED));
+  hardware.fillSpans(0, tft.height()/3, tft.width(), tft.height()/3, spanGradientV(TFT_BLACK, TFT_GREEN));
 }
 
 // ============================================
@@ -303,12 +404,8 @@ void drawGradientTest() {
 
 void runColorTest() {
   static int phase = 0;
-  static unsigned long lastUpdate = 0;
   static bool inverted = false;
   
-  if (millis() - lastUpdate < 3000) return;
-  lastUpdate = millis();
-  
   switch(phase) {
     case 0:
       Serial.println("🎨 Normale Farben");
@@ -335,90 +432,77 @@ void runColorTest() {
       return;
   }
   phase++;
+  hardware.requestFrame(3000);
 }
 
 void drawColorPattern() {
   int w = tft.width() / 8;
   int h = tft.height() / 8;
   
-  uint16_t colors[] = {
+  static const uint16_t colors[] = {
     TFT_BLACK, TFT_WHITE, TFT_RED, TFT_GREEN, 
     TFT_BLUE, TFT_YELLOW, TFT_MAGENTA, TFT_CYAN
   };
   
-  for(int i = 0; i < 8; i++) {
-    for(int j = 0; j < 8; j++) {
-      tft.fillRect(i*w, j*h, w, h, colors[(i+j) % 8]);
-    }
-  }
+  // 8x8 Zellen, Farbe (Spalte + Zeile) % 8
+  hardware.fillSpans(0, 0, 8*w, 8*h, spanGrid(colors, 8, w, h));
 }
 
 void drawRGBComponentTest() {
   int w = tft.width() / 3;
   
-  // Rot
-  for(int x = 0; x < w; x++) {
-    uint16_t color = tft.color565(x * 255 / w, 0, 0);
-    tft.drawFastVLine(x, 0, tft.height(), color);
-  }
-  
-  // Grün
-  for(int x = 0; x < w; x++) {
-    uint16_t color = tft.color565(0, x * 255 / w, 0);
-    tft.drawFastVLine(w + x, 0, tft.height(), color);
-  }
-  
-  // Blau
-  for(int x = 0; x < w; x++) {
-    uint16_t color = tft.color565(0, 0, x * 255 / w);
-    tft.drawFastVLine(2*w + x, 0, tft.height(), color);
-  }
+  hardware.fillSpans(0, 0, w, tft.height(), spanGradientH(TFT_BLACK, TFT_RED));     // Rot
+  hardware.fillSpans(w, 0, w, tft.height(), spanGradientH(TFT_BLACK, TFT_GREEN));   // Grün
+  hardware.fillSpans(2*w, 0, w, tft.height(), spanGradientH(TFT_BLACK, TFT_BLUE));  // Blau
 }
 
 // ============================================
 // BACKLIGHT TESTS
 // ============================================
 
-void runBacklightTest() {
-  static int brightness = 0;
-  static bool increasing = true;
-  static unsigned long lastUpdate = 0;
-  
-  if (millis() - lastUpdate < 200) return;
-  lastUpdate = millis();
+// Kompletter Backlight-Bildschirm in Bildschirmkoordinaten.
+// Der Flush ruft das pro Dirty-Band auf und überträgt nur diese Bereiche.
+void renderBacklightScreen(TFT_eSprite& canvas, void* context) {
+  int brightness = *(int*)context;
   
-  hardware.setDisplayBrightness(brightness);
-  
-  // Info anzeigen
-  tft.fillScreen(TFT_BLACK);
-  tft.setTextColor(TFT_WHITE);
-  tft.drawString("Backlight Test", 10, 10, 2);
-  tft.drawString("Helligkeit: " + String(brightness) + "%", 10, 40, 2);
+  canvas.fillRect(0, 0, tft.width(), tft.height(), TFT_BLACK);
+  canvas.setTextColor(TFT_WHITE);
+  canvas.drawString("Backlight Test", 10, 10, 2);
+  canvas.drawString("Fade auf " + String(brightness) + "%", 10, 40, 2);
   
   if (hardware.hasPWMBacklight()) {
-    tft.setTextColor(TFT_GREEN);
-    tft.drawString("PWM Backlight", 10, 70, 1);
+    canvas.setTextColor(TFT_GREEN);
+    canvas.drawString("PWM Backlight, LEDC-Fade, CIE-Gamma", 10, 70, 1);
   } else {
-    tft.setTextColor(TFT_YELLOW);
-    tft.drawString("Digital Backlight", 10, 70, 1);
+    canvas.setTextColor(TFT_YELLOW);
+    canvas.drawString("Digital Backlight", 10, 70, 1);
   }
   
-  Serial.println("💡 Helligkeit: " + String(brightness) + "%");
+  canvas.drawRect(10, 90, 202, 12, TFT_DARKGREY);
+  canvas.fillRect(11, 91, brightness * 2, 10, TFT_YELLOW);
+}
+
+#define BACKLIGHT_TEST_FADE_MS  2000
+#define BACKLIGHT_TEST_HOLD_MS  500
+
+// Abwechselnd auf 0 % und 100 %: der Fade läuft in der LEDC-Hardware,
+// neu gezeichnet wird nur beim Start eines Fades
+void runBacklightTest() {
+  static int brightness = 0;
   
-  // Helligkeit ändern
-  if (increasing) {
-    brightness += 10;
-    if (brightness >= 100) {
-      brightness = 100;
-      increasing = false;
-    }
-  } else {
-    brightness -= 10;
-    if (brightness <= 0) {
-      brightness = 0;
-      increasing = true;
-    }
-  }
+  brightness = (brightness == 100) ? 0 : 100;
+  hardware.fadeDisplayBrightness(brightness, BACKLIGHT_TEST_FADE_MS);
+  
+  // Nur Wert und Balken ändern sich
+  hardware.markDirty(10, 40, 140, 16);
+  hardware.markDirty(10, 90, 202, 12);
+  hardware.flushDisplay(renderBacklightScreen, &brightness);
+  hardware.requestFrame(BACKLIGHT_TEST_FADE_MS + BACKLIGHT_TEST_HOLD_MS);
+  
+  const DamageFlushStats& stats = hardware.getFlushStats();
+  Serial.printf("💡 Fade auf %d%% in %d ms (%lu Bytes, %u Fenster, %lu µs - Vollbild: %lu Bytes)\n",
+                brightness, BACKLIGHT_TEST_FADE_MS, (unsigned long)stats.lastBytes, stats.lastWindows,
+                (unsigned long)stats.lastMicros, (unsigned long)stats.fullFrameBytes);
 }
 
 // ============================================
@@ -426,34 +510,53 @@ void runBacklightTest() {
 // ============================================
 
 void runSingleTouchTest() {
-  static unsigned long lastTouch = 0;
+  hardware.requestFrame();  // Touch in jedem Slot auswerten
   
-  // Touch-Status prüfen
-  if (hardware.isTouchPressed()) {
-    if (millis() - lastTouch > TOUCH_DEBOUNCE) {
-      int x, y;
-      hardware.getTouchPoint(&x, &y);
-      
-      if (x >= 0 && y >= 0) {
-        // Touch visualisieren
-        tft.fillCircle(x, y, 10, TFT_RED);
-        tft.drawCircle(x, y, 15, TFT_WHITE);
-        
-        Serial.printf("👆 Touch: X=%d, Y=%d\n", x, y);
-        lastTouch = millis();
+  // Samples -> Events (Debouncing und Gesten übernimmt der HardwareManager)
+  hardware.processTouch();
+  
+  TouchEvent event;
+  while (hardware.getTouchEvent(&event)) {
+    touchEventCount++;
+    switch (event.type) {
+      case TOUCH_EVENT_DOWN:
+        tft.fillCircle(event.x, event.y, 10, TFT_RED);
+        tft.drawCircle(event.x, event.y, 15, TFT_WHITE);
+        Serial.printf("👆 Down: X=%d, Y=%d\n", event.x, event.y);
+        break;
+      case TOUCH_EVENT_MOVE:
+        tft.fillCircle(event.x, event.y, 3, TFT_RED);
+        break;
+      case TOUCH_EVENT_UP:
+        Serial.printf("   Up: X=%d, Y=%d (%d px/s)\n", event.x, event.y, event.velocity);
+        break;
+      case TOUCH_EVENT_TAP:
+        Serial.println("   Tap");
+        break;
+      case TOUCH_EVENT_DOUBLE_TAP:
+        Serial.println("   Double-Tap");
+        break;
+      case TOUCH_EVENT_LONG_PRESS:
+        tft.drawCircle(event.x, event.y, 20, TFT_YELLOW);
+        Serial.println("   Long-Press");
+        break;
+      case TOUCH_EVENT_SWIPE: {
+        static const char* directions[] = { "-", "links", "rechts", "hoch", "runter" };
+        Serial.printf("   Swipe %s: dx=%d, dy=%d, %d px/s\n",
+                      directions[event.direction], event.dx, event.dy, event.velocity);
+        break;
       }
     }
   }
   
-  // Info-Text
-  static unsigned long lastInfo = 0;
-  if (millis() - lastInfo > 5000) {
-    tft.fillRect(0, 0, tft.width(), 40, TFT_BLACK);
-    tft.setTextColor(TFT_WHITE);
-    tft.drawString("Single Touch Test", 10, 10, 2);
-    tft.drawString("Berühre das Display", 10, 25, 1);
-    lastInfo = millis();
-  }
+  // Info-Text: jedes Frame aktualisiert, übertragen werden nur geänderte Zeichen
+  char status[TEXT_LABEL_MAX_CHARS + 1];
+  snprintf(status, sizeof(status), "Events: %lu  Zeit: %lu s", touchEventCount,
+           (millis() - testStartTime) / 1000);
+  hardware.updateLabel(touchTitleLabel, "Single Touch Test");
+  hardware.updateLabel(touchModeLabel, hardware.isTouchSamplingActive() ? "IRQ-Sampling ('i' = Polling)"
+                                                                        : "Polling ('i' = IRQ-Sampling)");
+  hardware.updateLabel(touchStatusLabel, status);
 }
 
 void runMultiTouchTest() {
@@ -462,86 +565,136 @@ void runMultiTouchTest() {
     stopTest();
     return;
   }
+  hardware.requestFrame();
   
-  // Multi-Touch Implementation
+  // Multi-Touch: Index = Finger, bleibt bis zum Abheben gleich
+  static const uint16_t fingerColors[5] = { TFT_RED, TFT_GREEN, TFT_BLUE, TFT_YELLOW, TFT_MAGENTA };
+  static int lastCount = 0;
   int points[5][2];  // Max 5 Touch-Punkte
   hardware.getTouchPoints(points, 5);
   
+  int count = hardware.getTouchCount();
+  if (count != lastCount) {
+    Serial.printf("👆 %d Finger\n", count);
+    lastCount = count;
+  }
+  
   // Alle aktiven Punkte anzeigen
   for(int i = 0; i < 5; i++) {
     if (points[i][0] >= 0 && points[i][1] >= 0) {
-      uint16_t color = (i == 0) ? TFT_RED : ((i == 1) ? TFT_GREEN : TFT_BLUE);
-      tft.fillCircle(points[i][0], points[i][1], 8, color);
+      tft.fillCircle(points[i][0], points[i][1], 8, fingerColors[i]);
       Serial.printf("👆 Touch %d: X=%d, Y=%d\n", i+1, points[i][0], points[i][1]);
     }
   }
 }
 
 void runTouchCalibration() {
-  static int phase = 0;
-  static bool waitingForTouch = true;
-  static unsigned long phaseStart = 0;
-  
-  if (phase == 0) {
-    // Reset Kalibrierung
-    touchCal = {9999, 0, 9999, 0, 0};
-    phase = 1;
-    phaseStart = millis();
-    Serial.println("🎯 Touch Kalibrierung gestartet");
-    Serial.println("Berühre alle 4 Ecken + Mitte für 30 Sekunden");
-  }
-  
-  // Touch sammeln
-  if (hardware.isTouchPressed()) {
-    // Raw Touch-Daten lesen
-    TS_Point p = touch.getPoint();
-    
-    // Min/Max aktualisieren
-    touchCal.minX = min(touchCal.minX, (int)p.x);
-    touchCal.maxX = max(touchCal.maxX, (int)p.x);
-    touchCal.minY = min(touchCal.minY, (int)p.y);
-    touchCal.maxY = max(touchCal.maxY, (int)p.y);
-    touchCal.samples++;
-    
-    // Visuelles Feedback
-    int x, y;
-    hardware.getTouchPoint(&x, &y);
-    tft.fillCircle(x, y, 5, TFT_GREEN);
-    
-    Serial.printf("Raw: X=%d, Y=%d | Min/Max: X=%d-%d, Y=%d-%d\n", 
-                  p.x, p.y, touchCal.minX, touchCal.maxX, touchCal.minY, touchCal.maxY);
+  hardware.requestFrame();
+  
+  if (touchCal.target < 0) {
+    touchCal.target = 0;
+    touchCal.samples = 0;
+    touchCal.pressed = false;
+    Serial.printf("🎯 Touch Kalibrierung gestartet (%d Punkte)\n", touchCal.pointCount);
+    Serial.println("Berühre jedes Fadenkreuz, bis es weiterspringt ('m' = 3/5 Punkte, 'c' = NVS löschen)");
+    drawCalibrationTarget();
   }
   
-  // Info anzeigen
-  static unsigned long lastInfo = 0;
-  if (millis() - lastInfo > 1000) {
-    tft.fillRect(0, 0, tft.width(), 60, TFT_BLACK);
-    tft.setTextColor(TFT_WHITE);
-    tft.drawString("Touch Kalibrierung", 10, 10, 2);
-    tft.drawString("Samples: " + String(touchCal.samples), 10, 30, 1);
-    tft.drawString("Zeit: " + String((millis() - phaseStart)/1000) + "s", 10, 45, 1);
-    lastInfo = millis();
+  int rawX, rawY;
+  if (hardware.readRawTouch(&rawX, &rawY)) {
+    // Rohwerte sammeln solange gedrückt
+    touchCal.pressed = true;
+    if (touchCal.samples < TOUCH_CAL_MAX_SAMPLES) {
+      touchCal.rawX[touchCal.samples] = rawX;
+      touchCal.rawY[touchCal.samples] = rawY;
+      touchCal.samples++;
+    }
+    hardware.updateLabel(calSamplesLabel, ("Samples: " + String(touchCal.samples)).c_str());
+    return;
   }
   
-  // Timeout oder genug Samples
-  if (millis() - phaseStart > 30000 || touchCal.samples > 100) {
-    printCalibrationResults();
-    stopTest();
+  if (!touchCal.pressed) return;
+  
+  // Losgelassen: Zielpunkt abschließen
+  touchCal.pressed = false;
+  if (touchCal.samples < TOUCH_CAL_MIN_SAMPLES) {
+    Serial.printf("⚠️ Nur %d Samples - bitte länger drücken\n", touchCal.samples);
+    touchCal.samples = 0;
+    return;
+  }
+  
+  TouchCalPoint& point = touchCal.points[touchCal.target];
+  touchCalTarget(touchCal.target, touchCal.pointCount, tft.width(), tft.height(),
+                 &point.screenX, &point.screenY);
+  point.rawX = touchCalTrimmedMean(touchCal.rawX, touchCal.samples);
+  point.rawY = touchCalTrimmedMean(touchCal.rawY, touchCal.samples);
+  
+  Serial.printf("Punkt %d/%d: Ziel (%d,%d) <- Raw (%d,%d) aus %d Samples\n",
+                touchCal.target + 1, touchCal.pointCount,
+                point.screenX, point.screenY, point.rawX, point.rawY, touchCal.samples);
+  
+  touchCal.samples = 0;
+  touchCal.target++;
+  
+  if (touchCal.target < touchCal.pointCount) {
+    drawCalibrationTarget();
+    return;
   }
+  
+  finishTouchCalibration();
+  stopTest();
+}
+
+void drawCalibrationTarget() {
+  int32_t x, y;
+  touchCalTarget(touchCal.target, touchCal.pointCount, tft.width(), tft.height(), &x, &y);
+  
+  tft.fillScreen(TFT_BLACK);
+  hardware.drawText("Touch Kalibrierung", 10, tft.height() / 2 - 30, 2, TFT_WHITE, TFT_BLACK);
+  hardware.drawText("Punkt " + String(touchCal.target + 1) + "/" + String(touchCal.pointCount),
+                    10, tft.height() / 2 - 10, 2, TFT_WHITE, TFT_BLACK);
+  calSamplesLabel.setPosition(10, tft.height() / 2 + 10);
+  calSamplesLabel.invalidate();  // Nach fillScreen()
+  hardware.updateLabel(calSamplesLabel, "Samples: 0");
+  
+  // Fadenkreuz
+  tft.drawFastHLine(x - 10, y, 21, TFT_RED);
+  tft.drawFastVLine(x, y - 10, 21, TFT_RED);
+  tft.drawCircle(x, y, 6, TFT_WHITE);
+}
+
+void finishTouchCalibration() {
+  TouchCalibrationData data = {};
+  data.rotation = tft.getRotation() & 3;
+  data.points = touchCal.pointCount;
+  
+  if (!touchCalSolve(touchCal.points, touchCal.pointCount, tft.width(), tft.height(), &data.transform)) {
+    Serial.println("❌ Kalibrierung fehlgeschlagen: Punkte kollinear - bitte wiederholen ('6')");
+    return;
+  }
+  
+  int32_t maxError = touchCalMaxError(touchCal.points, touchCal.pointCount, data.transform);
+  bool saved = hardware.applyTouchCalibration(&data, true);
+  printCalibrationResults(data, maxError, saved);
+  
+  tft.fillScreen(TFT_BLACK);
+  tft.setTextColor(saved ? TFT_GREEN : TFT_RED);
+  tft.drawString(saved ? "Kalibrierung gespeichert" : "Speichern fehlgeschlagen", 10, 10, 2);
 }
 
-void printCalibrationResults() {
+void printCalibrationResults(const TouchCalibrationData& data, int32_t maxError, bool saved) {
+  const TouchTransform& t = data.transform;
+  
   Serial.println("\n" + String('=', 50));
   Serial.println("🎯 TOUCH KALIBRIERUNG ERGEBNISSE");
   Serial.println(String('=', 50));
-  Serial.printf("Samples gesammelt: %d\n", touchCal.samples);
-  Serial.printf("X-Range: %d - %d\n", touchCal.minX, touchCal.maxX);
-  Serial.printf("Y-Range: %d - %d\n", touchCal.minY, touchCal.maxY);
-  Serial.println("\n📋 HARDWARE PROFILE WERTE:");
-  Serial.printf("#define HW_TOUCH_MIN_X %d\n", touchCal.minX);
-  Serial.printf("#define HW_TOUCH_MAX_X %d\n", touchCal.maxX);
-  Serial.printf("#define HW_TOUCH_MIN_Y %d\n", touchCal.minY);
-  Serial.printf("#define HW_TOUCH_MAX_Y %d\n", touchCal.maxY);
+  Serial.printf("Zielpunkte: %d, Rotation: %d\n", data.points, data.rotation);
+  Serial.printf("X = (%ld*rx + %ld*ry + %ld) >> 16\n", (long)t.xx, (long)t.xy, (long)t.x0);
+  Serial.printf("Y = (%ld*rx + %ld*ry + %ld) >> 16\n", (long)t.yx, (long)t.yy, (long)t.y0);
+  Serial.printf("Max. Restfehler: %ld px\n", (long)maxError);
+  Serial.printf("NVS: %s (Version %d, CRC 0x%08lX)\n", saved ? "gespeichert" : "FEHLER",
+                data.version, (unsigned long)data.crc);
+  Serial.println("Wird beim nächsten Boot automatisch geladen - kein Recompile nötig");
   Serial.println(String('=', 50));
 }
 
@@ -551,25 +704,21 @@ void printCalibrationResults() {
 
 void runOrientationTest() {
   static int rotation = 0;
-  static unsigned long lastRotation = 0;
-  
-  if (millis() - lastRotation < 10000) return;
-  lastRotation = millis();
   
   hardware.setDisplayRotation(rotation);
   
   // DEBUG
   Serial.printf("Rotation %d: TFT=%dx%d, HW=%dx%d\n", 
                 rotation, tft.width(), tft.height(), 
-                HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT);
+                hardware.getProfile().display.width, hardware.getProfile().display.height);
   
   // Test-Pattern für jede Orientierung - ERST schwarzer Hintergrund
   tft.fillScreen(TFT_BLACK);
-  tft.setTextColor(TFT_WHITE);
   
-  // Orientierung anzeigen
-  tft.drawString("Rotation: " + String(rotation), 10, 10, 2);
-  tft.drawString("Size: " + String(tft.width()) + "x" + String(tft.height()), 10, 30, 1);
+  // Orientierung anzeigen (Glyphen-Atlas: ein Fenster pro Zeile)
+  hardware.drawText("Rotation: " + String(rotation), 10, 10, 2, TFT_WHITE, TFT_BLACK);
+  hardware.drawText("Size: " + String(tft.width()) + "x" + String(tft.height()), 10, 30, 1,
+                    TFT_WHITE, TFT_BLACK);
   
   // Feste Marker-Größe
   int markerSize = 20;
@@ -590,46 +739,400 @@ void runOrientationTest() {
   if (rotation == 0) {
     Serial.println("✅ Orientierungs Test abgeschlossen");
     stopTest();
+    return;
   }
+  hardware.requestFrame(10000);
 }
 
 // ============================================
 // STRESS TEST
 // ============================================
 
+// Anteil des Frame-Budgets, den der Stress Test mit Last füllt
+#define STRESS_FRAME_LOAD_PERCENT 80
+
+// Deterministische Dauerlast: dieselben Primitive wie die Benchmark-Suite
+// (inkl. Vollbild), Auswahl aus festem Seed. Für Messwerte pro Primitiv
+// siehe 'b' (CSV) bzw. 'j' (JSON). Jeder Frame füllt sein Budget nur zu
+// STRESS_FRAME_LOAD_PERCENT, damit der Takt hält.
 void runStressTest() {
   static unsigned long operations = 0;
+  static unsigned long pixels = 0;
   static unsigned long lastUpdate = 0;
   
-  // Zufällige Display-Operationen
-  switch(random(4)) {
-    case 0: // Zufällige Pixel
-      for(int i = 0; i < 100; i++) {
-        tft.drawPixel(random(tft.width()), random(tft.height()), random(0xFFFF));
+  hardware.requestFrame();
+  const uint32_t frameStart = micros();
+  const uint32_t loadUs = hardware.getFrameBudgetUs() / 100 * STRESS_FRAME_LOAD_PERCENT;
+  do {
+    pixels += benchmarkLoadStep(tft, hardware.getDisplaySpiDevice(), stressRng);
+    operations++;
+  } while (micros() - frameStart < loadUs);
+  
+  // Touch wie eine UI verarbeiten (im Dual-Core Betrieb erledigt das der IO-Task)
+  hardware.processTouch();
+  TouchEvent event;
+  while (hardware.getTouchEvent(&event)) {}
+  
+  // Statistiken anzeigen (Raten über das letzte Intervall)
+  unsigned long interval = millis() - lastUpdate;
+  if (interval > 1000) {
+    Serial.printf("⚡ Stress Test: %lu Operationen/s, %lu Pixel/s\n",
+                  operations * 1000 / interval, pixels * 1000 / interval);
+    operations = 0;
+    pixels = 0;
+    
+    // Alter der Samples bei der Verarbeitung, seit der letzten Ausgabe
+    TouchLatencyStats latency = hardware.getTouchLatency(true);
+    if (latency.samples > 0) {
+      Serial.printf("   Touch-Latenz (%s): Ø %lu µs, max %lu µs, %lu Samples\n",
+                    hardware.isTaskSplitActive() ? "Dual-Core" : "Single-Loop",
+                    (unsigned long)(latency.totalUs / latency.samples),
+                    (unsigned long)latency.maxUs, (unsigned long)latency.samples);
+    }
+    
+    FrameStats frames = hardware.getFrameStats(true);
+    Serial.printf("   Frames: %lu/s bei %u Hz, %lu über Budget, max %lu µs\n",
+                  (unsigned long)(frames.frames * 1000 / interval), hardware.getFrameRate(),
+                  (unsigned long)frames.missed, (unsigned long)frames.maxFrameUs);
+    lastUpdate = millis();
+  }
+}
+
+// ============================================
+// TOUCH TRANSFORM BENCHMARK
+// ============================================
+
+#define TOUCH_BENCH_SAMPLES 20000
+#define TOUCH_BENCH_SET 256
+
+void runTouchTransformBenchmark() {
+  Serial.println("\n" + String('=', 60));
+  Serial.println("⏱️ TOUCH-TRANSFORM BENCHMARK (switch/map vs. Matrix)");
+  Serial.println("Profile: " + hardware.getProfileName());
+  Serial.println(String('=', 60));
+
+  // Deterministische Rohwerte (LCG), bewusst auch außerhalb der Kalibrierung
+  static int16_t rawX[TOUCH_BENCH_SET], rawY[TOUCH_BENCH_SET];
+  uint32_t seed = 12345;
+  for (int i = 0; i < TOUCH_BENCH_SET; i++) {
+    seed = seed * 1664525UL + 1013904223UL;
+    rawX[i] = (seed >> 8) & 0x0FFF;
+    rawY[i] = (seed >> 20) & 0x0FFF;
+  }
+
+  const HwTouchConfig& touchConfig = hardware.getProfile().touch;
+  for (uint8_t rot = 0; rot < 4; rot++) {
+    volatile uint8_t rotation = rot;  // Verhindert Konstantenfaltung des switch
+    volatile long sink = 0;
+    const TouchTransform& t = touchConfig.transforms[rot];
+    const long maxX = t.maxX;
+    const long maxY = t.maxY;
+
+    // Bisheriger Pfad: switch + map() + Invertierung + Clamp
+    unsigned long start = micros();
+    for (int i = 0; i < TOUCH_BENCH_SAMPLES; i++) {
+      long tx, ty;
+      touchConfig.referenceMap(rotation, rawX[i % TOUCH_BENCH_SET], rawY[i % TOUCH_BENCH_SET], tx, ty);
+      sink = sink + constrain(tx, 0, maxX) + constrain(ty, 0, maxY);
+    }
+    unsigned long switchUs = micros() - start;
+
+    // Neuer Pfad: gecachte Festkomma-Matrix
+    start = micros();
+    for (int i = 0; i < TOUCH_BENCH_SAMPLES; i++) {
+      int x, y;
+      t.apply(rawX[i % TOUCH_BENCH_SET], rawY[i % TOUCH_BENCH_SET], &x, &y);
+      sink = sink + x + y;
+    }
+    unsigned long matrixUs = micros() - start;
+
+    // Maximale Abweichung über den Testsatz
+    long maxDev = 0;
+    for (int i = 0; i < TOUCH_BENCH_SET; i++) {
+      long tx, ty;
+      int x, y;
+      touchConfig.referenceMap(rot, rawX[i], rawY[i], tx, ty);
+      t.apply(rawX[i], rawY[i], &x, &y);
+      maxDev = max(maxDev, (long)abs(constrain(tx, 0, maxX) - x));
+      maxDev = max(maxDev, (long)abs(constrain(ty, 0, maxY) - y));
+    }
+
+    Serial.printf("Rotation %d: switch %.1f ns | Matrix %.1f ns | Faktor %.2fx | max. Abweichung %ld px\n",
+                  rot,
+                  switchUs * 1000.0f / TOUCH_BENCH_SAMPLES,
+                  matrixUs * 1000.0f / TOUCH_BENCH_SAMPLES,
+                  matrixUs ? (float)switchUs / matrixUs : 0.0f,
+                  maxDev);
+  }
+
+  Serial.println(String('=', 60));
+}
+
+// ============================================
+// TOUCH FILTER BENCHMARK
+// ============================================
+
+#define FILTER_BENCH_SAMPLES 20000
+
+// Mittlere Änderung zwischen aufeinanderfolgenden Werten (Jitter, Rohwert-Einheiten)
+static float filterJitter(const int16_t* values, int count) {
+  long sum = 0;
+  for (int i = 1; i < count; i++) sum += abs(values[i] - values[i - 1]);
+  return count > 1 ? (float)sum / (count - 1) : 0.0f;
+}
+
+void runTouchFilterBenchmark() {
+  Serial.println("\n" + String('=', 60));
+  Serial.println("⏱️ TOUCH-FILTER BENCHMARK (ruhender Finger + Rauschen)");
+  Serial.println(String('=', 60));
+
+  // Deterministisches Rauschen um einen festen Punkt, 5% Ausreißer, Druck um die Schwelle
+  const HwTouchConfig& touchConfig = hardware.getProfile().touch;
+  static int16_t inX[256], inY[256], outX[256];
+  static uint16_t inZ[256];
+  uint32_t seed = 4711;
+  for (int i = 0; i < 256; i++) {
+    seed = seed * 1664525UL + 1013904223UL;
+    int noise = (int)((seed >> 16) & 31) - 16;
+    bool outlier = ((seed >> 8) & 0xFF) < 13;
+    inX[i] = 2000 + noise + (outlier ? 400 : 0);
+    inY[i] = 2000 - noise;
+    inZ[i] = touchConfig.threshold + (int)((seed >> 4) & 0x3FF) - 128;
+  }
+
+  struct BenchConfig {
+    const char* name;
+    TouchFilterConfig config;
+  } configs[] = {
+    { "Aus",           { 0, 1, 0, 0 } },
+    { "Druck-Gate",    { touchConfig.threshold, 1, 0, 0 } },
+    { "Median-3",      { 0, 3, 0, 0 } },
+    { "Median-5",      { 0, 5, 0, 0 } },
+    { "IIR 1/2",       { 0, 1, 1, 0 } },
+    { "Dead-Band",     { 0, 1, 0, touchConfig.filterDeadband } },
+    { "Profil (alle)", hwTouchFilterConfig(touchConfig) }
+  };
+
+  Serial.printf("Jitter Eingang: %.1f (Rohwert-Einheiten)\n", filterJitter(inX, 256));
+
+  for (auto& bench : configs) {
+    TouchFilter filter(bench.config);
+    volatile int32_t sink = 0;
+    int accepted = 0;
+
+    unsigned long start = micros();
+    for (int i = 0; i < FILTER_BENCH_SAMPLES; i++) {
+      int16_t x, y;
+      if (filter.process(inX[i & 255], inY[i & 255], inZ[i & 255], &x, &y)) {
+        sink = sink + x + y;
       }
+    }
+    unsigned long elapsedUs = micros() - start;
+
+    // Jitter über einen Durchlauf (verworfene Samples halten den letzten Wert)
+    filter.reset();
+    int16_t last = inX[0];
+    for (int i = 0; i < 256; i++) {
+      int16_t x, y;
+      if (filter.process(inX[i], inY[i], inZ[i], &x, &y)) {
+        last = x;
+        accepted++;
+      }
+      outX[i] = last;
+    }
+
+    Serial.printf("%-14s %6.1f ns/Sample | Jitter %5.1f | akzeptiert %3d%%\n",
+                  bench.name, elapsedUs * 1000.0f / FILTER_BENCH_SAMPLES,
+                  filterJitter(outX, 256), accepted * 100 / 256);
+  }
+
+  Serial.println(String('=', 60));
+}
+
+// ============================================
+// DMA STRIP BENCHMARK
+// ============================================
+
+#define STRIP_BENCH_FRAMES 30
+
+// Testszene: Farbverlauf in Balken, bewegte Kreise und Text.
+// In Bildschirmkoordinaten, wird pro Streifen aufgerufen.
+void renderStripBenchScene(TFT_eSprite& canvas, void* context) {
+  int frame = *(int*)context;
+  int w = tft.width(), h = tft.height();
+  
+  for (int y = 0; y < h; y += 8) {
+    canvas.fillRect(0, y, w, 8, tft.color565((y + frame * 4) & 0xFF, 64, 255 - (y & 0xFF)));
+  }
+  for (int i = 0; i < 8; i++) {
+    int cx = (frame * (i + 1) * 3 + i * 40) % w;
+    canvas.fillCircle(cx, 30 + i * (h - 60) / 8, 12, TFT_WHITE);
+  }
+  canvas.setTextColor(TFT_BLACK);
+  canvas.drawString("Frame " + String(frame), 10, 10, 4);
+}
+
+void runStripBenchmark() {
+  Serial.println("\n" + String('=', 60));
+  Serial.println("⏱️ DMA STRIP BENCHMARK (blockierend vs. Ping-Pong)");
+  Serial.printf("Profile: %s | Streifen: %d Zeilen | %d Frames\n",
+                hardware.getProfileName().c_str(), hardware.getStripRows(), STRIP_BENCH_FRAMES);
+  Serial.println(String('=', 60));
+  
+  if (hardware.getStripRows() == 0) {
+    Serial.println("❌ Strip-Renderer nicht verfügbar");
+    return;
+  }
+  
+  float fps[2] = { 0, 0 };
+  for (int mode = 0; mode < 2; mode++) {
+    hardware.setDisplayDMA(mode == 1);
+    if (mode == 1 && !hardware.isDisplayDMAActive()) {
+      Serial.println("DMA:         nicht verfügbar (HW_DISPLAY_DMA / initDMA)");
       break;
-    case 1: // Zufällige Linien
-      tft.drawLine(random(tft.width()), random(tft.height()), 
-                   random(tft.width()), random(tft.height()), random(0xFFFF));
-      break;
-    case 2: // Zufällige Rechtecke
-      tft.fillRect(random(tft.width()-50), random(tft.height()-50), 
-                   random(50), random(50), random(0xFFFF));
-      break;
-    case 3: // Zufällige Kreise
-      tft.fillCircle(random(tft.width()), random(tft.height()), 
-                     random(20), random(0xFFFF));
-      break;
+    }
+    
+    unsigned long renderUs = 0;
+    unsigned long start = micros();
+    for (int frame = 0; frame < STRIP_BENCH_FRAMES; frame++) {
+      uint32_t fence = hardware.renderFrame(renderStripBenchScene, &frame);
+      hardware.waitFrame(fence);  // Frame vollständig auf dem Display
+      renderUs += hardware.getStripStats().renderMicros;
+    }
+    unsigned long elapsedUs = micros() - start;
+    
+    fps[mode] = elapsedUs ? STRIP_BENCH_FRAMES * 1000000.0f / elapsedUs : 0.0f;
+    Serial.printf("%-12s %5.1f FPS | %6.2f ms/Frame | CPU-Render %6.2f ms/Frame\n",
+                  mode == 1 ? "DMA:" : "Blockierend:", fps[mode],
+                  elapsedUs / 1000.0f / STRIP_BENCH_FRAMES,
+                  renderUs / 1000.0f / STRIP_BENCH_FRAMES);
   }
   
-  operations++;
+  if (fps[0] > 0 && fps[1] > 0) {
+    Serial.printf("Faktor: %.2fx\n", fps[1] / fps[0]);
+  }
   
-  // Statistiken anzeigen
-  if (millis() - lastUpdate > 1000) {
-    Serial.printf("⚡ Stress Test: %lu Operationen, FPS: %lu\n", 
-                  operations, operations * 1000 / (millis() - testStartTime));
-    lastUpdate = millis();
+  hardware.setDisplayDMA(true);  // Zurück auf den Standard (falls verfügbar)
+  Serial.println(String('=', 60));
+}
+
+// ============================================
+// DISPLAY BENCHMARK
+// ============================================
+
+// Primitive einzeln, geseedet, mit Warm-up und Wiederholungen.
+// Ausgabe ist maschinenlesbar: Serial-Log direkt als .csv/.json speichern.
+void runPrimitiveBenchmark(BenchmarkFormat format) {
+  BenchmarkConfig config;
+  config.seed = BENCH_DEFAULT_SEED;
+  config.warmup = BENCH_DEFAULT_WARMUP;
+  config.repeats = BENCH_DEFAULT_REPEATS;
+  config.spiHz = hardware.getDisplayWriteHz();
+  config.profile = hardware.getProfile().name;
+  config.display = &hardware.getDisplaySpiDevice();
+  
+  runDisplayBenchmark(tft, config, format);
+}
+
+// ============================================
+// DISPLAY-TAKT TUNING
+// ============================================
+
+// Schreib- und Lesetakt stufenweise erhöhen, Testmuster per readRect()
+// prüfen und den höchsten stabilen Takt mit Reserve in NVS speichern.
+// Der Test läuft mit dem Kabel/Gehäuse des Einsatzes am aussagekräftigsten.
+void runDisplayClockTuning() {
+  Serial.println("\n" + String('=', 60));
+  Serial.println("⚡ DISPLAY-TAKT TUNING");
+  Serial.printf("Profil: %.2f MHz schreiben, %.2f MHz lesen | Obergrenze %.2f MHz\n",
+                hardware.getProfile().display.writeHz / 1e6f,
+                hardware.getProfile().display.readHz / 1e6f,
+                hardware.getProfile().display.tuneMaxHz / 1e6f);
+  Serial.println(String('=', 60));
+  
+  tft.fillScreen(TFT_BLACK);
+  DisplayClockResult result;
+  bool saved = hardware.tuneDisplayClock(&result, true);
+  
+  if (result.ok) {
+    Serial.printf("\nSchreiben: %.2f MHz (erster Fehler: %s)\n", result.clock.writeHz / 1e6f,
+                  result.writeFailHz ? String(result.writeFailHz / 1e6f, 2).c_str() : "keiner");
+    Serial.printf("Lesen:     %.2f MHz (erster Fehler: %s)\n", result.clock.readHz / 1e6f,
+                  result.readFailHz ? String(result.readFailHz / 1e6f, 2).c_str() : "keiner");
+    Serial.printf("Reserve: %d%% | Bestätigung verworfen: %lu Pixelfehler | Dauer: %lu ms\n",
+                  result.clock.marginPct, (unsigned long)result.soakErrors,
+                  (unsigned long)result.durationMs);
+    Serial.printf("NVS: %s - wird beim nächsten Boot von initDisplay() übernommen\n",
+                  saved ? "gespeichert" : "FEHLER");
   }
+  
+  tft.setTextColor(saved ? TFT_GREEN : TFT_RED, TFT_BLACK);
+  tft.drawString(saved ? "Takt gespeichert" : "Tuning fehlgeschlagen", 10, 10, 2);
+  Serial.println(String('=', 60));
+}
+
+void resetDisplayClock() {
+  hardware.clearDisplayClock();
+  Serial.printf("🗑️ Display-Takt gelöscht - Profil-Werte aktiv (%.2f / %.2f MHz)\n",
+                hardware.getDisplayWriteHz() / 1e6f, hardware.getDisplayReadHz() / 1e6f);
+}
+
+// ============================================
+// SPI BUS STATISTIK
+// ============================================
+
+// Auslastung und Wartezeiten seit dem letzten Aufruf (z.B. während
+// Test 4 im IRQ-Modus und parallel laufendem Backlight-/Strip-Rendering)
+void printSpiBusStats() {
+  Serial.println("\n" + String('=', 60));
+  Serial.println("🔀 SPI-BUS STATISTIK");
+  Serial.println(String('=', 60));
+  spiArbiter.printStats();
+  spiArbiter.resetStats();
+  Serial.println(String('=', 60));
+}
+
+// ============================================
+// SELBSTTEST
+// ============================================
+
+// Früher fester Teil von setup(), jetzt nur auf Anforderung
+void runPowerOnSelfTest() {
+  Serial.println("\n🔍 SELBSTTEST");
+  hardware.waitBootComplete();
+  
+  // Vollbild-Farben
+  Serial.println("Teste Display-Grenzen...");
+  tft.fillScreen(TFT_RED);
+  delay(1000);
+  tft.fillScreen(TFT_GREEN);
+  delay(1000);
+  tft.fillScreen(TFT_BLUE);
+  delay(1000);
+  
+  // Rahmen um ganzes Display
+  tft.fillScreen(TFT_BLACK);
+  tft.drawRect(0, 0, tft.width(), tft.height(), TFT_WHITE);
+  Serial.printf("TFT Größe: %dx%d\n", tft.width(), tft.height());
+  
+  Serial.printf("Validierung: %s\n", hardware.validateHardware() ? "✅" : "❌");
+  hardware.printBootTimeline();
+}
+
+// ============================================
+// TRACE EXPORT
+// ============================================
+
+// Binär: Mitschnitt mit simulator/tools/hw_trace_convert nach JSON wandeln
+void dumpTrace(HwTraceFormat format) {
+  if (!HW_TRACE) {
+    Serial.println("❌ Tracing deaktiviert (HW_TRACE in config.h)");
+    return;
+  }
+  Serial.printf("\n🧵 Trace: %lu Ereignisse, %lu verworfen\n",
+                (unsigned long)hwTraceCount(), (unsigned long)hwTraceDropped());
+  hwTraceDumpSerial(format);
+  Serial.println();
 }
 
 // ============================================
@@ -644,16 +1147,30 @@ void printDetailedInfo() {
   // Hardware Manager Info
   hardware.printHardwareInfo();
   
-  // Profile-spezifische Details
-  Serial.printf("Display Resolution: %dx%d\n", HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT);
-  Serial.printf("Display Controller: %s\n", HW_DISPLAY_CONTROLLER_STR);
-  Serial.printf("Touch Controller: %s\n", HW_TOUCH_CONTROLLER_STR);
-  Serial.printf("Touch SPI Bus: %s\n", (HW_TOUCH_SPI_BUS == VSPI) ? "VSPI" : "HSPI");
+  // Profile-spezifische Details (aktives Profil, mit HW_RUNTIME_PROFILE
+  // ggf. zur Laufzeit aus der Tabelle gewählt)
+  const HardwareProfile& profile = hardware.getProfile();
+  Serial.printf("Display Resolution: %dx%d\n", profile.display.width, profile.display.height);
+  Serial.printf("Display Controller: %s\n", profile.display.controllerName);
+  Serial.printf("Touch Controller: %s\n", profile.touch.controllerName);
+  if (profile.touch.controller == HW_TOUCH_CTRL_XPT2046) {
+    Serial.printf("Touch SPI Bus: %s\n", (profile.touch.bus == VSPI) ? "VSPI" : "HSPI");
+  } else {
+    Serial.printf("Touch I2C: SDA=%d, SCL=%d\n", profile.touch.sda, profile.touch.scl);
+  }
+  
+  if (profile.backlight.pin >= 0) {
+    Serial.printf("Backlight Pin: %d (%s)\n", profile.backlight.pin,
+                  hardware.hasPWMBacklight() ? "PWM" : "Digital");
+  }
   
-  #ifdef HW_BACKLIGHT_PIN
-  Serial.printf("Backlight Pin: %d (%s)\n", HW_BACKLIGHT_PIN,
-                hardware.hasPWMBacklight() ? "PWM" : "Digital");
-  #endif
+  // Auto-Erkennung beim Start (HW_AUTO_DETECT)
+  Serial.println("\n🔍 AUTO-ERKENNUNG:");
+  if (hardware.getDetection().profileName) {
+    printHardwareDetection(hardware.getDetection());
+  } else {
+    Serial.println("Nicht aktiv (HW_AUTO_DETECT false)");
+  }
   
   // Feature Matrix
   Serial.println("\n🔧 FEATURE MATRIX:");
@@ -663,11 +1180,9 @@ void printDetailedInfo() {
   Serial.printf("Backlight Inversion: %s\n", hardware.isBacklightInverted() ? "✅" : "❌");
   
   // Touch Kalibrierung Status
-  #ifdef HW_TOUCH_CALIBRATED
-  Serial.printf("Touch Kalibriert: %s\n", HW_TOUCH_CALIBRATED ? "✅" : "❌");
-  Serial.printf("Touch Range: X=%d-%d, Y=%d-%d\n", 
-                HW_TOUCH_MIN_X, HW_TOUCH_MAX_X, HW_TOUCH_MIN_Y, HW_TOUCH_MAX_Y);
-  #endif
+  Serial.printf("Touch Kalibriert: %s\n", profile.touch.calibrated ? "✅" : "❌");
+  Serial.printf("Touch Range: X=%d-%d, Y=%d-%d\n",
+                profile.touch.minX, profile.touch.maxX, profile.touch.minY, profile.touch.maxY);
   
   // System Info
   Serial.println("\n💾 SYSTEM INFO:");
@@ -675,16 +1190,42 @@ void printDetailedInfo() {
   Serial.printf("Flash Size: %d bytes\n", ESP.getFlashChipSize());
   Serial.printf("CPU Frequency: %d MHz\n", ESP.getCpuFreqMHz());
   
+  // Glyphen-Atlas (drawText)
+  const GlyphAtlas& atlas = hardware.getGlyphAtlas();
+  const GlyphAtlasStats& glyphs = atlas.stats();
+  Serial.printf("Glyphen-Atlas: %u Glyphen, %lu/%lu Bytes | %lu Treffer, %lu gerastert, %lu verdrängt\n",
+                atlas.glyphCount(), (unsigned long)atlas.usedBytes(), (unsigned long)atlas.capacityBytes(),
+                (unsigned long)glyphs.hits, (unsigned long)glyphs.misses, (unsigned long)glyphs.evictions);
+  Serial.printf("   %lu Strings in %lu Fenstern (%llu Bytes)\n", (unsigned long)glyphs.strings,
+                (unsigned long)glyphs.windows, (unsigned long long)glyphs.bytes);
+  
   Serial.println(String('=', 60));
 }
 
 void handleTestCommand(char cmd) {
   // Test-spezifische Kommandos können hier verarbeitet werden
   switch(currentTest) {
+    case TEST_TOUCH_SINGLE:
+      if (cmd == 'i') {
+        if (hardware.isTaskSplitActive()) {
+          Serial.println("Im Dual-Core Modus bleibt IRQ-Sampling aktiv");
+        } else if (hardware.isTouchSamplingActive()) {
+          hardware.stopTouchSampling();
+        } else {
+          hardware.startTouchSampling();
+        }
+      }
+      break;
     case TEST_TOUCH_CALIBRATION:
       if (cmd == 'r') {
         Serial.println("🔄 Kalibrierung zurückgesetzt");
-        touchCal = {9999, 0, 9999, 0, 0};
+        touchCal.target = -1;
+      } else if (cmd == 'm') {
+        touchCal.pointCount = (touchCal.pointCount == 5) ? 3 : 5;
+        touchCal.target = -1;
+      } else if (cmd == 'c') {
+        hardware.clearTouchCalibration();
+        Serial.println("🗑️ NVS-Kalibrierung gelöscht - Profil-Werte aktiv");
       }
       break;
     default:
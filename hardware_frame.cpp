@@ -0,0 +1,168 @@
+/**
+ * hardware_frame.cpp - Frame-Takt des Hardware Managers
+ *
+ * Feste Slots mit HW_FRAME_RATE, gebündelte Anforderungen, übersprungene
+ * Slots ohne Änderung und optional Flush ab der TE-Flanke
+ * (siehe frame_scheduler.h).
+ */
+
+#include "config.h"
+#include "TFT_Setup.h"  // VOR TFT_eSPI!
+#include <TFT_eSPI.h>
+#include "hardware_hal.h"
+#include "hw_trace.h"
+
+extern TFT_eSPI tft;
+
+// requestFrame() kommt aus beiden Tasks, beginFrame() aus dem Render-Pfad
+static portMUX_TYPE frameMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ============================================
+// TEARING-EFFECT
+// ============================================
+
+// Aus initDisplay(): TE-Ausgang des Panels einschalten (nur V-Blank)
+template <typename Profile>
+void HardwareManagerT<Profile>::initTearingSync() {
+  if (profile.display.te >= 0) {
+    tft.writecommand(FRAME_CMD_TEON);
+    tft.writedata(0x00);
+    if (!frameTeBegin(profile.display.te)) {
+      Serial.println("⚠️ Tearing-Effect Interrupt nicht verfügbar - Frames ohne Sync");
+    }
+  }
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::hasTearingSync() {
+  return profile.display.te >= 0;
+}
+
+// ============================================
+// FRAME-TAKT
+// ============================================
+
+template <typename Profile>
+void HardwareManagerT<Profile>::setFrameRate(uint16_t hz) {
+  portENTER_CRITICAL(&frameMux);
+  frameScheduler.setRate(hz);
+  portEXIT_CRITICAL(&frameMux);
+}
+
+template <typename Profile>
+uint16_t HardwareManagerT<Profile>::getFrameRate() {
+  return frameScheduler.rate();
+}
+
+template <typename Profile>
+uint32_t HardwareManagerT<Profile>::getFrameBudgetUs() {
+  return frameScheduler.budgetUs();
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::requestFrame(uint32_t delayMs) {
+  const uint32_t now = micros();
+  portENTER_CRITICAL(&frameMux);
+  frameScheduler.request(now, delayMs * 1000);
+  portEXIT_CRITICAL(&frameMux);
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::beginFrame() {
+  HW_TRACE_SCOPE("beginFrame");
+  
+  // Panel schläft: nichts zeichnen, Anforderungen bleiben bis zum Wecken liegen
+  if (!isDisplayAwake()) return false;
+  
+  // Bis zum Slot schlafen statt zu pollen
+  portENTER_CRITICAL(&frameMux);
+  uint32_t waitUs = frameScheduler.waitUs(micros());
+  portEXIT_CRITICAL(&frameMux);
+  if (waitUs >= 1000) delay(waitUs / 1000);
+  if (waitUs % 1000) delayMicroseconds(waitUs % 1000);
+  
+  // Bereiche aus markDirty() zählen wie eine Anforderung
+  lockDisplay();
+  const bool dirty = displayDamage.isDirty();
+  unlockDisplay();
+  
+  portENTER_CRITICAL(&frameMux);
+  bool due = frameScheduler.startFrame(micros(), dirty);
+  portEXIT_CRITICAL(&frameMux);
+  if (!due) return false;
+  
+  // Flush am Anfang des V-Blanks beginnen
+  if (profile.display.te >= 0) {
+    HW_TRACE_SCOPE("frameTeWait");
+    bool teOk = frameTeWait(FRAME_TE_TIMEOUT_MS);
+    portENTER_CRITICAL(&frameMux);
+    frameScheduler.alignFrame(micros(), true, teOk);
+    portEXIT_CRITICAL(&frameMux);
+  }
+  return true;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::endFrame() {
+  // Laufenden DMA-Frame abwarten: die Frame-Zeit enthält die Übertragung
+  lockDisplay();
+  stripRenderer.sync();
+  unlockDisplay();
+  
+  portENTER_CRITICAL(&frameMux);
+  frameScheduler.endFrame(micros());
+  portEXIT_CRITICAL(&frameMux);
+}
+
+// ============================================
+// STATISTIK
+// ============================================
+
+template <typename Profile>
+FrameStats HardwareManagerT<Profile>::getFrameStats(bool reset) {
+  const uint32_t now = millis();
+  portENTER_CRITICAL(&frameMux);
+  FrameStats stats = frameScheduler.stats(now);
+  if (reset) frameScheduler.resetStats(now);
+  portEXIT_CRITICAL(&frameMux);
+  return stats;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::printFrameStats() {
+  FrameStats stats = getFrameStats(true);
+  const uint64_t elapsedUs = (uint64_t)stats.elapsedMs * 1000;
+  const uint32_t slots = stats.frames + stats.skipped;
+  
+  Serial.printf("\n🎞️ Frame-Takt: %u Hz, Budget %lu µs, TE-Sync %s\n", getFrameRate(),
+                (unsigned long)getFrameBudgetUs(),
+                hasTearingSync() ? "aktiv" : "aus (kein HW_DISPLAY_TE)");
+  Serial.printf("   Frames: %lu gezeichnet, %lu übersprungen (%.1f%% der Slots), %lu über Budget\n",
+                (unsigned long)stats.frames, (unsigned long)stats.skipped,
+                slots ? 100.0 * stats.skipped / slots : 0.0, (unsigned long)stats.missed);
+  Serial.printf("   Frame-Zeit: Ø %lu µs, max %lu µs | Leerlauf %.1f%% von %.1f s\n",
+                (unsigned long)(stats.frames ? stats.totalFrameUs / stats.frames : 0),
+                (unsigned long)stats.maxFrameUs,
+                elapsedUs ? 100.0 - 100.0 * stats.totalFrameUs / elapsedUs : 100.0,
+                stats.elapsedMs / 1000.0);
+  Serial.printf("   Anforderungen: %lu, davon %lu gebündelt\n",
+                (unsigned long)stats.requests, (unsigned long)stats.coalesced);
+  if (hasTearingSync()) {
+    Serial.printf("   TE: %lu Wartezeiten, %lu Timeouts, %lu Flanken\n",
+                  (unsigned long)stats.teWaits, (unsigned long)stats.teTimeouts,
+                  (unsigned long)frameTeEdges());
+  }
+}
+
+// Explizite Instanzierung der hier definierten Members
+// (die Klasse selbst instanziert hardware_manager.cpp)
+template void HardwareManagerT<HardwareManagerProfile>::initTearingSync();
+template bool HardwareManagerT<HardwareManagerProfile>::hasTearingSync();
+template void HardwareManagerT<HardwareManagerProfile>::setFrameRate(uint16_t);
+template uint16_t HardwareManagerT<HardwareManagerProfile>::getFrameRate();
+template uint32_t HardwareManagerT<HardwareManagerProfile>::getFrameBudgetUs();
+template void HardwareManagerT<HardwareManagerProfile>::requestFrame(uint32_t);
+template bool HardwareManagerT<HardwareManagerProfile>::beginFrame();
+template void HardwareManagerT<HardwareManagerProfile>::endFrame();
+template FrameStats HardwareManagerT<HardwareManagerProfile>::getFrameStats(bool);
+template void HardwareManagerT<HardwareManagerProfile>::printFrameStats();
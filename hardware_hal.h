@@ -6,22 +6,24 @@
  * Usage:
  * #define HARDWARE_PROFILE ESP32_2432S028R
  * #include "hardware_hal.h"
+ *
+ * Mit HW_RUNTIME_PROFILE true wählt der Manager Touch, Backlight,
+ * Touch-Matrizen und Filter zur Laufzeit aus der Profil-Tabelle
+ * (RuntimeHardwareProfile); das Display bleibt das von TFT_Setup.h.
  */
 
 #ifndef HARDWARE_HAL_H
 #define HARDWARE_HAL_H
 
 #include <Arduino.h>
+#include <SPI.h>
+#include <XPT2046_Touchscreen.h>
+#include "hardware_profile.h"  // Profil-IDs, HardwareProfile
 
 // ============================================
 // HARDWARE PROFILE SELECTION
 // ============================================
 
-// Verfügbare Hardware-Profile
-#define ESP32_TZT_24      1    // TZT 2,4" ST7789 (original)
-#define ESP32_2432S028R   2    // 2,8" ILI9341
-#define ESP32_GENERIC     99   // Generic Fallback
-
 // Standard-Profile falls nicht definiert
 #ifndef HARDWARE_PROFILE
   #define HARDWARE_PROFILE ESP32_TZT_24
@@ -42,36 +44,330 @@
   #error "Unbekanntes HARDWARE_PROFILE - unterstützte Profile: ESP32_TZT_24, ESP32_2432S028R, ESP32_GENERIC"
 #endif
 
+// ============================================
+// PROFIL-DEFAULTS
+// ============================================
+
+#include "hardware_profile_defaults.h"
+
+// Profil zur Laufzeit aus der Tabelle wählen (RuntimeHardwareProfile)
+#ifndef HW_RUNTIME_PROFILE
+  #define HW_RUNTIME_PROFILE false
+#endif
+
+// ============================================
+// AKTIVES PROFIL
+// ============================================
+
+// Alle Profil-Werte als constexpr Struktur (siehe hardware_profile.h)
+HW_DEFINE_PROFILE(ActiveHardwareProfile);
+
+static_assert(ActiveHardwareProfile::config.id == HARDWARE_PROFILE,
+              "HW_PROFILE_ID des Profil-Headers passt nicht zu HARDWARE_PROFILE");
+
+// Veränderliches Profil für Builds mit HW_RUNTIME_PROFILE: startet mit
+// dem kompilierten Profil, select() übernimmt einen Tabelleneintrag mit
+// demselben Display (hwDisplayCompatible) vor HardwareManager::begin().
+struct RuntimeHardwareProfile {
+  static constexpr bool runtime = true;
+  static inline HardwareProfile config = ActiveHardwareProfile::config;
+  static inline BacklightGammaTable backlightGamma = ActiveHardwareProfile::backlightGamma;
+
+  static bool select(const HardwareProfile& candidate) {
+    if (!hwDisplayCompatible(candidate, ActiveHardwareProfile::config)) {
+      return false;
+    }
+    config = candidate;
+    backlightGamma = backlightGammaTable(candidate.backlight.pwmResolution);
+    return true;
+  }
+};
+
 // ============================================
 // HARDWARE ABSTRACTION LAYER API
 // ============================================
 
-class HardwareManager {
+#include "touch_filter.h"
+#include "touch_calibration.h"
+#include "touch_sampler.h"
+#include "touch_gestures.h"
+#include "touch_i2c.h"
+#include "damage_tracker.h"
+#include "strip_renderer.h"
+#include "glyph_atlas.h"
+#include "text_label.h"
+#include "image_blit.h"
+#include "span_fill.h"
+#include "spi_arbiter.h"
+#include "display_clock.h"
+#include "hardware_auto_detect.h"
+#include "boot_sequence.h"
+#include "backlight_gamma.h"
+#include "power_manager.h"
+#include "frame_scheduler.h"
+
+#define HW_RENDER_TASK_STACK    8192
+#define HW_RENDER_TASK_PRIORITY 1
+#define HW_IO_TASK_STACK        4096
+#define HW_IO_TASK_PRIORITY     3
+
+// Frame-Funktion des Render-Tasks (wird wiederholt aufgerufen)
+typedef void (*HardwareFrameFn)(void* context);
+
+// Kommando an den IO-Task
+enum IoCommandType : uint8_t {
+  IO_CMD_BRIGHTNESS      // value = Prozent, durationMs = Fade (0 = sofort)
+};
+
+struct IoCommand {
+  IoCommandType type;
+  int16_t value;
+  uint16_t durationMs;
+};
+
+// Alter der Touch-Samples bei der Verarbeitung in processTouch()
+struct TouchLatencyStats {
+  uint32_t samples;
+  uint32_t maxUs;
+  uint64_t totalUs;
+};
+
+// Filter-Konfiguration aus dem Profil
+constexpr TouchFilterConfig hwTouchFilterConfig(const HwTouchConfig& touch) {
+  return TouchFilterConfig{ touch.threshold, touch.filterMedian, touch.filterIirShift, touch.filterDeadband };
+}
+
+// Templatisiert auf den Profil-Typ: alle Werte kommen aus Profile::config.
+// ActiveHardwareProfile: constexpr, nicht genutzte Zweige (Backlight, PWM,
+// DMA, ...) faltet der Compiler weg. RuntimeHardwareProfile: Eintrag der
+// Profil-Tabelle, gewählt vor begin() (selectProfile()).
+template <typename Profile>
+class HardwareManagerT {
+public:
+  static constexpr const HardwareProfile& profile = Profile::config;
+  // GT911, FT6236, CST816S am I2C-Bus statt XPT2046 am SPI-Host
+  static bool touchOnI2c() { return profile.touch.controller != HW_TOUCH_CTRL_XPT2046; }
+
 private:
   bool initialized;
+  bool profileSelected;              // selectProfile() vor begin(): Vorrang vor der Erkennung
+  
+  // Geräte des Profils: touchSPI ist der Host, den das Display nicht belegt
+  // (geteilter Host: tft.getSPIinstance(), siehe touchBus())
+  SpiDevice displaySpiDevice;        // Bus-Arbiter: Display (tft)
+  SpiDevice touchSpiDevice;          // Bus-Arbiter: XPT2046
+  SPIClass touchSPI;
+  XPT2046_Touchscreen touch;
+  
+  TouchTransform touchTransform;  // Aktive Matrix für die aktuelle Rotation
+  bool touchCalibrated;           // true = Kalibrierung aus NVS aktiv
+  TouchCalibrationData touchCalibration;
+  TouchGestureEngine touchGestures;  // Samples -> Events
+  TouchFilter touchFilter;           // Rauschfilter im Polling-Modus
+  TouchI2c touchI2c;                 // Kapazitive Controller (touchOnI2c)
+  DamageTracker displayDamage;       // Geänderte Bereiche seit dem letzten Flush
+  DamageFlushStats flushStats;
+  GlyphAtlas glyphAtlas;             // Vorgerenderte Glyphen für drawText()
+  ImageBlitter imageBlitter;         // Komprimierte Bilder für drawImage()
+  SpanFiller spanFiller;             // Verläufe/Raster für fillSpans()
+  StripRenderer stripRenderer;       // Vollbild-Pipeline (DMA Ping-Pong)
+  bool displayClockTuned;            // true = Takt aus NVS/Tuning aktiv
+  HardwareDetection detection;       // Ergebnis der Auto-Erkennung (HW_AUTO_DETECT)
+  
+  // Backlight: Gamma-Tabelle für die Profil-Auflösung (backlight_gamma.h)
+  static constexpr const BacklightGammaTable& backlightGamma = Profile::backlightGamma;
+  volatile int backlightPercent;     // Ziel des letzten Aufrufs
+  volatile bool backlightFading;     // Hardware-Fade gestartet, bis backlightFadeEndMs
+  volatile uint32_t backlightFadeEndMs;
+  uint32_t backlightTargetDuty;      // Duty des letzten Aufrufs (ohne ledcWrite-Marker)
+  
+  // Gestaffelter Start (boot_sequence.h)
+  BootTimeline bootTimeline;
+  TaskHandle_t bootTask;
+  volatile bool touchReady;          // Touch-API erst nach der Touch-Stufe
+  volatile bool bootComplete;
+  
+  // Energiesparstufen (power_manager.h, hardware_power.cpp)
+  PowerConfig powerConfig;
+  PowerStats powerStats;
+  volatile PowerState powerState;
+  volatile uint32_t lastActivityMs;
+  volatile bool powerSwallowTouch;   // Weck-Berührung bis zum Abheben verwerfen
+  uint32_t powerStateSinceMs;
+  uint32_t powerSleepInMs;           // millis() beim SLPIN
+  int powerRestorePercent;           // Helligkeit vor dem Dimmen
+  
+  // Frame-Takt (frame_scheduler.h, hardware_frame.cpp)
+  FrameScheduler frameScheduler;
+  
+  // Dual-Core Betrieb
+  TaskHandle_t renderTask;
+  TaskHandle_t ioTask;
+  volatile bool tasksStopping;
+  bool tasksStartedSampler;
+  HardwareFrameFn frameFn;
+  void* frameContext;
+  SemaphoreHandle_t displayMutex;       // Display-Methoden aus mehreren Tasks
+  SpscRing<char, 64> serialQueue;       // IO-Task -> Anwendung
+  SpscRing<IoCommand, 16> ioCommands;   // Anwendung -> IO-Task
+  TouchLatencyStats touchLatency;
+  
+  void applyProfile();   // Geräte, Matrix und Filter aus 'profile'
+  SPIClass& touchBus();
   void initBacklight();  // Private Methode deklariert
+  void fadeInBacklight();
+  void markBootStage(BootStage stage);
+  void runBootStages();  // Touch, Backlight, Validierung
+  void updateTouchTransform();
+  TouchTransform activeTouchTransform();
+  void applyBrightness(int percent, uint32_t fadeMs = 0);
+  void applyDisplayClock(uint32_t writeHz, uint32_t readHz);
+  void setPowerState(PowerState state);
+  void accountPowerState();
+  void enterPowerState(PowerState target);
+  uint32_t lightSleep();
+  void wakePower(uint32_t detectUs);
+  bool swallowWakeTouch(bool pressed);
+  void initTearingSync();
+  bool renderUnbuffered(int y, int h, DamageRenderFn render, void* context);
+  bool onIoTask();
+  void pollTouchI2c();
+  void lockDisplay();
+  void unlockDisplay();
+  static void renderTaskMain(void* param);
+  static void ioTaskMain(void* param);
+  static void bootTaskMain(void* param);
   
 public:
-  HardwareManager();
+  HardwareManagerT();
+  
+  // Profil aus der Tabelle übernehmen, vor begin(). Nur mit HW_RUNTIME_PROFILE
+  // und demselben Display wie TFT_Setup.h, sonst false (kompiliertes bleibt).
+  // Ohne Aufruf wählt begin() das Profil der Auto-Erkennung.
+  bool selectProfile(const HardwareProfile& candidate);
   
-  // Initialisierung
-  bool begin();
+  // Initialisierung: Display + erster Frame (firstFrame, sonst schwarz),
+  // danach kehrt begin() zurück; der Rest läuft im Boot-Task
+  bool begin(DamageRenderFn firstFrame = nullptr, void* context = nullptr);
   void end();
+  bool isBootComplete();
+  bool waitBootComplete(uint32_t timeoutMs = BOOT_WAIT_TIMEOUT_MS);
+  bool isTouchReady();
+  const BootTimeline& getBootTimeline();
+  void printBootTimeline();
   
   // Display Management
   bool initDisplay();
-  void setDisplayRotation(int rotation);
+  void setDisplayRotation(int rotation);  // Aktualisiert auch die Touch-Matrix
   void setDisplayBrightness(int percent);
+  void fadeDisplayBrightness(int percent, uint32_t ms);  // Kehrt sofort zurück (LEDC-Fade)
+  int getDisplayBrightness();      // Ziel in Prozent
+  bool isBrightnessFading();
   void invertDisplay(bool invert);
   
+  // Dirty-Rectangles: nur geänderte Bereiche übertragen
+  void markDirty(int x, int y, int w, int h);
+  void markDisplayDirty();                                   // Ganzer Bildschirm
+  bool flushDisplay(DamageRenderFn render, void* context = nullptr);
+  const DamageFlushStats& getFlushStats();
+  
+  // Text über den Glyphen-Atlas: ein Fenster pro String (glyph_atlas.h)
+  int16_t drawText(const char* text, int32_t x, int32_t y, uint8_t font, uint16_t fg, uint16_t bg);
+  int16_t drawText(const String& text, int32_t x, int32_t y, uint8_t font, uint16_t fg, uint16_t bg);
+  uint8_t updateLabel(TextLabel& label, const char* text);   // Nur geänderte Zeichen (text_label.h)
+  const GlyphAtlas& getGlyphAtlas();
+  
+  // Komprimiertes Bild aus dem Flash (image_asset.h, Packer: simulator/tools)
+  bool drawImage(const uint8_t* asset, int32_t x, int32_t y);
+  const ImageBlitStats& getImageStats();
+  
+  // Verlauf, Raster oder Balken in einem Adressfenster (span_fill.h)
+  bool fillSpans(int32_t x, int32_t y, int32_t w, int32_t h, const SpanPattern& pattern);
+  const SpanFillStats& getSpanStats();
+  
+  // Streifen-Rendering mit DMA Ping-Pong, Fence = Frame vollständig übertragen
+  uint32_t renderFrame(DamageRenderFn render, void* context = nullptr);
+  uint32_t renderRows(int y, int h, DamageRenderFn render, void* context = nullptr);
+  bool isFrameComplete(uint32_t fence);
+  void waitFrame(uint32_t fence);
+  bool isDisplayDMAActive();
+  void setDisplayDMA(bool enable);       // Für Vergleichsmessungen
+  const StripRendererStats& getStripStats();
+  int getStripRows();
+  
+  const SpiDevice& getDisplaySpiDevice();   // Für eigene Zugriffe am Bus-Arbiter
+  
+  // SPI-Takt des Displays (NVS, ersetzt HW_DISPLAY_SPI_FREQ / _READ_FREQ)
+  bool loadDisplayClock();                                 // Vor tft.init()
+  bool tuneDisplayClock(DisplayClockResult* result, bool persist);
+  void clearDisplayClock();                                // Zurück auf das Profil
+  bool hasTunedDisplayClock();
+  uint32_t getDisplayWriteHz();
+  uint32_t getDisplayReadHz();
+  
+  // Auto-Erkennung: Controller-IDs und Profil (profileName nullptr = nicht gelaufen)
+  int detectHardware();                                    // Vor initDisplay()
+  const HardwareDetection& getDetection();
+  
   // Touch Management  
   bool initTouch();
   bool isTouchPressed();
   void getTouchPoint(int* x, int* y);
-  int getTouchCount();  // Multi-Touch Support
-  void getTouchPoints(int points[][2], int maxPoints); // Multi-Touch
+  int getTouchCount();  // Aufliegende Finger
+  void getTouchPoints(int points[][2], int maxPoints); // Index = Finger, -1 = frei
+  bool readRawTouch(int* rawX, int* rawY);  // Unkalibrierte Rohwerte
+  
+  // Interrupt-gesteuertes Sampling (HW_TOUCH_IRQ) statt Polling
+  bool startTouchSampling(uint16_t rateHz = profile.touch.sampleRate);
+  void stopTouchSampling();
+  bool isTouchSamplingActive();
+  size_t readTouchSamples(TouchSample* samples, size_t maxSamples);
+  void mapTouchSample(const TouchSample& sample, int* x, int* y);
+  const TouchI2cStats& getTouchI2cStats();   // Burst-Reads der I2C-Controller
+  
+  // Touch Events (Down/Move/Up, Tap, Double-Tap, Long-Press, Swipe)
+  void processTouch();                     // Einmal pro Frame: Samples -> Events
+  bool getTouchEvent(TouchEvent* event);   // Nächstes Event, false = Queue leer
+  
+  // Dual-Core Betrieb: Render-Task (tft) auf HW_RENDER_CORE, Input/IO-Task
+  // (Touch, Serial, Backlight) auf HW_IO_CORE. Danach sind die öffentlichen
+  // Methoden aus beiden Tasks nutzbar; getTouchEvent() nur aus einem Task.
+  bool startTaskSplit(HardwareFrameFn frame, void* context = nullptr);
+  void stopTaskSplit();            // Aus dem Render-Task: endet nach dem Frame
+  bool isTaskSplitActive();
+  bool readSerialCommand(char* cmd);   // Serial direkt oder aus dem IO-Task
+  TouchLatencyStats getTouchLatency(bool reset = false);
+  
+  // Energiesparstufen: Dimmen, Display aus, Light-Sleep (power_manager.h)
+  PowerState updatePower();              // IO-Task bzw. einmal pro loop()
+  void notifyActivity();                 // Touch und Serial melden sich selbst
+  void setPowerConfig(const PowerConfig& config);
+  const PowerConfig& getPowerConfig();
+  PowerState getPowerState();
+  bool isDisplayAwake();                 // false: Panel schläft, nicht rendern
+  PowerStats getPowerStats(bool reset = false);
+  void printPowerStats();
+  
+  // Frame-Takt: feste Slots, gebündelte Anforderungen, TE-Sync (frame_scheduler.h)
+  bool beginFrame();                     // Wartet auf den Slot, false = nichts zu zeichnen
+  void endFrame();
+  void requestFrame(uint32_t delayMs = 0);
+  void setFrameRate(uint16_t hz);
+  uint16_t getFrameRate();
+  uint32_t getFrameBudgetUs();
+  bool hasTearingSync();                 // HW_DISPLAY_TE im Profil
+  FrameStats getFrameStats(bool reset = false);
+  void printFrameStats();
+  
+  // Touch Kalibrierung (NVS, ersetzt die Profil-Konstanten)
+  bool loadTouchCalibration();
+  bool applyTouchCalibration(TouchCalibrationData* data, bool persist);
+  void clearTouchCalibration();
+  bool hasTouchCalibration();
   
   // Hardware Info
+  const HardwareProfile& getProfile();          // Aktives Profil
+  const HardwareProfile* getDetectedProfile();  // Aus der Profil-Tabelle, nullptr = keins
   String getProfileName();
   String getDisplayController();
   String getTouchController();
@@ -88,6 +384,15 @@ public:
   bool validateHardware();
 };
 
+#if HW_RUNTIME_PROFILE
+  using HardwareManagerProfile = RuntimeHardwareProfile;
+#else
+  using HardwareManagerProfile = ActiveHardwareProfile;
+#endif
+
+extern template class HardwareManagerT<HardwareManagerProfile>;
+using HardwareManager = HardwareManagerT<HardwareManagerProfile>;
+
 // Globale Hardware Manager Instanz
 extern HardwareManager hardware;
 
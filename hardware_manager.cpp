@@ -6,326 +6,1102 @@
 #include "TFT_Setup.h"  // VOR TFT_eSPI!
 #include <TFT_eSPI.h>
 #include "hardware_hal.h"
+#include "hw_trace.h"
 #include <SPI.h>
+#include <Wire.h>
 #include <XPT2046_Touchscreen.h>
 
 // Globale Hardware Manager Instanz
 HardwareManager hardware;
 
-// Hardware-spezifische Instanzen
+// Display: Treiber und Pins legt TFT_Setup.h beim Kompilieren fest
 TFT_eSPI tft = TFT_eSPI();
 
-#if HW_TOUCH_SPI_BUS == VSPI
-  SPIClass touchSPI = SPIClass(VSPI);
-#else
-  SPIClass touchSPI = SPIClass(HSPI);
-#endif
+// Schützt touchTransform und die Latenz-Statistik zwischen den Tasks
+static portMUX_TYPE touchStateMux = portMUX_INITIALIZER_UNLOCKED;
 
-XPT2046_Touchscreen touch(HW_TOUCH_CS, HW_TOUCH_IRQ);
+template <typename Profile>
+HardwareManagerT<Profile>::HardwareManagerT()
+  : initialized(false), profileSelected(false),
+    displaySpiDevice{ "Display", profile.display.bus, SPI_PRIORITY_NORMAL, profile.display.writeHz, SPI_MODE0 },
+    touchSpiDevice{ "Touch", profile.touch.bus, SPI_PRIORITY_REALTIME, profile.touch.spiHz, SPI_MODE0 },
+    touchSPI(profile.display.bus == HSPI ? VSPI : HSPI), touch(profile.touch.cs, profile.touch.irq),
+    touchTransform(profile.touchTransform(profile.display.rotation)),
+    touchCalibrated(false), touchCalibration(), touchFilter(hwTouchFilterConfig(profile.touch)),
+    touchI2c(),
+    flushStats(), glyphAtlas(displaySpiDevice), imageBlitter(displaySpiDevice), spanFiller(displaySpiDevice),
+    displayClockTuned(false), detection(), backlightPercent(0), backlightFading(false),
+    backlightFadeEndMs(0), backlightTargetDuty(0),
+    bootTimeline(), bootTask(nullptr),
+    touchReady(false), bootComplete(false), powerConfig(powerConfigDefault()), powerStats(),
+    powerState(POWER_ACTIVE), lastActivityMs(0), powerSwallowTouch(false), powerStateSinceMs(0),
+    powerSleepInMs(0), powerRestorePercent(profile.backlight.defaultPercent), frameScheduler(),
+    renderTask(nullptr), ioTask(nullptr), tasksStopping(false),
+    tasksStartedSampler(false), frameFn(nullptr), frameContext(nullptr),
+    displayMutex(nullptr), touchLatency() {}
 
-HardwareManager::HardwareManager() : initialized(false) {}
+// Nur vor begin(): Touch, Backlight und Takte gehen danach vom gewählten Profil aus
+template <typename Profile>
+bool HardwareManagerT<Profile>::selectProfile(const HardwareProfile& candidate) {
+  if constexpr (Profile::runtime) {
+    if (candidate.id == profile.id) {
+      profileSelected = true;
+      return true;
+    }
+    if (initialized) {
+      Serial.println("ERROR: Profilwechsel nur vor begin()");
+      return false;
+    }
+    if (!Profile::select(candidate)) {
+      Serial.printf("⚠️ %s: anderes Display (%s) als TFT_Setup.h - bleibe bei %s\n",
+                    candidate.name, candidate.display.controllerName, profile.name);
+      return false;
+    }
+    applyProfile();
+    profileSelected = true;
+    Serial.printf("🔁 Profil aus der Tabelle: %s\n", profile.name);
+    return true;
+  } else {
+    if (candidate.id == profile.id) return true;
+    Serial.printf("⚠️ %s nicht wählbar: Build ohne HW_RUNTIME_PROFILE (kompiliert: %s)\n",
+                  candidate.name, profile.name);
+    return false;
+  }
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::applyProfile() {
+  displaySpiDevice.clockHz = profile.display.writeHz;
+  touchSpiDevice.host = profile.touch.bus;
+  touchSpiDevice.clockHz = profile.touch.spiHz;
+  touch = XPT2046_Touchscreen(profile.touch.cs, profile.touch.irq);
+  touchFilter = TouchFilter(hwTouchFilterConfig(profile.touch));
+  touchTransform = profile.touchTransform(profile.display.rotation);
+  powerRestorePercent = profile.backlight.defaultPercent;
+  displayClockWriteHz = profile.display.writeHz;
+  displayClockReadHz = profile.display.readHz;
+}
+
+// Geteilter Host: Touch nutzt dieselbe SPIClass-Instanz wie TFT_eSPI
+template <typename Profile>
+SPIClass& HardwareManagerT<Profile>::touchBus() {
+  return profile.touchSharesBus() ? tft.getSPIinstance() : touchSPI;
+}
 
-bool HardwareManager::begin() {
-  Serial.println("Initialisiere Hardware: " HW_PROFILE_NAME);
+template <typename Profile>
+bool HardwareManagerT<Profile>::begin(DamageRenderFn firstFrame, void* context) {
+  HW_TRACE_SCOPE("begin");
+  bootTimeline = BootTimeline();
+  bootComplete = false;
+  touchReady = false;
+  markBootStage(BOOT_STAGE_BEGIN);
+  lastActivityMs = powerStateSinceMs = millis();
+  Serial.printf("Initialisiere Hardware: %s\n", profile.name);
+  
+  spiArbiter.begin();
+  displayMutex = xSemaphoreCreateRecursiveMutex();
+  
+  // Mit HW_RUNTIME_PROFILE immer erkennen: das erkannte Profil liefert
+  // Touch, Backlight und Takte für alle folgenden Stufen
+  if (Profile::runtime || profile.has(HW_FEATURE_AUTO_DETECT)) {
+    // Erkennung braucht die Busse exklusiv: vor TFT- und Touch-Init
+    const int detected = detectHardware();
+    if (detected != profile.id) {
+      const HardwareProfile* entry = hardwareProfileById(detected);
+      if (!Profile::runtime) {
+        Serial.printf("⚠️ Erkannt: %s, kompiliert: %s - HARDWARE_PROFILE in config.h prüfen\n",
+                      detection.profileName, profile.name);
+      } else if (profileSelected) {
+        Serial.printf("⚠️ Erkannt: %s, per selectProfile() gewählt: %s - bleibe dabei\n",
+                      detection.profileName, profile.name);
+      } else if (entry) {
+        selectProfile(*entry);
+      }
+    }
+    markBootStage(BOOT_STAGE_DETECT);
+  }
+  
+  // Backlight bleibt aus, bis der erste Frame im Panel steht
+  if (profile.backlight.pin >= 0) {
+    initBacklight();
+  }
   
   if (!initDisplay()) {
     Serial.println("Display-Initialisierung fehlgeschlagen");
     return false;
   }
+  markBootStage(BOOT_STAGE_DISPLAY);
+  
+  // Erster Frame: Anwendung oder schwarz (Panel-RAM ist nach Reset undefiniert).
+  // Ohne Strip-Puffer über den kleinen Band-Puffer, notfalls schwarz.
+  bootTimeline.stripReady = stripRenderer.ready();
+  if (!bootTimeline.stripReady) {
+    Serial.println("⚠️ Strip-Renderer nicht verfügbar - Frames ohne DMA über den Band-Puffer");
+  }
+  {
+    HW_TRACE_SCOPE("firstFrame");
+    bool drawn = false;
+    if (firstFrame && bootTimeline.stripReady) {
+      waitFrame(renderFrame(firstFrame, context));
+      drawn = true;
+    } else if (firstFrame) {
+      drawn = renderUnbuffered(0, tft.height(), firstFrame, context);
+    }
+    if (!drawn) {
+      tft.fillScreen(TFT_BLACK);
+    }
+  }
+  markBootStage(BOOT_STAGE_FIRST_FRAME);
+  initialized = true;
+  
+  const uint32_t firstFrameUs = bootTimeline.stageUs[BOOT_STAGE_FIRST_FRAME];
+  Serial.printf("⏱️ Erster Frame nach %.1f ms %s\n", firstFrameUs / 1000.0f,
+                firstFrameUs <= BOOT_FIRST_FRAME_BUDGET_US ? "✅" : "⚠️ über Budget");
   
-  if (!initTouch()) {
+  // Touch, Fade-In und Validierung im Hintergrund
+  bootTimeline.background =
+    xTaskCreatePinnedToCore(bootTaskMain, "hw_boot", BOOT_TASK_STACK, this,
+                            BOOT_TASK_PRIORITY, &bootTask, HW_IO_CORE) == pdPASS;
+  if (!bootTimeline.background) {
+    bootTask = nullptr;
+    runBootStages();
+  }
+  return true;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::end() {
+  waitBootComplete();
+  initialized = false;
+}
+
+// ============================================
+// GESTAFFELTER START
+// ============================================
+
+template <typename Profile>
+void HardwareManagerT<Profile>::markBootStage(BootStage stage) {
+  // 0 steht für "nicht erreicht"
+  const uint32_t now = micros();
+  bootTimeline.stageUs[stage] = now ? now : 1;
+  HW_TRACE_INSTANT(bootStageName(stage));
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::runBootStages() {
+  HW_TRACE_SCOPE("bootStages");
+  bootTimeline.touchOk = initTouch();
+  if (bootTimeline.touchOk) {
+    // Gespeicherte Kalibrierung hat Vorrang vor den Profil-Konstanten
+    loadTouchCalibration();
+    touchReady = true;
+  } else {
     Serial.println("Touch-Initialisierung fehlgeschlagen");
-    return false;
   }
+  markBootStage(BOOT_STAGE_TOUCH);
   
-  #ifdef HW_BACKLIGHT_PIN
-    initBacklight();
-  #endif
+  if (profile.backlight.pin >= 0) {
+    fadeInBacklight();
+    markBootStage(BOOT_STAGE_BACKLIGHT);
+  }
   
-  // Hardware-spezifische Initialisierung
-  HW_INIT_CODE();
+  bootTimeline.validated = validateHardware();
+  markBootStage(BOOT_STAGE_VALIDATE);
   
-  initialized = true;
+  markBootStage(BOOT_STAGE_READY);
+  bootComplete = true;
   printHardwareInfo();
-  return true;
+  printBootTimeline();
 }
 
-void HardwareManager::end() {
-  initialized = false;
+template <typename Profile>
+bool HardwareManagerT<Profile>::isBootComplete() {
+  return bootComplete;
 }
 
-bool HardwareManager::initDisplay() {
+template <typename Profile>
+bool HardwareManagerT<Profile>::waitBootComplete(uint32_t timeoutMs) {
+  if (!initialized) return false;
+  const uint32_t start = millis();
+  while (!bootComplete && millis() - start < timeoutMs) {
+    delay(1);
+  }
+  return bootComplete;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::isTouchReady() {
+  return touchReady;
+}
+
+template <typename Profile>
+const BootTimeline& HardwareManagerT<Profile>::getBootTimeline() {
+  return bootTimeline;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::printBootTimeline() {
+  Serial.printf("⏱️ Boot-Ablauf (ab Start, %s):\n",
+                bootTimeline.background ? "Boot-Task" : "synchron");
+  uint32_t previous = 0;
+  for (uint8_t stage = 0; stage < BOOT_STAGE_COUNT; stage++) {
+    const uint32_t us = bootTimeline.stageUs[stage];
+    if (!us) continue;
+    Serial.printf("   %-15s %8.1f ms  (+%.1f ms)", bootStageName(stage), us / 1000.0f,
+                  (us - previous) / 1000.0f);
+    if (stage == BOOT_STAGE_FIRST_FRAME) {
+      Serial.print(us <= BOOT_FIRST_FRAME_BUDGET_US ? " ✅" : " ⚠️ über Budget");
+    } else if (stage == BOOT_STAGE_DISPLAY && !bootTimeline.stripReady) {
+      Serial.print(" ⚠️ ohne Strip-Puffer");
+    } else if (stage == BOOT_STAGE_TOUCH && !bootTimeline.touchOk) {
+      Serial.print(" ❌");
+    } else if (stage == BOOT_STAGE_VALIDATE) {
+      Serial.print(bootTimeline.validated ? " ✅" : " ⚠️");
+    }
+    Serial.println();
+    previous = us;
+  }
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::initDisplay() {
+  HW_TRACE_SCOPE("initDisplay");
+  
+  // Getunter Takt gilt schon für die Init-Sequenz
+  loadDisplayClock();
+  
   // TFT initialisieren
-  tft.init();
-  tft.setRotation(HW_DEFAULT_ROTATION);
+  {
+    HW_TRACE_SCOPE("tft.init");
+    tft.init();
+  }
+  
+  // Hardware-spezifische Initialisierung (HW_INIT_SEQUENCE)
+  if (profile.init.count) {
+    HW_TRACE_SCOPE("HW_INIT_SEQUENCE");
+    for (uint8_t i = 0; i < profile.init.count; i++) {
+      const HwInitCommand& command = profile.init.commands[i];
+      tft.writecommand(command.command);
+      for (uint8_t j = 0; j < command.length; j++) {
+        tft.writedata(command.data[j]);
+      }
+    }
+  }
+  
+  tft.setRotation(profile.display.rotation);
+  updateTouchTransform();
+  displayDamage.setBounds(tft.width(), tft.height());
 
-  #ifdef HW_COLORS_INVERTED
-    if (HW_COLORS_INVERTED) {
-      tft.invertDisplay(true);
+  if (profile.display.colorsInverted) {
+    tft.invertDisplay(true);
+  }
+  initTearingSync();
+  
+  // DMA für pushImageDMA, Streifen-Puffer nach freiem DMA-RAM
+  bool dma = false;
+  if (profile.display.dma) {
+    dma = tft.initDMA();
+    if (!dma) {
+      Serial.println("⚠️ DMA-Initialisierung fehlgeschlagen - blockierende Übertragung");
     }
-  #endif
+  }
+  stripRenderer.begin(&tft, &displaySpiDevice, dma, profile.display.stripRows, profile.display.stripRamShare);
   
   Serial.printf("Display initialisiert: %dx%d, Rotation: %d\n", 
-                HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT, HW_DEFAULT_ROTATION);
+                profile.display.width, profile.display.height, profile.display.rotation);
   return true;
-  // Vollbildschirm löschen testen
-  tft.fillRect(0, 0, 320, 240, TFT_BLACK);
-  delay(100);
-  tft.drawRect(0, 0, 320, 240, TFT_WHITE);
 }
 
-bool HardwareManager::initTouch() {
-  // Touch SPI initialisieren
-  touchSPI.begin(HW_TOUCH_CLK, HW_TOUCH_MISO, HW_TOUCH_MOSI, HW_TOUCH_CS);
+template <typename Profile>
+bool HardwareManagerT<Profile>::initTouch() {
+  HW_TRACE_SCOPE("initTouch");
+  if (touchOnI2c()) {
+    Wire.begin(profile.touch.sda, profile.touch.scl, profile.touch.i2cHz);
+    if (!touchI2c.begin(Wire, profile.touch.controller, profile.touch.i2cAddress, profile.touch.irq,
+                        profile.touch.rst, profile.touch.points, profile.touch.sampleRate)) {
+      Serial.printf("ERROR: %s antwortet nicht (SDA=%d, SCL=%d)\n",
+                    profile.touch.controllerName, profile.touch.sda, profile.touch.scl);
+      return false;
+    }
+
+    {
+      HW_TRACE_SCOPE("HW_TOUCH_INIT_CODE");
+      profile.touch.initCode();
+    }
+
+    Serial.printf("Touch initialisiert: %s an I2C 0x%02X (SDA=%d, SCL=%d, %d Punkte)\n",
+                  touchI2c.chipName(), touchI2c.address(), profile.touch.sda, profile.touch.scl,
+                  profile.touch.points);
+    return true;
+  }
+
+  // Touch SPI initialisieren (geteilter Host ist bereits von TFT_eSPI konfiguriert)
+  if (!profile.touchSharesBus()) {
+    touchSPI.begin(profile.touch.clk, profile.touch.miso, profile.touch.mosi, profile.touch.cs);
+  }
   
-  // Touch initialisieren
-  touch.begin(touchSPI);
+  // Touch initialisieren (läuft im Boot-Task: Bus über den Arbiter)
+  spiArbiter.acquire(touchSpiDevice);
+  touch.begin(touchBus());
+  spiArbiter.release(touchSpiDevice);
   
-  #ifdef HW_TOUCH_INIT_CODE
-    HW_TOUCH_INIT_CODE();
-  #endif
+  {
+    HW_TRACE_SCOPE("HW_TOUCH_INIT_CODE");
+    profile.touch.initCode();
+  }
   
-  Serial.printf("Touch initialisiert: %s auf %s\n", 
-                HW_TOUCH_CONTROLLER_STR, 
-                (HW_TOUCH_SPI_BUS == VSPI) ? "VSPI" : "HSPI");
+  Serial.printf("Touch initialisiert: %s auf %s%s\n", 
+                profile.touch.controllerName, 
+                (profile.touch.bus == VSPI) ? "VSPI" : "HSPI",
+                profile.touchSharesBus() ? " (geteilt mit Display)" : "");
   return true;
 }
 
-void HardwareManager::initBacklight() {
-  #ifdef HW_BACKLIGHT_PIN
-    #ifdef HW_BACKLIGHT_PWM_CHANNEL
-      // PWM-Backlight
-      ledcAttach(HW_BACKLIGHT_PIN, HW_BACKLIGHT_PWM_FREQ, HW_BACKLIGHT_PWM_RESOLUTION);
-      setDisplayBrightness(HW_BACKLIGHT_DEFAULT);
-      Serial.println("PWM-Backlight initialisiert");
-    #else
-      // Digital Backlight
-      pinMode(HW_BACKLIGHT_PIN, OUTPUT);
-      digitalWrite(HW_BACKLIGHT_PIN, HW_BACKLIGHT_INVERTED ? LOW : HIGH);
-      Serial.println("Digital-Backlight initialisiert");
-    #endif
-  #endif
+template <typename Profile>
+void HardwareManagerT<Profile>::initBacklight() {
+  HW_TRACE_SCOPE("initBacklight");
+  const HwBacklightConfig& backlight = profile.backlight;
+  if (backlight.pin < 0) {
+    return;
+  } else if (backlight.pwm) {
+    // PWM-Backlight, aus bis fadeInBacklight()
+    ledcAttach(backlight.pin, backlight.pwmFreq, backlight.pwmResolution);
+    applyBrightness(0);
+    Serial.println("PWM-Backlight initialisiert");
+  } else {
+    // Digital Backlight, aus bis fadeInBacklight()
+    pinMode(backlight.pin, OUTPUT);
+    digitalWrite(backlight.pin, backlight.inverted ? HIGH : LOW);
+    Serial.println("Digital-Backlight initialisiert");
+  }
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::fadeInBacklight() {
+  HW_TRACE_SCOPE("fadeInBacklight");
+  // Startet nur den Hardware-Fade, der Boot-Task wartet nicht darauf
+  applyBrightness(profile.backlight.defaultPercent, BOOT_FADE_MS);
 }
 
-void HardwareManager::setDisplayRotation(int rotation) {
+template <typename Profile>
+void HardwareManagerT<Profile>::setDisplayRotation(int rotation) {
+  lockDisplay();
   tft.setRotation(rotation);
+  updateTouchTransform();
+  displayDamage.setBounds(tft.width(), tft.height());
+  unlockDisplay();
 }
 
-void HardwareManager::setDisplayBrightness(int percent) {
-  #ifdef HW_BACKLIGHT_PIN
-    percent = constrain(percent, 0, 100);
-    
-    #ifdef HW_BACKLIGHT_PWM_CHANNEL
-      // PWM-Steuerung
-      int duty = map(percent, 0, 100, 0, (1 << HW_BACKLIGHT_PWM_RESOLUTION) - 1);
-      if (HW_BACKLIGHT_INVERTED) {
-        duty = ((1 << HW_BACKLIGHT_PWM_RESOLUTION) - 1) - duty;
-      }
-      ledcWrite(HW_BACKLIGHT_PIN, duty);
-    #else
-      // Digital Ein/Aus
-      bool state = (percent > 50) ? !HW_BACKLIGHT_INVERTED : HW_BACKLIGHT_INVERTED;
-      digitalWrite(HW_BACKLIGHT_PIN, state);
-    #endif
-  #endif
+template <typename Profile>
+void HardwareManagerT<Profile>::updateTouchTransform() {
+  uint8_t rotation = tft.getRotation() & 3;
+  TouchTransform transform;
+  
+  if (touchCalibrated) {
+    // Kalibrierte Matrix auf die aktive Rotation übertragen
+    transform = touchCalRotate(touchCalibration.transform, touchCalibration.rotation, rotation);
+  } else {
+    // Vorberechnete Matrix aus dem Profil
+    transform = profile.touchTransform(rotation);
+  }
+  
+  portENTER_CRITICAL(&touchStateMux);
+  touchTransform = transform;
+  portEXIT_CRITICAL(&touchStateMux);
 }
 
-void HardwareManager::invertDisplay(bool invert) {
-  tft.invertDisplay(invert);
+template <typename Profile>
+TouchTransform HardwareManagerT<Profile>::activeTouchTransform() {
+  portENTER_CRITICAL(&touchStateMux);
+  TouchTransform transform = touchTransform;
+  portEXIT_CRITICAL(&touchStateMux);
+  return transform;
 }
 
-bool HardwareManager::isTouchPressed() {
-  return touch.tirqTouched() && touch.touched();
+template <typename Profile>
+void HardwareManagerT<Profile>::setDisplayBrightness(int percent) {
+  // Dual-Core: Backlight gehört dem IO-Task
+  if (ioTask && !onIoTask()) {
+    portENTER_CRITICAL(&touchStateMux);  // Mehrere Erzeuger serialisieren
+    ioCommands.push(IoCommand{ IO_CMD_BRIGHTNESS, (int16_t)percent, 0 });
+    portEXIT_CRITICAL(&touchStateMux);
+    backlightPercent = constrain(percent, 0, 100);
+    return;
+  }
+  applyBrightness(percent);
 }
 
-void HardwareManager::getTouchPoint(int* x, int* y) {
-  if (!isTouchPressed()) {
-    *x = -1;
-    *y = -1;
+template <typename Profile>
+void HardwareManagerT<Profile>::fadeDisplayBrightness(int percent, uint32_t ms) {
+  if (ioTask && !onIoTask()) {
+    portENTER_CRITICAL(&touchStateMux);
+    ioCommands.push(IoCommand{ IO_CMD_BRIGHTNESS, (int16_t)percent, (uint16_t)(ms > 65535 ? 65535 : ms) });
+    portEXIT_CRITICAL(&touchStateMux);
+    backlightPercent = constrain(percent, 0, 100);
     return;
   }
+  applyBrightness(percent, ms);
+}
 
-  TS_Point p = touch.getPoint();
-  int rotation = tft.getRotation();
-  int tx = 0, ty = 0;
-
-  switch (rotation) {
-    case 0: // Portrait
-      #ifdef HW_TOUCH_MAP_PORTRAIT
-        HW_TOUCH_MAP_PORTRAIT(p.x, p.y, tx, ty);
-      #else
-        tx = map(p.x, HW_TOUCH_MIN_X, HW_TOUCH_MAX_X, 0, tft.width());
-        ty = map(p.y, HW_TOUCH_MIN_Y, HW_TOUCH_MAX_Y, 0, tft.height());
-      #endif
-      // Invertierung für ROTATION 0
-      #ifdef HW_TOUCH_INVERT_X_ROT0
-        if (HW_TOUCH_INVERT_X_ROT0) tx = tft.width() - tx;
-      #elif defined(HW_TOUCH_INVERT_X)
-        if (HW_TOUCH_INVERT_X) tx = tft.width() - tx;
-      #endif
-      #ifdef HW_TOUCH_INVERT_Y_ROT0
-        if (HW_TOUCH_INVERT_Y_ROT0) ty = tft.height() - ty;
-      #elif defined(HW_TOUCH_INVERT_Y)
-        if (HW_TOUCH_INVERT_Y) ty = tft.height() - ty;
-      #endif
-      break;
-
-    case 1: // Landscape
-      #ifdef HW_TOUCH_MAP_LANDSCAPE
-        HW_TOUCH_MAP_LANDSCAPE(p.x, p.y, tx, ty);
-      #else
-        tx = map(p.x, HW_TOUCH_MIN_X, HW_TOUCH_MAX_X, 0, tft.width());
-        ty = map(p.y, HW_TOUCH_MIN_Y, HW_TOUCH_MAX_Y, 0, tft.height());
-      #endif
-      // Invertierung für ROTATION 1
-      #ifdef HW_TOUCH_INVERT_X_ROT1
-        if (HW_TOUCH_INVERT_X_ROT1) tx = tft.width() - tx;
-      #elif defined(HW_TOUCH_INVERT_X)
-        if (HW_TOUCH_INVERT_X) tx = tft.width() - tx;
-      #endif
-      #ifdef HW_TOUCH_INVERT_Y_ROT1
-        if (HW_TOUCH_INVERT_Y_ROT1) ty = tft.height() - ty;
-      #elif defined(HW_TOUCH_INVERT_Y)
-        if (HW_TOUCH_INVERT_Y) ty = tft.height() - ty;
-      #endif
-      break;
-
-    case 2: // Portrait inverted
-      #ifdef HW_TOUCH_MAP_PORTRAIT_INV
-        HW_TOUCH_MAP_PORTRAIT_INV(p.x, p.y, tx, ty);
-      #else
-        tx = map(p.x, HW_TOUCH_MAX_X, HW_TOUCH_MIN_X, 0, tft.width());
-        ty = map(p.y, HW_TOUCH_MAX_Y, HW_TOUCH_MIN_Y, 0, tft.height());
-      #endif
-      // Invertierung für ROTATION 2
-      #ifdef HW_TOUCH_INVERT_X_ROT2
-        if (HW_TOUCH_INVERT_X_ROT2) tx = tft.width() - tx;
-      #elif defined(HW_TOUCH_INVERT_X)
-        if (HW_TOUCH_INVERT_X) tx = tft.width() - tx;
-      #endif
-      #ifdef HW_TOUCH_INVERT_Y_ROT2
-        if (HW_TOUCH_INVERT_Y_ROT2) ty = tft.height() - ty;
-      #elif defined(HW_TOUCH_INVERT_Y)
-        if (HW_TOUCH_INVERT_Y) ty = tft.height() - ty;
-      #endif
-      break;
-
-    case 3: // Landscape inverted
-      #ifdef HW_TOUCH_MAP_LANDSCAPE_INV
-        HW_TOUCH_MAP_LANDSCAPE_INV(p.x, p.y, tx, ty);
-      #else
-        tx = map(p.x, HW_TOUCH_MAX_X, HW_TOUCH_MIN_X, 0, tft.width());
-        ty = map(p.y, HW_TOUCH_MIN_Y, HW_TOUCH_MAX_Y, tft.height(), 0);
-      #endif
-      // Invertierung für ROTATION 3
-      #ifdef HW_TOUCH_INVERT_X_ROT3
-        if (HW_TOUCH_INVERT_X_ROT3) tx = tft.width() - tx;
-      #elif defined(HW_TOUCH_INVERT_X)
-        if (HW_TOUCH_INVERT_X) tx = tft.width() - tx;
-      #endif
-      #ifdef HW_TOUCH_INVERT_Y_ROT3
-        if (HW_TOUCH_INVERT_Y_ROT3) ty = tft.height() - ty;
-      #elif defined(HW_TOUCH_INVERT_Y)
-        if (HW_TOUCH_INVERT_Y) ty = tft.height() - ty;
-      #endif
-      break;
-  }
-
-  // Koordinaten begrenzen
-  *x = constrain(tx, 0, tft.width() - 1);
-  *y = constrain(ty, 0, tft.height() - 1);
-}
-
-int HardwareManager::getTouchCount() {
-  #ifdef HW_TOUCH_MULTIPOINT
-    return HW_TOUCH_MULTIPOINT;
-  #else
-    return 1;
-  #endif
-}
-
-void HardwareManager::getTouchPoints(int points[][2], int maxPoints) {
-  // Single-Touch Implementation
-  if (maxPoints > 0 && isTouchPressed()) {
-    getTouchPoint(&points[0][0], &points[0][1]);
-    // Weitere Punkte als ungültig markieren
-    for (int i = 1; i < maxPoints; i++) {
-      points[i][0] = -1;
-      points[i][1] = -1;
+template <typename Profile>
+int HardwareManagerT<Profile>::getDisplayBrightness() {
+  return backlightPercent;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::isBrightnessFading() {
+  // Nicht aus ledcRead() ableiten: ledcWrite() speichert für vollen Duty
+  // max+1 ("LEDC FULL ON"), das weicht dauerhaft von der Tabelle ab
+  return backlightFading && (int32_t)(millis() - backlightFadeEndMs) < 0;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::applyBrightness(int percent, uint32_t fadeMs) {
+  const HwBacklightConfig& backlight = profile.backlight;
+  percent = constrain(percent, 0, 100);
+  if (backlight.pin < 0) {
+    (void)fadeMs;
+  } else if (backlight.pwm) {
+    // PWM-Steuerung über die Gamma-Tabelle (wahrgenommene Helligkeit)
+    const uint32_t duty = backlightDuty(backlightGamma, backlight.pwmResolution,
+                                        backlight.inverted, percent);
+    if (fadeMs == 0 && !isBrightnessFading()) {
+      ledcWrite(backlight.pin, duty);
+      backlightFading = false;
+    } else {
+      // LEDC-Hardware-Fade ab dem aktuellen Duty, ersetzt einen laufenden
+      // Fade und braucht danach keine CPU-Zeit. Start: während eines Fades
+      // der Hardware-Duty, sonst der letzte Zielwert (nie max+1)
+      const uint32_t maxDuty = (1UL << backlight.pwmResolution) - 1;
+      const uint32_t start = isBrightnessFading() ? min(ledcRead(backlight.pin), maxDuty)
+                                                  : backlightTargetDuty;
+      const uint32_t ms = fadeMs ? fadeMs : 1;
+      ledcFade(backlight.pin, start, duty, (int)ms);
+      backlightFadeEndMs = millis() + ms;
+      backlightFading = true;
     }
+    backlightTargetDuty = duty;
   } else {
-    // Alle Punkte als ungültig markieren
-    for (int i = 0; i < maxPoints; i++) {
-      points[i][0] = -1;
-      points[i][1] = -1;
-    }
+    // Digital Ein/Aus, kein Fade möglich
+    (void)fadeMs;
+    bool state = (percent > 50) ? !backlight.inverted : backlight.inverted;
+    digitalWrite(backlight.pin, state);
   }
+  backlightPercent = percent;
 }
 
-String HardwareManager::getProfileName() {
-  return String(HW_PROFILE_NAME);
+template <typename Profile>
+void HardwareManagerT<Profile>::invertDisplay(bool invert) {
+  lockDisplay();
+  tft.invertDisplay(invert);
+  unlockDisplay();
 }
 
-String HardwareManager::getDisplayController() {
-  return String(HW_DISPLAY_CONTROLLER_STR);
+template <typename Profile>
+void HardwareManagerT<Profile>::markDirty(int x, int y, int w, int h) {
+  lockDisplay();
+  displayDamage.add(x, y, w, h);
+  unlockDisplay();
 }
 
-String HardwareManager::getTouchController() {
-  return String(HW_TOUCH_CONTROLLER_STR);
+template <typename Profile>
+void HardwareManagerT<Profile>::markDisplayDirty() {
+  lockDisplay();
+  displayDamage.markAll();
+  unlockDisplay();
 }
 
-bool HardwareManager::hasMultiTouch() {
-  #ifdef HW_TOUCH_MULTIPOINT
-    return HW_TOUCH_MULTIPOINT > 1;
-  #else
-    return false;
-  #endif
+template <typename Profile>
+bool HardwareManagerT<Profile>::flushDisplay(DamageRenderFn render, void* context) {
+  HW_TRACE_SCOPE("flushDisplay");
+  lockDisplay();
+  stripRenderer.sync();  // Bus erst nach laufendem DMA-Frame belegen
+  bool flushed = damageFlush(tft, displaySpiDevice, displayDamage, render, context, &flushStats);
+  unlockDisplay();
+  return flushed;
+}
+
+template <typename Profile>
+const DamageFlushStats& HardwareManagerT<Profile>::getFlushStats() {
+  return flushStats;
+}
+
+template <typename Profile>
+int16_t HardwareManagerT<Profile>::drawText(const char* text, int32_t x, int32_t y, uint8_t font,
+                                            uint16_t fg, uint16_t bg) {
+  lockDisplay();
+  stripRenderer.sync();
+  int16_t width = glyphAtlas.drawString(tft, text, x, y, font, fg, bg);
+  unlockDisplay();
+  return width;
 }
 
-bool HardwareManager::hasBacklightControl() {
-  #ifdef HW_HAS_BACKLIGHT_CONTROL
-    return HW_HAS_BACKLIGHT_CONTROL;
-  #else
+template <typename Profile>
+int16_t HardwareManagerT<Profile>::drawText(const String& text, int32_t x, int32_t y, uint8_t font,
+                                            uint16_t fg, uint16_t bg) {
+  return drawText(text.c_str(), x, y, font, fg, bg);
+}
+
+template <typename Profile>
+uint8_t HardwareManagerT<Profile>::updateLabel(TextLabel& label, const char* text) {
+  lockDisplay();
+  stripRenderer.sync();
+  uint8_t cells = label.update(tft, glyphAtlas, text);
+  unlockDisplay();
+  return cells;
+}
+
+template <typename Profile>
+const GlyphAtlas& HardwareManagerT<Profile>::getGlyphAtlas() {
+  return glyphAtlas;
+}
+
+// Farbreihenfolge (TFT_RGB_ORDER -> MADCTL) und Inversion (colorsInverted
+// -> INVON) gleicht der Treiber aus: das Panel erwartet normales RGB565.
+// Für BGR oder vorinvertiert gepackte Assets rechnet der Decoder um.
+template <typename Profile>
+bool HardwareManagerT<Profile>::drawImage(const uint8_t* asset, int32_t x, int32_t y) {
+  lockDisplay();
+  stripRenderer.sync();
+  bool ok = imageBlitter.draw(tft, asset, x, y, stripRenderer.isDMA());
+  unlockDisplay();
+  return ok;
+}
+
+template <typename Profile>
+const ImageBlitStats& HardwareManagerT<Profile>::getImageStats() {
+  return imageBlitter.stats();
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::fillSpans(int32_t x, int32_t y, int32_t w, int32_t h,
+                                          const SpanPattern& pattern) {
+  lockDisplay();
+  stripRenderer.sync();
+  bool ok = spanFiller.fill(tft, x, y, w, h, pattern, stripRenderer.isDMA());
+  unlockDisplay();
+  return ok;
+}
+
+template <typename Profile>
+const SpanFillStats& HardwareManagerT<Profile>::getSpanStats() {
+  return spanFiller.stats();
+}
+
+template <typename Profile>
+uint32_t HardwareManagerT<Profile>::renderFrame(DamageRenderFn render, void* context) {
+  return renderRows(0, tft.height(), render, context);
+}
+
+template <typename Profile>
+uint32_t HardwareManagerT<Profile>::renderRows(int y, int h, DamageRenderFn render, void* context) {
+  HW_TRACE_SCOPE("renderRows");
+  if (!stripRenderer.ready()) {
+    renderUnbuffered(y, h, render, context);
+    return 0;   // Synchron übertragen: Fence 0 gilt sofort als erreicht
+  }
+  lockDisplay();
+  uint32_t fence = stripRenderer.render(render, context, y, h);
+  unlockDisplay();
+  return fence;
+}
+
+// Ersatzweg ohne Strip-Puffer: Zeilen als Dirty-Rechteck über den
+// Band-Puffer des Damage-Flush (DAMAGE_BAND_ROWS Zeilen, blockierend)
+template <typename Profile>
+bool HardwareManagerT<Profile>::renderUnbuffered(int y, int h, DamageRenderFn render, void* context) {
+  lockDisplay();
+  displayDamage.add(0, y, tft.width(), h);
+  bool flushed = damageFlush(tft, displaySpiDevice, displayDamage, render, context, &flushStats);
+  unlockDisplay();
+  return flushed;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::isFrameComplete(uint32_t fence) {
+  lockDisplay();
+  bool complete = stripRenderer.poll(fence);
+  unlockDisplay();
+  return complete;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::waitFrame(uint32_t fence) {
+  HW_TRACE_SCOPE("waitFrame");
+  lockDisplay();
+  stripRenderer.wait(fence);
+  unlockDisplay();
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::isDisplayDMAActive() {
+  return stripRenderer.isDMA();
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::setDisplayDMA(bool enable) {
+  lockDisplay();
+  stripRenderer.setDMA(enable);
+  unlockDisplay();
+}
+
+template <typename Profile>
+const SpiDevice& HardwareManagerT<Profile>::getDisplaySpiDevice() {
+  return displaySpiDevice;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::loadDisplayClock() {
+  DisplayClockData data;
+  if (!displayClockLoad(&data, profile.id, profile.display.tuneMaxHz)) {
     return false;
-  #endif
+  }
+  
+  applyDisplayClock(data.writeHz, data.readHz);
+  displayClockTuned = true;
+  Serial.printf("Display-Takt aus NVS geladen (Schreiben %.2f MHz, Lesen %.2f MHz)\n",
+                data.writeHz / 1e6f, data.readHz / 1e6f);
+  return true;
 }
 
-bool HardwareManager::isBacklightInverted() {
-  #ifdef HW_BACKLIGHT_INVERTED
-    return HW_BACKLIGHT_INVERTED;
-  #else
+template <typename Profile>
+bool HardwareManagerT<Profile>::tuneDisplayClock(DisplayClockResult* result, bool persist) {
+  if (profile.display.miso < 0) {
+    (void)persist;
+    *result = DisplayClockResult();
+    Serial.println("ERROR: Takt-Tuning braucht HW_DISPLAY_MISO zum Zurücklesen");
     return false;
-  #endif
+  } else {
+    lockDisplay();
+    stripRenderer.sync();  // Kein DMA-Frame mehr auf dem Bus
+    spiArbiter.acquire(displaySpiDevice);
+    bool ok = displayClockTune(tft, profile.display.tuneMaxHz, profile.display.tuneMaxHz, result);
+    spiArbiter.release(displaySpiDevice);
+    if (ok) {
+      applyDisplayClock(result->clock.writeHz, result->clock.readHz);
+    }
+    unlockDisplay();
+    
+    if (!ok) {
+      Serial.println("ERROR: Kein stabiler Display-Takt gefunden - Profil-Werte bleiben aktiv");
+      return false;
+    }
+    if (persist && !displayClockSave(&result->clock, profile.id)) {
+      Serial.println("ERROR: Display-Takt konnte nicht gespeichert werden");
+      return false;
+    }
+    displayClockTuned = true;
+    return true;
+  }
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::clearDisplayClock() {
+  displayClockClear();
+  lockDisplay();
+  applyDisplayClock(profile.display.writeHz, profile.display.readHz);
+  unlockDisplay();
+  displayClockTuned = false;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::hasTunedDisplayClock() {
+  return displayClockTuned;
+}
+
+template <typename Profile>
+uint32_t HardwareManagerT<Profile>::getDisplayWriteHz() {
+  return displayClockWriteHz;
+}
+
+template <typename Profile>
+uint32_t HardwareManagerT<Profile>::getDisplayReadHz() {
+  return displayClockReadHz;
 }
 
-bool HardwareManager::areColorsInverted() {
-  #ifdef HW_COLORS_INVERTED
-    return HW_COLORS_INVERTED;
-  #else
+// ============================================
+// AUTO-ERKENNUNG
+// ============================================
+
+template <typename Profile>
+int HardwareManagerT<Profile>::detectHardware() {
+  HW_TRACE_SCOPE("detectHardware");
+  detectHardwareProfile(&detection);
+  printHardwareDetection(detection);
+  return detection.profile;
+}
+
+template <typename Profile>
+const HardwareDetection& HardwareManagerT<Profile>::getDetection() {
+  return detection;
+}
+
+// TFT_eSPI übernimmt den Takt bei der nächsten Transaktion,
+// das DMA-Gerät nur bei der Registrierung in initDMA()
+template <typename Profile>
+void HardwareManagerT<Profile>::applyDisplayClock(uint32_t writeHz, uint32_t readHz) {
+  displayClockWriteHz = writeHz;
+  displayClockReadHz = readHz;
+  if (stripRenderer.isDMAAvailable()) {
+    stripRenderer.sync();
+    tft.deInitDMA();
+    tft.initDMA();
+  }
+}
+
+template <typename Profile>
+const StripRendererStats& HardwareManagerT<Profile>::getStripStats() {
+  return stripRenderer.stats();
+}
+
+template <typename Profile>
+int HardwareManagerT<Profile>::getStripRows() {
+  return stripRenderer.rows();
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::isTouchPressed() {
+  if (!touchReady) return false;
+  
+  if (touchOnI2c()) {
+    pollTouchI2c();
+    return touchI2c.count() > 0;
+  }
+  
+  // IRQ-Modus: Zustand aus dem Sampling-Task, kein SPI-Zugriff
+  if (touchSamplerActive()) {
+    return touchSamplerPenDown();
+  }
+  if (!touch.tirqTouched()) {
     return false;
-  #endif
+  }
+  
+  // touched() liest per SPI, getPoint() nutzt danach den Cache der Bibliothek
+  spiArbiter.acquire(touchSpiDevice);
+  bool pressed = touch.touched() && touch.getPoint().z >= profile.touch.threshold;
+  spiArbiter.release(touchSpiDevice);
+  return pressed;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::getTouchPoint(int* x, int* y) {
+  int rawX, rawY;
+  if (!readRawTouch(&rawX, &rawY)) {
+    *x = -1;
+    *y = -1;
+    return;
+  }
+
+  // Rohwerte über die gecachte Festkomma-Matrix umrechnen (inkl. Clamp)
+  activeTouchTransform().apply(rawX, rawY, x, y);
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::startTouchSampling(uint16_t rateHz) {
+  // Kapazitiv: die INT-Flanke weckt touchI2c ohne eigenen Task
+  if (!touchReady || touchOnI2c()) return false;
+  const TouchSamplerConfig config = { &touch, &touchBus(), &touchSpiDevice, profile.touch.irq,
+                                      hwTouchFilterConfig(profile.touch) };
+  return touchSamplerStart(config, rateHz);
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::stopTouchSampling() {
+  touchSamplerStop();
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::isTouchSamplingActive() {
+  return touchSamplerActive();
+}
+
+template <typename Profile>
+size_t HardwareManagerT<Profile>::readTouchSamples(TouchSample* samples, size_t maxSamples) {
+  return touchSamplerRead(samples, maxSamples);
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::mapTouchSample(const TouchSample& sample, int* x, int* y) {
+  activeTouchTransform().apply(sample.rawX, sample.rawY, x, y);
 }
 
-bool HardwareManager::hasPWMBacklight() {
-  #ifdef HW_BACKLIGHT_PWM_CHANNEL
+template <typename Profile>
+const TouchI2cStats& HardwareManagerT<Profile>::getTouchI2cStats() {
+  return touchI2c.stats();
+}
+
+// Nur der IO-Task (ohne Task-Split loop()) liest den Bus, andere Tasks
+// sehen den letzten Bericht
+template <typename Profile>
+void HardwareManagerT<Profile>::pollTouchI2c() {
+  if (touchReady && (!ioTask || onIoTask())) {
+    touchI2c.update();
+  }
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::processTouch() {
+  // Dual-Core: der IO-Task verarbeitet die Samples selbst
+  if (ioTask && !onIoTask()) {
+    return;
+  }
+  
+  if (touchSamplerActive()) {
+    // IRQ-Modus: alle gepufferten Samples mit ihren Zeitstempeln einspeisen
+    const TouchTransform transform = activeTouchTransform();
+    TouchSample samples[16];
+    size_t count;
+    while ((count = touchSamplerRead(samples, 16)) > 0) {
+      const uint32_t now = micros();
+      for (size_t i = 0; i < count; i++) {
+        if (swallowWakeTouch(samples[i].z != 0)) continue;
+        int x = 0, y = 0;
+        if (samples[i].z) {
+          transform.apply(samples[i].rawX, samples[i].rawY, &x, &y);
+        }
+        touchGestures.feed(samples[i].timestampUs, x, y, samples[i].z != 0);
+        
+        // Alter des Samples bei der Verarbeitung
+        const uint32_t age = now - samples[i].timestampUs;
+        portENTER_CRITICAL(&touchStateMux);
+        touchLatency.samples++;
+        touchLatency.totalUs += age;
+        if (age > touchLatency.maxUs) touchLatency.maxUs = age;
+        portEXIT_CRITICAL(&touchStateMux);
+      }
+    }
+    touchGestures.tick(micros());
+    return;
+  }
+  
+  // Polling-Modus: ein Sample pro Aufruf
+  int x, y;
+  getTouchPoint(&x, &y);
+  if (swallowWakeTouch(x >= 0)) return;
+  touchGestures.feed(micros(), x, y, x >= 0);
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::getTouchEvent(TouchEvent* event) {
+  return touchGestures.poll(event);
+}
+
+template <typename Profile>
+TouchLatencyStats HardwareManagerT<Profile>::getTouchLatency(bool reset) {
+  portENTER_CRITICAL(&touchStateMux);
+  TouchLatencyStats stats = touchLatency;
+  if (reset) touchLatency = TouchLatencyStats();
+  portEXIT_CRITICAL(&touchStateMux);
+  return stats;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::readRawTouch(int* rawX, int* rawY) {
+  if (!touchReady) return false;
+  
+  if (touchOnI2c()) {
+    // Erster Finger; der Controller filtert selbst, Werte in Panel-Pixeln
+    pollTouchI2c();
+    TouchI2cPoint point;
+    if (!touchI2c.primary(&point)) {
+      return false;
+    }
+    *rawX = point.x;
+    *rawY = point.y;
     return true;
-  #else
+  }
+  
+  if (touchSamplerActive()) {
+    // Letzter Wert aus dem Sampling-Task
+    TouchSample sample;
+    if (!touchSamplerLatest(&sample)) {
+      return false;
+    }
+    *rawX = sample.rawX;
+    *rawY = sample.rawY;
+    return true;
+  }
+  
+  if (!touch.tirqTouched()) {
+    touchFilter.reset();
+    return false;
+  }
+  
+  spiArbiter.acquire(touchSpiDevice);
+  bool touched = touch.touched();
+  TS_Point p = touch.getPoint();
+  spiArbiter.release(touchSpiDevice);
+  
+  if (!touched) {
+    touchFilter.reset();
+    return false;
+  }
+  
+  // Druck-Gate, Median, IIR und Dead-Band
+  int16_t fx, fy;
+  if (!touchFilter.process(p.x, p.y, p.z, &fx, &fy)) {
     return false;
-  #endif
+  }
+  *rawX = fx;
+  *rawY = fy;
+  return true;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::loadTouchCalibration() {
+  TouchCalibrationData data;
+  if (!touchCalibrationLoad(&data)) {
+    return false;
+  }
+  
+  touchCalibration = data;
+  touchCalibrated = true;
+  updateTouchTransform();
+  Serial.printf("Touch-Kalibrierung aus NVS geladen (%d Punkte, Rotation %d)\n",
+                data.points, data.rotation);
+  return true;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::applyTouchCalibration(TouchCalibrationData* data, bool persist) {
+  if (persist && !touchCalibrationSave(data)) {
+    Serial.println("ERROR: Touch-Kalibrierung konnte nicht gespeichert werden");
+    return false;
+  }
+  
+  touchCalibration = *data;
+  touchCalibrated = true;
+  updateTouchTransform();
+  return true;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::clearTouchCalibration() {
+  touchCalibrationClear();
+  touchCalibrated = false;
+  updateTouchTransform();
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::hasTouchCalibration() {
+  return touchCalibrated;
+}
+
+template <typename Profile>
+int HardwareManagerT<Profile>::getTouchCount() {
+  if (touchOnI2c()) {
+    pollTouchI2c();
+    return touchI2c.count();
+  }
+  return isTouchPressed() ? 1 : 0;
 }
 
-void HardwareManager::printHardwareInfo() {
+template <typename Profile>
+void HardwareManagerT<Profile>::getTouchPoints(int points[][2], int maxPoints) {
+  // Alle Punkte als ungültig markieren
+  for (int i = 0; i < maxPoints; i++) {
+    points[i][0] = -1;
+    points[i][1] = -1;
+  }
+  
+  if (touchOnI2c()) {
+    // Ein Burst-Read für alle Finger; Index = Slot, bleibt bis zum Abheben
+    pollTouchI2c();
+    TouchI2cPoint contacts[TOUCH_I2C_MAX_POINTS];
+    const uint8_t count = touchI2c.points(contacts, TOUCH_I2C_MAX_POINTS);
+    const TouchTransform transform = activeTouchTransform();
+    for (uint8_t i = 0; i < count; i++) {
+      const uint8_t slot = contacts[i].slot;
+      if (slot < maxPoints) {
+        transform.apply(contacts[i].x, contacts[i].y, &points[slot][0], &points[slot][1]);
+      }
+    }
+  } else if (maxPoints > 0 && isTouchPressed()) {
+    // Single-Touch (XPT2046)
+    getTouchPoint(&points[0][0], &points[0][1]);
+  }
+}
+
+template <typename Profile>
+const HardwareProfile& HardwareManagerT<Profile>::getProfile() {
+  return profile;
+}
+
+template <typename Profile>
+const HardwareProfile* HardwareManagerT<Profile>::getDetectedProfile() {
+  return detection.profileName ? hardwareProfileById(detection.profile) : nullptr;
+}
+
+template <typename Profile>
+String HardwareManagerT<Profile>::getProfileName() {
+  return String(profile.name);
+}
+
+template <typename Profile>
+String HardwareManagerT<Profile>::getDisplayController() {
+  return String(profile.display.controllerName);
+}
+
+template <typename Profile>
+String HardwareManagerT<Profile>::getTouchController() {
+  return String(profile.touch.controllerName);
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::hasMultiTouch() {
+  return profile.touch.points > 1;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::hasBacklightControl() {
+  return profile.has(HW_FEATURE_BACKLIGHT_CONTROL);
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::isBacklightInverted() {
+  return profile.backlight.inverted;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::areColorsInverted() {
+  return profile.display.colorsInverted;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::hasPWMBacklight() {
+  return profile.backlight.pin >= 0 && profile.backlight.pwm;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::printHardwareInfo() {
   Serial.println("\n=== HARDWARE INFORMATION ===");
-  Serial.printf("Profile: %s\n", HW_PROFILE_NAME);
-  Serial.printf("Display: %s (%dx%d)\n", HW_DISPLAY_CONTROLLER_STR, HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT);
-  Serial.printf("Touch: %s (%s, %d points)\n", HW_TOUCH_CONTROLLER_STR, 
-                (HW_TOUCH_SPI_BUS == VSPI) ? "VSPI" : "HSPI", getTouchCount());
-  
-  #ifdef HW_BACKLIGHT_PIN
-    Serial.printf("Backlight: Pin %d (%s, %s)\n", HW_BACKLIGHT_PIN,
-                  HW_BACKLIGHT_INVERTED ? "inverted" : "normal",
+  Serial.printf("Profile: %s\n", profile.name);
+  Serial.printf("Display: %s (%dx%d)\n", profile.display.controllerName,
+                profile.display.width, profile.display.height);
+  Serial.printf("Touch: %s (%s, %d points)\n", profile.touch.controllerName, 
+                touchOnI2c() ? "I2C" : (profile.touch.bus == VSPI) ? "VSPI" : "HSPI", profile.touch.points);
+  
+  if (profile.backlight.pin >= 0) {
+    Serial.printf("Backlight: Pin %d (%s, %s)\n", profile.backlight.pin,
+                  profile.backlight.inverted ? "inverted" : "normal",
                   hasPWMBacklight() ? "PWM" : "digital");
-  #endif
+  }
+  
+  Serial.printf("Touch-Mapping: %s\n", touchCalibrated ? "NVS-Kalibrierung" : "Profil-Konstanten");
+  Serial.printf("Display-Takt: %.2f MHz schreiben, %.2f MHz lesen (%s)\n",
+                displayClockWriteHz / 1e6f, displayClockReadHz / 1e6f,
+                displayClockTuned ? "NVS-Tuning" : "Profil");
+  if (detection.profileName) {
+    Serial.printf("Auto-Erkennung: %s (%s / %s, %.2f ms)\n", detection.profileName,
+                  detectDisplayName(detection.display), detectTouchName(detection.touch),
+                  detection.totalUs / 1000.0f);
+  }
+  Serial.printf("Display-Pipeline: %s, 2 x %d Zeilen\n",
+                stripRenderer.isDMA() ? "DMA Ping-Pong" : "blockierend", stripRenderer.rows());
+  Serial.printf("SPI: Display %s, Touch %s%s\n",
+                (profile.display.bus == VSPI) ? "VSPI" : "HSPI",
+                (profile.touch.bus == VSPI) ? "VSPI" : "HSPI",
+                profile.touchSharesBus() ? " (arbitriert)" : "");
   
   Serial.printf("Features: ");
   if (hasMultiTouch()) Serial.print("MultiTouch ");
@@ -336,21 +1112,29 @@ void HardwareManager::printHardwareInfo() {
   Serial.println("============================\n");
 }
 
-bool HardwareManager::validateHardware() {
+template <typename Profile>
+bool HardwareManagerT<Profile>::validateHardware() {
+  HW_TRACE_SCOPE("validateHardware");
   bool valid = true;
   
-  // Display-Validation
-  if (tft.width() != HW_DISPLAY_WIDTH || tft.height() != HW_DISPLAY_HEIGHT) {
+  // Display-Validation (Profilmaße gelten für Rotation 0)
+  const bool landscape = tft.getRotation() & 1;
+  const int expectedW = landscape ? profile.display.height : profile.display.width;
+  const int expectedH = landscape ? profile.display.width : profile.display.height;
+  if (tft.width() != expectedW || tft.height() != expectedH) {
     Serial.printf("ERROR: Display size mismatch. Expected: %dx%d, Got: %dx%d\n",
-                  HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT, tft.width(), tft.height());
+                  expectedW, expectedH, tft.width(), tft.height());
     valid = false;
   }
   
-  // Touch-Validation
-  if (!touch.begin(touchSPI)) {
+  // Touch-Validation: Ergebnis der Boot-Stufe, kein zweites touch.begin()
+  if (profile.has(HW_FEATURE_TOUCH) && !touchReady) {
     Serial.println("ERROR: Touch controller not responding");
     valid = false;
   }
   
   return valid;
-}
\ No newline at end of file
+}
+
+// Members aus hardware_tasks.cpp werden dort instanziert
+template class HardwareManagerT<HardwareManagerProfile>;
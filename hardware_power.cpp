@@ -0,0 +1,260 @@
+/**
+ * hardware_power.cpp - Energiesparstufen des Hardware Managers
+ *
+ * Dimmen, Display aus (Backlight 0 + SLPIN), Light-Sleep mit Wecken
+ * über HW_TOUCH_IRQ oder UART (siehe power_manager.h).
+ */
+
+#include "config.h"
+#include "TFT_Setup.h"  // VOR TFT_eSPI!
+#include <TFT_eSPI.h>
+#include "hardware_hal.h"
+#include "hw_trace.h"
+#include <XPT2046_Touchscreen.h>
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#include <driver/uart.h>
+
+extern TFT_eSPI tft;
+
+// Schützt die Statistik zwischen IO-Task und Anwendung
+static portMUX_TYPE powerMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ============================================
+// AKTIVITÄT
+// ============================================
+
+template <typename Profile>
+void HardwareManagerT<Profile>::notifyActivity() {
+  lastActivityMs = millis();
+}
+
+// Berührung, die das Display weckt, bis zum Abheben verwerfen
+template <typename Profile>
+bool HardwareManagerT<Profile>::swallowWakeTouch(bool pressed) {
+  if (pressed) {
+    notifyActivity();
+    if (powerState >= POWER_DISPLAY_OFF) powerSwallowTouch = true;
+  }
+  if (!powerSwallowTouch) return false;
+  if (!pressed) powerSwallowTouch = false;
+  return true;
+}
+
+// ============================================
+// ZUSTANDSWECHSEL
+// ============================================
+
+template <typename Profile>
+PowerState HardwareManagerT<Profile>::updatePower() {
+  // Dual-Core: Backlight und Touch gehören dem IO-Task
+  if (!bootComplete || (ioTask && !onIoTask())) return powerState;
+
+  // Auch ohne processTouch() der Anwendung: Berührung weckt
+  if (powerState != POWER_ACTIVE && isTouchPressed()) {
+    swallowWakeTouch(true);
+  }
+
+  const uint32_t idleMs = millis() - lastActivityMs;
+  const PowerState target = powerStateForIdle(powerConfig, idleMs, profile.touch.irq >= 0 && touchReady);
+  if (target < powerState) {
+    wakePower(micros());
+  } else if (target > powerState) {
+    enterPowerState(target);
+  }
+  return powerState;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::setPowerState(PowerState state) {
+  portENTER_CRITICAL(&powerMux);
+  accountPowerState();
+  const PowerState previous = powerState;
+  powerState = state;
+  portEXIT_CRITICAL(&powerMux);
+
+  HW_TRACE_INSTANT(powerStateName(state));
+  Serial.printf("💤 Energie: %s -> %s\n", powerStateName(previous), powerStateName(state));
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::accountPowerState() {
+  const uint32_t now = millis();
+  powerStats.stateMs[powerState] += now - powerStateSinceMs;
+  powerStateSinceMs = now;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::enterPowerState(PowerState target) {
+  HW_TRACE_SCOPE("enterPowerState");
+  if (powerState == POWER_ACTIVE) {
+    powerRestorePercent = backlightPercent;
+  }
+
+  if (target == POWER_DIM) {
+    applyBrightness(min((int)powerConfig.dimPercent, powerRestorePercent), POWER_DIM_FADE_MS);
+    setPowerState(POWER_DIM);
+    return;
+  }
+
+  if (powerState < POWER_DISPLAY_OFF) {
+    // Backlight aus, laufende Übertragung abschließen, Panel schlafen legen.
+    // Der Panel-Speicher bleibt erhalten.
+    applyBrightness(0);
+    lockDisplay();
+    stripRenderer.sync();
+    tft.writecommand(TFT_SLPIN);
+    unlockDisplay();
+    powerSleepInMs = millis();
+    setPowerState(POWER_DISPLAY_OFF);
+  }
+
+  if (target == POWER_LIGHT_SLEEP) {
+    setPowerState(POWER_LIGHT_SLEEP);
+    wakePower(lightSleep());
+  }
+}
+
+// Kehrt nach dem Wecken zurück, Ergebnis: micros() beim Aufwachen
+template <typename Profile>
+uint32_t HardwareManagerT<Profile>::lightSleep() {
+  HW_TRACE_SCOPE("lightSleep");
+  const gpio_num_t irq = (gpio_num_t)profile.touch.irq;
+  Serial.flush();  // UART-Ausgabe vor dem Anhalten des Takts
+
+  // Touch-ISR (Bibliothek oder Sampler) ruhen lassen, Wecken per Pegel
+  gpio_intr_disable(irq);
+  gpio_wakeup_enable(irq, GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+  uart_set_wakeup_threshold(UART_NUM_0, POWER_UART_WAKE_EDGES);
+  esp_sleep_enable_uart_wakeup(UART_NUM_0);
+
+  esp_light_sleep_start();
+  const uint32_t wakeUs = micros();
+  const esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_UART);
+  gpio_wakeup_disable(irq);
+  gpio_set_intr_type(irq, GPIO_INTR_NEGEDGE);  // FALLING wie attachInterrupt()
+  gpio_intr_enable(irq);
+
+  // Der Finger liegt noch auf: nicht als Eingabe auswerten
+  if (cause == ESP_SLEEP_WAKEUP_GPIO) powerSwallowTouch = true;
+  notifyActivity();
+
+  portENTER_CRITICAL(&powerMux);
+  powerStats.lightSleeps++;
+  portEXIT_CRITICAL(&powerMux);
+  Serial.printf("⏰ Geweckt durch %s\n", cause == ESP_SLEEP_WAKEUP_GPIO ? "Touch-IRQ" :
+                                         cause == ESP_SLEEP_WAKEUP_UART ? "UART" : "?");
+  return wakeUs;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::wakePower(uint32_t detectUs) {
+  HW_TRACE_SCOPE("wakePower");
+  if (powerState >= POWER_DISPLAY_OFF) {
+    // Panel braucht 120 ms zwischen SLPIN und SLPOUT
+    const uint32_t sinceSleepMs = millis() - powerSleepInMs;
+    if (sinceSleepMs < POWER_SLEEP_GUARD_MS) {
+      delay(POWER_SLEEP_GUARD_MS - sinceSleepMs);
+    }
+    lockDisplay();
+    tft.writecommand(TFT_SLPOUT);
+    unlockDisplay();
+    delay(POWER_SLPOUT_DELAY_MS);
+  }
+
+  // Letzter Frame steht noch im Panel-Speicher: nur Backlight zurück
+  applyBrightness(powerRestorePercent, POWER_WAKE_FADE_MS);
+  const uint32_t wakeUs = micros() - detectUs;
+
+  portENTER_CRITICAL(&powerMux);
+  powerStats.wakeups++;
+  powerStats.lastWakeUs = wakeUs;
+  if (wakeUs > powerStats.maxWakeUs) powerStats.maxWakeUs = wakeUs;
+  portEXIT_CRITICAL(&powerMux);
+
+  setPowerState(POWER_ACTIVE);
+  if (renderTask) xTaskNotifyGive(renderTask);
+
+  const uint32_t visibleUs = wakeUs + POWER_WAKE_FADE_MS * 1000;
+  Serial.printf("☀️ Aufgewacht in %.1f ms (+%d ms Fade) %s\n", wakeUs / 1000.0f, POWER_WAKE_FADE_MS,
+                visibleUs <= POWER_WAKE_BUDGET_US ? "✅" : "⚠️ über Budget");
+}
+
+// ============================================
+// KONFIGURATION & STATISTIK
+// ============================================
+
+template <typename Profile>
+void HardwareManagerT<Profile>::setPowerConfig(const PowerConfig& config) {
+  powerConfig = config;
+}
+
+template <typename Profile>
+const PowerConfig& HardwareManagerT<Profile>::getPowerConfig() {
+  return powerConfig;
+}
+
+template <typename Profile>
+PowerState HardwareManagerT<Profile>::getPowerState() {
+  return powerState;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::isDisplayAwake() {
+  return powerState < POWER_DISPLAY_OFF;
+}
+
+template <typename Profile>
+PowerStats HardwareManagerT<Profile>::getPowerStats(bool reset) {
+  portENTER_CRITICAL(&powerMux);
+  accountPowerState();
+  PowerStats stats = powerStats;
+  if (reset) powerStats = PowerStats();
+  portEXIT_CRITICAL(&powerMux);
+  return stats;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::printPowerStats() {
+  const PowerStats stats = getPowerStats();
+  uint64_t totalMs = 0;
+  for (uint8_t state = 0; state < POWER_STATE_COUNT; state++) {
+    totalMs += stats.stateMs[state];
+  }
+
+  Serial.printf("⚡ Energie: %s | Dimmen %lu s, aus %lu s, Light-Sleep %lu s (0 = aus) | %d %%\n",
+                powerStateName(powerState), (unsigned long)(powerConfig.dimMs / 1000),
+                (unsigned long)(powerConfig.offMs / 1000), (unsigned long)(powerConfig.sleepMs / 1000),
+                powerConfig.dimPercent);
+  if (profile.touch.irq < 0) {
+    Serial.println("   Light-Sleep nicht verfügbar (kein HW_TOUCH_IRQ)");
+  }
+  for (uint8_t state = 0; state < POWER_STATE_COUNT; state++) {
+    Serial.printf("   %-12s %10.1f s  %5.1f%%\n", powerStateName(state), stats.stateMs[state] / 1000.0,
+                  totalMs ? 100.0 * stats.stateMs[state] / totalMs : 0.0);
+  }
+  Serial.printf("   Aufgewacht: %lu mal (%lu aus Light-Sleep) | zuletzt %.1f ms, max %.1f ms + %d ms Fade\n",
+                (unsigned long)stats.wakeups, (unsigned long)stats.lightSleeps,
+                stats.lastWakeUs / 1000.0f, stats.maxWakeUs / 1000.0f, POWER_WAKE_FADE_MS);
+}
+
+// Explizite Instanzierung der hier definierten Members
+// (die Klasse selbst instanziert hardware_manager.cpp)
+template void HardwareManagerT<HardwareManagerProfile>::notifyActivity();
+template bool HardwareManagerT<HardwareManagerProfile>::swallowWakeTouch(bool);
+template PowerState HardwareManagerT<HardwareManagerProfile>::updatePower();
+template void HardwareManagerT<HardwareManagerProfile>::setPowerState(PowerState);
+template void HardwareManagerT<HardwareManagerProfile>::accountPowerState();
+template void HardwareManagerT<HardwareManagerProfile>::enterPowerState(PowerState);
+template uint32_t HardwareManagerT<HardwareManagerProfile>::lightSleep();
+template void HardwareManagerT<HardwareManagerProfile>::wakePower(uint32_t);
+template void HardwareManagerT<HardwareManagerProfile>::setPowerConfig(const PowerConfig&);
+template const PowerConfig& HardwareManagerT<HardwareManagerProfile>::getPowerConfig();
+template PowerState HardwareManagerT<HardwareManagerProfile>::getPowerState();
+template bool HardwareManagerT<HardwareManagerProfile>::isDisplayAwake();
+template PowerStats HardwareManagerT<HardwareManagerProfile>::getPowerStats(bool);
+template void HardwareManagerT<HardwareManagerProfile>::printPowerStats();
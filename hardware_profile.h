@@ -0,0 +1,306 @@
+/**
+ * hardware_profile.h - Hardware-Profil als constexpr Datenstruktur
+ *
+ * Die Profil-Header im Ordner hardware_profiles bleiben die Quelle der
+ * Werte, weil TFT_eSPI und die #if-Prüfungen Makros brauchen.
+ * HW_DEFINE_PROFILE() fasst sie zu einem Typ mit einem constexpr
+ * HardwareProfile zusammen (Pins, Geometrie, Kalibrierung, Touch-Matrizen,
+ * Filter, Busse, Takt-Grenzen, Features, Init-Sequenz) und prüft ihn per
+ * static_assert:
+ *
+ *   HW_DEFINE_PROFILE(ActiveHardwareProfile);    // hardware_hal.h
+ *   HardwareManagerT<ActiveHardwareProfile>      // alle Werte constexpr
+ *
+ * hardware_profiles.cpp baut so eine Tabelle aller Profile für die
+ * Auswahl zur Laufzeit (Auto-Erkennung, hardwareProfileById(),
+ * RuntimeHardwareProfile in hardware_hal.h).
+ */
+
+#ifndef HARDWARE_PROFILE_H
+#define HARDWARE_PROFILE_H
+
+#include <Arduino.h>
+#include "backlight_gamma.h"  // BACKLIGHT_LEDC_CLOCK_HZ
+#include "touch_transform.h"  // TouchTransform, TouchReferenceMap
+
+// ============================================
+// PROFIL- UND CONTROLLER-IDS
+// ============================================
+
+// Verfügbare Hardware-Profile
+#define ESP32_TZT_24      1    // TZT 2,4" ST7789 (original)
+#define ESP32_2432S028R   2    // 2,8" ILI9341
+#define ESP32_GENERIC     99   // Generic Fallback
+
+// HW_DISPLAY_CONTROLLER (Werte wie DetectedDisplay, hardware_auto_detect.h)
+#define HW_DISPLAY_CTRL_ST7789    1
+#define HW_DISPLAY_CTRL_ILI9341   2
+#define HW_DISPLAY_CTRL_ILI9488   3
+
+// HW_TOUCH_CONTROLLER
+#define HW_TOUCH_CTRL_XPT2046     1
+#define HW_TOUCH_CTRL_GT911       2
+#define HW_TOUCH_CTRL_FT6236      3
+#define HW_TOUCH_CTRL_CST816S     4
+
+// Feature-Bits (HW_HAS_*)
+#define HW_FEATURE_BACKLIGHT_CONTROL  0x0001
+#define HW_FEATURE_RGB_LED            0x0002
+#define HW_FEATURE_RS485              0x0004
+#define HW_FEATURE_TOUCH              0x0008
+#define HW_FEATURE_MULTITOUCH         0x0010
+#define HW_FEATURE_AUTO_DETECT        0x0020   // Kandidat der Auto-Erkennung
+
+#define HW_INIT_MAX_COMMANDS  4
+#define HW_INIT_MAX_DATA      4
+
+// ============================================
+// DATENSTRUKTUREN
+// ============================================
+
+struct HwDisplayConfig {
+  uint8_t controller;              // HW_DISPLAY_CTRL_*
+  const char* controllerName;
+  uint16_t width, height;          // Rotation 0
+  uint8_t rotation;                // Standard-Rotation
+  bool colorsInverted;
+  uint8_t bus;                     // HSPI / VSPI
+  int8_t miso, mosi, sclk, cs, dc, rst;
+  int8_t te;                       // Tearing-Effect Ausgang, -1 = keiner
+  uint32_t writeHz, readHz;        // Profil-Takte (Tuning: display_clock.h)
+  uint32_t tuneMaxHz;              // Obergrenze des Takt-Tunings
+  bool dma;
+  uint8_t stripRows, stripRamShare;
+};
+
+struct HwTouchConfig {
+  uint8_t controller;              // HW_TOUCH_CTRL_*
+  const char* controllerName;
+  uint8_t bus;
+  uint8_t points;                  // Max. gleichzeitige Berührungen
+  int8_t mosi, miso, clk, cs, irq;
+  uint32_t spiHz;
+  int8_t sda, scl, rst;            // Kapazitive Controller (I2C), -1 = keiner
+  uint8_t i2cAddress;              // 0 = Standard des Controllers
+  uint32_t i2cHz;
+  uint16_t minX, maxX, minY, maxY; // Rohwert-Bereich (Profil-Kalibrierung)
+  uint16_t threshold;              // Druckschwelle
+  bool invertX, invertY;
+  bool calibrated;
+  uint16_t sampleRate;             // Hz im IRQ-Modus
+  uint8_t filterMedian, filterIirShift, filterDeadband;   // touch_filter.h
+  TouchReferenceMap referenceMap;  // HW_TOUCH_MAP_* als Funktion (Benchmark, Tests)
+  void (*initCode)();              // HW_TOUCH_INIT_CODE nach touch.begin()
+  TouchTransform transforms[4];    // Matrix pro Rotation, aus referenceMap abgeleitet
+};
+
+struct HwBacklightConfig {
+  int8_t pin;                      // -1 = kein Backlight
+  bool inverted;
+  bool pwm;                        // false = nur Ein/Aus
+  uint32_t pwmFreq;
+  uint8_t pwmResolution;
+  uint8_t defaultPercent;
+};
+
+// Kommando + Parameter, nach tft.init() gesendet (ersetzt HW_INIT_CODE)
+struct HwInitCommand {
+  uint8_t command;
+  uint8_t length;
+  uint8_t data[HW_INIT_MAX_DATA];
+};
+
+struct HwInitSequence {
+  uint8_t count;
+  HwInitCommand commands[HW_INIT_MAX_COMMANDS];
+};
+
+struct HardwareProfile {
+  int id;                          // ESP32_TZT_24, ...
+  const char* name;
+  HwDisplayConfig display;
+  HwTouchConfig touch;
+  HwBacklightConfig backlight;
+  uint16_t features;               // HW_FEATURE_*
+  HwInitSequence init;
+
+  constexpr bool has(uint16_t feature) const { return (features & feature) != 0; }
+
+  // Vorberechnete Touch-Matrix für die Rotation (ohne NVS-Kalibrierung)
+  constexpr const TouchTransform& touchTransform(uint8_t rotation) const {
+    return touch.transforms[rotation & 3];
+  }
+
+  // Teilen sich Touch und Display einen SPI-Host (arbitriert, spi_arbiter.h)?
+  constexpr bool touchSharesBus() const {
+    return touch.controller == HW_TOUCH_CTRL_XPT2046 && touch.bus == display.bus;
+  }
+};
+
+// ============================================
+// VALIDIERUNG (static_assert in HW_DEFINE_PROFILE)
+// ============================================
+
+constexpr bool hwDisplayValid(const HardwareProfile& p) {
+  return p.display.width > 0 && p.display.height > 0 && p.display.rotation < 4 &&
+         p.display.writeHz > 0 && p.display.readHz > 0 &&
+         p.display.tuneMaxHz >= p.display.writeHz &&
+         p.display.stripRows > 0 && p.display.stripRamShare > 0 &&
+         p.display.sclk >= 0 && p.display.mosi >= 0 && p.display.dc >= 0;
+}
+
+// Gleichzeitige Punkte, die der Controller meldet
+constexpr uint8_t hwTouchMaxPoints(uint8_t controller) {
+  return controller == HW_TOUCH_CTRL_GT911 ? 5 : controller == HW_TOUCH_CTRL_FT6236 ? 2 : 1;
+}
+
+constexpr bool hwTouchValid(const HardwareProfile& p) {
+  return p.touch.minX < p.touch.maxX && p.touch.minY < p.touch.maxY &&
+         p.touch.maxX <= 4095 && p.touch.maxY <= 4095 &&
+         p.touch.points >= 1 && p.touch.points <= hwTouchMaxPoints(p.touch.controller) &&
+         p.touch.sampleRate > 0 &&
+         (p.touch.controller == HW_TOUCH_CTRL_XPT2046
+            ? p.touch.spiHz > 0
+            : p.touch.sda >= 0 && p.touch.scl >= 0 && p.touch.i2cHz > 0);
+}
+
+// Teilt sich Touch den Host, müssen die Leitungen übereinstimmen
+// (kapazitive Controller hängen am I2C-Bus)
+constexpr bool hwBusValid(const HardwareProfile& p) {
+  return p.touch.controller != HW_TOUCH_CTRL_XPT2046 || p.touch.bus != p.display.bus ||
+         (p.touch.clk == p.display.sclk && p.touch.mosi == p.display.mosi &&
+          p.touch.miso == p.display.miso && p.touch.cs != p.display.cs);
+}
+
+constexpr bool hwBacklightValid(const HardwareProfile& p) {
+  return p.backlight.pin < 0 ||
+         (p.backlight.defaultPercent <= 100 &&
+          (!p.backlight.pwm || (p.backlight.pwmResolution >= 1 && p.backlight.pwmResolution <= 16 &&
+                                p.backlight.pwmFreq > 0 &&
+                                ((uint64_t)p.backlight.pwmFreq << p.backlight.pwmResolution) <=
+                                  BACKLIGHT_LEDC_CLOCK_HZ)));
+}
+
+constexpr bool hwInitValid(const HardwareProfile& p) {
+  if (p.init.count > HW_INIT_MAX_COMMANDS) return false;
+  for (uint8_t i = 0; i < p.init.count; i++) {
+    if (p.init.commands[i].length > HW_INIT_MAX_DATA) return false;
+  }
+  return true;
+}
+
+// Treiber-IC, Pins und Geometrie legt TFT_eSPI beim Kompilieren fest
+// (TFT_Setup.h): ein Profil aus der Tabelle ist zur Laufzeit nur wählbar,
+// wenn es dasselbe Display am selben Host beschreibt.
+constexpr bool hwDisplayCompatible(const HardwareProfile& a, const HardwareProfile& b) {
+  return a.display.controller == b.display.controller && a.display.bus == b.display.bus &&
+         a.display.width == b.display.width && a.display.height == b.display.height &&
+         a.display.miso == b.display.miso && a.display.mosi == b.display.mosi &&
+         a.display.sclk == b.display.sclk && a.display.cs == b.display.cs &&
+         a.display.dc == b.display.dc && a.display.rst == b.display.rst;
+}
+
+// ============================================
+// PROFIL AUS DEN HW_* MAKROS
+// ============================================
+
+// Touch-Code des Profils als Typ: Referenz-Mapping (HW_TOUCH_MAP_*,
+// HW_TOUCH_INVERT_*_ROTn) für TouchTransformDetail::derive() und
+// HW_TOUCH_INIT_CODE. map() ist die constexpr-Variante aus touch_transform.h.
+#define HW_DEFINE_TOUCH_CODE(Name)                                                       \
+  struct Name {                                                                          \
+    static constexpr long minX = HW_TOUCH_MIN_X, maxX = HW_TOUCH_MAX_X;                  \
+    static constexpr long minY = HW_TOUCH_MIN_Y, maxY = HW_TOUCH_MAX_Y;                  \
+    /* Bildschirmgröße pro Rotation (entspricht tft.width()/tft.height()) */             \
+    static constexpr long screenWidth(uint8_t rotation) {                                \
+      return (rotation & 1) ? HW_DISPLAY_HEIGHT : HW_DISPLAY_WIDTH;                      \
+    }                                                                                    \
+    static constexpr long screenHeight(uint8_t rotation) {                               \
+      return (rotation & 1) ? HW_DISPLAY_WIDTH : HW_DISPLAY_HEIGHT;                      \
+    }                                                                                    \
+    static constexpr void apply(uint8_t rotation, long rawX, long rawY, long& tx, long& ty) { \
+      using TouchTransformDetail::map;                                                   \
+      const long w = screenWidth(rotation);                                              \
+      const long h = screenHeight(rotation);                                             \
+      tx = 0;                                                                            \
+      ty = 0;                                                                            \
+      switch (rotation & 3) {                                                            \
+        case 0:                                                                          \
+          HW_TOUCH_MAP_PORTRAIT(rawX, rawY, tx, ty);                                     \
+          if (HW_TOUCH_INVERT_X_ROT0) tx = w - tx;                                       \
+          if (HW_TOUCH_INVERT_Y_ROT0) ty = h - ty;                                       \
+          break;                                                                         \
+        case 1:                                                                          \
+          HW_TOUCH_MAP_LANDSCAPE(rawX, rawY, tx, ty);                                    \
+          if (HW_TOUCH_INVERT_X_ROT1) tx = w - tx;                                       \
+          if (HW_TOUCH_INVERT_Y_ROT1) ty = h - ty;                                       \
+          break;                                                                         \
+        case 2:                                                                          \
+          HW_TOUCH_MAP_PORTRAIT_INV(rawX, rawY, tx, ty);                                 \
+          if (HW_TOUCH_INVERT_X_ROT2) tx = w - tx;                                       \
+          if (HW_TOUCH_INVERT_Y_ROT2) ty = h - ty;                                       \
+          break;                                                                         \
+        case 3:                                                                          \
+          HW_TOUCH_MAP_LANDSCAPE_INV(rawX, rawY, tx, ty);                                \
+          if (HW_TOUCH_INVERT_X_ROT3) tx = w - tx;                                       \
+          if (HW_TOUCH_INVERT_Y_ROT3) ty = h - ty;                                       \
+          break;                                                                         \
+      }                                                                                  \
+    }                                                                                    \
+    static void init() {                                                                 \
+      HW_TOUCH_INIT_CODE();                                                              \
+    }                                                                                    \
+  }
+
+// Setzt die Profil-Defaults voraus (hardware_profile_defaults.h)
+#define HW_PROFILE_CONFIG(TouchCode) {                                                   \
+  HW_PROFILE_ID, HW_PROFILE_NAME,                                                        \
+  { HW_DISPLAY_CONTROLLER, HW_DISPLAY_CONTROLLER_STR, HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT, \
+    HW_DEFAULT_ROTATION, HW_COLORS_INVERTED, HW_DISPLAY_SPI_BUS,                         \
+    HW_DISPLAY_MISO, HW_DISPLAY_MOSI, HW_DISPLAY_SCLK, HW_DISPLAY_CS, HW_DISPLAY_DC,     \
+    HW_DISPLAY_RST, HW_DISPLAY_TE, HW_DISPLAY_SPI_FREQ, HW_DISPLAY_SPI_READ_FREQ,        \
+    HW_DISPLAY_SPI_TUNE_MAX, HW_DISPLAY_DMA,                                             \
+    HW_DISPLAY_STRIP_ROWS, HW_DISPLAY_STRIP_RAM_SHARE },                                 \
+  { HW_TOUCH_CONTROLLER, HW_TOUCH_CONTROLLER_STR, HW_TOUCH_SPI_BUS, HW_TOUCH_MULTIPOINT, \
+    HW_TOUCH_MOSI, HW_TOUCH_MISO, HW_TOUCH_CLK, HW_TOUCH_CS, HW_TOUCH_IRQ,               \
+    HW_TOUCH_SPI_FREQ, HW_TOUCH_SDA, HW_TOUCH_SCL, HW_TOUCH_RST, HW_TOUCH_I2C_ADDRESS,  \
+    HW_TOUCH_I2C_FREQ, HW_TOUCH_MIN_X, HW_TOUCH_MAX_X, HW_TOUCH_MIN_Y, HW_TOUCH_MAX_Y,   \
+    HW_TOUCH_THRESHOLD, HW_TOUCH_INVERT_X, HW_TOUCH_INVERT_Y, HW_TOUCH_CALIBRATED,       \
+    HW_TOUCH_SAMPLE_RATE,                                                                \
+    HW_TOUCH_FILTER_MEDIAN, HW_TOUCH_FILTER_IIR_SHIFT, HW_TOUCH_FILTER_DEADBAND,         \
+    &TouchCode::apply, &TouchCode::init,                                                 \
+    { TouchTransformDetail::derive<TouchCode>(0), TouchTransformDetail::derive<TouchCode>(1), \
+      TouchTransformDetail::derive<TouchCode>(2), TouchTransformDetail::derive<TouchCode>(3) } }, \
+  { HW_PROFILE_BACKLIGHT_PIN, HW_BACKLIGHT_INVERTED, HW_PROFILE_BACKLIGHT_PWM,           \
+    HW_BACKLIGHT_PWM_FREQ, HW_BACKLIGHT_PWM_RESOLUTION, HW_BACKLIGHT_DEFAULT },          \
+  HW_PROFILE_FEATURES, HW_INIT_SEQUENCE }
+
+// Name::config: alle Profil-Werte, Name::backlightGamma: Gamma-Tabelle
+// für die PWM-Auflösung (backlight_gamma.h), Name::runtime: false
+#define HW_DEFINE_PROFILE(Name)                                                          \
+  HW_DEFINE_TOUCH_CODE(Name##TouchCode);                                                 \
+  struct Name {                                                                          \
+    static constexpr bool runtime = false;                                               \
+    static constexpr HardwareProfile config = HW_PROFILE_CONFIG(Name##TouchCode);        \
+    static constexpr BacklightGammaTable backlightGamma =                                \
+      backlightGammaTable(config.backlight.pwmResolution);                               \
+  };                                                                                     \
+  static_assert(hwDisplayValid(Name::config), #Name ": Display-Geometrie, Takt oder Pins ungültig"); \
+  static_assert(TouchTransformDetail::matchesReference<Name##TouchCode>(),              \
+                #Name ": Touch-Matrix weicht vom Profil-Mapping ab");                  \
+  static_assert(hwTouchValid(Name::config), #Name ": Touch-Kalibrierung oder Punkte ungültig");     \
+  static_assert(hwBusValid(Name::config), #Name ": geteilter SPI-Host mit abweichenden Pins");      \
+  static_assert(hwBacklightValid(Name::config), #Name ": Backlight-Konfiguration ungültig");         \
+  static_assert(hwInitValid(Name::config), #Name ": Init-Sequenz zu lang")
+
+// ============================================
+// PROFIL-TABELLE (hardware_profiles.cpp)
+// ============================================
+
+#define HW_PROFILE_COUNT 3
+
+extern const HardwareProfile hardwareProfiles[HW_PROFILE_COUNT];
+
+const HardwareProfile* hardwareProfileById(int id);   // nullptr = unbekannt
+
+#endif // HARDWARE_PROFILE_H
@@ -0,0 +1,249 @@
+/**
+ * hardware_profile_defaults.h - Defaults für optionale Profil-Werte
+ *
+ * Nach dem Profil-Header einbinden. Ohne Include-Guard: die
+ * Profil-Tabelle (hardware_profiles.cpp) bindet die Datei pro Profil
+ * erneut ein, dazwischen setzt profile_undef.h alle Werte zurück.
+ */
+
+#ifndef HW_PROFILE_ID
+  #error "HW_PROFILE_ID muss im Hardware-Profile definiert sein"
+#endif
+
+// ============================================
+// PROFIL-DEFAULTS
+// ============================================
+
+// Optionale Profil-Werte, falls das Profil sie nicht setzt
+#ifndef HW_TOUCH_SAMPLE_RATE
+  #define HW_TOUCH_SAMPLE_RATE 200   // Hz im IRQ-Modus
+#endif
+
+// SPI-Host des Displays; teilt sich Touch den Host, arbitriert spi_arbiter.h
+#ifndef HW_DISPLAY_SPI_BUS
+  #define HW_DISPLAY_SPI_BUS HSPI
+#endif
+
+// Obergrenze des Takt-Tunings (siehe display_clock.h). 80 MHz nur über
+// die IO_MUX-Pins des Hosts, über die GPIO-Matrix sind 40 MHz das Limit.
+#ifndef HW_DISPLAY_SPI_TUNE_MAX
+  #define HW_DISPLAY_SPI_TUNE_MAX 80000000
+#endif
+
+// Board beim Start erkennen und mit HARDWARE_PROFILE abgleichen
+// (siehe hardware_auto_detect.h)
+#ifndef HW_AUTO_DETECT
+  #define HW_AUTO_DETECT false
+#endif
+
+// Tearing-Effect Ausgang des Panels (siehe frame_scheduler.h), -1 = keiner
+#ifndef HW_DISPLAY_TE
+  #define HW_DISPLAY_TE -1
+#endif
+
+// DMA Strip-Renderer (siehe strip_renderer.h)
+#ifndef HW_DISPLAY_DMA
+  #define HW_DISPLAY_DMA false
+#endif
+
+#ifndef HW_DISPLAY_STRIP_ROWS
+  #define HW_DISPLAY_STRIP_ROWS 32
+#endif
+
+#ifndef HW_DISPLAY_STRIP_RAM_SHARE
+  #define HW_DISPLAY_STRIP_RAM_SHARE 4
+#endif
+
+// Dual-Core Betrieb (siehe hardware_tasks.cpp)
+#ifndef HW_RENDER_CORE
+  #define HW_RENDER_CORE 1            // Render-Task: besitzt tft
+#endif
+
+#ifndef HW_IO_CORE
+  #define HW_IO_CORE 0                // Input/IO-Task: Touch, Serial, Backlight
+#endif
+
+#ifndef HW_IO_TASK_PERIOD_MS
+  #define HW_IO_TASK_PERIOD_MS 5
+#endif
+
+// Touch-Filter (siehe touch_filter.h)
+#ifndef HW_TOUCH_FILTER_MEDIAN
+  #define HW_TOUCH_FILTER_MEDIAN 3
+#endif
+
+#ifndef HW_TOUCH_FILTER_IIR_SHIFT
+  #define HW_TOUCH_FILTER_IIR_SHIFT 1
+#endif
+
+#ifndef HW_TOUCH_FILTER_DEADBAND
+  #define HW_TOUCH_FILTER_DEADBAND 8
+#endif
+
+// Touch-Spiegelung und Punkte
+#ifndef HW_TOUCH_INVERT_X
+  #define HW_TOUCH_INVERT_X false
+#endif
+
+#ifndef HW_TOUCH_INVERT_Y
+  #define HW_TOUCH_INVERT_Y false
+#endif
+
+#ifndef HW_TOUCH_MULTIPOINT
+  #define HW_TOUCH_MULTIPOINT 1
+#endif
+
+// Spiegelung pro Rotation (HW_TOUCH_INVERT_*_ROT0..3), Standard: für alle gleich
+#ifndef HW_TOUCH_INVERT_X_ROT0
+  #define HW_TOUCH_INVERT_X_ROT0 HW_TOUCH_INVERT_X
+#endif
+
+#ifndef HW_TOUCH_INVERT_X_ROT1
+  #define HW_TOUCH_INVERT_X_ROT1 HW_TOUCH_INVERT_X
+#endif
+
+#ifndef HW_TOUCH_INVERT_X_ROT2
+  #define HW_TOUCH_INVERT_X_ROT2 HW_TOUCH_INVERT_X
+#endif
+
+#ifndef HW_TOUCH_INVERT_X_ROT3
+  #define HW_TOUCH_INVERT_X_ROT3 HW_TOUCH_INVERT_X
+#endif
+
+#ifndef HW_TOUCH_INVERT_Y_ROT0
+  #define HW_TOUCH_INVERT_Y_ROT0 HW_TOUCH_INVERT_Y
+#endif
+
+#ifndef HW_TOUCH_INVERT_Y_ROT1
+  #define HW_TOUCH_INVERT_Y_ROT1 HW_TOUCH_INVERT_Y
+#endif
+
+#ifndef HW_TOUCH_INVERT_Y_ROT2
+  #define HW_TOUCH_INVERT_Y_ROT2 HW_TOUCH_INVERT_Y
+#endif
+
+#ifndef HW_TOUCH_INVERT_Y_ROT3
+  #define HW_TOUCH_INVERT_Y_ROT3 HW_TOUCH_INVERT_Y
+#endif
+
+// Rohwert -> Bildschirm pro Rotation (siehe HW_DEFINE_TOUCH_CODE),
+// Standard: linear über den Kalibrierbereich, Bildschirmgröße der Rotation
+#ifndef HW_TOUCH_MAP_PORTRAIT
+  #define HW_TOUCH_MAP_PORTRAIT(rawX, rawY, mappedX, mappedY) do { \
+    mappedX = map(rawX, HW_TOUCH_MIN_X, HW_TOUCH_MAX_X, 0, HW_DISPLAY_WIDTH); \
+    mappedY = map(rawY, HW_TOUCH_MIN_Y, HW_TOUCH_MAX_Y, 0, HW_DISPLAY_HEIGHT); \
+  } while(0)
+#endif
+
+#ifndef HW_TOUCH_MAP_LANDSCAPE
+  #define HW_TOUCH_MAP_LANDSCAPE(rawX, rawY, mappedX, mappedY) do { \
+    mappedX = map(rawX, HW_TOUCH_MIN_X, HW_TOUCH_MAX_X, 0, HW_DISPLAY_HEIGHT); \
+    mappedY = map(rawY, HW_TOUCH_MIN_Y, HW_TOUCH_MAX_Y, 0, HW_DISPLAY_WIDTH); \
+  } while(0)
+#endif
+
+#ifndef HW_TOUCH_MAP_PORTRAIT_INV
+  #define HW_TOUCH_MAP_PORTRAIT_INV(rawX, rawY, mappedX, mappedY) do { \
+    mappedX = map(rawX, HW_TOUCH_MAX_X, HW_TOUCH_MIN_X, 0, HW_DISPLAY_WIDTH); \
+    mappedY = map(rawY, HW_TOUCH_MAX_Y, HW_TOUCH_MIN_Y, 0, HW_DISPLAY_HEIGHT); \
+  } while(0)
+#endif
+
+#ifndef HW_TOUCH_MAP_LANDSCAPE_INV
+  #define HW_TOUCH_MAP_LANDSCAPE_INV(rawX, rawY, mappedX, mappedY) do { \
+    mappedX = map(rawX, HW_TOUCH_MAX_X, HW_TOUCH_MIN_X, 0, HW_DISPLAY_HEIGHT); \
+    mappedY = map(rawY, HW_TOUCH_MIN_Y, HW_TOUCH_MAX_Y, HW_DISPLAY_WIDTH, 0); \
+  } while(0)
+#endif
+
+// Zusätzlicher Code nach touch.begin() bzw. dem I2C-Start
+#ifndef HW_TOUCH_INIT_CODE
+  #define HW_TOUCH_INIT_CODE() do {} while(0)
+#endif
+
+// Kapazitive Controller am I2C-Bus (siehe touch_i2c.h)
+#ifndef HW_TOUCH_SDA
+  #define HW_TOUCH_SDA -1
+#endif
+
+#ifndef HW_TOUCH_SCL
+  #define HW_TOUCH_SCL -1
+#endif
+
+#ifndef HW_TOUCH_RST
+  #define HW_TOUCH_RST -1
+#endif
+
+#ifndef HW_TOUCH_I2C_ADDRESS
+  #define HW_TOUCH_I2C_ADDRESS 0      // Standard des Controllers
+#endif
+
+#ifndef HW_TOUCH_I2C_FREQ
+  #define HW_TOUCH_I2C_FREQ 400000
+#endif
+
+// Backlight: ohne HW_BACKLIGHT_PIN keins, ohne PWM-Kanal nur Ein/Aus
+#ifdef HW_BACKLIGHT_PIN
+  #define HW_PROFILE_BACKLIGHT_PIN HW_BACKLIGHT_PIN
+#else
+  #define HW_PROFILE_BACKLIGHT_PIN -1
+#endif
+
+#ifdef HW_BACKLIGHT_PWM_CHANNEL
+  #define HW_PROFILE_BACKLIGHT_PWM true
+#else
+  #define HW_PROFILE_BACKLIGHT_PWM false
+#endif
+
+#ifndef HW_BACKLIGHT_INVERTED
+  #define HW_BACKLIGHT_INVERTED false
+#endif
+
+#ifndef HW_BACKLIGHT_PWM_FREQ
+  #define HW_BACKLIGHT_PWM_FREQ 5000
+#endif
+
+#ifndef HW_BACKLIGHT_PWM_RESOLUTION
+  #define HW_BACKLIGHT_PWM_RESOLUTION 12
+#endif
+
+#ifndef HW_BACKLIGHT_DEFAULT
+  #define HW_BACKLIGHT_DEFAULT 100
+#endif
+
+// Zusätzliche Kommandos nach tft.init() (siehe HwInitSequence)
+#ifndef HW_INIT_SEQUENCE
+  #define HW_INIT_SEQUENCE { 0, {} }
+#endif
+
+// ============================================
+// FEATURE-BITS
+// ============================================
+
+#ifndef HW_HAS_BACKLIGHT_CONTROL
+  #define HW_HAS_BACKLIGHT_CONTROL false
+#endif
+
+#ifndef HW_HAS_RGB_LED
+  #define HW_HAS_RGB_LED false
+#endif
+
+#ifndef HW_HAS_RS485
+  #define HW_HAS_RS485 false
+#endif
+
+#ifndef HW_HAS_TOUCH
+  #define HW_HAS_TOUCH true
+#endif
+
+#ifndef HW_HAS_MULTITOUCH
+  #define HW_HAS_MULTITOUCH false
+#endif
+
+#define HW_PROFILE_FEATURES (uint16_t)(                               \
+  (HW_HAS_BACKLIGHT_CONTROL ? HW_FEATURE_BACKLIGHT_CONTROL : 0) |     \
+  (HW_HAS_RGB_LED ? HW_FEATURE_RGB_LED : 0) |                         \
+  (HW_HAS_RS485 ? HW_FEATURE_RS485 : 0) |                             \
+  (HW_HAS_TOUCH ? HW_FEATURE_TOUCH : 0) |                             \
+  (HW_HAS_MULTITOUCH ? HW_FEATURE_MULTITOUCH : 0) |                   \
+  (HW_AUTO_DETECT ? HW_FEATURE_AUTO_DETECT : 0))
@@ -52,8 +52,9 @@
 #define AUTO_DETECT_HARDWARE
 
 #ifdef AUTO_DETECT_HARDWARE
-  // Hardware wird zur Laufzeit erkannt
-  #include "hardware_auto_detect.h"
+  // Hardware wird zur Laufzeit erkannt (hardware_hal.h bindet
+  // hardware_auto_detect.h ein, HW_AUTO_DETECT im Profil)
+  #include "hardware_hal.h"
 #else
   // Manuelle Hardware-Auswahl:
   
@@ -119,11 +120,14 @@
  *    - Passe alle HW_* Definitionen an
  * 
  * 2. PROFILE REGISTRIEREN
- *    - Füge zu hardware_hal.h hinzu:
+ *    - Füge zu hardware_profile.h hinzu:
  *      #define ESP32_DEIN_NAME 3
- *    - Erweitere die Include-Liste:
+ *    - Im Profil: #define HW_PROFILE_ID ESP32_DEIN_NAME
+ *    - Erweitere die Include-Liste in hardware_hal.h:
  *      #elif HARDWARE_PROFILE == ESP32_DEIN_NAME
  *        #include "hardware_profiles/esp32_dein_name.h"
+ *    - Profil-Tabelle: Block in hardware_profiles.cpp ergänzen,
+ *      HW_PROFILE_COUNT erhöhen, neue Makros in profile_undef.h
  * 
  * 3. TOUCH KALIBRIERUNG
  *    - Setze HW_TOUCH_CALIBRATED auf false
@@ -174,72 +178,33 @@
  *    - MAC-Address Bereiche
  */
 
-// Auto-Detection Implementation
+// Auto-Detection Implementation (hardware_auto_detect.cpp)
 #ifdef AUTO_DETECT_HARDWARE
 
 class HardwareDetector {
 public:
-  // Automatische Hardware-Erkennung
+  // Automatische Hardware-Erkennung, vor tft.init()/touch.begin()
   static int detectHardware() {
     Serial.println("🔍 Starte automatische Hardware-Erkennung...");
+    detectHardwareProfile(&lastResult());
+    printHardwareDetection(lastResult());
     
-    // Test 1: Display Controller erkennen
-    int displayController = detectDisplayController();
-    
-    // Test 2: Touch Controller erkennen  
-    int touchController = detectTouchController();
-    
-    // Test 3: Pin-Konfiguration testen
-    int pinConfig = detectPinConfiguration();
-    
-    // Hardware-Profile basierend auf Ergebnissen bestimmen
-    if (displayController == DISPLAY_ST7789 && touchController == TOUCH_XPT2046_HSPI) {
-      Serial.println("✅ Erkannt: ESP32_TZT_24 (2.4\" ST7789)");
-      return ESP32_TZT_24;
-    }
-    
-    if (displayController == DISPLAY_ILI9341 && touchController == TOUCH_XPT2046_VSPI) {
-      Serial.println("✅ Erkannt: ESP32_2432S028R (2.8\" ILI9341)");
-      return ESP32_2432S028R;
+    if (lastResult().profile == ESP32_GENERIC) {
+      Serial.println("⚠️ Hardware nicht erkannt - verwende Generic Profile");
+    } else {
+      Serial.printf("✅ Erkannt: %s\n", lastResult().profileName);
     }
-    
-    Serial.println("⚠️ Hardware nicht erkannt - verwende Generic Profile");
-    return ESP32_GENERIC;
-  }
-  
-private:
-  // Display Controller IDs
-  enum DisplayController {
-    DISPLAY_UNKNOWN = 0,
-    DISPLAY_ST7789 = 1,
-    DISPLAY_ILI9341 = 2,
-    DISPLAY_ILI9488 = 3
-  };
-  
-  // Touch Controller Types
-  enum TouchController {
-    TOUCH_UNKNOWN = 0,
-    TOUCH_XPT2046_HSPI = 1,
-    TOUCH_XPT2046_VSPI = 2,
-    TOUCH_GT911_I2C = 3
-  };
-  
-  static int detectDisplayController() {
-    // Implementierung der Display-Erkennung
-    // ...
-    return DISPLAY_UNKNOWN;
+    return lastResult().profile;
   }
   
-  static int detectTouchController() {
-    // Implementierung der Touch-Erkennung
-    // ...
-    return TOUCH_UNKNOWN;
-  }
+  // Einzelergebnisse des letzten Laufs (DetectedDisplay / DetectedTouch)
+  static int detectDisplayController() { return lastResult().display; }
+  static int detectTouchController() { return lastResult().touch; }
+  static int detectPinConfiguration() { return lastResult().displayPins; }
   
-  static int detectPinConfiguration() {
-    // Pin-Konfiguration testen
-    // ...
-    return 0;
+  static HardwareDetection& lastResult() {
+    static HardwareDetection result;
+    return result;
   }
 };
 
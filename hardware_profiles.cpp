@@ -0,0 +1,48 @@
+/**
+ * hardware_profiles.cpp - Tabelle aller Hardware-Profile
+ *
+ * Unabhängig von HARDWARE_PROFILE: jedes Profil wird einzeln
+ * eingebunden, per HW_DEFINE_PROFILE als constexpr Struktur
+ * übernommen (inkl. static_assert) und danach zurückgesetzt.
+ * Nutzer: Auto-Erkennung und hardwareProfileById().
+ */
+
+#include "hardware_profile.h"
+
+// ============================================
+// PROFILE
+// ============================================
+
+#include "hardware_profiles/esp32_tzt_24.h"
+#include "hardware_profile_defaults.h"
+namespace { HW_DEFINE_PROFILE(ProfileEsp32Tzt24); }
+#include "hardware_profiles/profile_undef.h"
+
+#include "hardware_profiles/esp32_2432s028r.h"
+#include "hardware_profile_defaults.h"
+namespace { HW_DEFINE_PROFILE(ProfileEsp32_2432S028R); }
+#include "hardware_profiles/profile_undef.h"
+
+#include "hardware_profiles/esp32_generic.h"
+#include "hardware_profile_defaults.h"
+namespace { HW_DEFINE_PROFILE(ProfileEsp32Generic); }
+#include "hardware_profiles/profile_undef.h"
+
+// ============================================
+// TABELLE
+// ============================================
+
+const HardwareProfile hardwareProfiles[HW_PROFILE_COUNT] = {
+  ProfileEsp32Tzt24::config,
+  ProfileEsp32_2432S028R::config,
+  ProfileEsp32Generic::config,
+};
+
+const HardwareProfile* hardwareProfileById(int id) {
+  for (const HardwareProfile& profile : hardwareProfiles) {
+    if (profile.id == id) {
+      return &profile;
+    }
+  }
+  return nullptr;
+}
@@ -11,6 +11,7 @@
 // HARDWARE PROFILE INFORMATION
 // ============================================
 
+#define HW_PROFILE_ID ESP32_2432S028R
 #define HW_PROFILE_NAME "ESP32-2432S028R"
 #define HW_PROFILE_VERSION "1.0"
 #define HW_PROFILE_DESCRIPTION "ESP32-2432S028R 2.8 inch ILI9341 Display"
@@ -26,7 +27,7 @@
 // DISPLAY CONFIGURATION
 // ============================================
 
-#define HW_DISPLAY_CONTROLLER ILI9341
+#define HW_DISPLAY_CONTROLLER HW_DISPLAY_CTRL_ILI9341
 #define HW_DISPLAY_WIDTH 320
 #define HW_DISPLAY_HEIGHT 240
 #define HW_DEFAULT_ROTATION 0   // Landscape (Standard für 2,8")
@@ -42,7 +43,10 @@
 #define HW_DISPLAY_RST -1
 
 // Display Features
+#define HW_DISPLAY_SPI_BUS HSPI           // TFT_eSPI: USE_HSPI_PORT
 #define HW_DISPLAY_DMA true
+#define HW_DISPLAY_STRIP_ROWS 32          // Max. Zeilen pro DMA-Streifen
+#define HW_DISPLAY_STRIP_RAM_SHARE 4      // Beide Puffer <= 1/4 des freien DMA-RAM
 #define HW_DISPLAY_SPI_FREQ 40000000
 #define HW_DISPLAY_SPI_READ_FREQ 20000000
 
@@ -54,14 +58,14 @@
 #define HW_BACKLIGHT_INVERTED false
 #define HW_BACKLIGHT_PWM_CHANNEL 0
 #define HW_BACKLIGHT_PWM_FREQ 5000
-#define HW_BACKLIGHT_PWM_RESOLUTION 8
+#define HW_BACKLIGHT_PWM_RESOLUTION 12   // Gamma-Tabelle: feine Stufen auch unten
 #define HW_BACKLIGHT_DEFAULT 100
 
 // ============================================
 // TOUCH CONFIGURATION
 // ============================================
 
-#define HW_TOUCH_CONTROLLER XPT2046
+#define HW_TOUCH_CONTROLLER HW_TOUCH_CTRL_XPT2046
 #define HW_TOUCH_SPI_BUS VSPI  // *** WICHTIG: VSPI statt HSPI ***
 #define HW_TOUCH_MULTIPOINT 1  // Single Touch
 
@@ -85,6 +89,14 @@
 // Touch SPI Frequency
 #define HW_TOUCH_SPI_FREQ 2500000
 
+// Touch Sampling (IRQ-Modus, solange der Stift aufliegt)
+#define HW_TOUCH_SAMPLE_RATE 200
+
+// Touch Filter (Rohwert-Ebene, siehe touch_filter.h)
+#define HW_TOUCH_FILTER_MEDIAN 3       // Median-of-N: 1 (aus), 3 oder 5
+#define HW_TOUCH_FILTER_IIR_SHIFT 1    // Glättung 1/2^n, 0 = aus
+#define HW_TOUCH_FILTER_DEADBAND 8     // Rohwert-Einheiten (< 1 Pixel)
+
 // ============================================
 // ADDITIONAL HARDWARE
 // ============================================
@@ -121,6 +133,7 @@
 #define HW_HAS_RS485 true
 #define HW_HAS_TOUCH true
 #define HW_HAS_MULTITOUCH false
+#define HW_AUTO_DETECT true     // Display-ID + Touch beim Start prüfen
 #define HW_HAS_SD_CARD false    // Abhängig vom Board
 #define HW_HAS_SPEAKER false    // Abhängig vom Board
 
@@ -144,11 +157,10 @@
 // HARDWARE-SPECIFIC INITIALIZATION CODE
 // ============================================
 
-// Hardware-spezifische Initialisierung
-#define HW_INIT_CODE() do { \
-  /* ILI9341-spezifische Initialisierung */ \
-  /* Eventuell andere RGB-Order */ \
-} while(0)
+// Nach tft.init(): Adressfenster 320x240 (CASET 0-319, RASET 0-239)
+#define HW_INIT_SEQUENCE { 2, {                    \
+  { 0x2A, 4, { 0x00, 0x00, 0x01, 0x3F } },         \
+  { 0x2B, 4, { 0x00, 0x00, 0x00, 0xEF } } } }
 
 // Hardware-spezifische Touch-Initialisierung
 #define HW_TOUCH_INIT_CODE() do { \
@@ -172,15 +184,6 @@
   mappedY = map(rawY, HW_TOUCH_MIN_Y, HW_TOUCH_MAX_Y, 0, HW_DISPLAY_HEIGHT); \
 } while(0)
 
-#define HW_INIT_CODE() do { \
-  tft.writecommand(0x2A); /* Column Address Set */ \
-  tft.writedata(0x00); tft.writedata(0x00); \
-  tft.writedata(0x01); tft.writedata(0x3F); /* 0-319 */ \
-  tft.writecommand(0x2B); /* Row Address Set */ \
-  tft.writedata(0x00); tft.writedata(0x00); \
-  tft.writedata(0x00); tft.writedata(0xEF); /* 0-239 */ \
-} while(0)
-	
 // ============================================
 // VALIDATION
 // ============================================
@@ -11,7 +11,8 @@
  * VERWENDUNG:
  * 1. Kopiere diese Datei zu: esp32_[DEIN_HARDWARE_NAME].h
  * 2. Ändere alle HW_* Definitionen entsprechend deiner Hardware
- * 3. Füge das neue Profile zur hardware_hal.h hinzu
+ * 3. Füge das neue Profile zur hardware_hal.h und zur Profil-Tabelle
+ *    (hardware_profiles.cpp, profile_undef.h) hinzu
  * 4. Verwende: #define HARDWARE_PROFILE ESP32_DEIN_HARDWARE_NAME
  * 
  * BEISPIELE FÜR VERSCHIEDENE HARDWARE:
@@ -30,6 +31,7 @@
 // ============================================
 
 // *** SCHRITT 1: GRUNDLEGENDE PROFIL-INFORMATIONEN ***
+#define HW_PROFILE_ID ESP32_GENERIC
 #define HW_PROFILE_NAME "ESP32-Generic"
 #define HW_PROFILE_VERSION "1.0"
 #define HW_PROFILE_DESCRIPTION "Generic ESP32 Display Template"
@@ -46,12 +48,12 @@
 // ============================================
 
 // *** SCHRITT 2: DISPLAY CONTROLLER FESTLEGEN ***
-// Häufige Controller:
-// - ST7789  (meist 240x320)
-// - ILI9341 (meist 320x240)
-// - ILI9488 (meist 320x480)
-// - ST7262  (meist 800x480)
-#define HW_DISPLAY_CONTROLLER ILI9341
+// Häufige Controller (IDs siehe hardware_profile.h):
+// - HW_DISPLAY_CTRL_ST7789  (meist 240x320)
+// - HW_DISPLAY_CTRL_ILI9341 (meist 320x240)
+// - HW_DISPLAY_CTRL_ILI9488 (meist 320x480)
+// - ST7262  (meist 800x480, RGB-Interface - kein Profil)
+#define HW_DISPLAY_CONTROLLER HW_DISPLAY_CTRL_ILI9341
 
 // *** SCHRITT 3: DISPLAY-AUFLÖSUNG ***
 // WICHTIG: Portrait vs Landscape berücksichtigen
@@ -80,6 +82,7 @@
 #define HW_DISPLAY_CS 15      // Chip Select (SS)
 #define HW_DISPLAY_DC 2       // Data/Command
 #define HW_DISPLAY_RST -1     // Reset (-1 = mit Arduino Reset verbunden)
+// #define HW_DISPLAY_TE 4    // Tearing-Effect, nur wenn am Modul herausgeführt
 
 // Alternative Pin-Konfigurationen:
 // ESP32-WROOM-32:   MISO=12, MOSI=13, SCLK=14
@@ -87,7 +90,10 @@
 // Custom:           Beliebige GPIO-Pins
 
 // *** SCHRITT 7: DISPLAY SPI EINSTELLUNGEN ***
+#define HW_DISPLAY_SPI_BUS HSPI           // SPI-Host des Displays (HSPI oder VSPI)
 #define HW_DISPLAY_DMA true               // DMA verwenden (Empfohlen)
+#define HW_DISPLAY_STRIP_ROWS 32          // Max. Zeilen pro DMA-Streifen (2 Puffer)
+#define HW_DISPLAY_STRIP_RAM_SHARE 4      // Beide Puffer <= 1/4 des freien DMA-RAM
 #define HW_DISPLAY_SPI_FREQ 40000000      // 40MHz (ILI9341 Standard)
 #define HW_DISPLAY_SPI_READ_FREQ 20000000 // 20MHz für Lesen
 
@@ -106,7 +112,7 @@
 #define HW_BACKLIGHT_INVERTED false     // true = LOW = an, false = HIGH = an
 #define HW_BACKLIGHT_PWM_CHANNEL 0      // LEDC Kanal für PWM
 #define HW_BACKLIGHT_PWM_FREQ 5000      // PWM Frequenz (1kHz - 10kHz)
-#define HW_BACKLIGHT_PWM_RESOLUTION 8   // 8-Bit = 0-255 Werte
+#define HW_BACKLIGHT_PWM_RESOLUTION 12  // 12-Bit = 0-4095, Frequenz x 2^Bit <= 80 MHz
 #define HW_BACKLIGHT_DEFAULT 100        // Standard-Helligkeit %
 
 // Backlight-Varianten:
@@ -124,12 +130,12 @@
 // ============================================
 
 // *** SCHRITT 9: TOUCH CONTROLLER ***
-// Häufige Touch-Controller:
-// - XPT2046 (Resistiv, Single-Touch)
-// - GT911   (Kapazitiv, Multi-Touch)
-// - FT6236  (Kapazitiv, Multi-Touch)
-// - CST816S (Kapazitiv, Single-Touch)
-#define HW_TOUCH_CONTROLLER XPT2046
+// Häufige Touch-Controller (IDs siehe hardware_profile.h):
+// - HW_TOUCH_CTRL_XPT2046 (Resistiv, Single-Touch)
+// - HW_TOUCH_CTRL_GT911   (Kapazitiv, Multi-Touch)
+// - HW_TOUCH_CTRL_FT6236  (Kapazitiv, Multi-Touch)
+// - HW_TOUCH_CTRL_CST816S (Kapazitiv, Single-Touch)
+#define HW_TOUCH_CONTROLLER HW_TOUCH_CTRL_XPT2046
 
 // *** SCHRITT 10: TOUCH SPI BUS ***
 // WICHTIG: ESP32 hat HSPI und VSPI
@@ -139,7 +145,7 @@
 
 // *** SCHRITT 11: TOUCH MULTIPOINT ***
 // Anzahl gleichzeitiger Touch-Punkte
-#define HW_TOUCH_MULTIPOINT 1           // XPT2046 = 1, GT911 = 5
+#define HW_TOUCH_MULTIPOINT 1           // XPT2046 = 1, GT911 = 5, FT6236 = 2, CST816S = 1
 
 // *** SCHRITT 12: TOUCH SPI PINS ***
 // Bei HSPI: Meist mit Display geteilt
@@ -155,6 +161,17 @@
 // ESP32-TZT-24 (HSPI):    MOSI=13, MISO=12, CLK=14, CS=33, IRQ=36
 // Kapazitive Touch (I2C): SDA=21, SCL=22, IRQ=36, RST=25
 
+// *** SCHRITT 12b: KAPAZITIVER TOUCH (I2C) ***
+// Nur für GT911/FT6236/CST816S (touch_i2c.h), die SPI-Werte bleiben
+// dann ungenutzt. HW_TOUCH_IRQ ist die INT-Leitung, ohne sie wird mit
+// HW_TOUCH_SAMPLE_RATE gepollt. Rohwerte sind Panel-Pixel:
+// MIN_X/MIN_Y = 0, MAX_X/MAX_Y = Breite/Höhe - 1 (Rotation 0).
+// #define HW_TOUCH_SDA 21
+// #define HW_TOUCH_SCL 22
+// #define HW_TOUCH_RST 25                 // Optional, weckt den CST816S
+// #define HW_TOUCH_I2C_ADDRESS 0x5D       // Optional, 0 = Standard des Controllers
+// #define HW_TOUCH_I2C_FREQ 400000
+
 // *** SCHRITT 13: TOUCH KALIBRIERUNG ***
 // Diese Werte müssen durch Testing ermittelt werden!
 #define HW_TOUCH_MIN_X 200              // Minimaler X-Rohwert
@@ -185,6 +202,16 @@
 // GT911:   I2C 400kHz
 // FT6236:  I2C 400kHz
 
+// *** SCHRITT 15b: TOUCH SAMPLING RATE ***
+// Abtastrate im IRQ-Modus (startTouchSampling), nur solange der Stift aufliegt
+#define HW_TOUCH_SAMPLE_RATE 200        // Hz (XPT2046 Bibliothek: max. ~330 Hz)
+
+// *** SCHRITT 15c: TOUCH FILTER ***
+// Zwischen Rohwert und Transformation, HW_TOUCH_THRESHOLD dient als Druck-Gate
+#define HW_TOUCH_FILTER_MEDIAN 3        // Median-of-N: 1 (aus), 3 oder 5
+#define HW_TOUCH_FILTER_IIR_SHIFT 1     // Glättung 1/2^n, 0 = aus
+#define HW_TOUCH_FILTER_DEADBAND 8      // Rohwert-Einheiten, ca. (MAX-MIN)/Breite = 1 Pixel
+
 // ============================================
 // ADDITIONAL HARDWARE
 // ============================================
@@ -248,6 +275,7 @@
 #define HW_HAS_SPEAKER false            // Audio-Ausgabe vorhanden
 #define HW_HAS_WIFI true                // WiFi verfügbar (Standard ESP32)
 #define HW_HAS_BLUETOOTH true           // Bluetooth verfügbar
+#define HW_AUTO_DETECT false            // Controller-Erkennung beim Start (nur bekannte Boards)
 
 // Feature-Flags helfen beim:
 // - Conditional Compilation
@@ -283,14 +311,14 @@
 // ============================================
 
 // *** SCHRITT 23: HARDWARE-SPEZIFISCHE INITIALISIERUNG ***
-#define HW_INIT_CODE() do { \
-  /* Hier kommt hardware-spezifischer Code */ \
-  Serial.println("Generic Hardware Init"); \
-  /* Beispiele: */ \
-  /* - Spezielle Register setzen */ \
-  /* - GPIO-Modi konfigurieren */ \
-  /* - Power Management */ \
-} while(0)
+// Display-Kommandos, die nach tft.init() gesendet werden:
+// { Anzahl, { { Kommando, Länge, { Daten } }, ... } }
+// Max. HW_INIT_MAX_COMMANDS Kommandos mit je HW_INIT_MAX_DATA Bytes
+#define HW_INIT_SEQUENCE { 0, {} }
+
+// Beispiel (ILI9341 Adressfenster 320x240):
+// #define HW_INIT_SEQUENCE { 2, { { 0x2A, 4, { 0x00, 0x00, 0x01, 0x3F } },
+//                                 { 0x2B, 4, { 0x00, 0x00, 0x00, 0xEF } } } }
 
 // *** SCHRITT 24: TOUCH-SPEZIFISCHE INITIALISIERUNG ***
 #define HW_TOUCH_INIT_CODE() do { \
@@ -363,7 +391,7 @@
   #pragma message "Info: Touch und Display teilen sich SPI-Bus (HSPI)"
 #endif
 
-#if HW_TOUCH_MULTIPOINT > 1 && HW_TOUCH_CONTROLLER == XPT2046
+#if HW_TOUCH_MULTIPOINT > 1 && HW_TOUCH_CONTROLLER == HW_TOUCH_CTRL_XPT2046
   #error "XPT2046 unterstützt nur Single-Touch (HW_TOUCH_MULTIPOINT = 1)"
 #endif
 
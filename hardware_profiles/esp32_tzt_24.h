@@ -11,6 +11,7 @@
 // HARDWARE PROFILE INFORMATION
 // ============================================
 
+#define HW_PROFILE_ID ESP32_TZT_24
 #define HW_PROFILE_NAME "ESP32-TZT-2.4"
 #define HW_PROFILE_VERSION "1.0"
 #define HW_PROFILE_DESCRIPTION "TZT ESP32 2.4 inch ST7789 Display"
@@ -26,7 +27,7 @@
 // DISPLAY CONFIGURATION
 // ============================================
 
-#define HW_DISPLAY_CONTROLLER ST7789
+#define HW_DISPLAY_CONTROLLER HW_DISPLAY_CTRL_ST7789
 #define HW_DISPLAY_WIDTH 240
 #define HW_DISPLAY_HEIGHT 320
 #define HW_DEFAULT_ROTATION 2    // Portrait USB unten
@@ -42,7 +43,10 @@
 #define HW_DISPLAY_RST -1  // Mit Arduino Reset verbunden
 
 // Display Features
+#define HW_DISPLAY_SPI_BUS HSPI           // TFT_eSPI: USE_HSPI_PORT
 #define HW_DISPLAY_DMA true
+#define HW_DISPLAY_STRIP_ROWS 32          // Max. Zeilen pro DMA-Streifen
+#define HW_DISPLAY_STRIP_RAM_SHARE 4      // Beide Puffer <= 1/4 des freien DMA-RAM
 #define HW_DISPLAY_SPI_FREQ 80000000
 #define HW_DISPLAY_SPI_READ_FREQ 80000000
 
@@ -54,14 +58,14 @@
 #define HW_BACKLIGHT_INVERTED false
 #define HW_BACKLIGHT_PWM_CHANNEL 0
 #define HW_BACKLIGHT_PWM_FREQ 5000
-#define HW_BACKLIGHT_PWM_RESOLUTION 8
+#define HW_BACKLIGHT_PWM_RESOLUTION 12   // Gamma-Tabelle: feine Stufen auch unten
 #define HW_BACKLIGHT_DEFAULT 100
 
 // ============================================
 // TOUCH CONFIGURATION
 // ============================================
 
-#define HW_TOUCH_CONTROLLER XPT2046
+#define HW_TOUCH_CONTROLLER HW_TOUCH_CTRL_XPT2046
 #define HW_TOUCH_SPI_BUS HSPI
 #define HW_TOUCH_MULTIPOINT 1  // Single Touch
 
@@ -85,6 +89,14 @@
 // Touch SPI Frequency
 #define HW_TOUCH_SPI_FREQ 2500000
 
+// Touch Sampling (IRQ-Modus, solange der Stift aufliegt)
+#define HW_TOUCH_SAMPLE_RATE 200
+
+// Touch Filter (Rohwert-Ebene, siehe touch_filter.h)
+#define HW_TOUCH_FILTER_MEDIAN 3       // Median-of-N: 1 (aus), 3 oder 5
+#define HW_TOUCH_FILTER_IIR_SHIFT 1    // Glättung 1/2^n, 0 = aus
+#define HW_TOUCH_FILTER_DEADBAND 8     // Rohwert-Einheiten (< 1 Pixel)
+
 // ============================================
 // ADDITIONAL HARDWARE
 // ============================================
@@ -121,6 +133,7 @@
 #define HW_HAS_RS485 true
 #define HW_HAS_TOUCH true
 #define HW_HAS_MULTITOUCH false
+#define HW_AUTO_DETECT true     // Display-ID + Touch beim Start prüfen
 
 // ============================================
 // TFT_ESPI USER_SETUP MAPPING
@@ -143,11 +156,8 @@
 // HARDWARE-SPECIFIC INITIALIZATION CODE
 // ============================================
 
-// Hardware-spezifische Initialisierung
-#define HW_INIT_CODE() do { \
-  /* TFT-spezifische Initialisierung */ \
-  /* RGB Order für ST7789 */ \
-} while(0)
+// Zusätzliche Kommandos nach tft.init() (RGB-Order setzt TFT_Setup.h)
+#define HW_INIT_SEQUENCE { 0, {} }
 
 // Hardware-spezifische Touch-Initialisierung
 #define HW_TOUCH_INIT_CODE() do { \
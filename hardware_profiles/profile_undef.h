@@ -0,0 +1,140 @@
+/**
+ * profile_undef.h - Setzt alle Profil-Makros zurück
+ *
+ * Nur für die Profil-Tabelle (hardware_profiles.cpp): zwischen zwei
+ * Profil-Headern einbinden, damit das nächste Profil samt
+ * hardware_profile_defaults.h ohne Redefinitionen ausgewertet wird.
+ * Neue HW_* Makros in einem Profil oder den Defaults hier ergänzen.
+ */
+
+// Profil-Information
+#undef HW_PROFILE_ID
+#undef HW_PROFILE_NAME
+#undef HW_PROFILE_VERSION
+#undef HW_PROFILE_DESCRIPTION
+#undef HW_PROFILE_NAME_STR
+#undef HW_DISPLAY_WIDTH_STR
+#undef HW_DISPLAY_HEIGHT_STR
+#undef HW_DISPLAY_CONTROLLER_STR
+#undef HW_TOUCH_CONTROLLER_STR
+
+// Display
+#undef HW_DISPLAY_CONTROLLER
+#undef HW_DISPLAY_WIDTH
+#undef HW_DISPLAY_HEIGHT
+#undef HW_DEFAULT_ROTATION
+#undef HW_COLORS_INVERTED
+#undef HW_DISPLAY_INVERSION_OFF
+#undef HW_DISPLAY_MISO
+#undef HW_DISPLAY_MOSI
+#undef HW_DISPLAY_SCLK
+#undef HW_DISPLAY_CS
+#undef HW_DISPLAY_DC
+#undef HW_DISPLAY_RST
+#undef HW_DISPLAY_TE
+#undef HW_DISPLAY_SPI_BUS
+#undef HW_DISPLAY_DMA
+#undef HW_DISPLAY_STRIP_ROWS
+#undef HW_DISPLAY_STRIP_RAM_SHARE
+#undef HW_DISPLAY_SPI_FREQ
+#undef HW_DISPLAY_SPI_READ_FREQ
+#undef HW_INIT_SEQUENCE
+#undef HW_DISPLAY_SPI_TUNE_MAX
+
+// Backlight
+#undef HW_BACKLIGHT_PIN
+#undef HW_BACKLIGHT_INVERTED
+#undef HW_BACKLIGHT_PWM_CHANNEL
+#undef HW_BACKLIGHT_PWM_FREQ
+#undef HW_BACKLIGHT_PWM_RESOLUTION
+#undef HW_BACKLIGHT_DEFAULT
+#undef HW_PROFILE_BACKLIGHT_PIN
+#undef HW_PROFILE_BACKLIGHT_PWM
+
+// Touch
+#undef HW_TOUCH_CONTROLLER
+#undef HW_TOUCH_SPI_BUS
+#undef HW_TOUCH_MULTIPOINT
+#undef HW_TOUCH_IRQ
+#undef HW_TOUCH_MOSI
+#undef HW_TOUCH_MISO
+#undef HW_TOUCH_CLK
+#undef HW_TOUCH_CS
+#undef HW_TOUCH_MIN_X
+#undef HW_TOUCH_MAX_X
+#undef HW_TOUCH_MIN_Y
+#undef HW_TOUCH_MAX_Y
+#undef HW_TOUCH_THRESHOLD
+#undef HW_TOUCH_CALIBRATED
+#undef HW_TOUCH_INVERT_X
+#undef HW_TOUCH_INVERT_Y
+#undef HW_TOUCH_SPI_FREQ
+#undef HW_TOUCH_SDA
+#undef HW_TOUCH_SCL
+#undef HW_TOUCH_RST
+#undef HW_TOUCH_I2C_ADDRESS
+#undef HW_TOUCH_I2C_FREQ
+#undef HW_TOUCH_SAMPLE_RATE
+#undef HW_TOUCH_FILTER_MEDIAN
+#undef HW_TOUCH_FILTER_IIR_SHIFT
+#undef HW_TOUCH_FILTER_DEADBAND
+#undef HW_TOUCH_INIT_CODE
+#undef HW_TOUCH_MAP_LANDSCAPE
+#undef HW_TOUCH_MAP_PORTRAIT
+#undef HW_TOUCH_MAP_LANDSCAPE_INV
+#undef HW_TOUCH_MAP_PORTRAIT_INV
+#undef HW_TOUCH_INVERT_X_ROT0
+#undef HW_TOUCH_INVERT_X_ROT1
+#undef HW_TOUCH_INVERT_X_ROT2
+#undef HW_TOUCH_INVERT_X_ROT3
+#undef HW_TOUCH_INVERT_Y_ROT0
+#undef HW_TOUCH_INVERT_Y_ROT1
+#undef HW_TOUCH_INVERT_Y_ROT2
+#undef HW_TOUCH_INVERT_Y_ROT3
+
+// Zusätzliche Hardware, Orientierung
+#undef HW_LED_RED_PIN
+#undef HW_LED_GREEN_PIN
+#undef HW_LED_BLUE_PIN
+#undef HW_LED_INVERTED
+#undef HW_RS485_RX_PIN
+#undef HW_RS485_TX_PIN
+#undef HW_RS485_UART
+#undef HW_RS485_BAUD
+#undef HW_ROTATION_PORTRAIT_NORMAL
+#undef HW_ROTATION_LANDSCAPE_LEFT
+#undef HW_ROTATION_PORTRAIT_INVERTED
+#undef HW_ROTATION_LANDSCAPE_RIGHT
+
+// Features
+#undef HW_HAS_BACKLIGHT_CONTROL
+#undef HW_HAS_PWM_BACKLIGHT
+#undef HW_HAS_RGB_LED
+#undef HW_HAS_RS485
+#undef HW_HAS_TOUCH
+#undef HW_HAS_MULTITOUCH
+#undef HW_AUTO_DETECT
+#undef HW_HAS_SD_CARD
+#undef HW_HAS_SPEAKER
+#undef HW_HAS_WIFI
+#undef HW_HAS_BLUETOOTH
+#undef HW_PROFILE_FEATURES
+
+// Dual-Core, Board-Code
+#undef HW_BOARD_DETECTION_CODE
+#undef HW_RENDER_CORE
+#undef HW_IO_CORE
+#undef HW_IO_TASK_PERIOD_MS
+
+// TFT_eSPI Mapping
+#undef TFT_ESPI_DRIVER
+#undef TFT_ESPI_WIDTH
+#undef TFT_ESPI_HEIGHT
+#undef TFT_ESPI_MISO
+#undef TFT_ESPI_MOSI
+#undef TFT_ESPI_SCLK
+#undef TFT_ESPI_CS
+#undef TFT_ESPI_DC
+#undef TFT_ESPI_RST
+#undef TFT_ESPI_SPI_PORT
+#undef TFT_ESPI_SPI_FREQ
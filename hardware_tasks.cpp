@@ -0,0 +1,189 @@
+/**
+ * hardware_tasks.cpp - Dual-Core Betrieb des Hardware Managers
+ *
+ * Render-Task (HW_RENDER_CORE): ruft die Frame-Funktion der Anwendung
+ * auf und besitzt damit tft. Input/IO-Task (HW_IO_CORE): verarbeitet
+ * Touch-Samples im festen Takt, liest Serial und führt Backlight-
+ * Kommandos aus; er steuert auch die Energiesparstufen (updatePower).
+ * Beide tauschen sich nur über die SPSC-Ringe aus, die
+ * Touch-Latenz hängt so nicht mehr von der Dauer eines Frames ab.
+ */
+
+#include "config.h"
+#include "hardware_hal.h"
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::startTaskSplit(HardwareFrameFn frame, void* context) {
+  if (isTaskSplitActive()) return true;
+  if (!frame) return false;
+  waitBootComplete();  // Touch und Backlight gehören danach dem IO-Task
+
+  frameFn = frame;
+  frameContext = context;
+  tasksStopping = false;
+  serialQueue.clear();
+  ioCommands.clear();
+
+  // Touch-Samples mit Zeitstempel aus dem IRQ-Sampler (XPT2046; kapazitive
+  // Controller liest der IO-Task nach ihrer INT-Flanke)
+  tasksStartedSampler = !touchSamplerActive() && startTouchSampling();
+
+  if (xTaskCreatePinnedToCore(ioTaskMain, "hw_io", HW_IO_TASK_STACK, this,
+                              HW_IO_TASK_PRIORITY, &ioTask, HW_IO_CORE) != pdPASS) {
+    ioTask = nullptr;
+    if (tasksStartedSampler) {
+      touchSamplerStop();  // Ohne IO-Task kein Konsument
+      tasksStartedSampler = false;
+    }
+    Serial.println("ERROR: IO-Task konnte nicht gestartet werden");
+    return false;
+  }
+
+  if (xTaskCreatePinnedToCore(renderTaskMain, "hw_render", HW_RENDER_TASK_STACK, this,
+                              HW_RENDER_TASK_PRIORITY, &renderTask, HW_RENDER_CORE) != pdPASS) {
+    renderTask = nullptr;
+    stopTaskSplit();  // Beendet nur den IO-Task, das Aufräumen des Render-Tasks fehlt
+    if (tasksStartedSampler) {
+      touchSamplerStop();
+      tasksStartedSampler = false;
+    }
+    Serial.println("ERROR: Render-Task konnte nicht gestartet werden");
+    return false;
+  }
+
+  Serial.printf("Dual-Core aktiv: Render-Task Core %d, IO-Task Core %d (%d ms)\n",
+                HW_RENDER_CORE, HW_IO_CORE, HW_IO_TASK_PERIOD_MS);
+  return true;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::stopTaskSplit() {
+  if (!isTaskSplitActive()) return;
+  tasksStopping = true;
+
+  // Aus dem Render-Task: der Task beendet sich nach dem laufenden Frame
+  if (renderTask && xTaskGetCurrentTaskHandle() == renderTask) return;
+
+  while (renderTask || ioTask) {
+    vTaskDelay(1);
+  }
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::isTaskSplitActive() {
+  return renderTask != nullptr || ioTask != nullptr;
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::onIoTask() {
+  return xTaskGetCurrentTaskHandle() == ioTask;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::lockDisplay() {
+  if (displayMutex) xSemaphoreTakeRecursive(displayMutex, portMAX_DELAY);
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::unlockDisplay() {
+  if (displayMutex) xSemaphoreGiveRecursive(displayMutex);
+}
+
+template <typename Profile>
+bool HardwareManagerT<Profile>::readSerialCommand(char* cmd) {
+  if (ioTask) {
+    return serialQueue.pop(cmd);
+  }
+  if (Serial.available()) {
+    *cmd = Serial.read();
+    notifyActivity();
+    return true;
+  }
+  return false;
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::ioTaskMain(void* param) {
+  HardwareManagerT* hw = (HardwareManagerT*)param;
+  TickType_t lastWake = xTaskGetTickCount();
+
+  while (!hw->tasksStopping) {
+    // Samples -> Gesten/Events (Konsument des Sampler-Rings)
+    hw->processTouch();
+
+    // Serial -> Anwendung; bei voller Queue bleiben Zeichen im UART-Puffer
+    while (Serial.available() && hw->serialQueue.size() < hw->serialQueue.capacity()) {
+      hw->serialQueue.push((char)Serial.read());
+      hw->notifyActivity();
+    }
+
+    IoCommand cmd;
+    while (hw->ioCommands.pop(&cmd)) {
+      switch (cmd.type) {
+        case IO_CMD_BRIGHTNESS: hw->applyBrightness(cmd.value, cmd.durationMs); break;
+      }
+    }
+
+    // Dimmen, Display aus, Light-Sleep (blockiert bis zum Wecken)
+    hw->updatePower();
+
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(HW_IO_TASK_PERIOD_MS));
+  }
+
+  hw->ioTask = nullptr;
+  vTaskDelete(nullptr);
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::renderTaskMain(void* param) {
+  HardwareManagerT* hw = (HardwareManagerT*)param;
+
+  while (!hw->tasksStopping) {
+    if (!hw->isDisplayAwake()) {
+      // Panel schläft: kein Rendern, wakePower() weckt per Notification
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(POWER_RENDER_IDLE_MS));
+      continue;
+    }
+    hw->frameFn(hw->frameContext);
+    // Offenen DMA-Frame abschließen: der Host gehört sonst bis zum nächsten
+    // Frame dem Display, IO-Task und Sampler warten so höchstens einen Frame
+    hw->lockDisplay();
+    hw->stripRenderer.sync();
+    hw->unlockDisplay();
+    vTaskDelay(1);  // Idle-Task (Watchdog) auf diesem Core laufen lassen
+  }
+
+  // Aufräumen übernimmt der Render-Task, auch wenn stop aus ihm selbst kam
+  while (hw->ioTask) {
+    vTaskDelay(1);
+  }
+  if (hw->tasksStartedSampler) {
+    touchSamplerStop();
+    hw->tasksStartedSampler = false;
+  }
+  Serial.println("Dual-Core beendet - Single-Loop aktiv");
+
+  hw->renderTask = nullptr;
+  vTaskDelete(nullptr);
+}
+
+template <typename Profile>
+void HardwareManagerT<Profile>::bootTaskMain(void* param) {
+  HardwareManagerT* hw = (HardwareManagerT*)param;
+  hw->runBootStages();
+  hw->bootTask = nullptr;
+  vTaskDelete(nullptr);
+}
+
+// Explizite Instanzierung der hier definierten Members
+// (die Klasse selbst instanziert hardware_manager.cpp)
+template bool HardwareManagerT<HardwareManagerProfile>::startTaskSplit(HardwareFrameFn, void*);
+template void HardwareManagerT<HardwareManagerProfile>::stopTaskSplit();
+template bool HardwareManagerT<HardwareManagerProfile>::isTaskSplitActive();
+template bool HardwareManagerT<HardwareManagerProfile>::onIoTask();
+template void HardwareManagerT<HardwareManagerProfile>::lockDisplay();
+template void HardwareManagerT<HardwareManagerProfile>::unlockDisplay();
+template bool HardwareManagerT<HardwareManagerProfile>::readSerialCommand(char*);
+template void HardwareManagerT<HardwareManagerProfile>::ioTaskMain(void*);
+template void HardwareManagerT<HardwareManagerProfile>::renderTaskMain(void*);
+template void HardwareManagerT<HardwareManagerProfile>::bootTaskMain(void*);
@@ -0,0 +1,133 @@
+/**
+ * hw_trace.cpp - Trace-Ring und Export
+ */
+
+#include "config.h"    // HW_TRACE
+#include "hw_trace.h"
+
+#if HW_TRACE
+
+#include <Arduino.h>
+#include <string.h>
+
+static_assert((HW_TRACE_EVENTS & (HW_TRACE_EVENTS - 1)) == 0,
+              "HW_TRACE_EVENTS muss eine Zweierpotenz sein");
+static_assert(HW_TRACE_NAMES < HW_TRACE_NO_NAME, "HW_TRACE_NAMES zu groß");
+
+static HwTraceEvent traceEvents[HW_TRACE_EVENTS];
+static const char* traceNames[HW_TRACE_NAMES];
+static uint8_t traceNameCount = 0;
+static uint32_t traceHead = 0;            // Ereignisse seit hwTraceClear()
+static volatile bool traceFrozen = false; // Während des Exports nicht schreiben
+static portMUX_TYPE traceMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ============================================
+// AUFZEICHNUNG
+// ============================================
+
+uint8_t hwTraceName(const char* name) {
+  uint8_t index = HW_TRACE_NO_NAME;
+  portENTER_CRITICAL(&traceMux);
+  for (uint8_t i = 0; i < traceNameCount; i++) {
+    if (traceNames[i] == name || !strcmp(traceNames[i], name)) {
+      index = i;
+      break;
+    }
+  }
+  if (index == HW_TRACE_NO_NAME && traceNameCount < HW_TRACE_NAMES) {
+    index = traceNameCount;
+    traceNames[traceNameCount++] = name;
+  }
+  portEXIT_CRITICAL(&traceMux);
+  return index;
+}
+
+void hwTraceRecord(uint8_t name, uint8_t phase) {
+  if (name == HW_TRACE_NO_NAME || traceFrozen) return;
+
+  // Zeitstempel im kritischen Abschnitt: Ring bleibt über beide Cores sortiert
+  portENTER_CRITICAL(&traceMux);
+  HwTraceEvent& event = traceEvents[traceHead & (HW_TRACE_EVENTS - 1)];
+  event.timestampUs = micros();
+  event.name = name;
+  event.phase = phase;
+  event.core = (uint8_t)xPortGetCoreID();
+  event.reserved = 0;
+  traceHead++;
+  portEXIT_CRITICAL(&traceMux);
+}
+
+void hwTraceClear() {
+  portENTER_CRITICAL(&traceMux);
+  traceHead = 0;
+  portEXIT_CRITICAL(&traceMux);
+}
+
+uint32_t hwTraceCount() {
+  return traceHead < HW_TRACE_EVENTS ? traceHead : HW_TRACE_EVENTS;
+}
+
+uint32_t hwTraceDropped() {
+  return traceHead - hwTraceCount();
+}
+
+// ============================================
+// EXPORT
+// ============================================
+
+static const char* traceNameOf(uint8_t name) {
+  return name < traceNameCount ? traceNames[name] : "?";
+}
+
+bool hwTraceDump(HwTraceFormat format, HwTraceWriteFn write, void* context) {
+  traceFrozen = true;
+
+  HwTraceHeader header;
+  header.version = HW_TRACE_VERSION;
+  header.nameCount = traceNameCount;
+  header.eventCount = hwTraceCount();
+  header.dropped = hwTraceDropped();
+  const uint32_t first = traceHead - header.eventCount;
+
+  if (format == HW_TRACE_FORMAT_BINARY) {
+    uint8_t buffer[HW_TRACE_NAME_MAX + 1];
+    hwTraceEncodeHeader(buffer, header);
+    write(buffer, HW_TRACE_HEADER_SIZE, context);
+    for (uint8_t i = 0; i < header.nameCount; i++) {
+      const size_t length = strnlen(traceNames[i], HW_TRACE_NAME_MAX);
+      buffer[0] = (uint8_t)length;
+      memcpy(buffer + 1, traceNames[i], length);
+      write(buffer, length + 1, context);
+    }
+    for (uint32_t i = 0; i < header.eventCount; i++) {
+      hwTraceEncodeEvent(buffer, traceEvents[(first + i) & (HW_TRACE_EVENTS - 1)]);
+      write(buffer, HW_TRACE_EVENT_SIZE, context);
+    }
+  } else {
+    char line[HW_TRACE_NAME_MAX + 96];
+    write((const uint8_t*)HW_TRACE_JSON_BEGIN, strlen(HW_TRACE_JSON_BEGIN), context);
+    for (uint32_t i = 0; i < header.eventCount; i++) {
+      const HwTraceEvent& event = traceEvents[(first + i) & (HW_TRACE_EVENTS - 1)];
+      char name[HW_TRACE_NAME_MAX + 1];
+      strncpy(name, traceNameOf(event.name), HW_TRACE_NAME_MAX);
+      name[HW_TRACE_NAME_MAX] = '\0';   // Wie im Binärformat gekürzt
+      const int length = hwTraceFormatJsonEvent(line, sizeof(line), name, event, i == 0);
+      write((const uint8_t*)line, length, context);
+    }
+    const int length = hwTraceFormatJsonEnd(line, sizeof(line), header);
+    write((const uint8_t*)line, length, context);
+  }
+
+  traceFrozen = false;
+  return true;
+}
+
+static void writeSerial(const uint8_t* data, size_t length, void* context) {
+  Serial.write(data, length);
+}
+
+bool hwTraceDumpSerial(HwTraceFormat format) {
+  return hwTraceDump(format, writeSerial, nullptr);
+}
+
+#endif // HW_TRACE
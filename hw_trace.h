@@ -0,0 +1,212 @@
+/**
+ * hw_trace.h - Phasen-Tracing für Boot und HAL
+ *
+ * Begin/End-Ereignisse mit micros()-Zeitstempel und Core-ID landen in
+ * einem festen, vorab belegten Ring (älteste Ereignisse werden
+ * überschrieben). Export über Serial als kompaktes Binärformat oder als
+ * Chrome Trace-Event JSON (chrome://tracing, Perfetto).
+ *
+ *   void HardwareManager::initDisplay() {
+ *     HW_TRACE_SCOPE("initDisplay");     // Begin hier, End am Scope-Ende
+ *     ...
+ *
+ * Mit HW_TRACE false (Standard) sind die Makros leer, Ring und Code
+ * entfallen vollständig.
+ *
+ * Das Format (Kodierung, JSON) ist reines C++ ohne Arduino und wird vom
+ * Gerät, vom Host-Simulator und vom Konverter
+ * (simulator/tools/hw_trace_convert.cpp) gemeinsam benutzt.
+ */
+
+#ifndef HW_TRACE_H
+#define HW_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#ifndef HW_TRACE
+  #define HW_TRACE false
+#endif
+
+#define HW_TRACE_EVENTS      512    // Zweierpotenz, 8 Bytes pro Ereignis
+#define HW_TRACE_NAMES       32     // Verschiedene Scope-Namen
+#define HW_TRACE_NAME_MAX    31     // Zeichen pro Name im Export
+#define HW_TRACE_NO_NAME     0xFF   // Namenstabelle voll: Ereignis verwerfen
+
+// ============================================
+// BINÄRFORMAT (Little Endian)
+// ============================================
+//
+//   Header   16 Bytes  "HWTR", Version u16, Namen u16, Ereignisse u32,
+//                      verworfen u32
+//   Namen    je 1 Byte Länge + Zeichen (ohne Nullbyte)
+//   Ereignis  8 Bytes  Zeitstempel µs u32, Name u8, Phase u8, Core u8, 0
+
+#define HW_TRACE_MAGIC        "HWTR"
+#define HW_TRACE_VERSION      1
+#define HW_TRACE_HEADER_SIZE  16
+#define HW_TRACE_EVENT_SIZE   8
+
+enum HwTracePhase : uint8_t {
+  HW_TRACE_PHASE_BEGIN   = 'B',
+  HW_TRACE_PHASE_END     = 'E',
+  HW_TRACE_PHASE_INSTANT = 'i'
+};
+
+enum HwTraceFormat : uint8_t {
+  HW_TRACE_FORMAT_BINARY,
+  HW_TRACE_FORMAT_JSON
+};
+
+struct HwTraceEvent {
+  uint32_t timestampUs;
+  uint8_t name;          // Index in die Namenstabelle
+  uint8_t phase;         // HwTracePhase
+  uint8_t core;
+  uint8_t reserved;
+};
+
+struct HwTraceHeader {
+  uint16_t version;
+  uint16_t nameCount;
+  uint32_t eventCount;
+  uint32_t dropped;      // Überschriebene Ereignisse
+};
+
+// Ziel des Exports: Serial, Datei, Puffer
+typedef void (*HwTraceWriteFn)(const uint8_t* data, size_t length, void* context);
+
+inline void hwTracePut16(uint8_t* out, uint16_t value) {
+  out[0] = (uint8_t)value;
+  out[1] = (uint8_t)(value >> 8);
+}
+
+inline void hwTracePut32(uint8_t* out, uint32_t value) {
+  hwTracePut16(out, (uint16_t)value);
+  hwTracePut16(out + 2, (uint16_t)(value >> 16));
+}
+
+inline uint16_t hwTraceGet16(const uint8_t* in) {
+  return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+inline uint32_t hwTraceGet32(const uint8_t* in) {
+  return hwTraceGet16(in) | ((uint32_t)hwTraceGet16(in + 2) << 16);
+}
+
+inline void hwTraceEncodeHeader(uint8_t out[HW_TRACE_HEADER_SIZE], const HwTraceHeader& header) {
+  for (int i = 0; i < 4; i++) out[i] = (uint8_t)HW_TRACE_MAGIC[i];
+  hwTracePut16(out + 4, header.version);
+  hwTracePut16(out + 6, header.nameCount);
+  hwTracePut32(out + 8, header.eventCount);
+  hwTracePut32(out + 12, header.dropped);
+}
+
+inline bool hwTraceDecodeHeader(const uint8_t in[HW_TRACE_HEADER_SIZE], HwTraceHeader* header) {
+  for (int i = 0; i < 4; i++) {
+    if (in[i] != (uint8_t)HW_TRACE_MAGIC[i]) return false;
+  }
+  header->version = hwTraceGet16(in + 4);
+  header->nameCount = hwTraceGet16(in + 6);
+  header->eventCount = hwTraceGet32(in + 8);
+  header->dropped = hwTraceGet32(in + 12);
+  return header->version == HW_TRACE_VERSION && header->nameCount <= HW_TRACE_NAMES;
+}
+
+inline void hwTraceEncodeEvent(uint8_t out[HW_TRACE_EVENT_SIZE], const HwTraceEvent& event) {
+  hwTracePut32(out, event.timestampUs);
+  out[4] = event.name;
+  out[5] = event.phase;
+  out[6] = event.core;
+  out[7] = 0;
+}
+
+inline HwTraceEvent hwTraceDecodeEvent(const uint8_t in[HW_TRACE_EVENT_SIZE]) {
+  HwTraceEvent event;
+  event.timestampUs = hwTraceGet32(in);
+  event.name = in[4];
+  event.phase = in[5];
+  event.core = in[6];
+  event.reserved = 0;
+  return event;
+}
+
+// ============================================
+// CHROME TRACE-EVENT JSON
+// ============================================
+//
+// Eine Zeile pro Ereignis, pid 1, tid = Core. Gerät und Konverter
+// erzeugen damit byte-gleiches JSON aus denselben Daten.
+
+#define HW_TRACE_JSON_BEGIN  "{\"traceEvents\":[\n"
+
+inline int hwTraceFormatJsonEvent(char* out, size_t size, const char* name,
+                                  const HwTraceEvent& event, bool first) {
+  return snprintf(out, size, "%s{\"name\":\"%s\",\"ph\":\"%c\",%s\"ts\":%lu,\"pid\":1,\"tid\":%u}",
+                  first ? "" : ",\n", name, (char)event.phase,
+                  event.phase == HW_TRACE_PHASE_INSTANT ? "\"s\":\"t\"," : "",
+                  (unsigned long)event.timestampUs, (unsigned)event.core);
+}
+
+inline int hwTraceFormatJsonEnd(char* out, size_t size, const HwTraceHeader& header) {
+  return snprintf(out, size,
+                  "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"version\":%u,\"dropped\":%lu}}\n",
+                  (unsigned)header.version, (unsigned long)header.dropped);
+}
+
+// ============================================
+// AUFZEICHNUNG (hw_trace.cpp)
+// ============================================
+
+#if HW_TRACE
+
+uint8_t hwTraceName(const char* name);             // Namen eintragen, HW_TRACE_NO_NAME = voll
+void hwTraceRecord(uint8_t name, uint8_t phase);
+void hwTraceClear();
+uint32_t hwTraceCount();                           // Ereignisse im Ring
+uint32_t hwTraceDropped();
+bool hwTraceDump(HwTraceFormat format, HwTraceWriteFn write, void* context);
+bool hwTraceDumpSerial(HwTraceFormat format);
+
+class HwTraceScope {
+private:
+  uint8_t name;
+
+public:
+  explicit HwTraceScope(uint8_t traceName) : name(traceName) {
+    hwTraceRecord(name, HW_TRACE_PHASE_BEGIN);
+  }
+  ~HwTraceScope() { hwTraceRecord(name, HW_TRACE_PHASE_END); }
+  HwTraceScope(const HwTraceScope&) = delete;
+  HwTraceScope& operator=(const HwTraceScope&) = delete;
+};
+
+#define HW_TRACE_CONCAT_(a, b) a##b
+#define HW_TRACE_CONCAT(a, b)  HW_TRACE_CONCAT_(a, b)
+
+// Name einmal pro Aufrufstelle eintragen, danach nur noch Index + Zeit
+#define HW_TRACE_SCOPE(name)                                                      \
+  static const uint8_t HW_TRACE_CONCAT(hwTraceId_, __LINE__) = hwTraceName(name); \
+  HwTraceScope HW_TRACE_CONCAT(hwTraceScope_, __LINE__)(HW_TRACE_CONCAT(hwTraceId_, __LINE__))
+
+#define HW_TRACE_INSTANT(name) hwTraceRecord(hwTraceName(name), HW_TRACE_PHASE_INSTANT)
+
+#else
+
+inline void hwTraceClear() {}
+inline uint32_t hwTraceCount() { return 0; }
+inline uint32_t hwTraceDropped() { return 0; }
+inline bool hwTraceDump(HwTraceFormat, HwTraceWriteFn, void*) { return false; }
+inline bool hwTraceDumpSerial(HwTraceFormat) { return false; }
+
+#define HW_TRACE_SCOPE(name)   do {} while (0)
+#define HW_TRACE_INSTANT(name) do {} while (0)
+
+#endif // HW_TRACE
+
+#endif // HW_TRACE_H
@@ -0,0 +1,221 @@
+/**
+ * image_asset.h - Komprimiertes RGB565-Bildformat und Decoder
+ *
+ * Logos, Icons und Hintergründe liegen als const-Array im Flash
+ * (memory-mapped, ohne Kopie ins RAM) und werden zeilenweise dekodiert:
+ *
+ *   RAW      Breite * Höhe RGB565-Pixel
+ *   RLE      Läufe und Literale aus RGB565-Pixeln
+ *   PALETTE  Wie RLE, aber 8-Bit Indizes in eine Palette (<= 256 Farben)
+ *
+ * Erzeugt werden die Assets auf dem Host mit simulator/tools/image_pack
+ * (PPM -> .hwim bzw. C-Header). Das Format ist reines C++ ohne Arduino
+ * und wird von Gerät, Simulator und Packer gemeinsam benutzt.
+ */
+
+#ifndef IMAGE_ASSET_H
+#define IMAGE_ASSET_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================
+// FORMAT (Little Endian)
+// ============================================
+//
+//   Header   20 Bytes  "HWIM", Version u8, Kodierung u8, Flags u8, 0,
+//                      Breite u16, Höhe u16, Palette u16 (Einträge), 0 u16,
+//                      Daten u32 (Bytes nach der Palette)
+//   Palette  Einträge * u16 RGB565
+//   Daten    Zeile für Zeile; bei RLE/PALETTE je Token ein Byte:
+//              Bit 7 = 1: Lauf, (Bit 0-6) + 1 Mal derselbe Wert
+//              Bit 7 = 0: Literal, (Bit 0-6) + 1 Werte folgen
+//            Wert = u16 Pixel (RLE) bzw. u8 Palettenindex (PALETTE).
+//            Läufe und Literale enden spätestens am Zeilenende.
+
+#define IMAGE_MAGIC        "HWIM"
+#define IMAGE_VERSION      1
+#define IMAGE_HEADER_SIZE  20
+#define IMAGE_RUN_FLAG     0x80
+#define IMAGE_TOKEN_MAX    128      // Werte pro Token
+#define IMAGE_PALETTE_MAX  256
+
+enum ImageEncoding : uint8_t {
+  IMAGE_ENC_RAW,
+  IMAGE_ENC_RLE,
+  IMAGE_ENC_PALETTE
+};
+
+// Farbformat der gespeicherten Pixel
+#define IMAGE_FLAG_BGR       0x01   // Rot und Blau vertauscht
+#define IMAGE_FLAG_INVERTED  0x02   // Für ein Panel ohne INVON vorinvertiert
+
+struct ImageHeader {
+  uint8_t encoding;        // ImageEncoding
+  uint8_t flags;           // IMAGE_FLAG_*
+  uint16_t width, height;
+  uint16_t paletteCount;
+  uint32_t dataSize;
+};
+
+inline uint16_t imageGet16(const uint8_t* in) {
+  return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+inline uint32_t imageGet32(const uint8_t* in) {
+  return imageGet16(in) | ((uint32_t)imageGet16(in + 2) << 16);
+}
+
+inline void imagePut16(uint8_t* out, uint16_t value) {
+  out[0] = (uint8_t)value;
+  out[1] = (uint8_t)(value >> 8);
+}
+
+inline void imagePut32(uint8_t* out, uint32_t value) {
+  imagePut16(out, (uint16_t)value);
+  imagePut16(out + 2, (uint16_t)(value >> 16));
+}
+
+inline void imageEncodeHeader(uint8_t out[IMAGE_HEADER_SIZE], const ImageHeader& header) {
+  for (int i = 0; i < 4; i++) out[i] = (uint8_t)IMAGE_MAGIC[i];
+  out[4] = IMAGE_VERSION;
+  out[5] = header.encoding;
+  out[6] = header.flags;
+  out[7] = 0;
+  imagePut16(out + 8, header.width);
+  imagePut16(out + 10, header.height);
+  imagePut16(out + 12, header.paletteCount);
+  imagePut16(out + 14, 0);
+  imagePut32(out + 16, header.dataSize);
+}
+
+inline bool imageDecodeHeader(const uint8_t* in, ImageHeader* header) {
+  for (int i = 0; i < 4; i++) {
+    if (in[i] != (uint8_t)IMAGE_MAGIC[i]) return false;
+  }
+  header->encoding = in[5];
+  header->flags = in[6];
+  header->width = imageGet16(in + 8);
+  header->height = imageGet16(in + 10);
+  header->paletteCount = imageGet16(in + 12);
+  header->dataSize = imageGet32(in + 16);
+  return in[4] == IMAGE_VERSION && header->encoding <= IMAGE_ENC_PALETTE &&
+         header->width > 0 && header->height > 0 && header->paletteCount <= IMAGE_PALETTE_MAX &&
+         (header->encoding == IMAGE_ENC_PALETTE) == (header->paletteCount > 0);
+}
+
+inline size_t imageAssetSize(const ImageHeader& header) {
+  return IMAGE_HEADER_SIZE + header.paletteCount * 2 + header.dataSize;
+}
+
+// ============================================
+// FARBEN
+// ============================================
+
+inline uint16_t imageSwapRedBlue(uint16_t color) {
+  return (uint16_t)((color << 11) | (color & 0x07E0) | (color >> 11));
+}
+
+// Gespeichertes Format (from) -> gewünschtes Format (to), IMAGE_FLAG_*
+inline uint16_t imageConvertColor(uint16_t color, uint8_t from, uint8_t to) {
+  if ((from ^ to) & IMAGE_FLAG_INVERTED) color = (uint16_t)~color;
+  if ((from ^ to) & IMAGE_FLAG_BGR) color = imageSwapRedBlue(color);
+  return color;
+}
+
+inline uint16_t imageSwapBytes(uint16_t color) {
+  return (uint16_t)((color << 8) | (color >> 8));
+}
+
+// ============================================
+// DECODER
+// ============================================
+
+// Dekodiert Zeile für Zeile direkt aus dem Asset (Flash oder RAM).
+// Ausgabe im Zielformat 'flags', optional schon in Display-Byte-Reihenfolge.
+class ImageDecoder {
+public:
+  ImageDecoder() : data(nullptr), end(nullptr), row(0), swap(false), targetFlags(0), header() {}
+
+  bool begin(const uint8_t* asset, uint8_t flags = 0, bool swapBytes = false) {
+    if (!imageDecodeHeader(asset, &header)) return false;
+    const uint8_t* palette = asset + IMAGE_HEADER_SIZE;
+    for (uint16_t i = 0; i < header.paletteCount; i++) {
+      colors[i] = output(imageGet16(palette + i * 2), flags, swapBytes);
+    }
+    data = palette + header.paletteCount * 2;
+    end = data + header.dataSize;
+    row = 0;
+    swap = swapBytes;
+    targetFlags = flags;
+    return header.encoding != IMAGE_ENC_RAW ||
+           header.dataSize >= (uint32_t)header.width * header.height * 2;
+  }
+
+  const ImageHeader& info() const { return header; }
+  uint16_t currentRow() const { return row; }
+
+  // Nächste Zeile; nur Spalten [x0, x1) landen in out (out[0] = Spalte x0).
+  // out == nullptr überspringt die Zeile. false = Daten beschädigt/zu Ende.
+  bool decodeRow(uint16_t* out, uint16_t x0, uint16_t x1) {
+    if (row >= header.height) return false;
+    row++;
+
+    if (header.encoding == IMAGE_ENC_RAW) {
+      const uint8_t* pixels = data;
+      data += header.width * 2;
+      if (!out) return true;
+      for (uint16_t x = x0; x < x1; x++) *out++ = pixel(imageGet16(pixels + x * 2));
+      return true;
+    }
+
+    const bool indexed = header.encoding == IMAGE_ENC_PALETTE;
+    const uint8_t valueSize = indexed ? 1 : 2;
+    uint16_t x = 0;
+    while (x < header.width) {
+      if (data >= end) return false;
+      const uint8_t token = *data++;
+      const uint16_t count = (token & ~IMAGE_RUN_FLAG) + 1;
+      if (x + count > header.width) return false;
+      const uint16_t from = x < x0 ? x0 : x;
+      const uint16_t to = x + count > x1 ? x1 : x + count;
+
+      if (token & IMAGE_RUN_FLAG) {
+        if (data + valueSize > end) return false;
+        if (out && from < to) {
+          const uint16_t color = indexed ? colors[*data] : pixel(imageGet16(data));
+          for (uint16_t i = from; i < to; i++) out[i - x0] = color;
+        }
+        data += valueSize;
+      } else {
+        if (data + count * valueSize > end) return false;
+        if (out) {
+          for (uint16_t i = from; i < to; i++) {
+            const uint8_t* value = data + (i - x) * valueSize;
+            out[i - x0] = indexed ? colors[*value] : pixel(imageGet16(value));
+          }
+        }
+        data += count * valueSize;
+      }
+      x += count;
+    }
+    return true;
+  }
+
+private:
+  uint16_t output(uint16_t color, uint8_t to, bool swapBytes) const {
+    color = imageConvertColor(color, header.flags, to);
+    return swapBytes ? imageSwapBytes(color) : color;
+  }
+  uint16_t pixel(uint16_t color) const { return output(color, targetFlags, swap); }
+
+  const uint8_t* data;
+  const uint8_t* end;
+  uint16_t row;
+  bool swap;
+  uint8_t targetFlags;
+  ImageHeader header;
+  uint16_t colors[IMAGE_PALETTE_MAX];   // Palette im Zielformat
+};
+
+#endif // IMAGE_ASSET_H
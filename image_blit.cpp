@@ -0,0 +1,116 @@
+/**
+ * image_blit.cpp - Zeilenweise dekodieren, Puffer per DMA überlappend senden
+ */
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <esp_heap_caps.h>
+#include "image_blit.h"
+#include "spi_arbiter.h"
+
+ImageBlitter::ImageBlitter(const SpiDevice& display)
+  : device(display), buffers{ nullptr, nullptr }, bufferPixels(0), decoder(), counters() {}
+
+bool ImageBlitter::begin(uint32_t pixels) {
+  if (buffers[0]) return true;
+  for (int i = 0; i < 2; i++) {
+    buffers[i] = (uint16_t*)heap_caps_malloc(pixels * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    if (!buffers[i]) {
+      end();
+      return false;
+    }
+  }
+  bufferPixels = pixels;
+  return true;
+}
+
+void ImageBlitter::end() {
+  for (int i = 0; i < 2; i++) {
+    heap_caps_free(buffers[i]);
+    buffers[i] = nullptr;
+  }
+  bufferPixels = 0;
+}
+
+bool ImageBlitter::draw(TFT_eSPI& tft, const uint8_t* asset, int32_t x, int32_t y, bool useDMA,
+                        uint8_t panelFlags) {
+  const uint32_t start = micros();
+
+  // Puffer schon in Display-Byte-Reihenfolge, wie die Sprite-Puffer
+  if (!asset || !decoder.begin(asset, panelFlags, true)) {
+    counters.errors++;
+    return false;
+  }
+  const ImageHeader& header = decoder.info();
+
+  // Sichtbarer Ausschnitt in Bildkoordinaten
+  const int32_t left = max((int32_t)0, -x);
+  const int32_t top = max((int32_t)0, -y);
+  const int32_t right = min((int32_t)header.width, (int32_t)tft.width() - x);
+  const int32_t bottom = min((int32_t)header.height, (int32_t)tft.height() - y);
+  counters.images++;
+  counters.assetBytes += imageAssetSize(header);
+  if (left >= right || top >= bottom) return true;
+
+  const uint16_t width = right - left;
+  if (!begin() || width > bufferPixels) {
+    counters.errors++;
+    return false;
+  }
+  const uint16_t chunkRows = bufferPixels / width;
+
+  bool ok = true;
+  uint32_t decodeStart = micros();
+  for (int32_t row = 0; row < top && ok; row++) {
+    ok = decoder.decodeRow(nullptr, 0, 0);
+  }
+  counters.decodeMicros += micros() - decodeStart;
+
+  const bool swap = tft.getSwapBytes();
+  tft.setSwapBytes(false);
+  spiArbiter.acquire(device);
+  tft.startWrite();
+
+  uint32_t chunks = 0;
+  for (int32_t chunkY = top; chunkY < bottom && ok; chunkY += chunkRows) {
+    const uint16_t rows = min((int32_t)chunkRows, bottom - chunkY);
+    uint16_t* pixels = buffers[chunks & 1];
+
+    // Dekodieren, während der andere Puffer noch per DMA läuft
+    decodeStart = micros();
+    for (uint16_t row = 0; row < rows && ok; row++) {
+      ok = decoder.decodeRow(pixels + row * width, left, right);
+    }
+    counters.decodeMicros += micros() - decodeStart;
+    if (!ok) break;
+
+    // Chunk-Grenze: wartendes Touch-Sample vorlassen
+    if (spiArbiter.yieldRequested(device)) {
+      if (useDMA) tft.dmaWait();
+      tft.endWrite();
+      spiArbiter.yield(device);
+      tft.startWrite();
+    }
+
+    if (useDMA) {
+      tft.pushImageDMA(x + left, y + chunkY, width, rows, pixels);  // Wartet auf den vorherigen Puffer
+    } else {
+      tft.pushImage(x + left, y + chunkY, width, rows, pixels);
+    }
+    counters.pixels += (uint32_t)width * rows;
+    chunks++;
+  }
+
+  if (useDMA) tft.dmaWait();
+  tft.endWrite();
+  spiArbiter.release(device);
+  tft.setSwapBytes(swap);
+
+  counters.chunks += chunks;
+  counters.totalMicros += micros() - start;
+  if (!ok) {
+    counters.errors++;
+    Serial.printf("⚠️ Bild-Asset beschädigt (Zeile %d von %d)\n", decoder.currentRow(), header.height);
+  }
+  return ok;
+}
@@ -0,0 +1,64 @@
+/**
+ * image_blit.h - Komprimierte Bilder (image_asset.h) direkt aus dem Flash zeichnen
+ *
+ * Das Asset bleibt im memory-mapped Flash. Dekodiert wird zeilenweise in
+ * zwei kleine DMA-fähige Puffer: während Puffer N per pushImageDMA läuft,
+ * entsteht Puffer N+1. Clipping am Bildschirmrand erfolgt beim Dekodieren,
+ * unsichtbare Spalten und Zeilen werden nur übersprungen.
+ */
+
+#ifndef IMAGE_BLIT_H
+#define IMAGE_BLIT_H
+
+#include <stdint.h>
+#include "image_asset.h"
+
+class TFT_eSPI;
+struct SpiDevice;
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#ifndef IMAGE_BLIT_BUFFER_PIXELS
+  #define IMAGE_BLIT_BUFFER_PIXELS 2048   // Pro Puffer, 2 x 4 KB DMA-RAM
+#endif
+
+struct ImageBlitStats {
+  uint32_t images;
+  uint32_t pixels;          // Sichtbar übertragen
+  uint32_t chunks;          // Übertragene Puffer
+  uint32_t assetBytes;      // Gelesene Asset-Größe (komprimiert)
+  uint32_t decodeMicros;    // CPU-Zeit im Decoder
+  uint32_t totalMicros;     // Aufruf bis Übertragung fertig
+  uint32_t errors;          // Ungültige/beschädigte Assets
+};
+
+// ============================================
+// IMAGE BLITTER
+// ============================================
+
+class ImageBlitter {
+public:
+  explicit ImageBlitter(const SpiDevice& display);   // Display am Bus-Arbiter
+
+  bool begin(uint32_t bufferPixels = IMAGE_BLIT_BUFFER_PIXELS);
+  void end();
+
+  // Asset an (x, y) zeichnen. panelFlags: IMAGE_FLAG_* die das Panel
+  // erwartet, abweichende Assets werden beim Dekodieren umgerechnet.
+  bool draw(TFT_eSPI& tft, const uint8_t* asset, int32_t x, int32_t y, bool useDMA,
+            uint8_t panelFlags = 0);
+
+  const ImageBlitStats& stats() const { return counters; }
+  void resetStats() { counters = ImageBlitStats(); }
+
+private:
+  const SpiDevice& device;
+  uint16_t* buffers[2];
+  uint32_t bufferPixels;
+  ImageDecoder decoder;     // Enthält die Palette im Zielformat
+  ImageBlitStats counters;
+};
+
+#endif // IMAGE_BLIT_H
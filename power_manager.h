@@ -0,0 +1,108 @@
+/**
+ * power_manager.h - Energiesparstufen bei Inaktivität
+ *
+ * Ohne Touch, Serial-Eingabe oder notifyActivity() durchläuft das Panel
+ * nach den konfigurierten Zeiten die Stufen:
+ *
+ *   AKTIV -> GEDIMMT -> DISPLAY AUS -> LIGHT-SLEEP
+ *            (Fade)     (Backlight 0,   (CPU schläft, Wecken per
+ *                        SLPIN, kein     HW_TOUCH_IRQ oder UART)
+ *                        Rendern)
+ *
+ * Das Panel behält im Sleep-Modus seinen Speicher: beim Aufwachen reicht
+ * SLPOUT und der Backlight-Fade, der letzte Frame steht ohne Neuzeichnen
+ * wieder da (Ziel < POWER_WAKE_BUDGET_US). Die Berührung, die das Panel
+ * aus DISPLAY AUS oder LIGHT-SLEEP weckt, wird bis zum Abheben verworfen,
+ * damit sie keine unsichtbare Schaltfläche auslöst.
+ *
+ * Gesteuert wird aus hardware.updatePower(): im Dual-Core Betrieb vom
+ * IO-Task, sonst einmal pro loop().
+ */
+
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <stdint.h>
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+// Zeit ohne Aktivität bis zur Stufe, 0 = Stufe aus
+#ifndef HW_POWER_DIM_MS
+  #define HW_POWER_DIM_MS       60000
+#endif
+
+#ifndef HW_POWER_OFF_MS
+  #define HW_POWER_OFF_MS       300000
+#endif
+
+#ifndef HW_POWER_SLEEP_MS
+  #define HW_POWER_SLEEP_MS     600000    // Nur mit HW_TOUCH_IRQ
+#endif
+
+#ifndef HW_POWER_DIM_PERCENT
+  #define HW_POWER_DIM_PERCENT  20
+#endif
+
+#define POWER_DIM_FADE_MS       1000     // Sanft abdunkeln
+#define POWER_WAKE_FADE_MS      50       // Schnell wieder hell
+#define POWER_SLPOUT_DELAY_MS   5        // ST7789/ILI9341: Takt läuft nach 5 ms
+#define POWER_SLEEP_GUARD_MS    120      // Mindestabstand SLPIN <-> SLPOUT
+#define POWER_WAKE_BUDGET_US    100000   // Ziel: letzter Frame sichtbar < 100 ms
+#define POWER_UART_WAKE_EDGES   3        // Flanken auf RX bis zum Wecken
+#define POWER_RENDER_IDLE_MS    100      // Render-Task bei schlafendem Display
+
+static_assert((POWER_SLPOUT_DELAY_MS + POWER_WAKE_FADE_MS) * 1000 < POWER_WAKE_BUDGET_US,
+              "Aufwachen passt nicht ins Budget");
+
+// ============================================
+// DATENSTRUKTUREN
+// ============================================
+
+enum PowerState : uint8_t {
+  POWER_ACTIVE,
+  POWER_DIM,             // Backlight auf dimPercent
+  POWER_DISPLAY_OFF,     // Backlight aus, Panel im Sleep, Render-Loop steht
+  POWER_LIGHT_SLEEP,     // Zusätzlich CPU im Light-Sleep
+  POWER_STATE_COUNT
+};
+
+struct PowerConfig {
+  uint32_t dimMs;        // 0 = Stufe aus
+  uint32_t offMs;
+  uint32_t sleepMs;
+  uint8_t dimPercent;
+};
+
+struct PowerStats {
+  uint64_t stateMs[POWER_STATE_COUNT];   // Verweildauer je Zustand
+  uint32_t wakeups;                      // Rückkehr nach AKTIV
+  uint32_t lightSleeps;
+  uint32_t lastWakeUs;                   // Aufwachen bis Fade-Start
+  uint32_t maxWakeUs;
+};
+
+constexpr PowerConfig powerConfigDefault() {
+  return PowerConfig{ HW_POWER_DIM_MS, HW_POWER_OFF_MS, HW_POWER_SLEEP_MS, HW_POWER_DIM_PERCENT };
+}
+
+// Zielzustand nach 'idleMs' ohne Aktivität
+constexpr PowerState powerStateForIdle(const PowerConfig& config, uint32_t idleMs, bool canSleep) {
+  return (canSleep && config.sleepMs && idleMs >= config.sleepMs) ? POWER_LIGHT_SLEEP :
+         (config.offMs && idleMs >= config.offMs)                 ? POWER_DISPLAY_OFF :
+         (config.dimMs && idleMs >= config.dimMs)                 ? POWER_DIM :
+                                                                    POWER_ACTIVE;
+}
+
+inline const char* powerStateName(uint8_t state) {
+  switch (state) {
+    case POWER_ACTIVE:      return "Aktiv";
+    case POWER_DIM:         return "Gedimmt";
+    case POWER_DISPLAY_OFF: return "Display aus";
+    case POWER_LIGHT_SLEEP: return "Light-Sleep";
+    default:                return "?";
+  }
+}
+
+#endif // POWER_MANAGER_H
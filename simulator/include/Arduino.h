@@ -0,0 +1,243 @@
+/**
+ * Arduino.h - Host-Simulator: Arduino/ESP32 Core Ersatz
+ *
+ * Stellt die vom Projekt genutzte Teilmenge des ESP32 Arduino Core 3.x
+ * und von FreeRTOS für einen Linux-Build bereit. Zeit ist virtuell:
+ * micros()/millis() laufen nur durch delay() und modellierte
+ * SPI-Übertragungen weiter (sim.h), nicht mit der Host-CPU.
+ *
+ * FreeRTOS ist single-threaded nachgebildet: Tasks lassen sich nicht
+ * starten (pdFAIL), Mutexe und kritische Abschnitte sind leer.
+ */
+
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atomic>
+#include <string>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// ============================================
+// KONSTANTEN
+// ============================================
+
+#define HIGH 1
+#define LOW  0
+
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+#define IRAM_ATTR
+
+// SPI-Hosts (ESP32 classic)
+#define FSPI 0
+#define HSPI 2
+#define VSPI 3
+
+#define MSBFIRST  1
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+#define UART0 0
+#define UART1 1
+#define UART2 2
+
+#ifndef M_PI
+  #define M_PI 3.14159265358979323846
+#endif
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ============================================
+// ZEIT, GPIO, LEDC
+// ============================================
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+long random(long maxValue);
+long random(long minValue, long maxValue);
+void randomSeed(unsigned long seed);
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+
+#define digitalPinToInterrupt(p) (p)
+void attachInterrupt(int pin, void (*isr)(void), int mode);
+void detachInterrupt(int pin);
+
+// LEDC-API des Core 3.x (Pin-basiert)
+bool ledcAttach(int pin, uint32_t freq, uint8_t resolution);
+bool ledcWrite(int pin, uint32_t duty);
+uint32_t ledcRead(int pin);
+bool ledcFade(int pin, uint32_t startDuty, uint32_t targetDuty, int maxFadeTimeMs);
+
+// ============================================
+// STRING
+// ============================================
+
+class String : public std::string {
+public:
+  String() {}
+  String(const char* s) : std::string(s ? s : "") {}
+  String(const std::string& s) : std::string(s) {}
+  explicit String(char c) : std::string(1, c) {}
+  String(int value, unsigned char base = 10) { assignNumber(value, base); }
+  String(unsigned int value, unsigned char base = 10) { assignNumber(value, base); }
+  String(long value, unsigned char base = 10) { assignNumber(value, base); }
+  String(unsigned long value, unsigned char base = 10) { assignNumber((long long)value, base); }
+  String(float value, unsigned int decimals = 2) { assignFloat(value, decimals); }
+  String(double value, unsigned int decimals = 2) { assignFloat(value, decimals); }
+
+  String operator+(const String& other) const { return String(std::string(*this) + std::string(other)); }
+  String operator+(const char* other) const { return String(std::string(*this) + other); }
+  friend String operator+(const char* a, const String& b) { return String(std::string(a) + std::string(b)); }
+
+  int toInt() const { return atoi(c_str()); }
+  float toFloat() const { return (float)atof(c_str()); }
+
+private:
+  void assignNumber(long long value, unsigned char base) {
+    char buf[72];
+    if (base == 16) snprintf(buf, sizeof(buf), "%llx", value);
+    else snprintf(buf, sizeof(buf), "%lld", value);
+    assign(buf);
+  }
+  void assignFloat(double value, unsigned int decimals) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimals, value);
+    assign(buf);
+  }
+};
+
+// ============================================
+// SERIAL
+// ============================================
+
+// Ausgabe auf stdout, Eingabe aus stdin (nicht blockierend nur mit Pipe/Datei)
+class HardwareSerial {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  void end() {}
+  int available();
+  int read();
+  void flush() { fflush(stdout); }
+  operator bool() const { return true; }
+
+  size_t print(const char* s) { return fputs(s, stdout) >= 0 ? strlen(s) : 0; }
+  size_t print(const String& s) { return print(s.c_str()); }
+  size_t print(char c) { return putchar(c) != EOF; }
+  size_t print(int v) { return printf("%d", v); }
+  size_t print(unsigned int v) { return printf("%u", v); }
+  size_t print(long v) { return printf("%ld", v); }
+  size_t print(unsigned long v) { return printf("%lu", v); }
+  size_t print(double v, int decimals = 2) { return printf("%.*f", decimals, v); }
+
+  size_t println() { return print("\n"); }
+  template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+  size_t println(double v, int decimals) { size_t n = print(v, decimals); return n + println(); }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  size_t write(uint8_t c) { return putchar(c) != EOF; }
+  size_t write(const uint8_t* buf, size_t n) { return fwrite(buf, 1, n, stdout); }
+};
+
+extern HardwareSerial Serial;
+
+// ============================================
+// ESP
+// ============================================
+
+class EspClass {
+public:
+  uint32_t getFreeHeap();
+  uint32_t getFlashChipSize() { return 4u << 20; }
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint32_t getCycleCount() { return (uint32_t)(micros() * 240u); }
+  const char* getChipModel() { return "ESP32-SIM"; }
+  void restart() { exit(0); }
+};
+
+extern EspClass ESP;
+
+// ============================================
+// FREERTOS (single-threaded)
+// ============================================
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void* TaskHandle_t;
+typedef void* QueueHandle_t;
+typedef void* SemaphoreHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdPASS  1
+#define pdFAIL  0
+
+#define portMAX_DELAY        0xFFFFFFFFu
+#define portTICK_PERIOD_MS   1
+#define pdMS_TO_TICKS(ms)    ((TickType_t)(ms))
+#define tskNO_AFFINITY       0x7FFFFFFF
+#define configMAX_PRIORITIES 25
+#define ARDUINO_RUNNING_CORE 1
+#define portYIELD_FROM_ISR() do {} while (0)
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack, void* param,
+                       UBaseType_t priority, TaskHandle_t* handle);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* param,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t period);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xPortGetCoreID();
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken);
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary();
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t* woken);
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem);
+void vSemaphoreDelete(SemaphoreHandle_t sem);
+
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux)     do { (void)(mux); } while (0)
+#define portEXIT_CRITICAL(mux)      do { (void)(mux); } while (0)
+#define portENTER_CRITICAL_ISR(mux) do { (void)(mux); } while (0)
+#define portEXIT_CRITICAL_ISR(mux)  do { (void)(mux); } while (0)
+
+#endif // SIM_ARDUINO_H
@@ -0,0 +1,87 @@
+/**
+ * Preferences.h - Host-Simulator: NVS Ersatz
+ *
+ * Schlüssel/Wert-Speicher im RAM, pro Prozess. Namespace und Schlüssel
+ * werden wie im NVS getrennt gehalten, Blobs exakt längengeprüft.
+ */
+
+#ifndef SIM_PREFERENCES_H
+#define SIM_PREFERENCES_H
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+class Preferences {
+public:
+  Preferences() : opened(false), readOnly(false) {}
+
+  bool begin(const char* name, bool readOnlyMode = false) {
+    space = name;
+    readOnly = readOnlyMode;
+    opened = true;
+    return true;
+  }
+  void end() { opened = false; }
+
+  bool isKey(const char* key) { return opened && store().count(path(key)) > 0; }
+
+  size_t getBytesLength(const char* key) {
+    auto it = store().find(path(key));
+    return it == store().end() ? 0 : it->second.size();
+  }
+
+  size_t getBytes(const char* key, void* buf, size_t maxLen) {
+    auto it = store().find(path(key));
+    if (!opened || it == store().end() || it->second.size() > maxLen) return 0;
+    memcpy(buf, it->second.data(), it->second.size());
+    return it->second.size();
+  }
+
+  size_t putBytes(const char* key, const void* value, size_t len) {
+    if (!opened || readOnly) return 0;
+    const uint8_t* p = (const uint8_t*)value;
+    store()[path(key)].assign(p, p + len);
+    return len;
+  }
+
+  uint32_t getUInt(const char* key, uint32_t defaultValue = 0) {
+    uint32_t v;
+    return getBytesLength(key) == sizeof(v) && getBytes(key, &v, sizeof(v)) ? v : defaultValue;
+  }
+  size_t putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+
+  uint8_t getUChar(const char* key, uint8_t defaultValue = 0) {
+    uint8_t v;
+    return getBytesLength(key) == sizeof(v) && getBytes(key, &v, sizeof(v)) ? v : defaultValue;
+  }
+  size_t putUChar(const char* key, uint8_t value) { return putBytes(key, &value, sizeof(value)); }
+
+  bool remove(const char* key) {
+    if (!opened || readOnly) return false;
+    return store().erase(path(key)) > 0;
+  }
+
+  bool clear() {
+    if (!opened || readOnly) return false;
+    const std::string prefix = space + "/";
+    for (auto it = store().begin(); it != store().end();) {
+      it = it->first.compare(0, prefix.size(), prefix) == 0 ? store().erase(it) : std::next(it);
+    }
+    return true;
+  }
+
+private:
+  std::string path(const char* key) const { return space + "/" + key; }
+
+  static std::map<std::string, std::vector<uint8_t>>& store() {
+    static std::map<std::string, std::vector<uint8_t>> nvs;
+    return nvs;
+  }
+
+  std::string space;
+  bool opened;
+  bool readOnly;
+};
+
+#endif // SIM_PREFERENCES_H
@@ -0,0 +1,61 @@
+/**
+ * SPI.h - Host-Simulator: SPIClass Ersatz
+ *
+ * Zählt Bytes und Transaktionen pro Host und schiebt die virtuelle Zeit
+ * um die Übertragungsdauer beim eingestellten Takt weiter (simSpiTransfer,
+ * sim.h). transfer() liefert die Antwort eines angehängten Geräts
+ * (simSpiAttach), sonst 0.
+ */
+
+#ifndef SIM_SPI_H
+#define SIM_SPI_H
+
+#include <Arduino.h>
+
+class SPISettings {
+public:
+  SPISettings() : clock(1000000), bitOrder(MSBFIRST), dataMode(SPI_MODE0) {}
+  SPISettings(uint32_t clockHz, uint8_t order, uint8_t mode)
+    : clock(clockHz), bitOrder(order), dataMode(mode) {}
+  uint32_t clock;
+  uint8_t bitOrder;
+  uint8_t dataMode;
+};
+
+class SPIClass {
+public:
+  explicit SPIClass(uint8_t spiBus = HSPI)
+    : bus(spiBus), sckPin(spiBus == VSPI ? 18 : 14), frequency(1000000), started(false) {}
+
+  // -1: IO_MUX-Standardpin des Hosts
+  void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) {
+    (void)miso; (void)mosi; (void)ss;
+    sckPin = sck >= 0 ? sck : (bus == VSPI ? 18 : 14);
+    started = true;
+  }
+  void end() { started = false; }
+
+  void beginTransaction(SPISettings settings);
+  void endTransaction() {}
+  void setFrequency(uint32_t hz) { frequency = hz; }
+  uint32_t getFrequency() const { return frequency; }
+  void setHwCs(bool use) { (void)use; }
+
+  uint8_t transfer(uint8_t data);
+  uint16_t transfer16(uint16_t data);
+  void writeBytes(const uint8_t* data, uint32_t size);
+  void transferBytes(const uint8_t* data, uint8_t* out, uint32_t size);
+
+  uint8_t getBus() const { return bus; }
+  bool isStarted() const { return started; }
+
+private:
+  uint8_t bus;
+  int8_t sckPin;
+  uint32_t frequency;
+  bool started;
+};
+
+extern SPIClass SPI;   // Globales SPI (VSPI)
+
+#endif // SIM_SPI_H
@@ -0,0 +1,282 @@
+/**
+ * TFT_eSPI.h - Host-Simulator: TFT_eSPI Ersatz
+ *
+ * Bildet die im Projekt genutzte API von TFT_eSPI 2.5 nach:
+ *  - Display: RGB565-Framebuffer im Panel-Speicher (Rotation wie
+ *    ILI9341/ST7789 über MADCTL), Kommandos INVON/INVOFF/DISPON/
+ *    DISPOFF/SLPIN/SLPOUT werden ausgewertet
+ *  - Viewport mit Datum, Text-Datum, Swap-Bytes wie in der Bibliothek
+ *  - TFT_eSprite: 16-Bit Puffer, byte-getauscht gespeichert
+ *
+ * SPI-Modell pro Operation: Adressfenster = 11 Bytes (CASET, RASET,
+ * RAMWR), Pixel = 2 Bytes, Lesen = 3 Bytes pro Pixel plus Dummy-Byte
+ * beim Lese-Takt. Sprites erzeugen keinen Busverkehr.
+ *
+ * Glyphen werden als Zellen-Rahmen gezeichnet (keine Font-Daten),
+ * Breite und Höhe entsprechen den Fonts 1, 2 und 4 der Bibliothek.
+ */
+
+#ifndef SIM_TFT_ESPI_H
+#define SIM_TFT_ESPI_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <vector>
+
+// Wie User_Setup_Select.h: Projekt-Setup laden, falls noch nicht geschehen
+#ifndef USER_SETUP_LOADED
+  #include "TFT_Setup.h"
+#endif
+
+#ifndef TFT_WIDTH
+  #define TFT_WIDTH 240
+#endif
+#ifndef TFT_HEIGHT
+  #define TFT_HEIGHT 320
+#endif
+
+// ============================================
+// KONSTANTEN
+// ============================================
+
+#define TFT_RGB 0
+#define TFT_BGR 1
+
+#define TFT_BLACK       0x0000
+#define TFT_NAVY        0x000F
+#define TFT_DARKGREEN   0x03E0
+#define TFT_DARKCYAN    0x03EF
+#define TFT_MAROON      0x7800
+#define TFT_PURPLE      0x780F
+#define TFT_OLIVE       0x7BE0
+#define TFT_LIGHTGREY   0xD69A
+#define TFT_DARKGREY    0x7BEF
+#define TFT_BLUE        0x001F
+#define TFT_GREEN       0x07E0
+#define TFT_CYAN        0x07FF
+#define TFT_RED         0xF800
+#define TFT_MAGENTA     0xF81F
+#define TFT_YELLOW      0xFFE0
+#define TFT_WHITE       0xFFFF
+#define TFT_ORANGE      0xFDA0
+#define TFT_GREENYELLOW 0xB7E0
+#define TFT_PINK        0xFE19
+#define TFT_BROWN       0x9A60
+#define TFT_GOLD        0xFEA0
+#define TFT_SILVER      0xC618
+#define TFT_SKYBLUE     0x867D
+#define TFT_VIOLET      0x915C
+
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define CL_DATUM 3
+#define MC_DATUM 4
+#define CC_DATUM 4
+#define MR_DATUM 5
+#define CR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+#define L_BASELINE 9
+#define C_BASELINE 10
+#define R_BASELINE 11
+
+#define TFT_INVOFF  0x20
+#define TFT_INVON   0x21
+#define TFT_DISPOFF 0x28
+#define TFT_DISPON  0x29
+#define TFT_SLPIN   0x10
+#define TFT_SLPOUT  0x11
+
+#define PSRAM_ENABLE 3
+
+// SPI-Modell (Bytes)
+#define SIM_TFT_WINDOW_BYTES 11   // CASET(1+4) + RASET(1+4) + RAMWR(1)
+#define SIM_TFT_READ_OVERHEAD 2   // RAMRD + Dummy-Byte
+#define SIM_TFT_READ_PIXEL_BYTES 3
+
+// Wie die Bibliothek: ohne eigenen Lesetakt gilt der Schreibtakt
+#ifndef SPI_READ_FREQUENCY
+  #define SPI_READ_FREQUENCY SPI_FREQUENCY
+#endif
+
+// ============================================
+// DISPLAY
+// ============================================
+
+class TFT_eSPI {
+public:
+  TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT);
+  virtual ~TFT_eSPI() {}
+
+  void init(uint8_t tc = 0);
+  void begin(uint8_t tc = 0) { init(tc); }
+
+  void setRotation(uint8_t r);
+  uint8_t getRotation() { return rotation; }
+  int16_t width() { return _vpDatum ? _xWidth : _width; }
+  int16_t height() { return _vpDatum ? _yHeight : _height; }
+  void invertDisplay(bool i);
+
+  // Viewport (Datum: Koordinaten relativ zur Viewport-Ecke)
+  void setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum = true);
+  void resetViewport();
+  int32_t getViewportX() { return _xDatum; }
+  int32_t getViewportY() { return _yDatum; }
+  int32_t getViewportWidth() { return _xWidth; }
+  int32_t getViewportHeight() { return _yHeight; }
+  bool getViewportDatum() { return _vpDatum; }
+
+  // Grafik
+  void drawPixel(int32_t x, int32_t y, uint32_t color);
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void fillScreen(uint32_t color);
+  void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+  void drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color);
+  void fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color);
+
+  // Text
+  void setTextColor(uint16_t color) { textcolor = textbgcolor = color; }
+  void setTextColor(uint16_t fg, uint16_t bg, bool bgfill = false) { (void)bgfill; textcolor = fg; textbgcolor = bg; }
+  void setTextDatum(uint8_t datum) { textdatum = datum; }
+  uint8_t getTextDatum() { return textdatum; }
+  void setTextFont(uint8_t font) { textfont = font; }
+  void setTextSize(uint8_t size) { textsize = size ? size : 1; }
+  int16_t drawString(const char* string, int32_t x, int32_t y, uint8_t font);
+  int16_t drawString(const char* string, int32_t x, int32_t y) { return drawString(string, x, y, textfont); }
+  int16_t drawString(const String& string, int32_t x, int32_t y, uint8_t font) { return drawString(string.c_str(), x, y, font); }
+  int16_t drawString(const String& string, int32_t x, int32_t y) { return drawString(string.c_str(), x, y, textfont); }
+  int16_t drawCentreString(const char* string, int32_t x, int32_t y, uint8_t font);
+  int16_t drawNumber(long value, int32_t x, int32_t y, uint8_t font);
+  int16_t drawNumber(long value, int32_t x, int32_t y) { return drawNumber(value, x, y, textfont); }
+  int16_t drawFloat(float value, uint8_t decimals, int32_t x, int32_t y, uint8_t font);
+  int16_t drawChar(uint16_t c, int32_t x, int32_t y, uint8_t font);
+  int16_t textWidth(const char* string, uint8_t font);
+  int16_t textWidth(const char* string) { return textWidth(string, textfont); }
+  int16_t textWidth(const String& string, uint8_t font) { return textWidth(string.c_str(), font); }
+  int16_t textWidth(const String& string) { return textWidth(string.c_str(), textfont); }
+  int16_t fontHeight(int16_t font);
+  int16_t fontHeight() { return fontHeight(textfont); }
+
+  // Pixel-Stream in ein Adressfenster
+  void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h);
+  void setWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1) { setAddrWindow(x0, y0, x1 - x0 + 1, y1 - y0 + 1); }
+  void pushColor(uint16_t color);
+  void pushColor(uint16_t color, uint32_t len);
+  void pushBlock(uint16_t color, uint32_t len) { pushColor(color, len); }
+  void pushColors(uint16_t* data, uint32_t len, bool swap = true);
+  void pushPixels(const void* data, uint32_t len);
+
+  // Bilder
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+  void pushRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data) { pushImage(x, y, w, h, data); }
+  void readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data);
+  uint16_t readPixel(int32_t x, int32_t y);
+
+  // DMA (synchron modelliert, Busverkehr wie pushImage)
+  bool initDMA(bool ctrlCS = false);
+  void deInitDMA() { dmaEnabled = false; }
+  bool dmaBusy() { return false; }
+  void dmaWait() {}
+  void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t const* data, uint16_t* buffer = nullptr);
+  void pushPixelsDMA(uint16_t* data, uint32_t len);
+
+  // Bus
+  void startWrite();
+  void endWrite();
+  void setSwapBytes(bool swap) { _swapBytes = swap; }
+  bool getSwapBytes() { return _swapBytes; }
+  void writecommand(uint8_t c);
+  void writedata(uint8_t d);
+  uint8_t readcommand8(uint8_t cmd, uint8_t index = 0);
+  uint16_t readcommand16(uint8_t cmd, uint8_t index = 0);
+  uint32_t readcommand32(uint8_t cmd, uint8_t index = 0);
+  SPIClass& getSPIinstance();
+
+  uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  }
+
+  // Simulator: sichtbare Farbe an (x, y) der aktuellen Rotation
+  // (Inversion berücksichtigt, schwarz bei DISPOFF/SLPIN)
+  uint16_t simVisiblePixel(int32_t x, int32_t y);
+  bool simIsSleeping() { return sleeping; }
+  bool simIsDisplayOn() { return displayOn && !sleeping; }
+
+protected:
+  // Zeichenziel, Koordinaten bereits geclippt und absolut
+  virtual void writeFill(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+  virtual void writeImage(int32_t x, int32_t y, int32_t w, int32_t h,
+                          const uint16_t* data, int32_t stride, bool swap);
+  virtual uint16_t readColor(int32_t x, int32_t y);
+
+  // Datum anwenden und auf Viewport/Bildschirm clippen
+  bool clip(int32_t& x, int32_t& y, int32_t& w, int32_t& h);
+  bool clipImage(int32_t& x, int32_t& y, int32_t& w, int32_t& h, int32_t& dx, int32_t& dy);
+  void glyphMetrics(uint8_t font, int16_t* w, int16_t* h);
+  void streamPixels(const uint16_t* data, uint32_t len, bool swap, uint16_t fill);
+
+  int32_t _init_width, _init_height;
+  int32_t _width, _height;
+  uint8_t rotation;
+
+  int32_t _vpX, _vpY, _vpW, _vpH;       // Clip-Bereich (rechts/unten exklusiv)
+  int32_t _xDatum, _yDatum, _xWidth, _yHeight;
+  bool _vpDatum, _vpOoB;
+
+  uint16_t textcolor, textbgcolor;
+  uint8_t textdatum, textfont, textsize;
+  bool _swapBytes;
+  bool spriteTarget;                    // Kein Busverkehr (TFT_eSprite)
+
+private:
+  uint8_t spiHost();
+  uint32_t writeHz();
+  uint32_t readHz();
+  uint32_t memIndex(int32_t x, int32_t y);
+
+  std::vector<uint16_t> panel;          // Panel-Speicher (Rotation 0)
+  uint32_t writeDepth;
+  int32_t winX, winY, winW, winH;
+  uint32_t winPos;
+  uint8_t lastCommand;
+  bool inverted, displayOn, sleeping, dmaEnabled;
+};
+
+// ============================================
+// SPRITE
+// ============================================
+
+class TFT_eSprite : public TFT_eSPI {
+public:
+  explicit TFT_eSprite(TFT_eSPI* tft);
+  ~TFT_eSprite() { deleteSprite(); }
+
+  void* createSprite(int16_t w, int16_t h, uint8_t frames = 1);
+  void deleteSprite();
+  bool created() { return !buffer.empty(); }
+  void* getPointer() { return buffer.empty() ? nullptr : buffer.data(); }
+  void setColorDepth(int8_t depth) { (void)depth; }   // Nur 16 Bit modelliert
+  int8_t getColorDepth() { return 16; }
+  void setAttribute(uint8_t id, uint8_t value) { (void)id; (void)value; }
+  void fillSprite(uint32_t color);
+  void pushSprite(int32_t x, int32_t y);
+
+protected:
+  void writeFill(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) override;
+  void writeImage(int32_t x, int32_t y, int32_t w, int32_t h,
+                  const uint16_t* data, int32_t stride, bool swap) override;
+  uint16_t readColor(int32_t x, int32_t y) override;
+
+private:
+  TFT_eSPI* _tft;
+  std::vector<uint16_t> buffer;   // Byte-getauscht wie in TFT_eSPI
+};
+
+#endif // SIM_TFT_ESPI_H
@@ -0,0 +1,52 @@
+/**
+ * Wire.h - Host-Simulator: TwoWire Ersatz
+ *
+ * endTransmission() ACKt, wenn an den aktuellen Pins ein Gerät mit der
+ * Adresse hängt (simI2cAttach, sim.h). Hat es ein Registermodell
+ * (SimI2cDevice), bekommt es die geschriebenen Bytes und liefert die
+ * Daten für requestFrom(); sonst wird nichts gelesen.
+ * Zeit: 9 Takte pro Byte (8 Bit + ACK) beim eingestellten Takt.
+ */
+
+#ifndef SIM_WIRE_H
+#define SIM_WIRE_H
+
+#include <Arduino.h>
+
+#define SIM_WIRE_BUFFER 128   // Wie I2C_BUFFER_LENGTH des ESP32-Cores
+
+class TwoWire {
+public:
+  TwoWire() : sda(-1), scl(-1), frequency(100000), address(0), started(false),
+              inTransaction(false), txLength(0), rxLength(0), rxPos(0) {}
+
+  bool begin(int sdaPin = 21, int sclPin = 22, uint32_t hz = 100000);
+  bool end() { started = false; return true; }
+  void setClock(uint32_t hz) { frequency = hz; }
+  void setTimeOut(uint16_t ms) { (void)ms; }
+
+  void beginTransmission(uint8_t deviceAddress) { address = deviceAddress; txLength = 0; }
+  size_t write(uint8_t data);
+  size_t write(const uint8_t* data, size_t size);
+  uint8_t endTransmission(bool sendStop = true);   // 0 = ACK, 2 = NACK auf Adresse
+  uint8_t requestFrom(uint8_t deviceAddress, size_t size, bool sendStop = true);
+  int available() { return rxLength - rxPos; }
+  int read() { return rxPos < rxLength ? rxBuffer[rxPos++] : -1; }
+
+private:
+  void clockBytes(uint32_t bytes);
+  void startCondition();
+
+  int sda, scl;
+  uint32_t frequency;
+  uint8_t address;
+  bool started;
+  bool inTransaction;   // Kein STOP gesendet: nächster Start ist ein Repeated Start
+  size_t txLength, rxLength, rxPos;
+  uint8_t txBuffer[SIM_WIRE_BUFFER];
+  uint8_t rxBuffer[SIM_WIRE_BUFFER];
+};
+
+extern TwoWire Wire;
+
+#endif // SIM_WIRE_H
@@ -0,0 +1,53 @@
+/**
+ * XPT2046_Touchscreen.h - Host-Simulator: XPT2046 Ersatz
+ *
+ * Liefert Rohwerte aus dem Touch-Skript (simTouchLoadScript, sim.h).
+ * Wie die echte Bibliothek liest update() höchstens alle 3 ms per SPI
+ * (ein Messzyklus = 20 Bytes auf dem Touch-Host) und cached sonst.
+ */
+
+#ifndef SIM_XPT2046_TOUCHSCREEN_H
+#define SIM_XPT2046_TOUCHSCREEN_H
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#define XPT2046_Z_THRESHOLD     300    // touched(): wie in der Bibliothek
+#define XPT2046_MSEC_THRESHOLD  3      // Mindestabstand zweier SPI-Messungen
+#define XPT2046_UPDATE_BYTES    20     // Kommandos + Antworten pro Messung
+
+class TS_Point {
+public:
+  TS_Point() : x(0), y(0), z(0) {}
+  TS_Point(int16_t px, int16_t py, int16_t pz) : x(px), y(py), z(pz) {}
+  bool operator==(TS_Point p) { return p.x == x && p.y == y && p.z == z; }
+  bool operator!=(TS_Point p) { return !(*this == p); }
+  int16_t x, y, z;
+};
+
+class XPT2046_Touchscreen {
+public:
+  XPT2046_Touchscreen(uint8_t csPin, uint8_t tirqPin = 255)
+    : cs(csPin), tirq(tirqPin), spi(nullptr), xraw(0), yraw(0), zraw(0),
+      lastUpdate(0), rotation(1) {}
+
+  bool begin(SPIClass& wspi = SPI);
+  TS_Point getPoint();
+  bool tirqTouched();
+  bool touched();
+  void readData(uint16_t* x, uint16_t* y, uint8_t* z);
+  bool bufferEmpty() { return millis() - lastUpdate < XPT2046_MSEC_THRESHOLD; }
+  uint8_t bufferSize() { return 1; }
+  void setRotation(uint8_t n) { rotation = n % 4; }
+
+private:
+  void update();
+
+  uint8_t cs, tirq;
+  SPIClass* spi;
+  int16_t xraw, yraw, zraw;
+  uint32_t lastUpdate;
+  uint8_t rotation;
+};
+
+#endif // SIM_XPT2046_TOUCHSCREEN_H
@@ -0,0 +1,30 @@
+/**
+ * driver/gpio.h - Host-Simulator: GPIO-Treiber Ersatz
+ *
+ * Nur Interrupt-Typ und Light-Sleep Wecken; Pegel kommen aus dem
+ * GPIO-Modell (digitalRead, simGpioInput).
+ */
+
+#ifndef SIM_DRIVER_GPIO_H
+#define SIM_DRIVER_GPIO_H
+
+#include "esp_sleep.h"   // esp_err_t
+
+typedef int gpio_num_t;
+
+typedef enum {
+  GPIO_INTR_DISABLE,
+  GPIO_INTR_POSEDGE,
+  GPIO_INTR_NEGEDGE,
+  GPIO_INTR_ANYEDGE,
+  GPIO_INTR_LOW_LEVEL,
+  GPIO_INTR_HIGH_LEVEL
+} gpio_int_type_t;
+
+esp_err_t gpio_set_intr_type(gpio_num_t pin, gpio_int_type_t type);
+esp_err_t gpio_intr_enable(gpio_num_t pin);
+esp_err_t gpio_intr_disable(gpio_num_t pin);
+esp_err_t gpio_wakeup_enable(gpio_num_t pin, gpio_int_type_t type);   // Nur LOW/HIGH_LEVEL
+esp_err_t gpio_wakeup_disable(gpio_num_t pin);
+
+#endif // SIM_DRIVER_GPIO_H
@@ -0,0 +1,20 @@
+/**
+ * driver/uart.h - Host-Simulator: UART-Treiber Ersatz
+ *
+ * Serial (UART0) weckt aus dem Light-Sleep, sobald Eingabe ansteht.
+ */
+
+#ifndef SIM_DRIVER_UART_H
+#define SIM_DRIVER_UART_H
+
+#include "esp_sleep.h"   // esp_err_t
+
+typedef int uart_port_t;
+
+#define UART_NUM_0 0
+#define UART_NUM_1 1
+#define UART_NUM_2 2
+
+esp_err_t uart_set_wakeup_threshold(uart_port_t uartNum, int wakeupThreshold);
+
+#endif // SIM_DRIVER_UART_H
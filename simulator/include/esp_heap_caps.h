@@ -0,0 +1,45 @@
+/**
+ * esp_heap_caps.h - Host-Simulator: Heap-Capabilities Ersatz
+ *
+ * Meldet den typischen freien internen DMA-RAM eines ESP32 nach dem
+ * Start (ohne WiFi), damit Puffergrößen wie auf dem Board ausfallen.
+ * Der größte Block lässt sich verkleinern, um Ersatzwege zu prüfen.
+ */
+
+#ifndef SIM_ESP_HEAP_CAPS_H
+#define SIM_ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_EXEC     (1 << 0)
+#define MALLOC_CAP_32BIT    (1 << 1)
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+
+#define SIM_HEAP_FREE          180000   // Freier Heap (Bytes)
+#define SIM_HEAP_LARGEST_BLOCK 110592   // Größter zusammenhängender Block
+
+extern size_t simHeapLargestBlock;      // --dma-ram, Standard SIM_HEAP_LARGEST_BLOCK
+
+inline size_t heap_caps_get_free_size(uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? 0 : SIM_HEAP_FREE;
+}
+
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? 0 : simHeapLargestBlock;
+}
+
+inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? nullptr : malloc(size);
+}
+
+inline void heap_caps_free(void* ptr) {
+  free(ptr);
+}
+
+#endif // SIM_ESP_HEAP_CAPS_H
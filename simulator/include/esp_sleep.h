@@ -0,0 +1,42 @@
+/**
+ * esp_sleep.h - Host-Simulator: Light-Sleep Ersatz
+ *
+ * esp_light_sleep_start() schiebt die virtuelle Uhr in 1-ms-Schritten
+ * weiter, bis eine aktivierte Weckquelle auslöst: GPIO-Pegel
+ * (gpio_wakeup_enable) oder Serial-Eingabe (UART). Ohne Weckquelle
+ * endet der Schlaf nach SIM_LIGHT_SLEEP_MAX_MS mit Timer-Ursache.
+ */
+
+#ifndef SIM_ESP_SLEEP_H
+#define SIM_ESP_SLEEP_H
+
+#include <stdint.h>
+
+#define SIM_LIGHT_SLEEP_MAX_MS 600000
+
+typedef int esp_err_t;
+#ifndef ESP_OK
+  #define ESP_OK 0
+#endif
+
+typedef enum {
+  ESP_SLEEP_WAKEUP_UNDEFINED,
+  ESP_SLEEP_WAKEUP_ALL,
+  ESP_SLEEP_WAKEUP_EXT0,
+  ESP_SLEEP_WAKEUP_EXT1,
+  ESP_SLEEP_WAKEUP_TIMER,
+  ESP_SLEEP_WAKEUP_TOUCHPAD,
+  ESP_SLEEP_WAKEUP_ULP,
+  ESP_SLEEP_WAKEUP_GPIO,
+  ESP_SLEEP_WAKEUP_UART
+} esp_sleep_source_t;
+
+typedef esp_sleep_source_t esp_sleep_wakeup_cause_t;
+
+esp_err_t esp_sleep_enable_gpio_wakeup();
+esp_err_t esp_sleep_enable_uart_wakeup(int uartNum);
+esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t source);
+esp_err_t esp_light_sleep_start();
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause();
+
+#endif // SIM_ESP_SLEEP_H
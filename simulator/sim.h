@@ -0,0 +1,171 @@
+/**
+ * sim.h - Host-Simulator: Zeit-, SPI- und Touch-Modell
+ *
+ * Die virtuelle Uhr (Nanosekunden) ist die einzige Zeitquelle des
+ * Simulators. Sie läuft nur durch delay() und durch modellierte
+ * SPI-Übertragungen: Bytes * 8 / Takt des jeweiligen Hosts. Alle
+ * Durchsätze sind damit unabhängig von der Host-CPU reproduzierbar
+ * und entsprechen der reinen Busauslastung auf dem Board (CPU-Zeit
+ * für Rendering, Filter usw. ist nicht modelliert).
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class TFT_eSPI;
+struct HardwareProfile;
+
+// ============================================
+// VIRTUELLE UHR
+// ============================================
+
+uint64_t simNowNs();
+void simAdvanceNs(uint64_t ns);
+
+// ============================================
+// SPI-MODELL
+// ============================================
+
+#define SIM_SPI_HOSTS 4   // FSPI, (1), HSPI, VSPI
+
+struct SimSpiStats {
+  uint64_t bytes;          // Übertragene Bytes (Kommandos, Fenster, Pixel)
+  uint64_t readBytes;      // Davon gelesen (MISO)
+  uint64_t busyNs;         // Modellierte Übertragungszeit
+  uint32_t transactions;   // CS-Zyklen (startWrite/endWrite, beginTransaction)
+  uint32_t windows;        // Adressfenster (CASET + RASET + RAMWR)
+};
+
+// Überträgt 'bytes' auf 'host' mit 'hz' und schiebt die Uhr weiter
+void simSpiTransfer(uint8_t host, uint32_t bytes, uint32_t hz, bool read = false);
+void simSpiTransaction(uint8_t host);
+void simSpiWindow(uint8_t host);
+const SimSpiStats& simSpiStats(uint8_t host);
+void simSpiReset();
+
+// Taktgrenzen des simulierten Kabels (0 = unbegrenzt): oberhalb kippt
+// bei jedem SIM_GLITCH_INTERVAL-ten Pixel ein Bit (Schreiben ins Panel
+// bzw. Rücklesen per readRect), für das Takt-Tuning (display_clock.h)
+#define SIM_GLITCH_INTERVAL 509
+void simDisplayClockLimit(uint32_t writeHz, uint32_t readHz);
+
+// ============================================
+// SPI-/I2C-GERÄTE
+// ============================================
+
+// Antwortet auf SPIClass::transfer(), solange sein CS low ist und der
+// Host auf seinem SCLK-Pin läuft (Registermodelle für die Auto-Erkennung)
+class SimSpiDevice {
+public:
+  virtual ~SimSpiDevice() {}
+  virtual void select() {}                   // CS fällt: neuer Befehl
+  virtual uint8_t transfer(uint8_t mosi) = 0;
+};
+
+void simSpiAttach(int sclk, int cs, SimSpiDevice* device);
+void simSpiDetach(SimSpiDevice* device);
+uint8_t simSpiExchange(int sclk, uint8_t mosi);   // 0 ohne ausgewähltes Gerät
+
+// Registermodell hinter TwoWire: write() bekommt die Bytes einer
+// Schreibphase (erst die Registeradresse), read() füllt eine Lesephase;
+// ack() false = Gerät antwortet nicht (z.B. im Schlaf)
+class SimI2cDevice {
+public:
+  virtual ~SimI2cDevice() {}
+  virtual bool ack() { return true; }
+  virtual void write(const uint8_t* data, size_t length) = 0;
+  virtual void read(uint8_t* data, size_t length) = 0;
+};
+
+struct SimI2cStats {
+  uint32_t transactions;   // START bis STOP, Repeated Start zählt nicht
+  uint64_t bytes;          // Inkl. Adressbytes
+};
+
+// Gerät mit 'address' ACKt auf dem Bus an SDA/SCL; ohne Modell liest es nichts
+void simI2cAttach(int sda, int scl, uint8_t address, SimI2cDevice* device = nullptr);
+bool simI2cPresent(int sda, int scl, uint8_t address);
+const SimI2cStats& simI2cStats();
+void simI2cReset();
+
+// Registermodelle der kapazitiven Controller (GT911, FT6236, CST816S):
+// setContacts() schreibt einen Bericht in die Register und löst, wenn
+// 'irq' gesetzt ist, die INT-Flanke aus. Ein CST816S mit 'rst' startet
+// im Auto-Sleep und ACKt erst nach einem Reset-Puls auf diesem Pin.
+struct SimTouchContact {
+  uint8_t trackId;
+  uint16_t x, y;
+};
+
+class SimTouchI2cDevice : public SimI2cDevice {
+public:
+  SimTouchI2cDevice(uint8_t controller, int irq, int rst = -1);
+  void setContacts(const SimTouchContact* contacts, uint8_t count);
+  bool ack() override;
+  void write(const uint8_t* data, size_t length) override;
+  void read(uint8_t* data, size_t length) override;
+
+private:
+  uint8_t controller;
+  int irq;
+  int rst;
+  uint32_t sleepPulses;    // Reset-Pulse beim Einschalten
+  uint16_t pointer;        // Aktuelle Registeradresse
+  uint8_t registers[0x10000];   // 16-Bit Adressraum (GT911)
+};
+
+// ============================================
+// SERIAL
+// ============================================
+
+void simSerialFeed(const char* text);   // Eingabe für Serial.available()/read()
+
+// ============================================
+// BACKLIGHT / GPIO
+// ============================================
+
+uint32_t simLedcDuty(int pin);       // Aktueller Duty inkl. laufender ledcFade()-Rampe
+int simGpioLevel(int pin);           // Letzter digitalWrite()-Wert, -1 = nie gesetzt
+uint32_t simGpioPulses(int pin);     // LOW->HIGH per digitalWrite() (Ende eines Reset-Pulses)
+
+// Eingang mit modelliertem Pegel (digitalRead, Light-Sleep Wecken)
+void simGpioInput(int pin, int (*level)());
+void simGpioInterrupt(int pin);      // Flanke: ISR aus attachInterrupt() aufrufen
+
+// ============================================
+// TOUCH-SKRIPT
+// ============================================
+
+// Zeilenformat (Zeit in ms ab Skriptstart, Koordinaten in Bildschirmpixeln
+// der aktuellen Rotation):
+//   <ms> down <x> <y> [z]    Finger aufsetzen
+//   <ms> move <x> <y>        Position springt
+//   <ms> drag <x> <y>        Linear von der letzten Position bis <ms>
+//   <ms> up                  Finger abheben
+//   noise <raw>              Gleichverteiltes Rauschen (Rohwert-Einheiten)
+//   # Kommentar
+bool simTouchLoadScript(const char* path);
+void simTouchStart();                // Skriptzeit 0 = jetzt
+bool simTouchScriptDone();           // Letzter Eintrag abgespielt
+uint32_t simTouchScriptEndMs();
+
+// Skriptzustand zum Zeitpunkt simNowNs() als Rohwerte (z = 0: kein Kontakt)
+void simTouchRaw(int16_t* rawX, int16_t* rawY, int16_t* rawZ);
+
+// Touch des simulierten Boards aus einem Eintrag der Profil-Tabelle
+// (XPT2046-Pins und Matrix für die Rohwerte), vor begin(). Das Display
+// bleibt HARDWARE_PROFILE, daher nur Einträge mit demselben Display.
+// Standard: das kompilierte Profil.
+bool simTouchBoard(const HardwareProfile& board);
+
+// ============================================
+// FRAMEBUFFER
+// ============================================
+
+// Sichtbares Bild in der aktuellen Rotation als .ppm (P6) oder .png
+bool simDumpFramebuffer(TFT_eSPI& display, const char* path);
+
+#endif // SIM_H
@@ -0,0 +1,833 @@
+/**
+ * sim_display.cpp - Host-Simulator: TFT_eSPI Display und Sprites
+ *
+ * Alle Primitive laufen über writeFill()/writeImage(): das Display
+ * schreibt in den Panel-Speicher und verbucht Adressfenster und Pixel
+ * auf dem SPI-Modell, Sprites schreiben nur in ihren Puffer.
+ */
+
+#include "config.h"
+#include "TFT_Setup.h"
+#include <TFT_eSPI.h>
+#include "hardware_hal.h"
+#include "sim.h"
+
+static inline uint16_t swap16(uint16_t v) {
+  return (uint16_t)((v >> 8) | (v << 8));
+}
+
+// Taktgrenzen (simDisplayClockLimit)
+static uint32_t writeLimitHz = 0;
+static uint32_t readLimitHz = 0;
+static uint32_t glitchCounter = 0;
+
+void simDisplayClockLimit(uint32_t writeHz, uint32_t readHz) {
+  writeLimitHz = writeHz;
+  readLimitHz = readHz;
+}
+
+// Oberhalb der Grenze: jedes SIM_GLITCH_INTERVAL-te Pixel mit gekipptem Bit
+static inline uint16_t glitch(uint16_t c, uint32_t hz, uint32_t limitHz) {
+  if (!limitHz || hz <= limitHz) return c;
+  return (++glitchCounter % SIM_GLITCH_INTERVAL) ? c : (uint16_t)(c ^ 0x0020);
+}
+
+// ============================================
+// REGISTER
+// ============================================
+
+// Leseregister des Controllers, Index 0 = Dummy-Byte
+static uint8_t displayRegister(uint8_t cmd, uint8_t index) {
+  constexpr bool st7789 = ActiveHardwareProfile::config.display.controller == HW_DISPLAY_CTRL_ST7789;
+  switch (cmd) {
+    case 0x04: {
+      static const uint8_t ili9341[] = { 0x00, 0x00, 0x00, 0x00 };
+      static const uint8_t st7789v[] = { 0x00, 0x85, 0x85, 0x52 };
+      return index < 4 ? (st7789 ? st7789v : ili9341)[index] : 0;
+    }
+    case 0xD3: {
+      static const uint8_t id4[] = { 0x00, 0x00, 0x93, 0x41 };
+      return (!st7789 && index < 4) ? id4[index] : 0;
+    }
+    default:
+      return 0;
+  }
+}
+
+// Controller am SPI-Bus (HW_DISPLAY_SCLK/CS, D/C über GPIO): Kommandos bei
+// D/C low, danach Leseregister. ILI9341 zusätzlich mit dem Index-Register
+// 0xD9 (0x10 + Index), über das TFT_eSPI readcommand8() einzelne Parameter holt.
+class SimDisplayDevice : public SimSpiDevice {
+public:
+  SimDisplayDevice() : command(0), readPos(0), index(0), expectIndex(false) {
+    simSpiAttach(HW_DISPLAY_SCLK, HW_DISPLAY_CS, this);
+  }
+
+  void select() override {
+    command = 0;
+    readPos = 0;
+    index = 0;
+    expectIndex = false;
+  }
+
+  uint8_t transfer(uint8_t mosi) override {
+    constexpr bool st7789 = ActiveHardwareProfile::config.display.controller == HW_DISPLAY_CTRL_ST7789;
+    if (simGpioLevel(HW_DISPLAY_DC) == LOW) {
+      expectIndex = mosi == 0xD9 && !st7789;
+      if (!expectIndex) {
+        command = mosi;
+        readPos = index;
+        index = 0;
+      }
+      return 0;
+    }
+    if (expectIndex) {
+      index = mosi >= 0x10 ? mosi - 0x10 : 0;
+      expectIndex = false;
+      return 0;
+    }
+    return displayRegister(command, readPos++);
+  }
+
+private:
+  uint8_t command, readPos, index;
+  bool expectIndex;
+};
+
+static SimDisplayDevice displayDevice;
+
+// Display-Host: wie TFT_eSPI abhängig von USE_HSPI_PORT. Als lokale
+// statische Instanz, da touchBus schon bei der statischen Initialisierung
+// eine Referenz darauf holt.
+static SPIClass& displayBus() {
+  #ifdef USE_HSPI_PORT
+    static SPIClass spi(HSPI);
+    return spi;
+  #else
+    return SPI;
+  #endif
+}
+
+// ============================================
+// KONSTRUKTION & ROTATION
+// ============================================
+
+TFT_eSPI::TFT_eSPI(int16_t w, int16_t h)
+  : _init_width(w), _init_height(h), _width(w), _height(h), rotation(0),
+    _vpX(0), _vpY(0), _vpW(w), _vpH(h), _xDatum(0), _yDatum(0), _xWidth(w), _yHeight(h),
+    _vpDatum(false), _vpOoB(false), textcolor(TFT_WHITE), textbgcolor(TFT_WHITE),
+    textdatum(TL_DATUM), textfont(1), textsize(1), _swapBytes(false),
+    spriteTarget(false), writeDepth(0), winX(0), winY(0), winW(0), winH(0), winPos(0), lastCommand(0),
+    inverted(false), displayOn(false), sleeping(true), dmaEnabled(false) {}
+
+void TFT_eSPI::init(uint8_t tc) {
+  (void)tc;
+  panel.assign((size_t)_init_width * _init_height, TFT_BLACK);
+  displayBus().begin();
+  displayBus().setFrequency(SPI_FREQUENCY);
+
+  // Init-Sequenz: Reset, SLPOUT (120 ms), Register, DISPON
+  simSpiTransaction(spiHost());
+  simSpiTransfer(spiHost(), 80, writeHz());
+  delay(120);
+  sleeping = false;
+  displayOn = true;
+  #ifdef TFT_INVERSION_ON
+    inverted = true;     // Panel mit invertierter Grundeinstellung: Treiber gleicht aus
+  #endif
+  setRotation(0);
+}
+
+void TFT_eSPI::setRotation(uint8_t r) {
+  rotation = r & 3;
+  _width = (rotation & 1) ? _init_height : _init_width;
+  _height = (rotation & 1) ? _init_width : _init_height;
+  writecommand(0x36);   // MADCTL
+  writedata(0);
+  resetViewport();
+}
+
+void TFT_eSPI::invertDisplay(bool i) {
+  #ifdef TFT_INVERSION_ON
+    writecommand(i ? TFT_INVOFF : TFT_INVON);
+  #else
+    writecommand(i ? TFT_INVON : TFT_INVOFF);
+  #endif
+}
+
+uint32_t TFT_eSPI::memIndex(int32_t x, int32_t y) {
+  int32_t mx, my;
+  switch (rotation) {
+    case 1:  mx = _init_width - 1 - y; my = x;                      break;
+    case 2:  mx = _init_width - 1 - x; my = _init_height - 1 - y;   break;
+    case 3:  mx = y;                   my = _init_height - 1 - x;   break;
+    default: mx = x;                   my = y;                      break;
+  }
+  return (uint32_t)my * _init_width + mx;
+}
+
+uint16_t TFT_eSPI::simVisiblePixel(int32_t x, int32_t y) {
+  if (panel.empty() || x < 0 || y < 0 || x >= _width || y >= _height) return TFT_BLACK;
+  if (!displayOn || sleeping) return TFT_BLACK;
+  uint16_t c = panel[memIndex(x, y)];
+  #ifdef TFT_INVERSION_ON
+    return inverted ? c : (uint16_t)~c;
+  #else
+    return inverted ? (uint16_t)~c : c;
+  #endif
+}
+
+// ============================================
+// VIEWPORT & CLIPPING
+// ============================================
+
+void TFT_eSPI::setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum) {
+  _vpDatum = vpDatum;
+  _vpOoB = false;
+  _xDatum = x;
+  _yDatum = y;
+  _xWidth = w;
+  _yHeight = h;
+
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > _width) w = _width - x;
+  if (y + h > _height) h = _height - y;
+
+  if (w < 1 || h < 1) {
+    _xDatum = 0; _yDatum = 0; _xWidth = _width; _yHeight = _height;
+    _vpX = 0; _vpY = 0; _vpW = 0; _vpH = 0;
+    _vpOoB = true;
+    return;
+  }
+
+  if (!vpDatum) {
+    _xDatum = 0; _yDatum = 0; _xWidth = _width; _yHeight = _height;
+  }
+  _vpX = x;
+  _vpY = y;
+  _vpW = x + w;
+  _vpH = y + h;
+}
+
+void TFT_eSPI::resetViewport() {
+  _xDatum = 0; _yDatum = 0;
+  _vpX = 0; _vpY = 0;
+  _vpW = _width; _vpH = _height;
+  _xWidth = _width; _yHeight = _height;
+  _vpDatum = false;
+  _vpOoB = false;
+}
+
+bool TFT_eSPI::clip(int32_t& x, int32_t& y, int32_t& w, int32_t& h) {
+  int32_t dx = 0, dy = 0;
+  return clipImage(x, y, w, h, dx, dy);
+}
+
+bool TFT_eSPI::clipImage(int32_t& x, int32_t& y, int32_t& w, int32_t& h, int32_t& dx, int32_t& dy) {
+  if (_vpOoB || (!spriteTarget && panel.empty())) return false;
+  x += _xDatum;
+  y += _yDatum;
+  dx = 0;
+  dy = 0;
+  if (x < _vpX) { dx = _vpX - x; w -= dx; x = _vpX; }
+  if (y < _vpY) { dy = _vpY - y; h -= dy; y = _vpY; }
+  if (x + w > _vpW) w = _vpW - x;
+  if (y + h > _vpH) h = _vpH - y;
+  return w > 0 && h > 0;
+}
+
+// ============================================
+// ZEICHENZIEL DISPLAY
+// ============================================
+
+uint8_t TFT_eSPI::spiHost() {
+  return displayBus().getBus();
+}
+
+// Pro Transaktion wie die Bibliothek: SPI_FREQUENCY / SPI_READ_FREQUENCY
+uint32_t TFT_eSPI::writeHz() {
+  return SPI_FREQUENCY;
+}
+
+uint32_t TFT_eSPI::readHz() {
+  return SPI_READ_FREQUENCY;
+}
+
+void TFT_eSPI::writeFill(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+  startWrite();
+  simSpiWindow(spiHost());
+  const uint32_t hz = writeHz();
+  simSpiTransfer(spiHost(), SIM_TFT_WINDOW_BYTES + (uint32_t)w * h * 2, hz);
+  for (int32_t row = y; row < y + h; row++) {
+    for (int32_t col = x; col < x + w; col++) panel[memIndex(col, row)] = glitch(color, hz, writeLimitHz);
+  }
+  endWrite();
+}
+
+void TFT_eSPI::writeImage(int32_t x, int32_t y, int32_t w, int32_t h,
+                          const uint16_t* data, int32_t stride, bool swap) {
+  startWrite();
+  simSpiWindow(spiHost());
+  const uint32_t hz = writeHz();
+  simSpiTransfer(spiHost(), SIM_TFT_WINDOW_BYTES + (uint32_t)w * h * 2, hz);
+  for (int32_t row = 0; row < h; row++) {
+    const uint16_t* src = data + (size_t)row * stride;
+    for (int32_t col = 0; col < w; col++) {
+      // swap = Daten in Host-Reihenfolge, sonst bereits in Bus-Reihenfolge
+      panel[memIndex(x + col, y + row)] = glitch(swap ? src[col] : swap16(src[col]), hz, writeLimitHz);
+    }
+  }
+  endWrite();
+}
+
+uint16_t TFT_eSPI::readColor(int32_t x, int32_t y) {
+  return panel[memIndex(x, y)];
+}
+
+// ============================================
+// GRAFIK-PRIMITIVE
+// ============================================
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  int32_t w = 1, h = 1;
+  if (clip(x, y, w, h)) writeFill(x, y, 1, 1, color);
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+  int32_t h = 1;
+  if (clip(x, y, w, h)) writeFill(x, y, w, 1, color);
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+  int32_t w = 1;
+  if (clip(x, y, w, h)) writeFill(x, y, 1, h, color);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  if (clip(x, y, w, h)) writeFill(x, y, w, h, color);
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  startWrite();
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y + 1, h - 2, color);
+  drawFastVLine(x + w - 1, y + 1, h - 2, color);
+  endWrite();
+}
+
+void TFT_eSPI::fillScreen(uint32_t color) {
+  fillRect(0, 0, _width, _height, color);
+}
+
+// Bresenham, zusammenhängende Läufe als ein Fenster (wie TFT_eSPI)
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+  const bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) { std::swap(x0, y0); std::swap(x1, y1); }
+  if (x0 > x1) { std::swap(x0, x1); std::swap(y0, y1); }
+
+  const int32_t dx = x1 - x0, dy = abs(y1 - y0);
+  const int32_t ystep = (y0 < y1) ? 1 : -1;
+  int32_t err = dx >> 1, run = 0;
+
+  startWrite();
+  for (; x0 <= x1; x0++) {
+    run++;
+    err -= dy;
+    if (err < 0 || x0 == x1) {
+      if (steep) drawFastVLine(y0, x0 - run + 1, run, color);
+      else drawFastHLine(x0 - run + 1, y0, run, color);
+      if (err < 0) {
+        err += dx;
+        y0 += ystep;
+      }
+      run = 0;
+    }
+  }
+  endWrite();
+}
+
+void TFT_eSPI::drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+  if (r <= 0) return;
+  int32_t f = 1 - r, ddx = 1, ddy = -2 * r, x = 0, y = r;
+
+  startWrite();
+  drawPixel(x0 + r, y0, color);
+  drawPixel(x0 - r, y0, color);
+  drawPixel(x0, y0 - r, color);
+  drawPixel(x0, y0 + r, color);
+  while (x < y) {
+    if (f >= 0) { y--; ddy += 2; f += ddy; }
+    x++;
+    ddx += 2;
+    f += ddx;
+    drawPixel(x0 + x, y0 + y, color);
+    drawPixel(x0 - x, y0 + y, color);
+    drawPixel(x0 + x, y0 - y, color);
+    drawPixel(x0 - x, y0 - y, color);
+    if (x == y) continue;
+    drawPixel(x0 + y, y0 + x, color);
+    drawPixel(x0 - y, y0 + x, color);
+    drawPixel(x0 + y, y0 - x, color);
+    drawPixel(x0 - y, y0 - x, color);
+  }
+  endWrite();
+}
+
+void TFT_eSPI::fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+  if (r < 0) return;
+  int32_t f = 1 - r, ddx = 1, ddy = -2 * r, x = 0, y = r;
+
+  startWrite();
+  drawFastHLine(x0 - r, y0, 2 * r + 1, color);
+  while (x < y) {
+    if (f >= 0) {
+      // Äußere Zeilen nur beim Wechsel von y zeichnen
+      drawFastHLine(x0 - x, y0 + y, 2 * x + 1, color);
+      drawFastHLine(x0 - x, y0 - y, 2 * x + 1, color);
+      y--;
+      ddy += 2;
+      f += ddy;
+    }
+    x++;
+    ddx += 2;
+    f += ddx;
+    drawFastHLine(x0 - y, y0 + x, 2 * y + 1, color);
+    drawFastHLine(x0 - y, y0 - x, 2 * y + 1, color);
+  }
+  endWrite();
+}
+
+// ============================================
+// TEXT
+// ============================================
+
+void TFT_eSPI::glyphMetrics(uint8_t font, int16_t* w, int16_t* h) {
+  switch (font) {
+    case 2:  *w = 8;  *h = 16; break;
+    case 4:  *w = 14; *h = 26; break;
+    case 6:  *w = 24; *h = 48; break;
+    case 7:  *w = 32; *h = 48; break;
+    default: *w = 6;  *h = 8;  break;   // GLCD 5x7 + Abstand
+  }
+  *w *= textsize;
+  *h *= textsize;
+}
+
+int16_t TFT_eSPI::fontHeight(int16_t font) {
+  int16_t w, h;
+  glyphMetrics(font, &w, &h);
+  return h;
+}
+
+int16_t TFT_eSPI::textWidth(const char* string, uint8_t font) {
+  int16_t w, h;
+  glyphMetrics(font, &w, &h);
+  return (int16_t)(strlen(string) * w);
+}
+
+int16_t TFT_eSPI::drawChar(uint16_t c, int32_t x, int32_t y, uint8_t font) {
+  int16_t w, h;
+  glyphMetrics(font, &w, &h);
+  const bool space = c == ' ';
+
+  if (textbgcolor != textcolor) {
+    // Mit Hintergrund: ganze Zelle in einem Fenster (wie die Bibliothek)
+    std::vector<uint16_t> cell((size_t)w * h, textbgcolor);
+    if (!space) {
+      for (int32_t i = 0; i < w - 1; i++) {
+        cell[i] = textcolor;
+        cell[(size_t)(h - 2) * w + i] = textcolor;
+      }
+      for (int32_t j = 0; j < h - 1; j++) {
+        cell[(size_t)j * w] = textcolor;
+        cell[(size_t)j * w + w - 2] = textcolor;
+      }
+    }
+    int32_t cx = x, cy = y, cw = w, ch = h, dx, dy;
+    if (clipImage(cx, cy, cw, ch, dx, dy)) {
+      writeImage(cx, cy, cw, ch, cell.data() + (size_t)dy * w + dx, w, true);
+    }
+  } else if (!space) {
+    // Transparent: nur Vordergrund-Läufe
+    startWrite();
+    drawRect(x, y, w - 1, h - 1, textcolor);
+    endWrite();
+  }
+  return w;
+}
+
+int16_t TFT_eSPI::drawString(const char* string, int32_t x, int32_t y, uint8_t font) {
+  const int16_t w = textWidth(string, font);
+  const int16_t h = fontHeight(font);
+
+  switch (textdatum) {
+    case TC_DATUM: x -= w / 2;                 break;
+    case TR_DATUM: x -= w;                     break;
+    case ML_DATUM:              y -= h / 2;    break;
+    case MC_DATUM: x -= w / 2;  y -= h / 2;    break;
+    case MR_DATUM: x -= w;      y -= h / 2;    break;
+    case BL_DATUM: case L_BASELINE:              y -= h; break;
+    case BC_DATUM: case C_BASELINE: x -= w / 2;  y -= h; break;
+    case BR_DATUM: case R_BASELINE: x -= w;      y -= h; break;
+    default: break;
+  }
+
+  startWrite();
+  for (const char* p = string; *p; p++) {
+    x += drawChar((uint8_t)*p, x, y, font);
+  }
+  endWrite();
+  return w;
+}
+
+int16_t TFT_eSPI::drawCentreString(const char* string, int32_t x, int32_t y, uint8_t font) {
+  const uint8_t datum = textdatum;
+  textdatum = TC_DATUM;
+  const int16_t w = drawString(string, x, y, font);
+  textdatum = datum;
+  return w;
+}
+
+int16_t TFT_eSPI::drawNumber(long value, int32_t x, int32_t y, uint8_t font) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%ld", value);
+  return drawString(buf, x, y, font);
+}
+
+int16_t TFT_eSPI::drawFloat(float value, uint8_t decimals, int32_t x, int32_t y, uint8_t font) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.*f", decimals, (double)value);
+  return drawString(buf, x, y, font);
+}
+
+// ============================================
+// PIXEL-STREAM
+// ============================================
+
+void TFT_eSPI::setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+  winX = x + _xDatum;
+  winY = y + _yDatum;
+  winW = w;
+  winH = h;
+  winPos = 0;
+  startWrite();
+  simSpiWindow(spiHost());
+  simSpiTransfer(spiHost(), SIM_TFT_WINDOW_BYTES, writeHz());
+  endWrite();
+}
+
+// Schreibt 'len' Pixel ab der aktuellen Fensterposition (Zeilen laufen um)
+void TFT_eSPI::streamPixels(const uint16_t* data, uint32_t len, bool swap, uint16_t fill) {
+  startWrite();
+  const uint32_t hz = writeHz();
+  simSpiTransfer(spiHost(), len * 2, hz);
+  const uint32_t area = panel.empty() ? 0 : (uint32_t)max(winW, (int32_t)0) * max(winH, (int32_t)0);
+  for (uint32_t i = 0; i < len && area; i++) {
+    const uint32_t pos = winPos++ % area;
+    const int32_t x = winX + (int32_t)(pos % winW), y = winY + (int32_t)(pos / winW);
+    if (x < 0 || y < 0 || x >= _width || y >= _height) continue;
+    uint16_t c = data ? data[i] : fill;
+    panel[memIndex(x, y)] = glitch(swap ? c : swap16(c), hz, writeLimitHz);
+  }
+  endWrite();
+}
+
+void TFT_eSPI::pushColor(uint16_t color) {
+  streamPixels(nullptr, 1, true, color);
+}
+
+void TFT_eSPI::pushColor(uint16_t color, uint32_t len) {
+  streamPixels(nullptr, len, true, color);
+}
+
+void TFT_eSPI::pushColors(uint16_t* data, uint32_t len, bool swap) {
+  streamPixels(data, len, swap, 0);
+}
+
+void TFT_eSPI::pushPixels(const void* data, uint32_t len) {
+  streamPixels((const uint16_t*)data, len, _swapBytes, 0);
+}
+
+// ============================================
+// BILDER
+// ============================================
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+  const int32_t stride = w;
+  int32_t dx, dy;
+  if (!clipImage(x, y, w, h, dx, dy)) return;
+  writeImage(x, y, w, h, data + (size_t)dy * stride + dx, stride, _swapBytes);
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data) {
+  pushImage(x, y, w, h, (const uint16_t*)data);
+}
+
+// Wie die Bibliothek: Ergebnis passt ohne Umwandlung zu pushImage()
+void TFT_eSPI::readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data) {
+  const int32_t stride = w;
+  int32_t dx, dy;
+  if (!clipImage(x, y, w, h, dx, dy)) return;
+
+  startWrite();
+  if (!spriteTarget) {
+    simSpiWindow(spiHost());
+    simSpiTransfer(spiHost(), SIM_TFT_WINDOW_BYTES, writeHz());
+    simSpiTransfer(spiHost(), SIM_TFT_READ_OVERHEAD + (uint32_t)w * h * SIM_TFT_READ_PIXEL_BYTES,
+                   readHz(), true);
+  }
+  const uint32_t limitHz = spriteTarget ? 0 : readLimitHz;
+  for (int32_t row = 0; row < h; row++) {
+    uint16_t* dst = data + (size_t)(row + dy) * stride + dx;
+    for (int32_t col = 0; col < w; col++) {
+      const uint16_t c = glitch(readColor(x + col, y + row), readHz(), limitHz);
+      dst[col] = _swapBytes ? c : swap16(c);
+    }
+  }
+  endWrite();
+}
+
+uint16_t TFT_eSPI::readPixel(int32_t x, int32_t y) {
+  uint16_t c = 0;
+  const bool swap = _swapBytes;
+  _swapBytes = true;
+  readRect(x, y, 1, 1, &c);
+  _swapBytes = swap;
+  return c;
+}
+
+// ============================================
+// DMA
+// ============================================
+
+bool TFT_eSPI::initDMA(bool ctrlCS) {
+  (void)ctrlCS;
+  dmaEnabled = true;
+  return true;
+}
+
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t const* data, uint16_t* buffer) {
+  (void)buffer;
+  pushImage(x, y, w, h, data);
+}
+
+void TFT_eSPI::pushPixelsDMA(uint16_t* data, uint32_t len) {
+  streamPixels(data, len, _swapBytes, 0);
+}
+
+// ============================================
+// BUS
+// ============================================
+
+void TFT_eSPI::startWrite() {
+  if (spriteTarget) return;
+  if (writeDepth++ == 0) simSpiTransaction(spiHost());
+}
+
+void TFT_eSPI::endWrite() {
+  if (writeDepth) writeDepth--;
+}
+
+void TFT_eSPI::writecommand(uint8_t c) {
+  startWrite();
+  simSpiTransfer(spiHost(), 1, writeHz());
+  endWrite();
+  lastCommand = c;
+
+  switch (c) {
+    case TFT_INVON:   inverted = true;   break;
+    case TFT_INVOFF:  inverted = false;  break;
+    case TFT_DISPON:  displayOn = true;  break;
+    case TFT_DISPOFF: displayOn = false; break;
+    case TFT_SLPIN:   sleeping = true;   break;
+    case TFT_SLPOUT:  sleeping = false;  break;
+    default: break;
+  }
+}
+
+void TFT_eSPI::writedata(uint8_t d) {
+  (void)d;
+  startWrite();
+  simSpiTransfer(spiHost(), 1, writeHz());
+  endWrite();
+}
+
+// Register-Modell: Display-ID (RDDID 0x04), ILI9341 ID4 (0xD3), Status
+uint8_t TFT_eSPI::readcommand8(uint8_t cmd, uint8_t index) {
+  startWrite();
+  simSpiTransfer(spiHost(), 1, writeHz());
+  simSpiTransfer(spiHost(), (uint32_t)index + 1, readHz(), true);
+  endWrite();
+
+  if (cmd == 0x0A) {   // RDDPM: Booster, Sleep Out, Display On
+    return (uint8_t)(0x08 | (sleeping ? 0 : 0x10) | (displayOn ? 0x04 : 0) | 0x80);
+  }
+  return displayRegister(cmd, index);
+}
+
+uint16_t TFT_eSPI::readcommand16(uint8_t cmd, uint8_t index) {
+  return (uint16_t)((readcommand8(cmd, index) << 8) | readcommand8(cmd, index + 1));
+}
+
+uint32_t TFT_eSPI::readcommand32(uint8_t cmd, uint8_t index) {
+  return ((uint32_t)readcommand16(cmd, index) << 16) | readcommand16(cmd, index + 2);
+}
+
+SPIClass& TFT_eSPI::getSPIinstance() {
+  return displayBus();
+}
+
+// ============================================
+// SPRITE
+// ============================================
+
+TFT_eSprite::TFT_eSprite(TFT_eSPI* tft) : TFT_eSPI(0, 0), _tft(tft) {
+  spriteTarget = true;
+}
+
+void* TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t frames) {
+  (void)frames;
+  if (w < 1 || h < 1) return nullptr;
+  buffer.assign((size_t)w * h, 0);
+  _init_width = _width = w;
+  _init_height = _height = h;
+  resetViewport();
+  return buffer.data();
+}
+
+void TFT_eSprite::deleteSprite() {
+  buffer.clear();
+  buffer.shrink_to_fit();
+  _width = _height = 0;
+  resetViewport();
+}
+
+void TFT_eSprite::fillSprite(uint32_t color) {
+  std::fill(buffer.begin(), buffer.end(), swap16(color));
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
+  if (!created()) return;
+  const bool swap = _tft->getSwapBytes();
+  _tft->setSwapBytes(false);
+  _tft->pushImage(x, y, _width, _height, buffer.data());
+  _tft->setSwapBytes(swap);
+}
+
+void TFT_eSprite::writeFill(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+  const uint16_t stored = swap16(color);
+  for (int32_t row = y; row < y + h; row++) {
+    std::fill_n(buffer.begin() + (size_t)row * _width + x, w, stored);
+  }
+}
+
+void TFT_eSprite::writeImage(int32_t x, int32_t y, int32_t w, int32_t h,
+                             const uint16_t* data, int32_t stride, bool swap) {
+  for (int32_t row = 0; row < h; row++) {
+    const uint16_t* src = data + (size_t)row * stride;
+    uint16_t* dst = buffer.data() + (size_t)(y + row) * _width + x;
+    for (int32_t col = 0; col < w; col++) dst[col] = swap ? swap16(src[col]) : src[col];
+  }
+}
+
+uint16_t TFT_eSprite::readColor(int32_t x, int32_t y) {
+  return swap16(buffer[(size_t)y * _width + x]);
+}
+
+// ============================================
+// FRAMEBUFFER-DUMP
+// ============================================
+
+static void toRgb888(uint16_t c, uint8_t* out) {
+  const uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+  out[0] = (uint8_t)((r << 3) | (r >> 2));
+  out[1] = (uint8_t)((g << 2) | (g >> 4));
+  out[2] = (uint8_t)((b << 3) | (b >> 2));
+}
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t length) {
+  crc = ~crc;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+static void putBe32(std::vector<uint8_t>& out, uint32_t v) {
+  out.push_back(v >> 24); out.push_back(v >> 16); out.push_back(v >> 8); out.push_back(v);
+}
+
+static void pngChunk(FILE* f, const char* type, const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> chunk;
+  putBe32(chunk, (uint32_t)data.size());
+  chunk.insert(chunk.end(), type, type + 4);
+  chunk.insert(chunk.end(), data.begin(), data.end());
+  const uint32_t crc = crc32Update(0, chunk.data() + 4, chunk.size() - 4);
+  putBe32(chunk, crc);
+  fwrite(chunk.data(), 1, chunk.size(), f);
+}
+
+// PNG ohne Kompression: zlib-Strom aus "stored" Deflate-Blöcken
+static bool writePng(FILE* f, int32_t w, int32_t h, const std::vector<uint8_t>& rgb) {
+  static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+  fwrite(signature, 1, sizeof(signature), f);
+
+  std::vector<uint8_t> ihdr;
+  putBe32(ihdr, w);
+  putBe32(ihdr, h);
+  ihdr.insert(ihdr.end(), { 8, 2, 0, 0, 0 });   // 8 Bit, RGB, Deflate, Filter 0, kein Interlace
+  pngChunk(f, "IHDR", ihdr);
+
+  std::vector<uint8_t> raw;
+  raw.reserve((size_t)h * (w * 3 + 1));
+  for (int32_t y = 0; y < h; y++) {
+    raw.push_back(0);   // Filter: None
+    raw.insert(raw.end(), rgb.begin() + (size_t)y * w * 3, rgb.begin() + (size_t)(y + 1) * w * 3);
+  }
+
+  std::vector<uint8_t> z = { 0x78, 0x01 };
+  uint32_t a = 1, b = 0;
+  for (uint8_t v : raw) {
+    a = (a + v) % 65521;
+    b = (b + a) % 65521;
+  }
+  for (size_t pos = 0; pos < raw.size() || pos == 0;) {
+    const size_t len = min((size_t)65535, raw.size() - pos);
+    z.push_back(pos + len == raw.size() ? 1 : 0);
+    z.push_back(len & 0xFF); z.push_back(len >> 8);
+    z.push_back(~len & 0xFF); z.push_back((~len >> 8) & 0xFF);
+    z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + len);
+    pos += len;
+    if (!len) break;
+  }
+  putBe32(z, (b << 16) | a);
+  pngChunk(f, "IDAT", z);
+  pngChunk(f, "IEND", {});
+  return true;
+}
+
+bool simDumpFramebuffer(TFT_eSPI& display, const char* path) {
+  const uint8_t rotation = display.getRotation();
+  const int32_t w = (rotation & 1) ? TFT_HEIGHT : TFT_WIDTH;
+  const int32_t h = (rotation & 1) ? TFT_WIDTH : TFT_HEIGHT;
+
+  std::vector<uint8_t> rgb((size_t)w * h * 3);
+  for (int32_t y = 0; y < h; y++) {
+    for (int32_t x = 0; x < w; x++) toRgb888(display.simVisiblePixel(x, y), &rgb[((size_t)y * w + x) * 3]);
+  }
+
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  const size_t len = strlen(path);
+  bool ok;
+  if (len > 4 && strcmp(path + len - 4, ".png") == 0) {
+    ok = writePng(f, w, h, rgb);
+  } else {
+    fprintf(f, "P6\n%d %d\n255\n", (int)w, (int)h);
+    ok = fwrite(rgb.data(), 1, rgb.size(), f) == rgb.size();
+  }
+  return fclose(f) == 0 && ok;
+}
@@ -0,0 +1,1073 @@
+/**
+ * sim_main.cpp - Host-Simulator: Einstiegspunkt
+ *
+ * Startet HardwareManager gegen die simulierten Treiber, tunt optional
+ * den Display-Takt gegen eine simulierte Taktgrenze, fährt die
+ * Rendering-Pipelines (Strip-Renderer, Dirty-Rectangles), optional die
+ * Primitive-Benchmarks und ein Touch-Skript, und gibt den modellierten
+ * SPI-Verkehr aus. Alle Zeiten sind virtuelle Buszeiten (sim.h).
+ *
+ * Aufruf:
+ *   sim_<profil> [--frames N] [--bench csv|json] [--touch skript.txt]
+ *                [--dump bild.ppm|bild.png] [--tune] [--clock-limit W,R]
+ *                [--i2c-device SDA,SCL,ADDR] [--trace datei.trace|datei.json]
+ *                [--power skript.txt] [--touch-check] [--dma-ram BYTES]
+ *
+ * --clock-limit: Taktgrenzen des simulierten Kabels in MHz (Schreiben,
+ * Lesen), darüber werden Pixel verfälscht (simDisplayClockLimit).
+ * --i2c-device: Gerät für die Auto-Erkennung anhängen, z.B. 21,22,0x5D
+ * (GT911); mehrfach möglich.
+ * --trace: Phasen-Trace (hw_trace.h) am Ende schreiben, binär oder bei
+ * Endung .json als Chrome JSON - dasselbe Format wie auf dem Gerät.
+ * --power: Energiesparstufen mit kurzen Zeiten (SIM_POWER_*) durchlaufen,
+ * das Touch-Skript weckt das Panel.
+ * --dma-ram: größter freier DMA-Block, z.B. 4096 für den Ersatzweg ohne
+ * Strip-Puffer.
+ * --touch-check: nur die Touch-Mathematik prüfen und messen (Matrix
+ * gegen Referenz-Mapping über das ganze Rohraster, Kalibrier-Solver,
+ * Rotation, Mittelung, NVS-Blob), dann beenden.
+ */
+
+#include "config.h"
+#include "TFT_Setup.h"
+#include <TFT_eSPI.h>
+#include "hardware_hal.h"
+#include "display_benchmark.h"
+#include "hw_trace.h"
+#include "sim.h"
+#include "tools/image_pack.h"
+#include <Preferences.h>
+#include <esp_heap_caps.h>
+#include <chrono>
+
+extern TFT_eSPI tft;
+
+#define SIM_DEFAULT_FRAMES   30
+#define SIM_TOUCH_POLL_MS    HW_IO_TASK_PERIOD_MS
+#define SIM_TOUCH_TAIL_MS    600     // Nachlauf für Tap-/Long-Press-Timeouts
+#define SIM_POWER_DIM_MS     1000    // Verkürzte Stufen für --power
+#define SIM_POWER_OFF_MS     2000
+#define SIM_POWER_SLEEP_MS   3000
+#define SIM_I2C_TOUCH_SDA    21      // Bus der kapazitiven Registermodelle
+#define SIM_I2C_TOUCH_SCL    22
+#define SIM_I2C_TOUCH_IRQ    34
+#define SIM_I2C_TOUCH_RST    26
+
+static const char* const eventNames[] = {
+  "DOWN", "MOVE", "UP", "TAP", "DOUBLE_TAP", "LONG_PRESS", "SWIPE"
+};
+static const char* const swipeNames[] = { "-", "LEFT", "RIGHT", "UP", "DOWN" };
+
+// ============================================
+// SZENEN
+// ============================================
+
+// Wie renderStripBenchScene() im Sketch: Verlauf, bewegte Kreise, Text
+static void renderScene(TFT_eSprite& canvas, void* context) {
+  const int frame = *(int*)context;
+  const int w = tft.width(), h = tft.height();
+
+  for (int y = 0; y < h; y += 8) {
+    canvas.fillRect(0, y, w, 8, tft.color565((y + frame * 4) & 0xFF, 64, 255 - (y & 0xFF)));
+  }
+  for (int i = 0; i < 8; i++) {
+    const int cx = (frame * (i + 1) * 3 + i * 40) % w;
+    canvas.fillCircle(cx, 30 + i * (h - 60) / 8, 12, TFT_WHITE);
+  }
+  canvas.setTextColor(TFT_BLACK);
+  canvas.drawString("Frame " + String(frame), 10, 10, 4);
+}
+
+// ============================================
+// PIPELINES
+// ============================================
+
+// Anderes Gerät am Display-Host im selben Task vor waitFrame() (wie
+// isTouchPressed() am geteilten Bus): der Arbiter muss den offenen
+// DMA-Frame abschließen, statt den Task auf sich selbst warten zu lassen
+static bool runStripDrain() {
+  if (!hardware.isDisplayDMAActive() || hardware.getStripRows() == 0) return true;
+
+  const SpiDevice probe = { "Probe", HW_DISPLAY_SPI_BUS, SPI_PRIORITY_REALTIME, 2500000, SPI_MODE0 };
+  int frame = 0;
+  const uint32_t fence = hardware.renderFrame(renderScene, &frame);
+  const uint32_t contended = spiArbiter.getStats(HW_DISPLAY_SPI_BUS).contended;
+  const bool acquired = spiArbiter.acquire(probe);
+  spiArbiter.release(probe);
+  const bool drained = acquired && hardware.isFrameComplete(fence) &&
+                       spiArbiter.getStats(HW_DISPLAY_SPI_BUS).contended == contended;
+  Serial.printf("   Buszugriff vor waitFrame(): Frame abgeschlossen, ohne Warten %s\n",
+                drained ? "✅" : "❌");
+  return drained;
+}
+
+// Ohne Strip-Puffer (--dma-ram zu klein) laufen die Frames über den
+// Band-Puffer: auch dann muss jeder Frame vollständig auf den Bus
+static bool runStripPipeline(int frames) {
+  const uint64_t startNs = simNowNs();
+  const SimSpiStats before = simSpiStats(HW_DISPLAY_SPI_BUS);
+
+  for (int frame = 0; frame < frames; frame++) {
+    hardware.waitFrame(hardware.renderFrame(renderScene, &frame));
+  }
+
+  const uint64_t elapsedNs = simNowNs() - startNs;
+  const uint64_t bytes = simSpiStats(HW_DISPLAY_SPI_BUS).bytes - before.bytes;
+  const bool complete = bytes >= (uint64_t)frames * tft.width() * tft.height() * 2;
+  if (hardware.getStripRows() > 0) {
+    Serial.printf("🎞️ Strip-Rendering: %d Frames | %d Zeilen/Streifen | %s\n",
+                  frames, hardware.getStripRows(), hardware.isDisplayDMAActive() ? "DMA" : "blockierend");
+  } else {
+    Serial.printf("🎞️ Strip-Rendering: %d Frames | ohne Strip-Puffer, über den Band-Puffer\n", frames);
+  }
+  Serial.printf("   %.1f FPS (Busmodell) | %.2f ms/Frame | %llu Bytes/Frame %s\n",
+                elapsedNs ? frames * 1e9 / elapsedNs : 0.0, elapsedNs / 1e6 / max(frames, 1),
+                (unsigned long long)(bytes / max(frames, 1)), complete ? "✅" : "❌");
+  return complete && runStripDrain();
+}
+
+// Zähler-Label neu zeichnen: nur das Rechteck wird übertragen. Der
+// Byte- und Fensterzähler des Flushes muss dem SPI-Modell entsprechen.
+static bool runDamagePipeline(int frames) {
+  int frame = 0;
+  hardware.markDisplayDirty();
+  hardware.flushDisplay(renderScene, &frame);
+
+  uint64_t bytes = 0;
+  uint32_t windows = 0;
+  const SimSpiStats before = simSpiStats(HW_DISPLAY_SPI_BUS);
+  const uint64_t startNs = simNowNs();
+  for (frame = 1; frame <= frames; frame++) {
+    hardware.markDirty(10, 10, 140, tft.fontHeight(4));
+    hardware.flushDisplay(renderScene, &frame);
+    bytes += hardware.getFlushStats().lastBytes;
+    windows += hardware.getFlushStats().lastWindows;
+  }
+  const uint64_t elapsedNs = simNowNs() - startNs;
+  const uint64_t busBytes = simSpiStats(HW_DISPLAY_SPI_BUS).bytes - before.bytes;
+  const uint32_t busWindows = simSpiStats(HW_DISPLAY_SPI_BUS).windows - before.windows;
+  const bool counted = bytes == busBytes && windows == busWindows;
+
+  const DamageFlushStats& stats = hardware.getFlushStats();
+  Serial.printf("🩹 Dirty-Rectangles: %d Frames | %llu Bytes/Frame statt %lu (%.1f%%) | %lu Fenster\n",
+                frames, (unsigned long long)(bytes / max(frames, 1)), (unsigned long)stats.fullFrameBytes,
+                stats.fullFrameBytes ? 100.0 * bytes / max(frames, 1) / stats.fullFrameBytes : 0.0,
+                (unsigned long)stats.lastWindows);
+  Serial.printf("   %.1f Updates/s (Busmodell) | Zähler = Bus %s\n",
+                elapsedNs ? frames * 1e9 / elapsedNs : 0.0, counted ? "✅" : "❌");
+  return counted;
+}
+
+// Eine Sekunde im Frame-Takt: Label alle 100 ms, je zwei Anforderungen
+// pro Änderung (gebündelt), dazwischen leere Slots
+static bool runFramePacing() {
+  int frame = 0;
+  hardware.getFrameStats(true);
+  const uint32_t startMs = millis();
+  uint32_t nextChangeMs = startMs;
+  while (millis() - startMs < 1000) {
+    if ((int32_t)(millis() - nextChangeMs) >= 0) {
+      hardware.requestFrame();
+      hardware.requestFrame();
+      nextChangeMs += 100;
+    }
+    if (hardware.beginFrame()) {
+      frame++;
+      hardware.markDirty(10, 10, 140, tft.fontHeight(4));
+      hardware.flushDisplay(renderScene, &frame);
+      hardware.endFrame();
+    }
+  }
+
+  FrameStats stats = hardware.getFrameStats(true);
+  const bool paced = stats.frames >= 9 && stats.frames <= 11 && stats.skipped > stats.frames &&
+                     stats.coalesced >= stats.frames && stats.missed == 0;
+  Serial.printf("🎞️ Frame-Takt %u Hz: %lu Frames, %lu leere Slots, %lu gebündelt, %lu über Budget "
+                "(max %lu µs) | Leerlauf %.1f%% | %s\n",
+                hardware.getFrameRate(), (unsigned long)stats.frames, (unsigned long)stats.skipped,
+                (unsigned long)stats.coalesced, (unsigned long)stats.missed, (unsigned long)stats.maxFrameUs,
+                stats.elapsedMs ? 100.0 - stats.totalFrameUs / (10.0 * stats.elapsedMs) : 100.0,
+                paced ? "✅" : "❌");
+  return paced;
+}
+
+// Status-Zeile 20-mal neu: drawString() mit Hintergrund gegen den
+// Glyphen-Atlas, beide Zeilen müssen pixelgleich sein
+static bool runGlyphAtlas() {
+  const SimSpiStats& bus = simSpiStats(HW_DISPLAY_SPI_BUS);
+  const int32_t rows[2] = { 40, 70 };
+  uint32_t windows[2];
+  uint64_t bytes[2];
+  char text[32] = "";
+  for (int mode = 0; mode < 2; mode++) {
+    const uint32_t startWindows = bus.windows;
+    const uint64_t startBytes = bus.bytes;
+    for (int i = 0; i < 20; i++) {
+      snprintf(text, sizeof(text), "Zeit: %ds Samples: %d", i, i * 37);
+      if (mode == 0) {
+        tft.setTextColor(TFT_WHITE, TFT_BLACK);
+        tft.drawString(text, 10, rows[mode], 2);
+      } else {
+        hardware.drawText(text, 10, rows[mode], 2, TFT_WHITE, TFT_BLACK);
+      }
+    }
+    windows[mode] = bus.windows - startWindows;
+    bytes[mode] = bus.bytes - startBytes;
+  }
+
+  bool same = true;
+  for (int32_t y = 0; y < tft.fontHeight(2); y++) {
+    for (int32_t x = 0; x < tft.textWidth(text, 2); x++) {
+      same = same && tft.simVisiblePixel(10 + x, rows[0] + y) == tft.simVisiblePixel(10 + x, rows[1] + y);
+    }
+  }
+
+  // Alle druckbaren Zeichen in FONT4 (> GLYPH_ATLAS_BYTES): LRU muss verdrängen
+  for (int first = '!'; first <= '~'; first += 16) {
+    for (int i = 0; i < 16; i++) text[i] = (char)min(first + i, (int)'~');
+    text[16] = '\0';
+    tft.setTextColor(TFT_WHITE, TFT_BLUE);
+    tft.drawString(text, 10, 100, 4);
+    hardware.drawText(text, 10, 130, 4, TFT_WHITE, TFT_BLUE);
+    for (int32_t y = 0; y < tft.fontHeight(4); y++) {
+      for (int32_t x = 0; x < tft.textWidth(text, 4); x++) {
+        same = same && tft.simVisiblePixel(10 + x, 100 + y) == tft.simVisiblePixel(10 + x, 130 + y);
+      }
+    }
+  }
+
+  const GlyphAtlas& atlas = hardware.getGlyphAtlas();
+  const GlyphAtlasStats& stats = atlas.stats();
+  const bool ok = same && windows[1] * 10 <= windows[0] && stats.evictions > 0;
+  Serial.printf("🔤 Glyphen-Atlas: %lu statt %lu Fenster, %llu statt %llu Bytes | %u Glyphen (%lu Bytes), "
+                "%lu Treffer, %lu gerastert, %lu verdrängt | Bild %s | %s\n",
+                (unsigned long)windows[1], (unsigned long)windows[0], (unsigned long long)bytes[1],
+                (unsigned long long)bytes[0], atlas.glyphCount(), (unsigned long)atlas.usedBytes(),
+                (unsigned long)stats.hits, (unsigned long)stats.misses, (unsigned long)stats.evictions,
+                same ? "gleich" : "abweichend",
+                ok ? "✅" : "❌");
+  return ok;
+}
+
+// Logo mit Verlaufsband gepackt (Palette bzw. RLE als BGR) und über die
+// Ränder gezeichnet: sichtbare Pixel müssen der Quelle gleichen
+static bool runImageBlit() {
+  const uint16_t width = 120, height = 60;
+  std::vector<uint16_t> pixels((size_t)width * height, TFT_NAVY);
+  for (uint16_t y = 0; y < height; y++) {
+    for (uint16_t x = 0; x < width; x++) {
+      if (y >= 48) pixels[y * width + x] = imagePackRgb565(x / 8 * 16, 255 - x / 8 * 16, y * 4);
+      else if ((x / 8 + y / 12) % 2 && x > 8 && x < 112) pixels[y * width + x] = TFT_ORANGE;
+    }
+  }
+  std::vector<uint8_t> assets[2];
+  imagePack(pixels.data(), width, height, IMAGE_ENC_PALETTE, 0, &assets[0]);
+  imagePack(pixels.data(), width, height, IMAGE_ENC_RLE, IMAGE_FLAG_BGR, &assets[1]);
+
+  const int32_t positions[3][2] = { { -20, 10 }, { tft.width() - 70, tft.height() - 25 }, { 40, -30 } };
+  const SimSpiStats& bus = simSpiStats(HW_DISPLAY_SPI_BUS);
+  uint64_t blitBytes = 0;
+  bool same = true;
+  for (int a = 0; a < 2; a++) {
+    for (const int32_t* pos : positions) {
+      tft.fillScreen(TFT_BLACK);
+      const uint64_t startBytes = bus.bytes;
+      same = same && hardware.drawImage(assets[a].data(), pos[0], pos[1]);
+      blitBytes += bus.bytes - startBytes;
+      for (int32_t y = 0; y < height; y++) {
+        for (int32_t x = 0; x < width; x++) {
+          const int32_t sx = pos[0] + x, sy = pos[1] + y;
+          if (sx < 0 || sy < 0 || sx >= tft.width() || sy >= tft.height()) continue;
+          same = same && tft.simVisiblePixel(sx, sy) == pixels[y * width + x];
+        }
+      }
+    }
+  }
+
+  const ImageBlitStats& stats = hardware.getImageStats();
+  const uint32_t rawBytes = width * height * 2;
+  const bool ok = same && stats.errors == 0 && stats.images == 6;
+  Serial.printf("🖼️ Bild-Blitter: Palette %lu / RLE %lu statt %lu Bytes Flash | %lu Pixel in %lu Puffern, "
+                "%llu Bytes SPI | Bild %s | %s\n",
+                (unsigned long)assets[0].size(), (unsigned long)assets[1].size(), (unsigned long)rawBytes,
+                (unsigned long)stats.pixels, (unsigned long)stats.chunks,
+                (unsigned long long)blitBytes, same ? "gleich" : "abweichend", ok ? "✅" : "❌");
+  tft.fillScreen(TFT_BLACK);
+  return ok;
+}
+
+// Farbverlauf-Test (oben Spalten, Mitte Zeilen) und ein links geclipptes
+// 8x8-Raster: Linien/Rechtecke gegen Spans, Fenster und Pixel vergleichen
+static bool runSpanFill() {
+  static const uint16_t colors[] = { TFT_BLACK, TFT_WHITE, TFT_RED, TFT_GREEN,
+                                     TFT_BLUE, TFT_YELLOW, TFT_MAGENTA, TFT_CYAN };
+  const int32_t w = tft.width(), third = tft.height() / 3;
+  const int32_t cellW = w / 8, cellH = third / 8;
+  const SimSpiStats& bus = simSpiStats(HW_DISPLAY_SPI_BUS);
+  std::vector<uint16_t> reference((size_t)w * tft.height());
+  uint32_t windows[2];
+  bool same = true;
+
+  for (int mode = 0; mode < 2; mode++) {
+    tft.fillScreen(TFT_BLACK);
+    const uint32_t startWindows = bus.windows;
+    if (mode == 0) {
+      for (int32_t x = 0; x < w; x++) tft.drawFastVLine(x, 0, third, tft.color565(x * 255 / w, 0, 0));
+      for (int32_t y = 0; y < third; y++) tft.drawFastHLine(0, third + y, w, tft.color565(0, y * 255 / third, 0));
+      for (int32_t i = 0; i < 8; i++) {
+        for (int32_t j = 0; j < 8; j++) {
+          tft.fillRect(i * cellW - cellW / 2, 2 * third + j * cellH, cellW, cellH, colors[(i + j) % 8]);
+        }
+      }
+    } else {
+      hardware.fillSpans(0, 0, w, third, spanGradientH(TFT_BLACK, TFT_RED));
+      hardware.fillSpans(0, third, w, third, spanGradientV(TFT_BLACK, TFT_GREEN));
+      hardware.fillSpans(-cellW / 2, 2 * third, 8 * cellW, 8 * cellH, spanGrid(colors, 8, cellW, cellH));
+    }
+    windows[mode] = bus.windows - startWindows;
+
+    for (int32_t y = 0; y < tft.height(); y++) {
+      for (int32_t x = 0; x < w; x++) {
+        uint16_t& pixel = reference[(size_t)y * w + x];
+        if (mode == 0) pixel = tft.simVisiblePixel(x, y);
+        else same = same && tft.simVisiblePixel(x, y) == pixel;
+      }
+    }
+  }
+
+  const SpanFillStats& stats = hardware.getSpanStats();
+  const bool ok = same && windows[1] == 3;
+  Serial.printf("🌈 Span-Füllung: %lu statt %lu Fenster | %lu Zeilen erzeugt, %lu kopiert, %lu Puffer "
+                "wiederverwendet | Bild %s | %s\n",
+                (unsigned long)windows[1], (unsigned long)windows[0], (unsigned long)stats.rowsGenerated,
+                (unsigned long)stats.rowsCopied, (unsigned long)stats.bandsReused,
+                same ? "gleich" : "abweichend", ok ? "✅" : "❌");
+  tft.fillScreen(TFT_BLACK);
+  return ok;
+}
+
+// Zähler 200-mal hochzählen, dann kürzer werden lassen: Bytes pro Update
+// gegen ein 60 Zeilen hohes Band, Ergebnis pixelgleich zu drawString()
+static bool runTextLabel() {
+  TextLabel label(10, 170, 2, TFT_WHITE, TFT_BLACK);
+  char text[TEXT_LABEL_MAX_CHARS + 1];
+  tft.fillRect(0, 170, tft.width(), 60, TFT_BLACK);
+  for (int i = 0; i < 200; i++) {
+    snprintf(text, sizeof(text), "Samples: %d  Zeit: %d s", i * 7, i / 10);
+    hardware.updateLabel(label, text);
+  }
+  const TextLabelStats stats = label.stats();
+  hardware.updateLabel(label, "Samples: 7");
+
+  // Referenz: Band löschen und komplett neu zeichnen
+  tft.fillRect(0, 200, tft.width(), 30, TFT_BLACK);
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+  tft.drawString("Samples: 7", 10, 200, 2);
+  bool same = true;
+  for (int32_t y = 0; y < tft.fontHeight(2); y++) {
+    for (int32_t x = 0; x < tft.width() - 10; x++) {
+      same = same && tft.simVisiblePixel(10 + x, 170 + y) == tft.simVisiblePixel(10 + x, 200 + y);
+    }
+  }
+
+  const uint32_t bandBytes = (uint32_t)tft.width() * 60 * 2;
+  const uint32_t averageBytes = (uint32_t)(stats.totalBytes / stats.updates);
+  const bool ok = same && averageBytes * 20 < bandBytes;
+  Serial.printf("🏷️ Text-Label: Ø %.1f Zellen, %lu Bytes pro Update (Band: %lu Bytes) | Bild %s | %s\n",
+                (float)stats.cells / stats.updates, (unsigned long)averageBytes, (unsigned long)bandBytes,
+                same ? "gleich" : "abweichend", ok ? "✅" : "❌");
+  return ok;
+}
+
+// Boot-Fade abwarten, dann Hardware-Fade mit Gamma-Tabelle abtasten
+static bool runBacklightFade() {
+  if (!hardware.hasPWMBacklight()) return true;
+  const uint32_t maxDuty = (1u << HW_BACKLIGHT_PWM_RESOLUTION) - 1;
+  delay(BOOT_FADE_MS);
+  Serial.printf("💡 Backlight %d %% (Duty %lu/%lu) | Fade 100 -> 20 %% in 400 ms:",
+                hardware.getDisplayBrightness(), (unsigned long)simLedcDuty(HW_BACKLIGHT_PIN),
+                (unsigned long)maxDuty);
+  hardware.fadeDisplayBrightness(20, 400);
+  for (int i = 0; i <= 4; i++) {
+    Serial.printf(" %lu", (unsigned long)simLedcDuty(HW_BACKLIGHT_PIN));
+    delay(100);
+  }
+  const bool faded = !hardware.isBrightnessFading();
+  Serial.printf(" | %s", faded ? "fertig ✅" : "läuft noch ❌");
+
+  // Voller Duty per ledcWrite() liest sich als max+1 zurück: kein Fade,
+  // der nächste Fade startet trotzdem im gültigen Bereich
+  hardware.setDisplayBrightness(100);
+  const bool settled = !hardware.isBrightnessFading();
+  hardware.fadeDisplayBrightness(50, 100);
+  const bool inRange = simLedcDuty(HW_BACKLIGHT_PIN) <= maxDuty;
+  delay(100);
+  Serial.printf(" | 100 %% gesetzt: %s, Fade-Start %s\n", settled ? "ruhend ✅" : "Fade ❌",
+                inRange ? "im Bereich ✅" : "max+1 ❌");
+  hardware.setDisplayBrightness(HW_BACKLIGHT_DEFAULT);
+  return faded && settled && inRange;
+}
+
+static void runBenchmark(BenchmarkFormat format) {
+  BenchmarkConfig config;
+  config.seed = BENCH_DEFAULT_SEED;
+  config.warmup = BENCH_DEFAULT_WARMUP;
+  config.repeats = BENCH_DEFAULT_REPEATS;
+  config.spiHz = hardware.getDisplayWriteHz();
+  config.profile = hardware.getProfile().name;
+  config.display = &hardware.getDisplaySpiDevice();
+  runDisplayBenchmark(tft, config, format);
+}
+
+// Tuning mit Persistenz, danach NVS-Rundlauf wie beim nächsten Boot
+static bool runClockTune() {
+  Serial.println("⚡ Display-Takt Tuning");
+  DisplayClockResult result;
+  if (!hardware.tuneDisplayClock(&result, true)) {
+    return false;
+  }
+  Serial.printf("   Ergebnis: %.2f MHz schreiben, %.2f MHz lesen | %lu ms (Busmodell)\n",
+                result.clock.writeHz / 1e6, result.clock.readHz / 1e6,
+                (unsigned long)result.durationMs);
+  return hardware.loadDisplayClock();
+}
+
+// Skript abspielen, Events ausgeben und als Spur einzeichnen
+static int runTouchScript() {
+  int counts[7] = { 0 };
+  simTouchStart();
+  const uint32_t startUs = micros();
+  const uint32_t endMs = millis() + simTouchScriptEndMs() + SIM_TOUCH_TAIL_MS;
+
+  while ((int32_t)(millis() - endMs) < 0) {
+    hardware.processTouch();
+
+    TouchEvent event;
+    while (hardware.getTouchEvent(&event)) {
+      counts[event.type]++;
+      if (event.type == TOUCH_EVENT_MOVE) {
+        tft.fillCircle(event.x, event.y, 2, TFT_YELLOW);
+        continue;   // MOVE nur zählen, nicht ausgeben
+      }
+      Serial.printf("👆 %7.1f ms %-10s x=%3d y=%3d dx=%4d dy=%4d v=%4u %s\n",
+                    (event.timestampUs - startUs) / 1000.0, eventNames[event.type], event.x, event.y,
+                    event.dx, event.dy, event.velocity,
+                    event.type == TOUCH_EVENT_SWIPE ? swipeNames[event.direction] : "");
+      if (event.type == TOUCH_EVENT_DOWN) tft.fillCircle(event.x, event.y, 4, TFT_GREEN);
+      if (event.type == TOUCH_EVENT_UP) tft.fillCircle(event.x, event.y, 4, TFT_RED);
+    }
+    delay(SIM_TOUCH_POLL_MS);
+  }
+
+  Serial.printf("   Events: %d DOWN, %d MOVE, %d UP, %d TAP, %d DOUBLE_TAP, %d LONG_PRESS, %d SWIPE\n",
+                counts[0], counts[1], counts[2], counts[3], counts[4], counts[5], counts[6]);
+  return counts[TOUCH_EVENT_DOWN] + counts[TOUCH_EVENT_UP];
+}
+
+// Stufen durchlaufen, Touch weckt; der letzte Frame muss ohne Neuzeichnen
+// wieder sichtbar sein
+static bool runPowerScenario() {
+  const int px = tft.width() - 1, py = tft.height() - 1;
+  const uint16_t before = tft.simVisiblePixel(px, py);
+  bool darkSeen = false;
+  int downs = 0;
+
+  hardware.setPowerConfig(PowerConfig{ SIM_POWER_DIM_MS, SIM_POWER_OFF_MS, SIM_POWER_SLEEP_MS,
+                                       HW_POWER_DIM_PERCENT });
+  hardware.getPowerStats(true);
+  hardware.notifyActivity();
+  simTouchStart();
+  const uint32_t endMs = millis() + simTouchScriptEndMs() + SIM_TOUCH_TAIL_MS;
+
+  while ((int32_t)(millis() - endMs) < 0) {
+    hardware.processTouch();
+    hardware.updatePower();
+    if (!hardware.isDisplayAwake() && tft.simVisiblePixel(px, py) == TFT_BLACK) darkSeen = true;
+
+    TouchEvent event;
+    while (hardware.getTouchEvent(&event)) {
+      if (event.type == TOUCH_EVENT_DOWN) downs++;
+    }
+    delay(SIM_TOUCH_POLL_MS);
+  }
+
+  const PowerStats stats = hardware.getPowerStats();
+  const bool restored = hardware.isDisplayAwake() && tft.simVisiblePixel(px, py) == before;
+  hardware.printPowerStats();
+  Serial.printf("   Touch-Events: %d DOWN | Panel dunkel: %s | Frame nach dem Wecken: %s\n", downs,
+                darkSeen ? "ja" : "nein", restored ? "erhalten ✅" : "verloren ❌");
+  hardware.setPowerConfig(powerConfigDefault());
+  return restored && darkSeen && stats.wakeups > 0 &&
+         stats.maxWakeUs + POWER_WAKE_FADE_MS * 1000 <= POWER_WAKE_BUDGET_US;
+}
+
+// ============================================
+// ZUSAMMENFASSUNG
+// ============================================
+
+static void printSpiHost(const char* name, uint8_t host, uint32_t hz, uint64_t elapsedNs) {
+  const SimSpiStats& s = simSpiStats(host);
+  Serial.printf("   %-8s %s @ %5.1f MHz: %10llu Bytes (%llu gelesen) | %6lu Transaktionen | "
+                "%6lu Fenster | %8.2f ms Bus | %5.1f%%\n",
+                name, host == VSPI ? "VSPI" : "HSPI", hz / 1e6, (unsigned long long)s.bytes,
+                (unsigned long long)s.readBytes, (unsigned long)s.transactions,
+                (unsigned long)s.windows, s.busyNs / 1e6,
+                elapsedNs ? 100.0 * s.busyNs / elapsedNs : 0.0);
+}
+
+static void printSpiSummary() {
+  const uint64_t elapsedNs = simNowNs();
+  Serial.println("\n📊 SPI-Modell (seit Start)");
+  printSpiHost("Display", HW_DISPLAY_SPI_BUS, hardware.getDisplayWriteHz(), elapsedNs);
+  const HardwareProfile& profile = hardware.getProfile();
+  if (!profile.touchSharesBus()) {
+    printSpiHost("Touch", profile.touch.bus, profile.touch.spiHz, elapsedNs);
+  }
+  Serial.printf("   Virtuelle Zeit: %.2f ms\n", elapsedNs / 1e6);
+}
+
+static void writeTraceFile(const uint8_t* data, size_t length, void* context) {
+  fwrite(data, 1, length, (FILE*)context);
+}
+
+static bool writeTrace(const char* path) {
+  const size_t length = strlen(path);
+  const bool json = length >= 5 && !strcmp(path + length - 5, ".json");
+  FILE* file = fopen(path, "wb");
+  if (!file) return false;
+  const bool ok = hwTraceDump(json ? HW_TRACE_FORMAT_JSON : HW_TRACE_FORMAT_BINARY,
+                              writeTraceFile, file);
+  return fclose(file) == 0 && ok;
+}
+
+// ============================================
+// PROFIL-TABELLE (--profile, --board)
+// ============================================
+
+static const HardwareProfile* findTableProfile(const char* name) {
+  for (int i = 0; i < HW_PROFILE_COUNT; i++) {
+    if (!strcmp(hardwareProfiles[i].name, name)) return &hardwareProfiles[i];
+  }
+  Serial.printf("❌ Profil %s nicht in der Tabelle\n", name);
+  return nullptr;
+}
+
+// Eintrag der Profil-Tabelle per Name vor begin() übernehmen. Das
+// simulierte Display bleibt HARDWARE_PROFILE, wie TFT_Setup.h auf dem Gerät.
+static bool selectTableProfile(const char* name) {
+  const HardwareProfile* entry = findTableProfile(name);
+  return entry && hardware.selectProfile(*entry);
+}
+
+// Simuliertes Board: Touch aus dem Eintrag, die Auto-Erkennung soll ihn finden
+static bool selectSimBoard(const char* name) {
+  const HardwareProfile* entry = findTableProfile(name);
+  if (!entry) return false;
+  if (!simTouchBoard(*entry)) {
+    Serial.printf("❌ Board %s: anderes Display oder kein XPT2046\n", name);
+    return false;
+  }
+  Serial.printf("🧩 Simuliertes Board: %s\n", entry->name);
+  return true;
+}
+
+// ============================================
+// MAIN
+// ============================================
+
+static void printUsage(const char* argv0) {
+  fprintf(stderr, "Aufruf: %s [--frames N] [--bench csv|json] [--touch skript.txt]\n"
+                  "          [--dump bild.ppm|bild.png] [--tune] [--clock-limit W,R]\n"
+                  "          [--i2c-device SDA,SCL,ADDR] [--trace datei.trace|datei.json]\n"
+                  "          [--power skript.txt] [--touch-check] [--dma-ram BYTES]\n"
+                  "          [--profile NAME] (nur Build mit HW_RUNTIME_PROFILE) [--board NAME]\n", argv0);
+}
+
+// ============================================
+// TOUCH-MATHEMATIK (--touch-check)
+// ============================================
+
+#define SIM_TOUCH_RAW_MAX    4095    // 12-Bit Rohwerte des XPT2046
+#define SIM_CAL_NOISE        8       // Rauschen der Kalibrier-Rohwerte (± Counts)
+#define SIM_CAL_GRID         8       // Raster der Fehlerprüfung (Pixel)
+
+// Host-Zeit pro Punkt über das ganze Rohraster; 'sink' verhindert,
+// dass der Compiler die Schleife wegoptimiert
+static double touchGridNs(const HwTouchConfig& touch, uint8_t rotation, bool reference) {
+  const TouchTransform& t = touch.transforms[rotation];
+  volatile long sink = 0;
+  long sum = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (long rawY = 0; rawY <= SIM_TOUCH_RAW_MAX; rawY++) {
+    for (long rawX = 0; rawX <= SIM_TOUCH_RAW_MAX; rawX++) {
+      if (reference) {
+        long tx, ty;
+        touch.referenceMap(rotation, rawX, rawY, tx, ty);
+        sum += TouchTransformDetail::clampTo(tx, t.maxX) + TouchTransformDetail::clampTo(ty, t.maxY);
+      } else {
+        int x, y;
+        t.apply(rawX, rawY, &x, &y);
+        sum += x + y;
+      }
+    }
+  }
+  sink = sum;
+  (void)sink;
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  return ns / ((SIM_TOUCH_RAW_MAX + 1.0) * (SIM_TOUCH_RAW_MAX + 1.0));
+}
+
+// Matrizen des aktiven Profils gegen sein Referenz-Mapping an jedem
+// Rohpunkt 0..4095 x 0..4095 aller vier Rotationen. Nach dem Clamp darf
+// die Matrix höchstens 1 Pixel abweichen (Rundung statt Abschneiden);
+// die static_asserts in HW_DEFINE_PROFILE prüfen nur Ecken und Mitte.
+static bool runTouchGrid() {
+  const HwTouchConfig& touch = hardware.getProfile().touch;
+  bool allOk = true;
+  for (uint8_t rotation = 0; rotation < 4; rotation++) {
+    const TouchTransform& t = touch.transforms[rotation];
+    long worst = 0, worstX = 0, worstY = 0;
+    uint64_t exact = 0;
+    for (long rawY = 0; rawY <= SIM_TOUCH_RAW_MAX; rawY++) {
+      for (long rawX = 0; rawX <= SIM_TOUCH_RAW_MAX; rawX++) {
+        int x, y;
+        long tx, ty;
+        t.apply(rawX, rawY, &x, &y);
+        touch.referenceMap(rotation, rawX, rawY, tx, ty);
+        const long dx = labs(x - TouchTransformDetail::clampTo(tx, t.maxX));
+        const long dy = labs(y - TouchTransformDetail::clampTo(ty, t.maxY));
+        const long d = max(dx, dy);
+        if (d == 0) exact++;
+        if (d > worst) {
+          worst = d;
+          worstX = rawX;
+          worstY = rawY;
+        }
+      }
+    }
+    const double matrixNs = touchGridNs(touch, rotation, false);
+    const double referenceNs = touchGridNs(touch, rotation, true);
+    const bool ok = worst <= 1;
+    Serial.printf("👆 Touch-Matrix Rotation %d: max. %ld px (bei %ld/%ld), %.1f%% exakt | "
+                  "%.2f ns/Punkt statt %.2f (%.1fx) | %s\n",
+                  rotation, worst, worstX, worstY,
+                  100.0 * exact / ((SIM_TOUCH_RAW_MAX + 1.0) * (SIM_TOUCH_RAW_MAX + 1.0)),
+                  matrixNs, referenceNs, matrixNs > 0 ? referenceNs / matrixNs : 0, ok ? "✅" : "❌");
+    allOk = allOk && ok;
+  }
+  return allOk;
+}
+
+// Slot des Fingers an (x, y), -1 = nicht gemeldet
+static int touchI2cSlotAt(const TouchI2c& driver, uint16_t x, uint16_t y) {
+  TouchI2cPoint points[TOUCH_I2C_MAX_POINTS];
+  const uint8_t count = driver.points(points, TOUCH_I2C_MAX_POINTS);
+  for (uint8_t i = 0; i < count; i++) {
+    if (points[i].x == x && points[i].y == y) return points[i].slot;
+  }
+  return -1;
+}
+
+// Bericht ins Registermodell, INT-Flanke, update(): genau 'expected'
+// Transaktionen und alle Finger an ihrer Position
+static bool touchI2cReport(SimTouchI2cDevice& device, TouchI2c& driver, const SimTouchContact* contacts,
+                           uint8_t count, uint32_t expected, uint64_t* bytes) {
+  const SimI2cStats before = simI2cStats();
+  device.setContacts(contacts, count);
+  if (!driver.update()) return false;
+  *bytes = simI2cStats().bytes - before.bytes;
+  if (simI2cStats().transactions - before.transactions != expected || driver.count() != count) return false;
+  for (uint8_t i = 0; i < count; i++) {
+    if (touchI2cSlotAt(driver, contacts[i].x, contacts[i].y) < 0) return false;
+  }
+  return true;
+}
+
+// Pro Controller ein Registermodell am I2C-Bus: Finger aufsetzen, in
+// anderer Reihenfolge verschieben, den ersten abheben, einen neuen
+// setzen, alle abheben. Jeder Bericht ist ein Burst-Read (GT911 plus
+// Quittung), Slots folgen den Fingern, ohne INT-Flanke kein Verkehr.
+// Der CST816S antwortet erst, nachdem begin() RST gepulst hat.
+static bool runTouchI2c() {
+  static SimTouchI2cDevice devices[3] = { SimTouchI2cDevice(HW_TOUCH_CTRL_GT911, SIM_I2C_TOUCH_IRQ),
+                                          SimTouchI2cDevice(HW_TOUCH_CTRL_FT6236, SIM_I2C_TOUCH_IRQ),
+                                          SimTouchI2cDevice(HW_TOUCH_CTRL_CST816S, SIM_I2C_TOUCH_IRQ,
+                                                            SIM_I2C_TOUCH_RST) };
+  static const uint8_t controllers[3] = { HW_TOUCH_CTRL_GT911, HW_TOUCH_CTRL_FT6236, HW_TOUCH_CTRL_CST816S };
+  static const uint8_t addresses[3] = { TOUCH_I2C_ADDR_GT911, TOUCH_I2C_ADDR_FT6236, TOUCH_I2C_ADDR_CST816S };
+  static const char* const names[3] = { "GT911", "FT6236", "CST816S" };
+  static const uint8_t trackIds[TOUCH_I2C_MAX_POINTS] = { 3, 7, 1, 9, 4 };
+  TwoWire bus;
+  bus.begin(SIM_I2C_TOUCH_SDA, SIM_I2C_TOUCH_SCL, HW_TOUCH_I2C_FREQ);
+  bool allOk = true;
+
+  for (int c = 0; c < 3; c++) {
+    const uint8_t maxPoints = hwTouchMaxPoints(controllers[c]);
+    const uint32_t expected = controllers[c] == HW_TOUCH_CTRL_GT911 ? 2 : 1;
+    simI2cAttach(SIM_I2C_TOUCH_SDA, SIM_I2C_TOUCH_SCL, addresses[c], &devices[c]);
+    TouchI2c driver;
+    // Ohne RST-Puls bleibt der CST816S im Auto-Sleep stumm (nur er hängt an RST)
+    const bool sleeper = controllers[c] == HW_TOUCH_CTRL_CST816S;
+    const bool asleep = !sleeper ||
+                        !driver.begin(bus, controllers[c], 0, SIM_I2C_TOUCH_IRQ, -1, maxPoints, HW_TOUCH_SAMPLE_RATE);
+    bool ok = asleep &&
+              driver.begin(bus, controllers[c], 0, SIM_I2C_TOUCH_IRQ, sleeper ? SIM_I2C_TOUCH_RST : -1,
+                           maxPoints, HW_TOUCH_SAMPLE_RATE) &&
+              !strcmp(driver.chipName(), names[c]);
+    driver.update();   // Bericht nach begin(): noch kein Finger
+
+    // Alle Finger auf, dann verschoben in umgekehrter Reihenfolge
+    SimTouchContact contacts[TOUCH_I2C_MAX_POINTS], moved[TOUCH_I2C_MAX_POINTS];
+    int slots[TOUCH_I2C_MAX_POINTS];
+    uint64_t burstBytes = 0, bytes = 0;
+    const uint64_t startNs = simNowNs();
+    for (uint8_t i = 0; i < maxPoints; i++) {
+      contacts[i] = { trackIds[i], (uint16_t)(20 + 40 * i), (uint16_t)(30 + 25 * i) };
+    }
+    ok = ok && touchI2cReport(devices[c], driver, contacts, maxPoints, expected, &burstBytes);
+    const uint64_t burstNs = simNowNs() - startNs;
+    for (uint8_t i = 0; i < maxPoints; i++) {
+      slots[i] = touchI2cSlotAt(driver, contacts[i].x, contacts[i].y);
+      moved[maxPoints - 1 - i] = { contacts[i].trackId, (uint16_t)(contacts[i].x + 5), (uint16_t)(contacts[i].y + 3) };
+    }
+    ok = ok && touchI2cReport(devices[c], driver, moved, maxPoints, expected, &bytes);
+    bool stable = true;
+    for (uint8_t i = 0; i < maxPoints; i++) {
+      stable = stable && touchI2cSlotAt(driver, contacts[i].x + 5, contacts[i].y + 3) == slots[i];
+    }
+
+    // Ersten Finger abheben: die übrigen behalten ihren Slot, ein neuer
+    // Finger bekommt den frei gewordenen
+    ok = ok && touchI2cReport(devices[c], driver, moved, maxPoints - 1, expected, &bytes);
+    for (uint8_t i = 1; i < maxPoints; i++) {
+      stable = stable && touchI2cSlotAt(driver, contacts[i].x + 5, contacts[i].y + 3) == slots[i];
+    }
+    moved[maxPoints - 1] = { 12, 200, 150 };
+    ok = ok && touchI2cReport(devices[c], driver, moved, maxPoints, expected, &bytes);
+    stable = stable && touchI2cSlotAt(driver, 200, 150) == slots[0];
+    ok = ok && touchI2cReport(devices[c], driver, nullptr, 0, expected, &bytes);
+
+    // Ruhe: update() ohne INT-Flanke liest nicht
+    const uint32_t idleStart = simI2cStats().transactions;
+    for (int i = 0; i < 10; i++) {
+      simAdvanceNs(10000000ull);
+      driver.update();
+    }
+    const bool quiet = simI2cStats().transactions == idleStart;
+    driver.end();
+
+    ok = ok && stable && quiet && driver.stats().errors == 0;
+    Serial.printf("👆 I2C-Touch %s: %d Finger in 1 Burst-Read (%lu Transaktion%s, %llu Bytes, %llu µs) | "
+                  "Slots %s | Ruhe %s | %s\n",
+                  names[c], maxPoints, (unsigned long)expected, expected > 1 ? "en inkl. Quittung" : "",
+                  (unsigned long long)burstBytes, (unsigned long long)(burstNs / 1000),
+                  stable ? "stabil" : "gewechselt", quiet ? "ohne Verkehr" : "mit Verkehr", ok ? "✅" : "❌");
+    allOk = allOk && ok;
+  }
+  return allOk;
+}
+
+// Bekannte Abbildung Bildschirm -> Rohwert: Achse X invertiert, leicht
+// gedreht und geschert, wie ein schief verklebtes Panel
+static void calibrationRaw(double x, double y, double* rawX, double* rawY) {
+  *rawX = 3700.0 - 14.0 * x + 0.8 * y;
+  *rawY = 250.0 + 0.5 * x + 11.0 * y;
+}
+
+// Größter Fehler der Matrix auf dem ganzen Bildschirm (Raster), Pixel
+static int calibrationError(const TouchTransform& t) {
+  int worst = 0;
+  for (int y = 0; y <= t.maxY; y += SIM_CAL_GRID) {
+    for (int x = 0; x <= t.maxX; x += SIM_CAL_GRID) {
+      double rawX, rawY;
+      calibrationRaw(x, y, &rawX, &rawY);
+      int sx, sy;
+      t.apply(lround(rawX), lround(rawY), &sx, &sy);
+      worst = max(worst, max(abs(sx - x), abs(sy - y)));
+    }
+  }
+  return worst;
+}
+
+// Zielpunkte wie runTouchCalibration() im Sketch, Rohwerte aus der
+// bekannten Abbildung plus Rauschen
+static int calibrationPoints(int count, int noise, uint32_t* seed, TouchCalPoint* pts) {
+  for (int i = 0; i < count; i++) {
+    touchCalTarget(i, count, HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT, &pts[i].screenX, &pts[i].screenY);
+    double rawX, rawY;
+    calibrationRaw(pts[i].screenX, pts[i].screenY, &rawX, &rawY);
+    *seed = *seed * 1664525u + 1013904223u;
+    pts[i].rawX = lround(rawX) + (int32_t)(*seed >> 16) % (2 * noise + 1) - noise;
+    *seed = *seed * 1664525u + 1013904223u;
+    pts[i].rawY = lround(rawY) + (int32_t)(*seed >> 16) % (2 * noise + 1) - noise;
+  }
+  return count;
+}
+
+// touchCalRotate() um 'steps' Schritte und zurück: jeder Schritt muss
+// (x, y) -> (y, w-1-x) sein, der Rückweg die Ausgangsmatrix ergeben
+// (je höchstens 1 Pixel, Raster über alle Rohwerte)
+static bool calibrationRotationOk(const TouchTransform& base, uint8_t steps) {
+  const TouchTransform rotated = touchCalRotate(base, 0, steps);
+  const TouchTransform back = touchCalRotate(rotated, steps, 0);
+  for (int rawY = 0; rawY <= SIM_TOUCH_RAW_MAX; rawY += 64) {
+    for (int rawX = 0; rawX <= SIM_TOUCH_RAW_MAX; rawX += 64) {
+      int x, y, rx, ry, bx, by;
+      base.apply(rawX, rawY, &x, &y);
+      rotated.apply(rawX, rawY, &rx, &ry);
+      back.apply(rawX, rawY, &bx, &by);
+      if (abs(bx - x) > 1 || abs(by - y) > 1) return false;
+
+      int w = base.maxX + 1, h = base.maxY + 1;
+      for (uint8_t s = 0; s < steps; s++) {
+        const int nx = y;
+        y = w - 1 - x;
+        x = nx;
+        std::swap(w, h);
+      }
+      if (abs(rx - x) > 1 || abs(ry - y) > 1) return false;
+    }
+  }
+  return true;
+}
+
+// Solver, Mittelung, Rotation und NVS-Blob der Kalibrierung (touch_calibration.h)
+static bool runTouchCalibration() {
+  uint32_t seed = 12345;
+  TouchCalPoint pts[TOUCH_CAL_MAX_POINTS];
+  TouchTransform t5, t3;
+
+  // 5 Punkte mit Rauschen: ausgleichend, 3 Punkte ohne Rauschen: exakt
+  const bool solved5 = touchCalSolve(pts, calibrationPoints(5, SIM_CAL_NOISE, &seed, pts),
+                                     HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT, &t5);
+  const int error5 = solved5 ? calibrationError(t5) : 9999;
+  const bool solved3 = touchCalSolve(pts, calibrationPoints(3, 0, &seed, pts),
+                                     HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT, &t3);
+  const int error3 = solved3 ? calibrationError(t3) : 9999;
+  const bool fitOk = error5 <= 2 && error3 <= 1 && touchCalMaxError(pts, 3, t3) <= 1;
+
+  // Entartete Punktmengen: zu wenige, kollinear, identisch
+  TouchCalPoint line[3] = { { 100, 100, 20, 20 }, { 2000, 2000, 120, 160 }, { 3900, 3900, 220, 300 } };
+  TouchCalPoint same[5];
+  for (int i = 0; i < 5; i++) {
+    same[i] = { 2048, 2048, 0, 0 };
+    touchCalTarget(i, 5, HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT, &same[i].screenX, &same[i].screenY);
+  }
+  TouchTransform unused;
+  const bool degenerateOk = !touchCalSolve(line, 2, HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT, &unused) &&
+                            !touchCalSolve(line, 3, HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT, &unused) &&
+                            !touchCalSolve(same, 5, HW_DISPLAY_WIDTH, HW_DISPLAY_HEIGHT, &unused);
+
+  // Rotation: ein bis drei Schritte und zurück
+  bool rotationOk = solved5;
+  for (uint8_t steps = 1; steps < 4 && rotationOk; steps++) {
+    rotationOk = calibrationRotationOk(t5, steps);
+  }
+
+  // Getrimmter Mittelwert: Abheben (0) und Prellen (4095) fallen heraus
+  int16_t samples[16] = { 1000, 1002, 998, 1001, 4095, 999, 1000, 0,
+                          1003, 997, 1000, 4095, 1001, 0, 999, 1000 };
+  int16_t odd[9] = { 500, 0, 502, 4095, 498, 501, 499, 500, 4095 };
+  const bool meanOk = touchCalTrimmedMean(samples, 16) == 1000 &&
+                      touchCalTrimmedMean(odd, 9) == 500 && touchCalTrimmedMean(odd, 0) == 0;
+
+  // NVS: speichern und laden, dann Blob mit falscher CRC, falscher
+  // Version und falscher Länge - alle müssen abgewiesen werden
+  TouchCalibrationData saved = {}, loaded = {};
+  saved.rotation = 0;
+  saved.points = 5;
+  saved.transform = t5;
+  bool storageOk = touchCalibrationSave(&saved) && touchCalibrationLoad(&loaded) &&
+                   !memcmp(&saved, &loaded, sizeof(saved));
+  TouchCalibrationData corrupt = saved;
+  corrupt.transform.x0 ^= 0x100;
+  Preferences prefs;
+  prefs.begin(TOUCH_CAL_NVS_NAMESPACE, false);
+  prefs.putBytes(TOUCH_CAL_NVS_KEY, &corrupt, sizeof(corrupt));
+  storageOk = storageOk && !touchCalIsValid(corrupt) && !touchCalibrationLoad(&loaded);
+  corrupt = saved;
+  corrupt.version = TOUCH_CAL_VERSION + 1;
+  corrupt.crc = touchCalChecksum(corrupt);
+  prefs.putBytes(TOUCH_CAL_NVS_KEY, &corrupt, sizeof(corrupt));
+  storageOk = storageOk && !touchCalibrationLoad(&loaded);
+  prefs.putBytes(TOUCH_CAL_NVS_KEY, &saved, sizeof(saved) - 4);
+  storageOk = storageOk && !touchCalibrationLoad(&loaded);
+  prefs.end();
+  touchCalibrationClear();
+  storageOk = storageOk && !touchCalibrationLoad(&loaded);
+
+  Serial.printf("🎯 Kalibrierung: 5 Punkte ±%d Counts max. %d px, 3 Punkte max. %d px %s | "
+                "entartet abgewiesen %s | Rotation %s | Mittelwert %s | NVS/CRC %s\n",
+                SIM_CAL_NOISE, error5, error3, fitOk ? "✅" : "❌", degenerateOk ? "✅" : "❌",
+                rotationOk ? "✅" : "❌", meanOk ? "✅" : "❌", storageOk ? "✅" : "❌");
+  return fitOk && degenerateOk && rotationOk && meanOk && storageOk;
+}
+
+int main(int argc, char** argv) {
+  int frames = SIM_DEFAULT_FRAMES;
+  const char* bench = nullptr;
+  const char* touchScript = nullptr;
+  const char* dumpPath = nullptr;
+  const char* tracePath = nullptr;
+  const char* powerScript = nullptr;
+  const char* profileName = nullptr;
+  const char* boardName = nullptr;
+  bool tune = false;
+  bool touchCheck = false;
+  float writeLimitMHz = 0, readLimitMHz = 0;
+  int sda, scl;
+  unsigned address;
+
+  for (int i = 1; i < argc; i++) {
+    const bool hasValue = i + 1 < argc;
+    if (!strcmp(argv[i], "--frames") && hasValue)      frames = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--bench") && hasValue)  bench = argv[++i];
+    else if (!strcmp(argv[i], "--touch") && hasValue)  touchScript = argv[++i];
+    else if (!strcmp(argv[i], "--dump") && hasValue)   dumpPath = argv[++i];
+    else if (!strcmp(argv[i], "--trace") && hasValue)  tracePath = argv[++i];
+    else if (!strcmp(argv[i], "--power") && hasValue)  powerScript = argv[++i];
+    else if (!strcmp(argv[i], "--tune"))               tune = true;
+    else if (!strcmp(argv[i], "--touch-check"))        touchCheck = true;
+    else if (!strcmp(argv[i], "--profile") && hasValue) profileName = argv[++i];
+    else if (!strcmp(argv[i], "--board") && hasValue)  boardName = argv[++i];
+    else if (!strcmp(argv[i], "--dma-ram") && hasValue) simHeapLargestBlock = strtoul(argv[++i], nullptr, 0);
+    else if (!strcmp(argv[i], "--clock-limit") && hasValue &&
+             sscanf(argv[++i], "%f,%f", &writeLimitMHz, &readLimitMHz) == 2) {}
+    else if (!strcmp(argv[i], "--i2c-device") && hasValue &&
+             sscanf(argv[++i], "%d,%d,%i", &sda, &scl, (int*)&address) == 3) {
+      simI2cAttach(sda, scl, (uint8_t)address);
+    }
+    else {
+      printUsage(argv[0]);
+      return 2;
+    }
+  }
+  if (bench && strcmp(bench, "csv") && strcmp(bench, "json")) {
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  simDisplayClockLimit((uint32_t)(writeLimitMHz * 1e6f), (uint32_t)(readLimitMHz * 1e6f));
+
+  Serial.println("🖥️ Host-Simulator: " HW_PROFILE_NAME);
+  if (boardName && !selectSimBoard(boardName)) {
+    return 1;
+  }
+  if (profileName && !selectTableProfile(profileName)) {
+    return 1;
+  }
+  if (touchCheck) {
+    if (!runTouchGrid()) {
+      Serial.println("❌ Touch-Matrix weicht ab");
+      return 1;
+    }
+    if (!runTouchCalibration()) {
+      Serial.println("❌ Touch-Kalibrierung fehlerhaft");
+      return 1;
+    }
+    return 0;
+  }
+  if (!hardware.begin()) {
+    Serial.println("❌ hardware.begin() fehlgeschlagen");
+    return 1;
+  }
+  // Ohne FreeRTOS laufen die Boot-Stufen synchron in begin()
+  if (!hardware.waitBootComplete() || !hardware.getBootTimeline().validated) {
+    Serial.println("⚠️ validateHardware() meldet Probleme");
+  }
+
+  if (tune) {
+    Serial.println();
+    if (!runClockTune()) {
+      Serial.println("❌ Takt-Tuning fehlgeschlagen");
+      return 1;
+    }
+  }
+
+  Serial.println();
+  if (!runBacklightFade()) {
+    Serial.println("❌ Backlight-Fade fehlerhaft");
+    return 1;
+  }
+  if (!runStripPipeline(frames)) {
+    Serial.println("❌ Strip-Rendering unvollständig");
+    return 1;
+  }
+  if (!runDamagePipeline(frames)) {
+    Serial.println("❌ Dirty-Rectangle Zähler weicht vom Bus ab");
+    return 1;
+  }
+  if (!runFramePacing()) {
+    Serial.println("❌ Frame-Takt fehlerhaft");
+    return 1;
+  }
+  if (!runGlyphAtlas()) {
+    Serial.println("❌ Glyphen-Atlas fehlerhaft");
+    return 1;
+  }
+  if (!runTextLabel()) {
+    Serial.println("❌ Text-Label fehlerhaft");
+    return 1;
+  }
+  if (!runImageBlit()) {
+    Serial.println("❌ Bild-Blitter fehlerhaft");
+    return 1;
+  }
+  if (!runSpanFill()) {
+    Serial.println("❌ Span-Füllung fehlerhaft");
+    return 1;
+  }
+  if (!runTouchI2c()) {
+    Serial.println("❌ I2C-Touch fehlerhaft");
+    return 1;
+  }
+
+  if (bench) {
+    runBenchmark(strcmp(bench, "json") == 0 ? BENCH_FORMAT_JSON : BENCH_FORMAT_CSV);
+  }
+
+  if (touchScript) {
+    if (!simTouchLoadScript(touchScript)) {
+      Serial.printf("❌ Touch-Skript fehlerhaft: %s\n", touchScript);
+      return 1;
+    }
+    Serial.printf("\n👆 Touch-Skript: %s (%lu ms)\n", touchScript, (unsigned long)simTouchScriptEndMs());
+    if (runTouchScript() == 0) {
+      Serial.println("❌ Keine Touch-Events erkannt");
+      return 1;
+    }
+  }
+
+  if (powerScript) {
+    if (!simTouchLoadScript(powerScript)) {
+      Serial.printf("❌ Touch-Skript fehlerhaft: %s\n", powerScript);
+      return 1;
+    }
+    Serial.printf("\n💤 Energiesparstufen: %s (%d/%d/%d ms)\n", powerScript,
+                  SIM_POWER_DIM_MS, SIM_POWER_OFF_MS, SIM_POWER_SLEEP_MS);
+    if (!runPowerScenario()) {
+      Serial.println("❌ Energiesparstufen fehlerhaft");
+      return 1;
+    }
+  }
+
+  printSpiSummary();
+
+  if (dumpPath) {
+    if (!simDumpFramebuffer(tft, dumpPath)) {
+      Serial.printf("❌ Dump fehlgeschlagen: %s\n", dumpPath);
+      return 1;
+    }
+    Serial.printf("💾 Framebuffer: %s\n", dumpPath);
+  }
+
+  if (tracePath) {
+    if (!writeTrace(tracePath)) {
+      Serial.printf("❌ Trace fehlgeschlagen (HW_TRACE aktiv?): %s\n", tracePath);
+      return 1;
+    }
+    Serial.printf("🧵 Trace: %s (%lu Ereignisse, %lu verworfen)\n", tracePath,
+                  (unsigned long)hwTraceCount(), (unsigned long)hwTraceDropped());
+  }
+  return 0;
+}
@@ -0,0 +1,605 @@
+/**
+ * sim_runtime.cpp - Host-Simulator: Uhr, SPI-/I2C-Modell, GPIO/LEDC, Light-Sleep, FreeRTOS
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+#include <esp_heap_caps.h>
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#include <driver/uart.h>
+#include <deque>
+#include <map>
+#include <vector>
+#include "sim.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+SPIClass SPI(VSPI);
+TwoWire Wire;
+
+// ============================================
+// VIRTUELLE UHR
+// ============================================
+
+static uint64_t nowNs = 0;
+
+uint64_t simNowNs() {
+  return nowNs;
+}
+
+void simAdvanceNs(uint64_t ns) {
+  nowNs += ns;
+}
+
+unsigned long micros() {
+  return (unsigned long)(uint32_t)(nowNs / 1000);
+}
+
+unsigned long millis() {
+  return (unsigned long)(uint32_t)(nowNs / 1000000);
+}
+
+void delay(unsigned long ms) {
+  simAdvanceNs((uint64_t)ms * 1000000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  simAdvanceNs((uint64_t)us * 1000);
+}
+
+// ============================================
+// SPI-MODELL
+// ============================================
+
+static SimSpiStats spiStats[SIM_SPI_HOSTS];
+
+void simSpiTransfer(uint8_t host, uint32_t bytes, uint32_t hz, bool read) {
+  SimSpiStats& s = spiStats[host % SIM_SPI_HOSTS];
+  const uint64_t ns = hz ? (uint64_t)bytes * 8 * 1000000000ull / hz : 0;
+  s.bytes += bytes;
+  if (read) s.readBytes += bytes;
+  s.busyNs += ns;
+  simAdvanceNs(ns);
+}
+
+void simSpiTransaction(uint8_t host) {
+  spiStats[host % SIM_SPI_HOSTS].transactions++;
+}
+
+void simSpiWindow(uint8_t host) {
+  spiStats[host % SIM_SPI_HOSTS].windows++;
+}
+
+const SimSpiStats& simSpiStats(uint8_t host) {
+  return spiStats[host % SIM_SPI_HOSTS];
+}
+
+void simSpiReset() {
+  memset(spiStats, 0, sizeof(spiStats));
+}
+
+void SPIClass::beginTransaction(SPISettings settings) {
+  frequency = settings.clock;
+  simSpiTransaction(bus);
+}
+
+uint8_t SPIClass::transfer(uint8_t data) {
+  simSpiTransfer(bus, 1, frequency, true);
+  return simSpiExchange(sckPin, data);
+}
+
+uint16_t SPIClass::transfer16(uint16_t data) {
+  simSpiTransfer(bus, 2, frequency, true);
+  const uint8_t high = simSpiExchange(sckPin, (uint8_t)(data >> 8));
+  return (uint16_t)((high << 8) | simSpiExchange(sckPin, (uint8_t)data));
+}
+
+void SPIClass::writeBytes(const uint8_t* data, uint32_t size) {
+  (void)data;
+  simSpiTransfer(bus, size, frequency);
+}
+
+void SPIClass::transferBytes(const uint8_t* data, uint8_t* out, uint32_t size) {
+  for (uint32_t i = 0; i < size; i++) {
+    const uint8_t in = simSpiExchange(sckPin, data ? data[i] : 0xFF);
+    if (out) out[i] = in;
+  }
+  simSpiTransfer(bus, size, frequency, out != nullptr);
+}
+
+// ============================================
+// SPI-/I2C-GERÄTE
+// ============================================
+
+struct SimSpiSlot {
+  int sclk, cs;
+  SimSpiDevice* device;
+};
+
+struct SimI2cSlot {
+  int sda, scl;
+  uint8_t address;
+  SimI2cDevice* device;   // nullptr = ACKt nur
+};
+
+static SimI2cStats i2cStats;
+
+// Function-local: Geräte registrieren sich aus statischen Konstruktoren
+static std::vector<SimSpiSlot>& spiDevices() {
+  static std::vector<SimSpiSlot> devices;
+  return devices;
+}
+
+static std::vector<SimI2cSlot>& i2cDevices() {
+  static std::vector<SimI2cSlot> devices;
+  return devices;
+}
+
+void simSpiAttach(int sclk, int cs, SimSpiDevice* device) {
+  spiDevices().push_back({ sclk, cs, device });
+}
+
+void simSpiDetach(SimSpiDevice* device) {
+  std::vector<SimSpiSlot>& devices = spiDevices();
+  for (size_t i = 0; i < devices.size(); i++) {
+    if (devices[i].device == device) {
+      devices.erase(devices.begin() + i);
+      return;
+    }
+  }
+}
+
+uint8_t simSpiExchange(int sclk, uint8_t mosi) {
+  for (const SimSpiSlot& slot : spiDevices()) {
+    if (slot.sclk == sclk && simGpioLevel(slot.cs) == LOW) {
+      return slot.device->transfer(mosi);
+    }
+  }
+  return 0;
+}
+
+void simI2cAttach(int sda, int scl, uint8_t address, SimI2cDevice* device) {
+  i2cDevices().push_back({ sda, scl, address, device });
+}
+
+static const SimI2cSlot* i2cFind(int sda, int scl, uint8_t address) {
+  for (const SimI2cSlot& slot : i2cDevices()) {
+    if (slot.sda == sda && slot.scl == scl && slot.address == address) return &slot;
+  }
+  return nullptr;
+}
+
+bool simI2cPresent(int sda, int scl, uint8_t address) {
+  return i2cFind(sda, scl, address) != nullptr;
+}
+
+const SimI2cStats& simI2cStats() {
+  return i2cStats;
+}
+
+void simI2cReset() {
+  i2cStats = SimI2cStats();
+}
+
+bool TwoWire::begin(int sdaPin, int sclPin, uint32_t hz) {
+  sda = sdaPin;
+  scl = sclPin;
+  frequency = hz;
+  started = true;
+  return true;
+}
+
+void TwoWire::clockBytes(uint32_t bytes) {
+  i2cStats.bytes += bytes;
+  simAdvanceNs(frequency ? (uint64_t)bytes * 9 * 1000000000ull / frequency : 0);
+}
+
+void TwoWire::startCondition() {
+  if (!inTransaction) i2cStats.transactions++;
+  inTransaction = true;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  return write(&data, 1);
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t size) {
+  size = min(size, SIM_WIRE_BUFFER - txLength);
+  memcpy(txBuffer + txLength, data, size);
+  txLength += size;
+  clockBytes(size);
+  return size;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  startCondition();
+  clockBytes(1);   // Adressbyte
+  const SimI2cSlot* slot = started ? i2cFind(sda, scl, address) : nullptr;
+  if (slot && slot->device && !slot->device->ack()) slot = nullptr;
+  if (slot && slot->device) slot->device->write(txBuffer, txLength);
+  txLength = 0;
+  if (sendStop || !slot) inTransaction = false;
+  return slot ? 0 : 2;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t deviceAddress, size_t size, bool sendStop) {
+  startCondition();
+  clockBytes(1);
+  rxLength = rxPos = 0;
+  const SimI2cSlot* slot = started ? i2cFind(sda, scl, deviceAddress) : nullptr;
+  if (slot && slot->device && !slot->device->ack()) slot = nullptr;
+  if (slot && slot->device) {
+    rxLength = min(size, (size_t)SIM_WIRE_BUFFER);
+    slot->device->read(rxBuffer, rxLength);
+    clockBytes(rxLength);
+  }
+  if (sendStop || !slot) inTransaction = false;
+  return (uint8_t)rxLength;
+}
+
+// ============================================
+// SERIAL
+// ============================================
+
+static std::deque<char> serialInput;
+
+void simSerialFeed(const char* text) {
+  while (*text) serialInput.push_back(*text++);
+}
+
+int HardwareSerial::available() {
+  return (int)serialInput.size();
+}
+
+int HardwareSerial::read() {
+  if (serialInput.empty()) return -1;
+  const char c = serialInput.front();
+  serialInput.pop_front();
+  return (uint8_t)c;
+}
+
+size_t HardwareSerial::printf(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  const int n = vprintf(format, args);
+  va_end(args);
+  return n < 0 ? 0 : (size_t)n;
+}
+
+uint32_t EspClass::getFreeHeap() {
+  return SIM_HEAP_FREE;
+}
+
+// ============================================
+// ARDUINO HILFSFUNKTIONEN
+// ============================================
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// Eigener LCG statt rand(): gleiche Folge auf jedem Host
+static uint32_t randomState = 1;
+
+void randomSeed(unsigned long seed) {
+  if (seed) randomState = (uint32_t)seed;
+}
+
+long random(long maxValue) {
+  if (maxValue <= 0) return 0;
+  randomState = randomState * 1664525u + 1013904223u;
+  return (long)((randomState >> 8) % (uint32_t)maxValue);
+}
+
+long random(long minValue, long maxValue) {
+  return minValue >= maxValue ? minValue : minValue + random(maxValue - minValue);
+}
+
+size_t simHeapLargestBlock = SIM_HEAP_LARGEST_BLOCK;
+
+// ============================================
+// GPIO & LEDC
+// ============================================
+
+struct SimLedc {
+  uint32_t freq;
+  uint8_t resolution;
+  uint32_t startDuty, targetDuty;
+  uint64_t fadeStartNs, fadeNs;       // Lineare Rampe in virtueller Zeit
+};
+
+static std::map<int, int> gpioLevels;
+static std::map<int, uint32_t> gpioPulses;
+static std::map<int, SimLedc> ledcPins;
+static std::map<int, void (*)(void)> interrupts;
+static std::map<int, int (*)()> gpioInputs;
+
+void pinMode(int pin, int mode) {
+  (void)pin; (void)mode;
+}
+
+void digitalWrite(int pin, int value) {
+  const int level = value ? HIGH : LOW;
+  if (level == HIGH && simGpioLevel(pin) == LOW) gpioPulses[pin]++;
+  if (level == LOW && simGpioLevel(pin) != LOW) {
+    for (const SimSpiSlot& slot : spiDevices()) {
+      if (slot.cs == pin) slot.device->select();
+    }
+  }
+  gpioLevels[pin] = level;
+}
+
+int digitalRead(int pin) {
+  auto input = gpioInputs.find(pin);
+  if (input != gpioInputs.end()) return input->second();
+  auto it = gpioLevels.find(pin);
+  return it == gpioLevels.end() ? HIGH : it->second;   // Eingänge mit Pull-Up
+}
+
+int simGpioLevel(int pin) {
+  auto it = gpioLevels.find(pin);
+  return it == gpioLevels.end() ? -1 : it->second;
+}
+
+uint32_t simGpioPulses(int pin) {
+  auto it = gpioPulses.find(pin);
+  return it == gpioPulses.end() ? 0 : it->second;
+}
+
+void simGpioInput(int pin, int (*level)()) {
+  gpioInputs[pin] = level;
+}
+
+void simGpioInterrupt(int pin) {
+  auto it = interrupts.find(pin);
+  if (it != interrupts.end()) it->second();
+}
+
+void attachInterrupt(int pin, void (*isr)(void), int mode) {
+  (void)mode;
+  interrupts[pin] = isr;
+}
+
+void detachInterrupt(int pin) {
+  interrupts.erase(pin);
+}
+
+bool ledcAttach(int pin, uint32_t freq, uint8_t resolution) {
+  if (resolution == 0 || resolution > 20) return false;
+  ledcPins[pin] = SimLedc{ freq, resolution, 0, 0, 0, 0 };
+  return true;
+}
+
+uint32_t ledcRead(int pin) {
+  auto it = ledcPins.find(pin);
+  if (it == ledcPins.end()) return 0;
+  const SimLedc& c = it->second;
+  const uint64_t elapsed = simNowNs() - c.fadeStartNs;
+  if (!c.fadeNs || elapsed >= c.fadeNs) return c.targetDuty;
+  const int64_t delta = (int64_t)c.targetDuty - (int64_t)c.startDuty;
+  return (uint32_t)((int64_t)c.startDuty + delta * (int64_t)elapsed / (int64_t)c.fadeNs);
+}
+
+bool ledcWrite(int pin, uint32_t duty) {
+  auto it = ledcPins.find(pin);
+  if (it == ledcPins.end()) return false;
+  // Wie arduino-esp32: voller Duty wird als max+1 gespeichert ("LEDC FULL ON")
+  const uint32_t maxDuty = (1u << it->second.resolution) - 1;
+  if (duty == maxDuty && maxDuty != 1) duty = maxDuty + 1;
+  it->second.startDuty = it->second.targetDuty = duty;
+  it->second.fadeNs = 0;
+  return true;
+}
+
+bool ledcFade(int pin, uint32_t startDuty, uint32_t targetDuty, int maxFadeTimeMs) {
+  auto it = ledcPins.find(pin);
+  if (it == ledcPins.end() || maxFadeTimeMs < 0) return false;
+  it->second.startDuty = startDuty;
+  it->second.targetDuty = targetDuty;
+  it->second.fadeStartNs = simNowNs();
+  it->second.fadeNs = (uint64_t)maxFadeTimeMs * 1000000;
+  return true;
+}
+
+uint32_t simLedcDuty(int pin) {
+  return ledcRead(pin);
+}
+
+// ============================================
+// LIGHT-SLEEP
+// ============================================
+
+static std::map<int, int> gpioWakeLevels;   // Pin -> Weckpegel
+static bool gpioWakeEnabled = false;
+static bool uartWakeEnabled = false;
+static esp_sleep_wakeup_cause_t wakeupCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+
+esp_err_t gpio_set_intr_type(gpio_num_t pin, gpio_int_type_t type) { (void)pin; (void)type; return ESP_OK; }
+esp_err_t gpio_intr_enable(gpio_num_t pin) { (void)pin; return ESP_OK; }
+esp_err_t gpio_intr_disable(gpio_num_t pin) { (void)pin; return ESP_OK; }
+
+esp_err_t gpio_wakeup_enable(gpio_num_t pin, gpio_int_type_t type) {
+  if (type != GPIO_INTR_LOW_LEVEL && type != GPIO_INTR_HIGH_LEVEL) return -1;
+  gpioWakeLevels[pin] = type == GPIO_INTR_HIGH_LEVEL ? HIGH : LOW;
+  return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_disable(gpio_num_t pin) {
+  gpioWakeLevels.erase(pin);
+  return ESP_OK;
+}
+
+esp_err_t uart_set_wakeup_threshold(uart_port_t uartNum, int wakeupThreshold) {
+  (void)uartNum; (void)wakeupThreshold;
+  return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_gpio_wakeup() {
+  gpioWakeEnabled = true;
+  return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_uart_wakeup(int uartNum) {
+  uartWakeEnabled = uartNum == UART_NUM_0;   // Nur Serial ist modelliert
+  return ESP_OK;
+}
+
+esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t source) {
+  if (source == ESP_SLEEP_WAKEUP_GPIO || source == ESP_SLEEP_WAKEUP_ALL) gpioWakeEnabled = false;
+  if (source == ESP_SLEEP_WAKEUP_UART || source == ESP_SLEEP_WAKEUP_ALL) uartWakeEnabled = false;
+  return ESP_OK;
+}
+
+static bool gpioWakePending() {
+  if (!gpioWakeEnabled) return false;
+  for (const auto& wake : gpioWakeLevels) {
+    if (digitalRead(wake.first) == wake.second) return true;
+  }
+  return false;
+}
+
+esp_err_t esp_light_sleep_start() {
+  for (uint32_t ms = 0; ms < SIM_LIGHT_SLEEP_MAX_MS; ms++) {
+    simAdvanceNs(1000000);
+    if (gpioWakePending()) {
+      wakeupCause = ESP_SLEEP_WAKEUP_GPIO;
+      return ESP_OK;
+    }
+    if (uartWakeEnabled && !serialInput.empty()) {
+      wakeupCause = ESP_SLEEP_WAKEUP_UART;
+      return ESP_OK;
+    }
+  }
+  wakeupCause = ESP_SLEEP_WAKEUP_TIMER;
+  return ESP_OK;
+}
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() {
+  return wakeupCause;
+}
+
+// ============================================
+// FREERTOS (single-threaded)
+// ============================================
+
+// Ohne Threads kann kein zweiter Task laufen: Aufrufer fallen auf ihren
+// Polling-Pfad zurück (Touch-Sampling, Dual-Core Betrieb).
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack, void* param,
+                       UBaseType_t priority, TaskHandle_t* handle) {
+  (void)fn; (void)name; (void)stack; (void)param; (void)priority;
+  if (handle) *handle = nullptr;
+  return pdFAIL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* param,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+  (void)core;
+  return xTaskCreate(fn, name, stack, param, priority, handle);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  (void)task;
+}
+
+void vTaskDelay(TickType_t ticks) {
+  delay(ticks * portTICK_PERIOD_MS);
+}
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t period) {
+  const TickType_t next = *previousWake + period;
+  const TickType_t now = xTaskGetTickCount();
+  if ((int32_t)(next - now) > 0) vTaskDelay(next - now);
+  *previousWake = next;
+}
+
+TickType_t xTaskGetTickCount() {
+  return (TickType_t)millis();
+}
+
+static int mainTask;
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  return &mainTask;
+}
+
+BaseType_t xPortGetCoreID() {
+  return ARDUINO_RUNNING_CORE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  (void)clearOnExit;
+  if (ticks != portMAX_DELAY) vTaskDelay(ticks);
+  return 0;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  (void)task;
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken) {
+  (void)task;
+  if (woken) *woken = pdFALSE;
+}
+
+// Semaphore: Zähler ohne Blockieren (es gibt keinen zweiten Task)
+struct SimSemaphore {
+  int count;
+  int max;
+};
+
+static SemaphoreHandle_t createSemaphore(int count, int maxCount) {
+  return new SimSemaphore{ count, maxCount };
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+  return createSemaphore(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+  return createSemaphore(0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+  return createSemaphore(1, 1);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+  SimSemaphore* s = (SimSemaphore*)sem;
+  if (!s) return pdFALSE;
+  if (s->count > 0) {
+    s->count--;
+    return pdTRUE;
+  }
+  // Niemand kann freigeben: Wartezeit verstreichen lassen
+  if (ticks != portMAX_DELAY) vTaskDelay(ticks);
+  return pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+  SimSemaphore* s = (SimSemaphore*)sem;
+  if (!s || s->count >= s->max) return pdFALSE;
+  s->count++;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t* woken) {
+  if (woken) *woken = pdFALSE;
+  return xSemaphoreGive(sem);
+}
+
+// Rekursiv: ein einziger Task hält den Mutex immer selbst
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticks) {
+  (void)ticks;
+  return sem ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem) {
+  return sem ? pdTRUE : pdFALSE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) {
+  delete (SimSemaphore*)sem;
+}
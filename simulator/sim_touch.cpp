@@ -0,0 +1,343 @@
+/**
+ * sim_touch.cpp - Host-Simulator: Touch-Skript, XPT2046 und I2C-Controller
+ *
+ * Das Skript beschreibt Fingerpositionen in Bildschirmpixeln. Sie
+ * werden über die Profil-Matrix der aktuellen Rotation zurück in
+ * Rohwerte gerechnet, damit Filter, Kalibrierung und Gesten-Engine
+ * denselben Weg durchlaufen wie auf dem Board.
+ */
+
+#include "config.h"
+#include "TFT_Setup.h"
+#include <TFT_eSPI.h>
+#include <XPT2046_Touchscreen.h>
+#include "hardware_hal.h"
+#include "sim.h"
+#include <vector>
+
+extern TFT_eSPI tft;
+
+#define SIM_TOUCH_DEFAULT_Z  1200     // Druck, weit über HW_TOUCH_THRESHOLD
+#define SIM_TOUCH_LIB_HZ     2000000  // SPI-Takt der XPT2046 Bibliothek
+#define SIM_TOUCH_TEMP0      0x2A0    // TEMP0 Rohwert bei ~25 °C
+
+// ============================================
+// SKRIPT
+// ============================================
+
+enum SimTouchAction : uint8_t { SIM_TOUCH_DOWN, SIM_TOUCH_MOVE, SIM_TOUCH_DRAG, SIM_TOUCH_UP };
+
+struct SimTouchStep {
+  uint32_t ms;
+  SimTouchAction action;
+  int16_t x, y, z;
+};
+
+static std::vector<SimTouchStep> script;
+static uint64_t scriptStartNs = 0;
+static int16_t noiseAmplitude = 0;
+static uint32_t noiseState = 0x2046;
+static const HardwareProfile* board = &ActiveHardwareProfile::config;
+
+bool simTouchLoadScript(const char* path) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+
+  script.clear();
+  char line[128];
+  int lineNo = 0;
+  bool ok = true;
+  while (fgets(line, sizeof(line), f)) {
+    lineNo++;
+    char* p = line;
+    while (*p == ' ' || *p == '\t') p++;
+    if (*p == '#' || *p == '\n' || *p == '\r' || *p == 0) continue;
+
+    int value;
+    if (sscanf(p, "noise %d", &value) == 1) {
+      noiseAmplitude = (int16_t)value;
+      continue;
+    }
+
+    unsigned ms;
+    char action[8];
+    int x = 0, y = 0, z = SIM_TOUCH_DEFAULT_Z;
+    const int n = sscanf(p, "%u %7s %d %d %d", &ms, action, &x, &y, &z);
+    SimTouchStep step = { ms, SIM_TOUCH_UP, (int16_t)x, (int16_t)y, (int16_t)z };
+    if (n >= 4 && strcmp(action, "down") == 0)      step.action = SIM_TOUCH_DOWN;
+    else if (n >= 4 && strcmp(action, "move") == 0) step.action = SIM_TOUCH_MOVE;
+    else if (n >= 4 && strcmp(action, "drag") == 0) step.action = SIM_TOUCH_DRAG;
+    else if (n >= 2 && strcmp(action, "up") == 0)   step.action = SIM_TOUCH_UP;
+    else {
+      fprintf(stderr, "%s:%d: unbekannte Zeile: %s", path, lineNo, line);
+      ok = false;
+      continue;
+    }
+    if (!script.empty() && ms < script.back().ms) {
+      fprintf(stderr, "%s:%d: Zeit läuft rückwärts\n", path, lineNo);
+      ok = false;
+      continue;
+    }
+    script.push_back(step);
+  }
+  fclose(f);
+  simTouchStart();
+  return ok;
+}
+
+void simTouchStart() {
+  scriptStartNs = simNowNs();
+}
+
+uint32_t simTouchScriptEndMs() {
+  return script.empty() ? 0 : script.back().ms;
+}
+
+bool simTouchScriptDone() {
+  return (simNowNs() - scriptStartNs) / 1000000 > simTouchScriptEndMs();
+}
+
+// Zustand zum Zeitpunkt 'ms': Position, Druck (0 = abgehoben)
+static void scriptState(uint32_t ms, int32_t* x, int32_t* y, int32_t* z) {
+  *x = 0; *y = 0; *z = 0;
+  int32_t lastX = 0, lastY = 0;
+  uint32_t lastMs = 0;
+  for (const SimTouchStep& s : script) {
+    if (s.ms > ms) {
+      // Laufender drag: linear zwischen letzter Position und Ziel
+      if (s.action == SIM_TOUCH_DRAG && *z && s.ms > lastMs) {
+        const int32_t t = (int32_t)(ms - lastMs), span = (int32_t)(s.ms - lastMs);
+        *x = lastX + (s.x - lastX) * t / span;
+        *y = lastY + (s.y - lastY) * t / span;
+      }
+      return;
+    }
+    if (s.action == SIM_TOUCH_UP) {
+      *z = 0;
+    } else {
+      *x = s.x;
+      *y = s.y;
+      if (s.action == SIM_TOUCH_DOWN) *z = s.z;
+    }
+    lastX = *x;
+    lastY = *y;
+    lastMs = s.ms;
+  }
+}
+
+void simTouchRaw(int16_t* rawX, int16_t* rawY, int16_t* rawZ) {
+  int32_t x, y, z;
+  scriptState((uint32_t)((simNowNs() - scriptStartNs) / 1000000), &x, &y, &z);
+  if (!z) {
+    *rawX = *rawY = *rawZ = 0;
+    return;
+  }
+
+  // Pixelmitte über die inverse Matrix des simulierten Boards in Rohwerte zurückrechnen
+  const TouchTransform& t = board->touchTransform(tft.getRotation());
+  const double det = (double)t.xx * t.yy - (double)t.xy * t.yx;
+  const double sx = x * 65536.0 + 32768.0 - t.x0;
+  const double sy = y * 65536.0 + 32768.0 - t.y0;
+  double rx = det ? (sx * t.yy - sy * t.xy) / det : 0;
+  double ry = det ? (sy * t.xx - sx * t.yx) / det : 0;
+
+  if (noiseAmplitude > 0) {
+    noiseState = noiseState * 1664525u + 1013904223u;
+    rx += (int32_t)((noiseState >> 8) % (2 * noiseAmplitude + 1)) - noiseAmplitude;
+    noiseState = noiseState * 1664525u + 1013904223u;
+    ry += (int32_t)((noiseState >> 8) % (2 * noiseAmplitude + 1)) - noiseAmplitude;
+  }
+
+  *rawX = (int16_t)constrain(lround(rx), 0L, 4095L);
+  *rawY = (int16_t)constrain(lround(ry), 0L, 4095L);
+  *rawZ = (int16_t)z;
+}
+
+// ============================================
+// XPT2046
+// ============================================
+
+// ADC am SPI-Bus (HW_TOUCH_CLK/CS) für Zugriffe per SPIClass::transfer():
+// Kommandobyte mit Startbit, danach 16 Takte mit Busy (0), 12 Datenbits
+// und 3 Füllbits. Das nächste Kommando darf im letzten Byte folgen.
+class SimXpt2046Device : public SimSpiDevice {
+public:
+  SimXpt2046Device() : response(0), remaining(0) {
+    simSpiAttach(HW_TOUCH_CLK, HW_TOUCH_CS, this);
+  }
+
+  void select() override {
+    remaining = 0;
+  }
+
+  uint8_t transfer(uint8_t mosi) override {
+    uint8_t out = 0;
+    if (remaining) {
+      out = (uint8_t)(remaining == 2 ? response >> 8 : response);
+      remaining--;
+    }
+    if (mosi & 0x80) {
+      response = (uint16_t)(sample((mosi >> 4) & 0x07) << 3);
+      remaining = 2;
+    }
+    return out;
+  }
+
+private:
+  static uint16_t sample(uint8_t channel) {
+    int16_t x, y, z;
+    simTouchRaw(&x, &y, &z);
+    switch (channel) {
+      case 0: return SIM_TOUCH_TEMP0;
+      case 1: return (uint16_t)y;
+      case 3: return (uint16_t)(z / 2);            // Z1: z = Z1 + 4095 - Z2
+      case 4: return (uint16_t)(4095 - z / 2);     // Z2
+      case 5: return (uint16_t)x;
+      default: return 0;
+    }
+  }
+
+  uint16_t response;
+  uint8_t remaining;
+};
+
+static SimXpt2046Device xpt2046Device;
+
+bool simTouchBoard(const HardwareProfile& entry) {
+  if (!hwDisplayCompatible(entry, ActiveHardwareProfile::config) ||
+      entry.touch.controller != HW_TOUCH_CTRL_XPT2046) {
+    return false;
+  }
+  board = &entry;
+  simSpiDetach(&xpt2046Device);
+  simSpiAttach(entry.touch.clk, entry.touch.cs, &xpt2046Device);
+  return true;
+}
+
+// T_IRQ ist low, solange der Finger aufliegt
+static int touchIrqLevel() {
+  int16_t x, y, z;
+  simTouchRaw(&x, &y, &z);
+  return z > 0 ? LOW : HIGH;
+}
+
+bool XPT2046_Touchscreen::begin(SPIClass& wspi) {
+  spi = &wspi;
+  pinMode(cs, OUTPUT);
+  digitalWrite(cs, HIGH);
+  if (tirq != 255) simGpioInput(tirq, touchIrqLevel);
+  return true;
+}
+
+void XPT2046_Touchscreen::update() {
+  const uint32_t now = millis();
+  if (now - lastUpdate < XPT2046_MSEC_THRESHOLD) return;
+  if (spi) {
+    simSpiTransaction(spi->getBus());
+    simSpiTransfer(spi->getBus(), XPT2046_UPDATE_BYTES, SIM_TOUCH_LIB_HZ, true);
+  }
+  simTouchRaw(&xraw, &yraw, &zraw);
+  if (zraw < XPT2046_Z_THRESHOLD) zraw = 0;
+  lastUpdate = now;
+}
+
+TS_Point XPT2046_Touchscreen::getPoint() {
+  update();
+  return TS_Point(xraw, yraw, zraw);
+}
+
+bool XPT2046_Touchscreen::tirqTouched() {
+  return touchIrqLevel() == LOW;
+}
+
+bool XPT2046_Touchscreen::touched() {
+  update();
+  return zraw >= XPT2046_Z_THRESHOLD;
+}
+
+void XPT2046_Touchscreen::readData(uint16_t* x, uint16_t* y, uint8_t* z) {
+  update();
+  *x = xraw;
+  *y = yraw;
+  *z = (uint8_t)min((int16_t)255, zraw);
+}
+
+// ============================================
+// KAPAZITIVE CONTROLLER (I2C)
+// ============================================
+
+// Register wie im Datenblatt; der Bericht liegt bis zum nächsten
+// setContacts() an, der GT911 setzt zusätzlich Bit 7 im Status, bis
+// der Treiber es quittiert
+SimTouchI2cDevice::SimTouchI2cDevice(uint8_t controllerId, int irqPin, int rstPin)
+  : controller(controllerId), irq(irqPin), rst(rstPin), sleepPulses(rstPin >= 0 ? simGpioPulses(rstPin) : 0),
+    pointer(0), registers() {
+  if (controller == HW_TOUCH_CTRL_GT911) {
+    memcpy(registers + GT911_REG_PRODUCT_ID, "911", 4);
+  } else if (controller == HW_TOUCH_CTRL_FT6236) {
+    registers[FT6236_REG_CHIP_ID] = 0x36;
+    registers[FT6236_REG_STATUS] = 0x0F;   // Vor dem ersten Bericht
+  } else {
+    registers[CST816S_REG_CHIP_ID] = 0xB4;
+  }
+}
+
+// Nur der CST816S schläft; wach ist er nach einem Reset-Puls seit dem Einschalten
+bool SimTouchI2cDevice::ack() {
+  if (controller != HW_TOUCH_CTRL_CST816S || rst < 0) return true;
+  return simGpioPulses(rst) != sleepPulses;
+}
+
+void SimTouchI2cDevice::write(const uint8_t* data, size_t length) {
+  const size_t regBytes = controller == HW_TOUCH_CTRL_GT911 ? 2 : 1;
+  if (length < regBytes) return;
+  pointer = regBytes == 2 ? (uint16_t)((data[0] << 8) | data[1]) : data[0];
+  for (size_t i = regBytes; i < length; i++) {
+    registers[pointer] = data[i];
+    pointer = regBytes == 2 ? (uint16_t)(pointer + 1) : (uint8_t)(pointer + 1);
+  }
+}
+
+void SimTouchI2cDevice::read(uint8_t* data, size_t length) {
+  const bool wide = controller == HW_TOUCH_CTRL_GT911;
+  for (size_t i = 0; i < length; i++) {
+    data[i] = registers[pointer];
+    pointer = wide ? (uint16_t)(pointer + 1) : (uint8_t)(pointer + 1);
+  }
+}
+
+void SimTouchI2cDevice::setContacts(const SimTouchContact* contacts, uint8_t count) {
+  if (controller == HW_TOUCH_CTRL_GT911) {
+    registers[GT911_REG_STATUS] = 0x80 | count;
+    for (uint8_t i = 0; i < count; i++) {
+      uint8_t* p = registers + GT911_REG_STATUS + 1 + i * GT911_POINT_BYTES;
+      const uint8_t point[GT911_POINT_BYTES] = {
+        contacts[i].trackId,
+        (uint8_t)contacts[i].x, (uint8_t)(contacts[i].x >> 8),
+        (uint8_t)contacts[i].y, (uint8_t)(contacts[i].y >> 8),
+        24, 0, 0 };
+      memcpy(p, point, GT911_POINT_BYTES);
+    }
+  } else if (controller == HW_TOUCH_CTRL_FT6236) {
+    registers[FT6236_REG_STATUS] = count;
+    for (uint8_t i = 0; i < 2; i++) {
+      uint8_t* p = registers + FT6236_REG_STATUS + 1 + i * FT6236_POINT_BYTES;
+      if (i >= count) {
+        memset(p, 0xFF, FT6236_POINT_BYTES);   // Event 3: kein Punkt
+        continue;
+      }
+      const uint8_t point[FT6236_POINT_BYTES] = {
+        (uint8_t)(0x80 | (contacts[i].x >> 8)), (uint8_t)contacts[i].x,   // Event 2: Kontakt
+        (uint8_t)((contacts[i].trackId << 4) | (contacts[i].y >> 8)), (uint8_t)contacts[i].y,
+        0x20, 0x00 };
+      memcpy(p, point, FT6236_POINT_BYTES);
+    }
+  } else {
+    const uint8_t report[CST816S_REPORT_BYTES] = {
+      0x00, (uint8_t)(count ? 1 : 0),
+      (uint8_t)(count ? contacts[0].x >> 8 : 0), (uint8_t)(count ? contacts[0].x : 0),
+      (uint8_t)(count ? contacts[0].y >> 8 : 0), (uint8_t)(count ? contacts[0].y : 0) };
+    memcpy(registers + CST816S_REG_GESTURE, report, CST816S_REPORT_BYTES);
+  }
+  if (irq >= 0) simGpioInterrupt(irq);
+}
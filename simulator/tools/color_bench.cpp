@@ -0,0 +1,150 @@
+/**
+ * color_bench.cpp - Farbkonvertierung (color_convert.h) prüfen und messen
+ *
+ * Jede Spezialisierung wird gegen den skalaren Referenzweg geprüft:
+ * RGB888 erschöpfend (alle 2^24 Farben), Graustufen komplett, ARGB8888
+ * mit Zufallswerten, jeweils auch mit versetzten Ein-/Ausgabepuffern.
+ * Danach MPixel/s für Kernel und Referenz auf einem 320x240-Bild.
+ *
+ * Aufruf:
+ *   color_bench
+ */
+
+#include "color_convert.h"
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+#define BENCH_WIDTH    320
+#define BENCH_HEIGHT   240
+#define BENCH_SECONDS  0.05
+
+static uint32_t benchRandom(uint32_t* state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state;
+}
+
+// Kanalwerte wie der Kernel, aber zur Laufzeit
+struct ReferenceFormat {
+  bool bgr, invert, swap;
+  uint8_t levels[256];
+  const uint8_t* lut;
+};
+
+static ReferenceFormat referenceFormat(bool bgr, bool invert, bool swap, uint8_t gammaX10, uint8_t brightness) {
+  ReferenceFormat format = { bgr, invert, swap, {}, nullptr };
+  for (int i = 0; i < 256; i++) format.levels[i] = colorLevel((uint8_t)i, gammaX10, brightness);
+  if (gammaX10 != 10 || brightness != 100) format.lut = format.levels;
+  return format;
+}
+
+static uint16_t reference(const ReferenceFormat& f, uint8_t r, uint8_t g, uint8_t b) {
+  return colorConvertReference(r, g, b, f.bgr, f.invert, f.swap, f.lut);
+}
+
+template <typename Converter>
+static bool checkExact(const ReferenceFormat& format) {
+  // RGB888: eine Zeile je (r, g) mit allen b, Ausgabe um 0/1 Pixel versetzt
+  std::vector<uint8_t> rgb(256 * 3 + 3);
+  std::vector<uint16_t> out(256 + 2);
+  for (int r = 0; r < 256; r++) {
+    for (int g = 0; g < 256; g++) {
+      const int shift = (r + g) & 1;
+      for (int b = 0; b < 256; b++) {
+        rgb[shift + b * 3] = r;
+        rgb[shift + b * 3 + 1] = g;
+        rgb[shift + b * 3 + 2] = b;
+      }
+      Converter::fromRgb888(&rgb[shift], &out[shift], 256 - shift);
+      for (int b = 0; b < 256 - shift; b++) {
+        if (out[shift + b] != reference(format, r, g, b)) return false;
+      }
+    }
+  }
+
+  std::vector<uint8_t> gray(256 + 1);
+  for (int shift = 0; shift < 2; shift++) {
+    for (int i = 0; i < 256; i++) gray[shift + i] = i;
+    Converter::fromGray8(&gray[shift], &out[shift], 256);
+    for (int i = 0; i < 256; i++) {
+      if (out[shift + i] != reference(format, i, i, i)) return false;
+    }
+  }
+
+  std::vector<uint32_t> argb(4099);
+  std::vector<uint16_t> argbOut(argb.size() + 1);
+  uint32_t state = 7;
+  for (int pass = 0; pass < 64; pass++) {
+    for (uint32_t& value : argb) value = benchRandom(&state);
+    const int shift = pass & 1;
+    Converter::fromArgb8888(argb.data(), &argbOut[shift], argb.size());
+    for (size_t i = 0; i < argb.size(); i++) {
+      const uint32_t v = argb[i];
+      if (argbOut[shift + i] != reference(format, v >> 16, v >> 8, v)) return false;
+    }
+  }
+  return true;
+}
+
+static double megapixels(size_t pixels, double seconds) {
+  return seconds > 0 ? pixels / seconds / 1e6 : 0;
+}
+
+template <typename Converter>
+static double measureKernel(const std::vector<uint8_t>& rgb, std::vector<uint16_t>& out) {
+  size_t pixels = 0;
+  double seconds = 0;
+  const auto start = std::chrono::steady_clock::now();
+  do {
+    Converter::fromRgb888(rgb.data(), out.data(), out.size());
+    pixels += out.size();
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  } while (seconds < BENCH_SECONDS);
+  return megapixels(pixels, seconds);
+}
+
+static double measureReference(const ReferenceFormat& format, const std::vector<uint8_t>& rgb,
+                               std::vector<uint16_t>& out) {
+  size_t pixels = 0;
+  double seconds = 0;
+  const auto start = std::chrono::steady_clock::now();
+  do {
+    for (size_t i = 0; i < out.size(); i++) {
+      out[i] = reference(format, rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2]);
+    }
+    pixels += out.size();
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  } while (seconds < BENCH_SECONDS);
+  return megapixels(pixels, seconds);
+}
+
+template <bool Bgr, bool Invert, bool SwapBytes, uint8_t GammaX10, uint8_t Brightness>
+static bool runFormat(const char* name, const std::vector<uint8_t>& rgb) {
+  typedef ColorConverter<Bgr, Invert, SwapBytes, GammaX10, Brightness> Converter;
+  const ReferenceFormat format = referenceFormat(Bgr, Invert, SwapBytes, GammaX10, Brightness);
+  std::vector<uint16_t> out(BENCH_WIDTH * BENCH_HEIGHT);
+  const bool exact = checkExact<Converter>(format);
+  const double kernel = measureKernel<Converter>(rgb, out);
+  const double scalar = measureReference(format, rgb, out);
+  printf("%-28s %10.1f %10.1f %7.1fx  %s\n", name, kernel, scalar, scalar > 0 ? kernel / scalar : 0,
+         exact ? "✅ bitgenau" : "❌ abweichend");
+  return exact;
+}
+
+int main() {
+  std::vector<uint8_t> rgb(BENCH_WIDTH * BENCH_HEIGHT * 3);
+  uint32_t state = 1;
+  for (uint8_t& value : rgb) value = benchRandom(&state) >> 24;
+
+  printf("%-28s %10s %10s %8s  %s\n", "Format (RGB888 ->)", "Kernel", "Referenz", "Faktor", "Ergebnis");
+  printf("%-28s %10s %10s\n", "", "MPixel/s", "MPixel/s");
+  bool ok = true;
+  ok &= runFormat<false, false, true, 10, 100>("Display (RGB, Byte-Tausch)", rgb);
+  ok &= runFormat<false, false, false, 10, 100>("RGB565 nativ", rgb);
+  ok &= runFormat<true, false, true, 10, 100>("BGR, Byte-Tausch", rgb);
+  ok &= runFormat<false, true, true, 10, 100>("invertiert, Byte-Tausch", rgb);
+  ok &= runFormat<false, false, true, 22, 100>("Gamma 2.2", rgb);
+  ok &= runFormat<true, true, true, 10, 50>("BGR, invertiert, 50 %", rgb);
+  ok &= runFormat<false, false, true, 18, 80>("Gamma 1.8, 80 %", rgb);
+  return ok ? 0 : 1;
+}
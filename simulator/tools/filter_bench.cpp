@@ -0,0 +1,180 @@
+/**
+ * filter_bench.cpp - Touch-Filter (touch_filter.h) prüfen und messen
+ *
+ * Pro Konfiguration:
+ *   - ns/Sample auf dem Host über verrauschte Rohwerte
+ *   - Sprungantwort: Samples bis zum Einschwingen, ohne Überschwingen
+ *   - Ausreißer: ein einzelner (Median 3) bzw. zwei aufeinander
+ *     folgende Ausreißer (Median 5) dürfen die Ausgabe nicht bewegen
+ * Dazu das Druck-Gate und die Sortiernetze gegen std::nth_element.
+ *
+ * Aufruf:
+ *   filter_bench
+ */
+
+#include "touch_filter.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCH_SAMPLES    4000000
+#define BENCH_NOISE      24        // ± Rohwert-Einheiten
+#define STEP_FROM        1000
+#define STEP_TO          3000
+#define STEP_LIMIT       64        // Danach gilt der Sprung als nicht eingeschwungen
+#define SPIKE_VALUE      4000
+#define BENCH_PRESSURE   600
+
+static uint32_t benchRandom(uint32_t* state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state;
+}
+
+static int16_t noisy(int16_t value, uint32_t* state) {
+  return (int16_t)(value + (int)(benchRandom(state) >> 16) % (2 * BENCH_NOISE + 1) - BENCH_NOISE);
+}
+
+// ============================================
+// MESSUNG
+// ============================================
+
+static double measureNs(const TouchFilterConfig& config) {
+  static int16_t rawX[1024], rawY[1024];
+  uint32_t state = 7;
+  for (int i = 0; i < 1024; i++) {
+    rawX[i] = noisy(2000, &state);
+    rawY[i] = noisy(1500, &state);
+  }
+
+  TouchFilter filter(config);
+  int16_t x = 0, y = 0;
+  int32_t sum = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < BENCH_SAMPLES; i++) {
+    filter.process(rawX[i & 1023], rawY[i & 1023], BENCH_PRESSURE, &x, &y);
+    sum += x + y;
+  }
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  volatile int32_t sink = sum;   // Schleife nicht wegoptimieren
+  (void)sink;
+  return ns / BENCH_SAMPLES;
+}
+
+// ============================================
+// SPRUNGANTWORT
+// ============================================
+
+// Samples nach dem Sprung, bis die Ausgabe innerhalb des Dead-Bands am
+// Ziel liegt; -1 = nie oder mit Überschwingen/Rücklauf
+static int stepResponse(const TouchFilterConfig& config) {
+  TouchFilter filter(config);
+  int16_t x = 0, y = 0;
+  for (int i = 0; i < 16; i++) filter.process(STEP_FROM, STEP_FROM, BENCH_PRESSURE, &x, &y);
+
+  int16_t last = x;
+  for (int i = 1; i <= STEP_LIMIT; i++) {
+    filter.process(STEP_TO, STEP_TO, BENCH_PRESSURE, &x, &y);
+    if (x < last || x > STEP_TO || x != y) return -1;
+    last = x;
+    if (STEP_TO - x <= config.deadband) return i;
+  }
+  return -1;
+}
+
+// ============================================
+// AUSREISSER
+// ============================================
+
+// Größte Auslenkung der Ausgabe durch 'burst' aufeinander folgende
+// Ausreißer in einem ruhigen Signal
+static int outlierDeflection(const TouchFilterConfig& config, int burst) {
+  TouchFilter filter(config);
+  int16_t x = 0, y = 0;
+  for (int i = 0; i < 16; i++) filter.process(STEP_FROM, STEP_FROM, BENCH_PRESSURE, &x, &y);
+  int worst = 0;
+  for (int i = 0; i < 16; i++) {
+    const int16_t raw = i >= 4 && i < 4 + burst ? SPIKE_VALUE : STEP_FROM;
+    filter.process(raw, STEP_FROM, BENCH_PRESSURE, &x, &y);
+    worst = std::max(worst, abs(x - STEP_FROM));
+  }
+  return worst;
+}
+
+// ============================================
+// GATE UND SORTIERNETZE
+// ============================================
+
+static bool checkGate() {
+  const TouchFilterConfig config = { 400, 3, 1, 0 };
+  TouchFilter filter(config);
+  int16_t x = 0, y = 0;
+  bool ok = !filter.process(100, 100, 399, &x, &y) && !filter.process(100, 100, 0, &x, &y);
+  ok = ok && filter.process(100, 100, 400, &x, &y) && x == 100;
+
+  // Nach dem Abheben beginnt die nächste Berührung ohne Verlauf
+  ok = ok && !filter.process(100, 100, 10, &x, &y);
+  ok = ok && filter.process(3000, 3000, 800, &x, &y) && x == 3000 && y == 3000;
+  return ok;
+}
+
+// Ohne Glättung und Dead-Band ist die Ausgabe der Median des Fensters
+static bool checkMedian(uint8_t size) {
+  const TouchFilterConfig config = { 0, size, 0, 0 };
+  TouchFilter filter(config);
+  uint32_t state = size;
+  int16_t history[TOUCH_FILTER_MAX_MEDIAN];
+  int16_t x = 0, y = 0;
+  for (int i = 0; i < 100000; i++) {
+    const int16_t raw = (int16_t)(benchRandom(&state) >> 20);
+    if (i == 0) std::fill(history, history + size, raw);
+    history[i % size] = raw;
+    filter.process(raw, raw, BENCH_PRESSURE, &x, &y);
+    int16_t sorted[TOUCH_FILTER_MAX_MEDIAN];
+    std::copy(history, history + size, sorted);
+    std::nth_element(sorted, sorted + size / 2, sorted + size);
+    if (x != sorted[size / 2]) return false;
+  }
+  return true;
+}
+
+// ============================================
+// MAIN
+// ============================================
+
+struct BenchConfig {
+  const char* name;
+  TouchFilterConfig config;
+  int maxSettle;        // Samples bis zum Ziel: Median-Verzögerung plus IIR
+  int maxDeflection1;   // Erlaubte Auslenkung bei 1 bzw. 2 Ausreißern, -1 = egal
+  int maxDeflection2;
+};
+
+int main() {
+  static const BenchConfig configs[] = {
+    { "aus",                        { 0, 1, 0, 0 },    1, -1, -1 },
+    { "Median 3",                   { 0, 3, 0, 0 },    2,  0, -1 },
+    { "Median 5",                   { 0, 5, 0, 0 },    3,  0,  0 },
+    { "IIR 1/4",                    { 0, 1, 2, 0 },   32, -1, -1 },
+    { "Profil (Median 3, 1/2, 8)",  { 400, 3, 1, 8 }, 12,  0, -1 },
+    { "Median 5, 1/4, 8",           { 400, 5, 2, 8 }, 24,  0,  0 },
+  };
+
+  printf("%-28s %8s %8s %10s %10s  %s\n", "Konfiguration", "ns/Sam.", "Sprung", "1 Ausr.", "2 Ausr.", "Ergebnis");
+  bool ok = true;
+  for (const BenchConfig& c : configs) {
+    const double ns = measureNs(c.config);
+    const int settle = stepResponse(c.config);
+    const int one = outlierDeflection(c.config, 1);
+    const int two = outlierDeflection(c.config, 2);
+    const bool pass = settle > 0 && settle <= c.maxSettle && (c.maxDeflection1 < 0 || one <= c.maxDeflection1) &&
+                      (c.maxDeflection2 < 0 || two <= c.maxDeflection2);
+    printf("%-28s %8.2f %8d %10d %10d  %s\n", c.name, ns, settle, one, two, pass ? "✅" : "❌");
+    ok &= pass;
+  }
+
+  const bool gate = checkGate();
+  const bool median = checkMedian(3) && checkMedian(5);
+  printf("Druck-Gate %s | Sortiernetze gegen nth_element %s\n", gate ? "✅" : "❌", median ? "✅" : "❌");
+  return ok && gate && median ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+/**
+ * hw_trace_convert.cpp - Binär-Trace (hw_trace.h) nach Chrome JSON
+ *
+ * Liest einen Binär-Export von Gerät oder Host-Simulator. Die Eingabe
+ * darf ein kompletter Serial-Mitschnitt sein: gesucht wird die Kennung
+ * "HWTR". Das JSON entsteht mit denselben Funktionen wie auf dem Gerät
+ * (Taste 'e') und ist damit direkt vergleichbar. Auf stderr folgt eine
+ * Zusammenfassung pro Scope (Anzahl, Summe, Maximum).
+ *
+ * Aufruf:
+ *   hw_trace_convert trace.bin [trace.json]     (ohne Ziel: stdout)
+ */
+
+#include "hw_trace.h"
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+struct ScopeStats {
+  uint32_t count, totalUs, maxUs;
+};
+
+static bool readFile(const char* path, std::vector<uint8_t>* data) {
+  FILE* file = fopen(path, "rb");
+  if (!file) return false;
+  uint8_t buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data->insert(data->end(), buffer, buffer + n);
+  }
+  fclose(file);
+  return true;
+}
+
+// Begin/End je Core paaren (Scopes sind pro Core verschachtelt)
+static void printSummary(const HwTraceHeader& header, char names[][HW_TRACE_NAME_MAX + 1],
+                         const std::vector<HwTraceEvent>& events) {
+  ScopeStats stats[HW_TRACE_NAMES] = {};
+  std::vector<HwTraceEvent> open[2];
+  uint32_t unmatched = 0;
+
+  for (const HwTraceEvent& event : events) {
+    std::vector<HwTraceEvent>& stack = open[event.core & 1];
+    if (event.phase == HW_TRACE_PHASE_BEGIN) {
+      stack.push_back(event);
+    } else if (event.phase == HW_TRACE_PHASE_END) {
+      if (stack.empty() || stack.back().name != event.name) {
+        unmatched++;   // Begin vom Ring überschrieben
+        continue;
+      }
+      const uint32_t us = event.timestampUs - stack.back().timestampUs;
+      stack.pop_back();
+      ScopeStats& s = stats[event.name];
+      s.count++;
+      s.totalUs += us;
+      if (us > s.maxUs) s.maxUs = us;
+    }
+  }
+
+  fprintf(stderr, "%lu Ereignisse, %lu verworfen, %lu ohne Begin\n",
+          (unsigned long)header.eventCount, (unsigned long)header.dropped, (unsigned long)unmatched);
+  fprintf(stderr, "%-24s %8s %12s %12s\n", "Scope", "Anzahl", "Summe ms", "Max ms");
+  for (uint16_t i = 0; i < header.nameCount; i++) {
+    if (!stats[i].count) continue;
+    fprintf(stderr, "%-24s %8lu %12.3f %12.3f\n", names[i], (unsigned long)stats[i].count,
+            stats[i].totalUs / 1000.0, stats[i].maxUs / 1000.0);
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    fprintf(stderr, "Aufruf: %s trace.bin [trace.json]\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<uint8_t> data;
+  if (!readFile(argv[1], &data)) {
+    fprintf(stderr, "❌ Nicht lesbar: %s\n", argv[1]);
+    return 1;
+  }
+
+  // Kennung suchen, davor kann Serial-Text stehen
+  size_t pos = 0;
+  HwTraceHeader header;
+  while (pos + HW_TRACE_HEADER_SIZE <= data.size() && !hwTraceDecodeHeader(&data[pos], &header)) {
+    pos++;
+  }
+  if (pos + HW_TRACE_HEADER_SIZE > data.size()) {
+    fprintf(stderr, "❌ Kein Trace (Kennung %s, Version %d) gefunden\n", HW_TRACE_MAGIC, HW_TRACE_VERSION);
+    return 1;
+  }
+  pos += HW_TRACE_HEADER_SIZE;
+
+  char names[HW_TRACE_NAMES][HW_TRACE_NAME_MAX + 1];
+  for (uint16_t i = 0; i < header.nameCount; i++) {
+    const size_t length = pos < data.size() ? data[pos] : 0;
+    if (length > HW_TRACE_NAME_MAX || pos + 1 + length > data.size()) {
+      fprintf(stderr, "❌ Namenstabelle unvollständig\n");
+      return 1;
+    }
+    memcpy(names[i], &data[pos + 1], length);
+    names[i][length] = '\0';
+    pos += 1 + length;
+  }
+
+  if (pos + (size_t)header.eventCount * HW_TRACE_EVENT_SIZE > data.size()) {
+    fprintf(stderr, "❌ Trace abgeschnitten: %lu Ereignisse erwartet\n", (unsigned long)header.eventCount);
+    return 1;
+  }
+  std::vector<HwTraceEvent> events;
+  for (uint32_t i = 0; i < header.eventCount; i++, pos += HW_TRACE_EVENT_SIZE) {
+    events.push_back(hwTraceDecodeEvent(&data[pos]));
+  }
+
+  FILE* out = argc == 3 ? fopen(argv[2], "w") : stdout;
+  if (!out) {
+    fprintf(stderr, "❌ Nicht schreibbar: %s\n", argv[2]);
+    return 1;
+  }
+  char line[HW_TRACE_NAME_MAX + 96];
+  fputs(HW_TRACE_JSON_BEGIN, out);
+  for (size_t i = 0; i < events.size(); i++) {
+    const char* name = events[i].name < header.nameCount ? names[events[i].name] : "?";
+    hwTraceFormatJsonEvent(line, sizeof(line), name, events[i], i == 0);
+    fputs(line, out);
+  }
+  hwTraceFormatJsonEnd(line, sizeof(line), header);
+  fputs(line, out);
+  if (out != stdout) fclose(out);
+
+  printSummary(header, names, events);
+  return 0;
+}
@@ -0,0 +1,287 @@
+/**
+ * image_pack.cpp - Bilder für drawImage() packen (image_asset.h)
+ *
+ * Liest ein PPM (P6, 8 Bit) und schreibt das Asset als Binärdatei (.hwim)
+ * oder als C-Header (.h) zum Einbinden in den Sketch. Ohne --format wird
+ * die kleinste Kodierung gewählt. --bgr/--invert speichern die Pixel für
+ * ein Panel, dessen Treiber Farbreihenfolge bzw. Inversion nicht selbst
+ * ausgleicht; drawImage() rechnet bei Bedarf zurück.
+ *
+ * --selftest packt synthetische Bilder (Verlauf, Icon, Logo, Rauschen) in
+ * allen Kodierungen, dekodiert sie mit dem Gerätedecoder bitgenau zurück
+ * (auch mit Clipping) und misst den Dekodier-Durchsatz.
+ *
+ * Aufruf:
+ *   image_pack [--format raw|rle|palette|auto] [--bgr] [--invert]
+ *              [--name NAME] bild.ppm asset.hwim|asset.h
+ *   image_pack --selftest
+ */
+
+#include "image_pack.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* const encodingNames[] = { "raw", "rle", "palette" };
+
+// ============================================
+// DATEIEN
+// ============================================
+
+// Zahl im PPM-Header, Kommentare (#) überspringen
+static bool readPpmNumber(FILE* file, int* value) {
+  int c = fgetc(file);
+  while (c == '#' || c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+    if (c == '#') {
+      while (c != '\n' && c != EOF) c = fgetc(file);
+    }
+    c = fgetc(file);
+  }
+  if (c < '0' || c > '9') return false;
+  *value = 0;
+  while (c >= '0' && c <= '9') {
+    *value = *value * 10 + (c - '0');
+    c = fgetc(file);
+  }
+  return true;   // Ein Trennzeichen nach der Zahl ist verbraucht
+}
+
+static bool readPpm(const char* path, std::vector<uint16_t>* pixels, uint16_t* width, uint16_t* height) {
+  FILE* file = fopen(path, "rb");
+  if (!file) return false;
+  int w = 0, h = 0, maxValue = 0;
+  const bool ok = fgetc(file) == 'P' && fgetc(file) == '6' && readPpmNumber(file, &w) &&
+                  readPpmNumber(file, &h) && readPpmNumber(file, &maxValue) &&
+                  w > 0 && h > 0 && w <= 0xFFFF && h <= 0xFFFF && maxValue == 255;
+  std::vector<uint8_t> rgb(ok ? (size_t)w * h * 3 : 0);
+  const bool complete = ok && fread(rgb.data(), 1, rgb.size(), file) == rgb.size();
+  fclose(file);
+  if (!complete) return false;
+
+  pixels->resize((size_t)w * h);
+  ColorConverter<false, false, false>::fromRgb888(rgb.data(), pixels->data(), pixels->size());
+  *width = (uint16_t)w;
+  *height = (uint16_t)h;
+  return true;
+}
+
+static bool writeAsset(const char* path, const char* name, const std::vector<uint8_t>& asset) {
+  const size_t length = strlen(path);
+  const bool header = length > 2 && strcmp(path + length - 2, ".h") == 0;
+  FILE* file = fopen(path, header ? "w" : "wb");
+  if (!file) return false;
+  if (!header) {
+    fwrite(asset.data(), 1, asset.size(), file);
+    return fclose(file) == 0;
+  }
+
+  // const: liegt auf dem ESP32 im memory-mapped Flash, nicht im RAM
+  fprintf(file, "// Erzeugt mit image_pack, %lu Bytes\n", (unsigned long)asset.size());
+  fprintf(file, "#pragma once\n#include <stdint.h>\n\n");
+  fprintf(file, "static const uint8_t %s[%lu] = {", name, (unsigned long)asset.size());
+  for (size_t i = 0; i < asset.size(); i++) {
+    fprintf(file, "%s0x%02X,", i % 16 ? " " : "\n  ", asset[i]);
+  }
+  fprintf(file, "\n};\n");
+  return fclose(file) == 0;
+}
+
+// ============================================
+// SELBSTTEST
+// ============================================
+
+struct TestImage {
+  const char* name;
+  uint16_t width, height;
+  std::vector<uint16_t> pixels;
+};
+
+static uint32_t testRandom(uint32_t* state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 8;
+}
+
+static std::vector<TestImage> makeTestImages() {
+  std::vector<TestImage> images(4);
+
+  TestImage& gradient = images[0];   // Viele Farben: nur RAW/RLE
+  gradient = { "Verlauf 320x240", 320, 240, std::vector<uint16_t>(320 * 240) };
+  for (int y = 0; y < 240; y++) {
+    for (int x = 0; x < 320; x++) {
+      gradient.pixels[y * 320 + x] = imagePackRgb565(x * 255 / 319, y * 255 / 239, (x + y) & 0xFF);
+    }
+  }
+
+  TestImage& icon = images[1];       // Flächen mit wenigen Farben
+  icon = { "Icon 64x64", 64, 64, std::vector<uint16_t>(64 * 64, 0x0000) };
+  for (int y = 0; y < 64; y++) {
+    for (int x = 0; x < 64; x++) {
+      const int dx = x - 32, dy = y - 32;
+      if (dx * dx + dy * dy < 28 * 28) icon.pixels[y * 64 + x] = 0x07E0;
+      if (dx * dx + dy * dy < 20 * 20) icon.pixels[y * 64 + x] = 0xFFFF;
+      if (x > 28 && x < 36 && y > 14 && y < 50) icon.pixels[y * 64 + x] = 0xF800;
+    }
+  }
+
+  TestImage& logo = images[2];       // Schrift-ähnliche Balken, 16 Farben
+  logo = { "Logo 200x80", 200, 80, std::vector<uint16_t>(200 * 80, 0x001F) };
+  for (int y = 0; y < 80; y++) {
+    for (int x = 0; x < 200; x++) {
+      if ((x / 6) % 3 != 0 && y > 12 && y < 68 && ((x / 18) + (y / 14)) % 2) {
+        logo.pixels[y * 200 + x] = imagePackRgb565(255, (x / 25) * 32, (y / 20) * 64);
+      }
+    }
+  }
+
+  TestImage& noise = images[3];      // Schlechtester Fall für RLE
+  noise = { "Rauschen 97x33", 97, 33, std::vector<uint16_t>(97 * 33) };
+  uint32_t state = 22;
+  for (uint16_t& pixel : noise.pixels) pixel = (uint16_t)testRandom(&state);
+  return images;
+}
+
+// Zeilenweise dekodieren, Fenster [x0, x1) x [y0, y1) gegen die Quelle prüfen
+static bool checkDecode(const TestImage& image, const std::vector<uint8_t>& asset, uint8_t targetFlags,
+                        bool swapBytes, uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1) {
+  ImageDecoder decoder;
+  if (!decoder.begin(asset.data(), targetFlags, swapBytes)) return false;
+  std::vector<uint16_t> row(image.width);
+  for (uint16_t y = 0; y < image.height; y++) {
+    const bool visible = y >= y0 && y < y1;
+    if (!decoder.decodeRow(visible ? row.data() : nullptr, x0, x1)) return false;
+    if (!visible) continue;
+    for (uint16_t x = x0; x < x1; x++) {
+      uint16_t expected = imageConvertColor(image.pixels[(size_t)y * image.width + x], 0, targetFlags);
+      if (swapBytes) expected = imageSwapBytes(expected);
+      if (row[x - x0] != expected) return false;
+    }
+  }
+  return !decoder.decodeRow(row.data(), 0, image.width);   // Genau height Zeilen
+}
+
+static double decodeMegapixels(const std::vector<uint8_t>& asset, uint16_t width, uint16_t height) {
+  ImageDecoder decoder;
+  std::vector<uint16_t> row(width);
+  uint64_t pixels = 0;
+  const auto start = std::chrono::steady_clock::now();
+  double seconds = 0;
+  do {
+    decoder.begin(asset.data(), 0, true);
+    for (uint16_t y = 0; y < height; y++) decoder.decodeRow(row.data(), 0, width);
+    pixels += (uint64_t)width * height;
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  } while (seconds < 0.05);
+  return pixels / seconds / 1e6;
+}
+
+static int runSelftest() {
+  const std::vector<TestImage> images = makeTestImages();
+  const uint8_t flagSets[] = { 0, IMAGE_FLAG_BGR, IMAGE_FLAG_INVERTED, IMAGE_FLAG_BGR | IMAGE_FLAG_INVERTED };
+  int failures = 0;
+
+  printf("%-16s %-8s %9s %7s %10s  %s\n", "Bild", "Format", "Bytes", "Quote", "MPixel/s", "Ergebnis");
+  for (const TestImage& image : images) {
+    const size_t rawBytes = (size_t)image.width * image.height * 2;
+    for (uint8_t encoding = IMAGE_ENC_RAW; encoding <= IMAGE_ENC_PALETTE; encoding++) {
+      std::vector<uint8_t> asset;
+      if (!imagePack(image.pixels.data(), image.width, image.height, encoding, 0, &asset)) {
+        printf("%-16s %-8s %9s\n", image.name, encodingNames[encoding], "-");
+        continue;
+      }
+
+      // Voll, geclippt, alle Flag-Kombinationen, Display-Byte-Reihenfolge
+      bool ok = checkDecode(image, asset, 0, false, 0, image.width, 0, image.height) &&
+                checkDecode(image, asset, 0, true, 0, image.width, 0, image.height) &&
+                checkDecode(image, asset, 0, false, image.width / 3, image.width - 5, 7, image.height / 2);
+      for (uint8_t stored : flagSets) {
+        std::vector<uint8_t> flagged;
+        imagePack(image.pixels.data(), image.width, image.height, encoding, stored, &flagged);
+        for (uint8_t target : flagSets) {
+          ok = ok && checkDecode(image, flagged, target, true, 1, image.width - 1, 0, image.height);
+        }
+      }
+
+      // Abgeschnittenes Asset muss erkannt werden statt über das Ende zu lesen
+      if (encoding != IMAGE_ENC_RAW) {
+        std::vector<uint8_t> truncated(asset.begin(), asset.end() - 1);
+        imagePut32(&truncated[16], imageGet32(&asset[16]) - 1);
+        ok = ok && !checkDecode(image, truncated, 0, false, 0, image.width, 0, image.height);
+      }
+
+      printf("%-16s %-8s %9lu %6.1f%% %10.1f  %s\n", image.name, encodingNames[encoding],
+             (unsigned long)asset.size(), 100.0 * asset.size() / rawBytes,
+             decodeMegapixels(asset, image.width, image.height), ok ? "✅ bitgenau" : "❌ abweichend");
+      if (!ok) failures++;
+    }
+  }
+  return failures ? 1 : 0;
+}
+
+// ============================================
+// AUFRUF
+// ============================================
+
+static void printUsage(const char* argv0) {
+  fprintf(stderr, "Aufruf: %s [--format raw|rle|palette|auto] [--bgr] [--invert] [--name NAME]"
+                  " bild.ppm asset.hwim|asset.h\n       %s --selftest\n", argv0, argv0);
+}
+
+int main(int argc, char** argv) {
+  uint8_t encoding = IMAGE_PACK_AUTO;
+  uint8_t flags = 0;
+  const char* name = "imageAsset";
+  const char* paths[2] = { nullptr, nullptr };
+  int pathCount = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--selftest") == 0) {
+      return runSelftest();
+    } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+      const char* format = argv[++i];
+      encoding = strcmp(format, "auto") == 0 ? IMAGE_PACK_AUTO : 0xFE;
+      for (uint8_t e = IMAGE_ENC_RAW; e <= IMAGE_ENC_PALETTE; e++) {
+        if (strcmp(format, encodingNames[e]) == 0) encoding = e;
+      }
+      if (encoding == 0xFE) {
+        printUsage(argv[0]);
+        return 2;
+      }
+    } else if (strcmp(argv[i], "--bgr") == 0) {
+      flags |= IMAGE_FLAG_BGR;
+    } else if (strcmp(argv[i], "--invert") == 0) {
+      flags |= IMAGE_FLAG_INVERTED;
+    } else if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+      name = argv[++i];
+    } else if (argv[i][0] != '-' && pathCount < 2) {
+      paths[pathCount++] = argv[i];
+    } else {
+      printUsage(argv[0]);
+      return 2;
+    }
+  }
+  if (pathCount != 2) {
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  std::vector<uint16_t> pixels;
+  uint16_t width, height;
+  if (!readPpm(paths[0], &pixels, &width, &height)) {
+    fprintf(stderr, "❌ Kein PPM (P6, 8 Bit): %s\n", paths[0]);
+    return 1;
+  }
+  std::vector<uint8_t> asset;
+  if (!imagePack(pixels.data(), width, height, encoding, flags, &asset)) {
+    fprintf(stderr, "❌ Mehr als %d Farben - Palette nicht möglich\n", IMAGE_PALETTE_MAX);
+    return 1;
+  }
+  if (!writeAsset(paths[1], name, asset)) {
+    fprintf(stderr, "❌ Nicht schreibbar: %s\n", paths[1]);
+    return 1;
+  }
+
+  fprintf(stderr, "%ux%u, %s, %lu Bytes (%.1f%% von RAW)\n", width, height, encodingNames[asset[5]],
+          (unsigned long)asset.size(), 100.0 * asset.size() / ((size_t)width * height * 2));
+  return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * image_pack.h - Encoder für das Bildformat aus image_asset.h (nur Host)
+ *
+ * Gemeinsam benutzt vom Packer (image_pack.cpp) und vom Simulator, damit
+ * Encoder und Gerätedecoder immer zusammen getestet werden.
+ */
+
+#ifndef IMAGE_PACK_H
+#define IMAGE_PACK_H
+
+#include "image_asset.h"
+#include "color_convert.h"
+#include <vector>
+
+#define IMAGE_PACK_AUTO     0xFF   // Kleinste passende Kodierung wählen
+#define IMAGE_PACK_MIN_RUN  3      // Kürzere Wiederholungen bleiben im Literal
+
+inline uint16_t imagePackRgb565(uint8_t r, uint8_t g, uint8_t b) {
+  return ColorConverter<false, false, false>::pixel(r, g, b);
+}
+
+// Eine Zeile Werte (Pixel oder Indizes) als Läufe und Literale
+inline void imagePackRow(const uint16_t* values, uint16_t width, uint8_t valueSize,
+                         std::vector<uint8_t>* out) {
+  uint16_t x = 0;
+  uint16_t literal = 0;       // Beginn des offenen Literals
+  while (x < width) {
+    uint16_t run = 1;
+    while (x + run < width && run < IMAGE_TOKEN_MAX && values[x + run] == values[x]) run++;
+
+    const bool emitRun = run >= IMAGE_PACK_MIN_RUN;
+    if (emitRun || x + run == width || x + run - literal >= IMAGE_TOKEN_MAX) {
+      // Offenes Literal (ggf. inklusive dieser kurzen Wiederholung) abschließen
+      uint16_t end = emitRun ? x : x + run;
+      while (literal < end) {
+        const uint16_t count = end - literal > IMAGE_TOKEN_MAX ? IMAGE_TOKEN_MAX : end - literal;
+        out->push_back((uint8_t)(count - 1));
+        for (uint16_t i = literal; i < literal + count; i++) {
+          out->push_back((uint8_t)values[i]);
+          if (valueSize == 2) out->push_back((uint8_t)(values[i] >> 8));
+        }
+        literal += count;
+      }
+      if (emitRun) {
+        out->push_back((uint8_t)(IMAGE_RUN_FLAG | (run - 1)));
+        out->push_back((uint8_t)values[x]);
+        if (valueSize == 2) out->push_back((uint8_t)(values[x] >> 8));
+      }
+      literal = x + run;
+    }
+    x += run;
+  }
+}
+
+// pixels: Breite * Höhe RGB565 (normales RGB). flags: gespeichertes Format,
+// die Pixel werden vorab umgerechnet. false = Palette mit > 256 Farben.
+inline bool imagePackEncoding(const uint16_t* pixels, uint16_t width, uint16_t height,
+                              uint8_t encoding, uint8_t flags, std::vector<uint8_t>* out) {
+  std::vector<uint16_t> stored((size_t)width * height);
+  for (size_t i = 0; i < stored.size(); i++) stored[i] = imageConvertColor(pixels[i], 0, flags);
+
+  std::vector<uint16_t> palette;
+  std::vector<uint8_t> data;
+  if (encoding == IMAGE_ENC_RAW) {
+    for (uint16_t value : stored) {
+      data.push_back((uint8_t)value);
+      data.push_back((uint8_t)(value >> 8));
+    }
+  } else if (encoding == IMAGE_ENC_RLE) {
+    for (uint16_t y = 0; y < height; y++) imagePackRow(&stored[(size_t)y * width], width, 2, &data);
+  } else {
+    // Palette in Reihenfolge des Auftretens, dann Indizes wie RLE
+    std::vector<uint16_t> indices(stored.size());
+    for (size_t i = 0; i < stored.size(); i++) {
+      size_t index = 0;
+      while (index < palette.size() && palette[index] != stored[i]) index++;
+      if (index == palette.size()) {
+        if (palette.size() == IMAGE_PALETTE_MAX) return false;
+        palette.push_back(stored[i]);
+      }
+      indices[i] = (uint16_t)index;
+    }
+    for (uint16_t y = 0; y < height; y++) imagePackRow(&indices[(size_t)y * width], width, 1, &data);
+  }
+
+  ImageHeader header = { encoding, flags, width, height, (uint16_t)palette.size(), (uint32_t)data.size() };
+  out->resize(IMAGE_HEADER_SIZE);
+  imageEncodeHeader(out->data(), header);
+  for (uint16_t color : palette) {
+    out->push_back((uint8_t)color);
+    out->push_back((uint8_t)(color >> 8));
+  }
+  out->insert(out->end(), data.begin(), data.end());
+  return true;
+}
+
+// Kodierung oder IMAGE_PACK_AUTO
+inline bool imagePack(const uint16_t* pixels, uint16_t width, uint16_t height, uint8_t encoding,
+                      uint8_t flags, std::vector<uint8_t>* out) {
+  if (encoding != IMAGE_PACK_AUTO) return imagePackEncoding(pixels, width, height, encoding, flags, out);
+  out->clear();
+  for (uint8_t candidate = IMAGE_ENC_RAW; candidate <= IMAGE_ENC_PALETTE; candidate++) {
+    std::vector<uint8_t> packed;
+    if (!imagePackEncoding(pixels, width, height, candidate, flags, &packed)) continue;
+    if (out->empty() || packed.size() < out->size()) out->swap(packed);
+  }
+  return true;
+}
+
+#endif // IMAGE_PACK_H
@@ -0,0 +1,172 @@
+/**
+ * ring_test.cpp - SPSC-Ringpuffer (spsc_ring.h) auf dem Host prüfen
+ *
+ * Erst deterministisch in einem Thread: leer, voll (Verwerfen und
+ * dropped()), Entnahme in Blöcken und Umlauf der Indizes über das
+ * Pufferende. Danach ein simulierter Producer in einem eigenen Thread
+ * gegen einen Consumer, der in Blöcken wechselnder Größe abholt:
+ * einmal mit Wiederholen bei vollem Puffer (keine Lücke erlaubt),
+ * einmal verwerfend wie der Sampling-Task (empfangen + verworfen =
+ * gesendet, Reihenfolge steigend).
+ *
+ * Aufruf:
+ *   ring_test
+ */
+
+#include "spsc_ring.h"
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+
+#define RING_CAPACITY      64      // Wie TOUCH_SAMPLE_BUFFER
+#define RING_ITEMS         2000000
+#define RING_MAX_BATCH     23      // Teilerfremd zur Kapazität
+
+typedef SpscRing<uint32_t, RING_CAPACITY> TestRing;
+
+static bool report(const char* name, bool ok) {
+  printf("%s %s\n", ok ? "✅" : "❌", name);
+  return ok;
+}
+
+// ============================================
+// DETERMINISTISCH (ein Thread)
+// ============================================
+
+static bool checkEmpty() {
+  TestRing ring;
+  uint32_t out[4];
+  return ring.empty() && ring.size() == 0 && ring.pop(out, 4) == 0 && !ring.pop(out) &&
+         ring.dropped() == 0 && TestRing::capacity() == RING_CAPACITY;
+}
+
+static bool checkFull() {
+  TestRing ring;
+  bool ok = true;
+  for (uint32_t i = 0; i < RING_CAPACITY; i++) ok = ok && ring.push(i);
+  ok = ok && ring.size() == RING_CAPACITY;
+  ok = ok && !ring.push(1000) && !ring.push(1001) && ring.dropped() == 2;
+
+  // Verworfen wird das neue Element, die alten bleiben vollständig
+  uint32_t out[RING_CAPACITY + 1];
+  ok = ok && ring.pop(out, RING_CAPACITY + 1) == RING_CAPACITY;
+  for (uint32_t i = 0; i < RING_CAPACITY; i++) ok = ok && out[i] == i;
+  ok = ok && ring.empty() && ring.push(7) && ring.size() == 1;
+  return ok;
+}
+
+static bool checkBatches() {
+  TestRing ring;
+  bool ok = true;
+  for (uint32_t i = 0; i < 40; i++) ok = ok && ring.push(i);
+  uint32_t out[RING_CAPACITY];
+  uint32_t expected = 0;
+  const size_t batches[] = { 1, 5, 0, 16, 64 };
+  const size_t results[] = { 1, 5, 0, 16, 18 };
+  for (size_t b = 0; b < 5; b++) {
+    const size_t n = ring.pop(out, batches[b]);
+    ok = ok && n == results[b];
+    for (size_t i = 0; i < n; i++) ok = ok && out[i] == expected++;
+  }
+  ring.push(1);
+  ring.clear();
+  return ok && ring.empty() && expected == 40;
+}
+
+// Schreib- und Leseposition laufen viele Male über das Pufferende,
+// Blöcke liegen dabei auch über der Nahtstelle
+static bool checkWrap() {
+  TestRing ring;
+  bool ok = true;
+  uint32_t next = 0, expected = 0;
+  uint32_t out[RING_CAPACITY];
+  for (int round = 0; round < 1000; round++) {
+    const uint32_t fill = 1 + (round * 37) % RING_CAPACITY;
+    while (ring.size() < fill) ok = ok && ring.push(next++);
+    const size_t n = ring.pop(out, 1 + (round * 13) % RING_CAPACITY);
+    for (size_t i = 0; i < n; i++) ok = ok && out[i] == expected++;
+  }
+  while (ring.pop(out)) ok = ok && out[0] == expected++;
+  return ok && expected == next && next > 10 * RING_CAPACITY && ring.dropped() == 0;
+}
+
+// ============================================
+// SIMULIERTER PRODUCER (eigener Thread)
+// ============================================
+
+struct ThreadResult {
+  uint64_t received;
+  uint32_t fullHits;     // Producer fand den Puffer voll
+  uint32_t emptyPolls;   // Consumer fand den Puffer leer
+  bool ordered;
+  double seconds;
+};
+
+static ThreadResult runThreads(bool retry) {
+  static TestRing ring;
+  ring.clear();
+  ThreadResult result = { 0, 0, 0, true, 0 };
+  const uint32_t droppedBefore = ring.dropped();
+  std::atomic<bool> producerDone(false);
+  const auto start = std::chrono::steady_clock::now();
+
+  std::thread producer([&result, &producerDone, retry]() {
+    for (uint32_t i = 0; i < RING_ITEMS; i++) {
+      while (!ring.push(i)) {
+        result.fullHits++;
+        if (!retry) break;
+        std::this_thread::yield();
+      }
+      // Verwerfend wie der Sampling-Task: Bursts von 96 Samples gegen
+      // 64 Plätze, dazwischen kommt der Consumer zum Zug
+      if (!retry && i % 96 == 95) std::this_thread::yield();
+    }
+    producerDone.store(true, std::memory_order_release);
+  });
+
+  uint32_t out[RING_MAX_BATCH];
+  int64_t last = -1;
+  size_t batch = 1;
+  for (;;) {
+    const size_t n = ring.pop(out, batch);
+    if (n == 0) {
+      // Fertig erst, wenn nach dem Ende des Producers nichts mehr liegt
+      if (producerDone.load(std::memory_order_acquire) && ring.empty()) break;
+      result.emptyPolls++;
+      std::this_thread::yield();
+      continue;
+    }
+    for (size_t i = 0; i < n; i++) {
+      if (retry ? out[i] != last + 1 : (int64_t)out[i] <= last) result.ordered = false;
+      last = out[i];
+    }
+    result.received += n;
+    batch = batch % RING_MAX_BATCH + 1;
+  }
+  producer.join();
+
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (!retry) result.fullHits = ring.dropped() - droppedBefore;
+  return result;
+}
+
+static bool checkThreads(bool retry) {
+  const ThreadResult r = runThreads(retry);
+  const bool ok = r.ordered && (retry ? r.received == RING_ITEMS : r.received + r.fullHits == RING_ITEMS);
+  printf("%s Producer-Thread, %s: %llu von %u empfangen (%.1f M/s) | voll %u | leer %u\n",
+         ok ? "✅" : "❌", retry ? "wiederholt bei voll" : "verwirft bei voll",
+         (unsigned long long)r.received, RING_ITEMS, r.seconds > 0 ? r.received / r.seconds / 1e6 : 0,
+         r.fullHits, r.emptyPolls);
+  return ok;
+}
+
+int main() {
+  bool ok = true;
+  ok &= report("Leer: size 0, pop liefert nichts", checkEmpty());
+  ok &= report("Voll: neues Element verworfen", checkFull());
+  ok &= report("Entnahme in Blöcken, clear()", checkBatches());
+  ok &= report("Umlauf über das Pufferende", checkWrap());
+  ok &= checkThreads(true);
+  ok &= checkThreads(false);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+/**
+ * span_fill.cpp - Zeilen erzeugen (32-Bit-Schreibzugriffe per memcpy) und in einem Fenster streamen
+ */
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+#include "span_fill.h"
+#include "color_convert.h"
+#include "spi_arbiter.h"
+
+// ============================================
+// KERNEL
+// ============================================
+
+// Zwei Pixel als ein 32-Bit-Store; memcpy statt uint32_t* (Strict Aliasing,
+// pushPixels liest den Puffer als uint16_t)
+static inline uint16_t* spanStore2(uint16_t* out, uint32_t pair) {
+  memcpy(out, &pair, 4);
+  return out + 2;
+}
+
+// 'count' Pixel einer Farbe (Display-Byte-Reihenfolge), zwei pro Wort
+static void spanSolid(uint16_t* out, int32_t count, uint16_t color) {
+  if (count > 0 && ((uintptr_t)out & 2)) {
+    *out++ = color;
+    count--;
+  }
+  const uint32_t pair = color | ((uint32_t)color << 16);
+  for (; count >= 2; count -= 2) out = spanStore2(out, pair);
+  if (count) *out = color;
+}
+
+// RGB565 -> 8-Bit Kanäle wie color565() sie wieder abbildet
+static void spanChannels(uint16_t color, int32_t rgb[3]) {
+  const int32_t r = color >> 11, g = (color >> 5) & 0x3F, b = color & 0x1F;
+  rgb[0] = (r << 3) | (r >> 2);
+  rgb[1] = (g << 2) | (g >> 4);
+  rgb[2] = (b << 3) | (b >> 2);
+}
+
+// Schritt 'step' von 'steps', Ergebnis in Display-Byte-Reihenfolge
+static uint16_t spanGradientColor(const int32_t from[3], const int32_t to[3], int32_t step, int32_t steps) {
+  const int32_t r = from[0] + (to[0] - from[0]) * step / steps;
+  const int32_t g = from[1] + (to[1] - from[1]) * step / steps;
+  const int32_t b = from[2] + (to[2] - from[2]) * step / steps;
+  return DisplayColorConverter::pixel(r, g, b);
+}
+
+// Gleicher Schlüssel = gleiche Zeile
+static int32_t spanRowKey(const SpanPattern& pattern, int32_t row) {
+  switch (pattern.type) {
+    case SPAN_GRADIENT_H: return 0;
+    case SPAN_GRID:       return row / pattern.cellH;
+    default:              return row;
+  }
+}
+
+void SpanFiller::generateRow(uint16_t* out, const SpanPattern& pattern, int32_t column, int32_t width,
+                             int32_t row, int32_t rectW, int32_t rectH) {
+  int32_t from[3], to[3];
+  if (pattern.type == SPAN_GRADIENT_V) {
+    spanChannels(pattern.from, from);
+    spanChannels(pattern.to, to);
+    spanSolid(out, width, spanGradientColor(from, to, row, rectH));
+
+  } else if (pattern.type == SPAN_GRADIENT_H) {
+    spanChannels(pattern.from, from);
+    spanChannels(pattern.to, to);
+    int32_t i = 0;
+    if ((uintptr_t)out & 2) {
+      out[i++] = spanGradientColor(from, to, column, rectW);
+    }
+    for (; i + 1 < width; i += 2) {
+      spanStore2(out + i, spanGradientColor(from, to, column + i, rectW) |
+                          ((uint32_t)spanGradientColor(from, to, column + i + 1, rectW) << 16));
+    }
+    if (i < width) out[i] = spanGradientColor(from, to, column + i, rectW);
+
+  } else {
+    const int32_t cellRow = row / pattern.cellH;
+    int32_t cell = column / pattern.cellW;
+    int32_t left = pattern.cellW - column % pattern.cellW;   // Rest der ersten Zelle
+    for (int32_t i = 0; i < width; cell++) {
+      const int32_t span = min(left, width - i);
+      spanSolid(out + i, span, colorSwap16(pattern.colors[(cell + cellRow) % pattern.count]));
+      i += span;
+      left = pattern.cellW;
+    }
+  }
+  counters.rowsGenerated++;
+}
+
+// ============================================
+// SPAN FILLER
+// ============================================
+
+SpanFiller::SpanFiller(const SpiDevice& display)
+  : device(display), buffers{ nullptr, nullptr }, bufferPixels(0), bufferKey{ -1, -1 }, bufferRows{ 0, 0 },
+    counters() {}
+
+bool SpanFiller::begin(uint32_t pixels) {
+  if (buffers[0]) return true;
+  for (int i = 0; i < 2; i++) {
+    buffers[i] = (uint16_t*)heap_caps_malloc(pixels * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    if (!buffers[i]) {
+      end();
+      return false;
+    }
+  }
+  bufferPixels = pixels;
+  return true;
+}
+
+void SpanFiller::end() {
+  for (int i = 0; i < 2; i++) {
+    heap_caps_free(buffers[i]);
+    buffers[i] = nullptr;
+  }
+  bufferPixels = 0;
+}
+
+bool SpanFiller::fill(TFT_eSPI& tft, int32_t x, int32_t y, int32_t w, int32_t h,
+                      const SpanPattern& pattern, bool useDMA) {
+  if (pattern.type == SPAN_GRID && (!pattern.colors || !pattern.count || pattern.cellW <= 0 || pattern.cellH <= 0)) {
+    return false;
+  }
+  const int32_t left = max(x, (int32_t)0), top = max(y, (int32_t)0);
+  const int32_t right = min(x + w, (int32_t)tft.width()), bottom = min(y + h, (int32_t)tft.height());
+  if (left >= right || top >= bottom) return true;
+
+  const int32_t width = right - left;
+  if (!begin() || (uint32_t)width > bufferPixels) return false;
+  const int32_t bandRows = bufferPixels / width;
+  bufferKey[0] = bufferKey[1] = -1;
+
+  const bool swap = tft.getSwapBytes();
+  tft.setSwapBytes(false);  // Puffer liegt bereits in Display-Byte-Reihenfolge
+  spiArbiter.acquire(device);
+  tft.startWrite();
+  tft.setAddrWindow(left, top, width, bottom - top);
+  counters.windows++;
+
+  uint32_t bands = 0;
+  for (int32_t bandY = top; bandY < bottom; bandY += bandRows) {
+    const int32_t rows = min(bandRows, bottom - bandY);
+    const uint8_t index = bands & 1;
+    uint16_t* pixels = buffers[index];
+
+    // Puffer mit lauter gleichen Zeilen unverändert erneut senden
+    const int32_t firstKey = spanRowKey(pattern, bandY - y);
+    const bool uniform = firstKey == spanRowKey(pattern, bandY + rows - 1 - y);
+    if (uniform && bufferKey[index] == firstKey && bufferRows[index] >= rows) {
+      counters.bandsReused++;
+    } else {
+      int32_t previousKey = -1;
+      for (int32_t row = 0; row < rows; row++) {
+        const int32_t key = spanRowKey(pattern, bandY + row - y);
+        if (row > 0 && key == previousKey) {
+          memcpy(pixels + row * width, pixels + (row - 1) * width, width * sizeof(uint16_t));
+          counters.rowsCopied++;
+        } else {
+          generateRow(pixels + row * width, pattern, left - x, width, bandY + row - y, w, h);
+        }
+        previousKey = key;
+      }
+      bufferKey[index] = uniform ? firstKey : -1;
+      bufferRows[index] = rows;
+    }
+
+    // Zwischen zwei Bändern wartendes Touch-Sample vorlassen, Fenster neu setzen
+    if (bands > 0 && spiArbiter.yieldRequested(device)) {
+      if (useDMA) tft.dmaWait();
+      tft.endWrite();
+      spiArbiter.yield(device);
+      tft.startWrite();
+      tft.setAddrWindow(left, bandY, width, bottom - bandY);
+      counters.windows++;
+    }
+
+    if (useDMA) {
+      tft.pushPixelsDMA(pixels, rows * width);  // Wartet auf den vorherigen Puffer
+    } else {
+      tft.pushPixels(pixels, rows * width);
+    }
+    bands++;
+  }
+
+  if (useDMA) tft.dmaWait();
+  tft.endWrite();
+  spiArbiter.release(device);
+  tft.setSwapBytes(swap);
+
+  counters.fills++;
+  counters.pixels += (uint32_t)width * (bottom - top);
+  return true;
+}
@@ -0,0 +1,110 @@
+/**
+ * span_fill.h - Verläufe, Raster und Farbbalken als Zeilen-Spans
+ *
+ * drawFastVLine()/fillRect() pro Spalte oder Zelle öffnen jedes Mal ein
+ * eigenes Adressfenster. Der Span-Kernel erzeugt die Zeilen stattdessen
+ * in einem DMA-fähigen Zeilenpuffer (zwei Pixel pro 32-Bit-Schreibzugriff,
+ * Display-Byte-Reihenfolge) und streamt alle Zeilen in ein Fenster:
+ *
+ *   hardware.fillSpans(0, 0, 320, 240, spanGradientH(TFT_BLACK, TFT_RED));
+ *
+ * Gleiche Zeilen (Verlauf horizontal, Zellzeilen im Raster) werden
+ * kopiert bzw. ganze Puffer wiederverwendet. Mit DMA wird Puffer N
+ * gefüllt, während Puffer N-1 läuft.
+ */
+
+#ifndef SPAN_FILL_H
+#define SPAN_FILL_H
+
+#include <stdint.h>
+
+class TFT_eSPI;
+struct SpiDevice;
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#ifndef SPAN_FILL_BUFFER_PIXELS
+  #define SPAN_FILL_BUFFER_PIXELS 2048   // Pro Puffer, 2 x 4 KB DMA-RAM
+#endif
+
+// ============================================
+// MUSTER
+// ============================================
+
+enum SpanPatternType : uint8_t {
+  SPAN_GRADIENT_H,      // Farbe ändert sich über die Spalten
+  SPAN_GRADIENT_V,      // Farbe ändert sich über die Zeilen
+  SPAN_GRID             // Zellen: colors[(Spalte + Zeile) % count]
+};
+
+// Verläufe interpolieren je Kanal (8 Bit) von 'from' bei 0 bis 'to' bei
+// Breite bzw. Höhe (exklusiv), also wie color565(x * 255 / w, ...).
+struct SpanPattern {
+  SpanPatternType type;
+  uint16_t from, to;
+  const uint16_t* colors;   // SPAN_GRID, muss bis zum Ende von fill() gültig sein
+  uint8_t count;
+  int16_t cellW, cellH;
+};
+
+inline SpanPattern spanGradientH(uint16_t from, uint16_t to) {
+  return SpanPattern{ SPAN_GRADIENT_H, from, to, nullptr, 0, 0, 0 };
+}
+
+inline SpanPattern spanGradientV(uint16_t from, uint16_t to) {
+  return SpanPattern{ SPAN_GRADIENT_V, from, to, nullptr, 0, 0, 0 };
+}
+
+// Schachbrett mit count = 2, diagonale Farbfolge mit count > 2
+inline SpanPattern spanGrid(const uint16_t* colors, uint8_t count, int16_t cellW, int16_t cellH) {
+  return SpanPattern{ SPAN_GRID, 0, 0, colors, count, cellW, cellH };
+}
+
+// Senkrechte Farbbalken
+inline SpanPattern spanBars(const uint16_t* colors, uint8_t count, int16_t barW) {
+  return spanGrid(colors, count, barW, INT16_MAX);
+}
+
+struct SpanFillStats {
+  uint32_t fills;
+  uint32_t windows;         // 1 pro fill(), + 1 pro Bus-Abgabe an Touch
+  uint32_t pixels;
+  uint32_t rowsGenerated;   // Zeilen neu erzeugt
+  uint32_t rowsCopied;      // Zeilen aus der Vorzeile kopiert
+  uint32_t bandsReused;     // Puffer ohne neues Erzeugen erneut gesendet
+};
+
+// ============================================
+// SPAN FILLER
+// ============================================
+
+class SpanFiller {
+public:
+  explicit SpanFiller(const SpiDevice& display);   // Display am Bus-Arbiter
+
+  bool begin(uint32_t bufferPixels = SPAN_FILL_BUFFER_PIXELS);
+  void end();
+
+  // Rechteck mit Muster füllen, geclippt auf den Bildschirm. Das Muster
+  // bleibt am Rechteck verankert. false = kein Puffer
+  bool fill(TFT_eSPI& tft, int32_t x, int32_t y, int32_t w, int32_t h,
+            const SpanPattern& pattern, bool useDMA);
+
+  const SpanFillStats& stats() const { return counters; }
+  void resetStats() { counters = SpanFillStats(); }
+
+private:
+  const SpiDevice& device;
+  uint16_t* buffers[2];
+  uint32_t bufferPixels;
+  int32_t bufferKey[2];     // Zeilenschlüssel eines einheitlichen Puffers, -1 = gemischt
+  uint16_t bufferRows[2];
+  SpanFillStats counters;
+
+  void generateRow(uint16_t* out, const SpanPattern& pattern, int32_t column, int32_t width,
+                   int32_t row, int32_t rectW, int32_t rectH);
+};
+
+#endif // SPAN_FILL_H
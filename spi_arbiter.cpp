@@ -0,0 +1,244 @@
+/**
+ * spi_arbiter.cpp - SPI Bus-Arbiter
+ */
+
+#include "spi_arbiter.h"
+
+SpiArbiter spiArbiter;
+
+SpiArbiter::SpiArbiter() : lock(nullptr), hosts() {}
+
+bool SpiArbiter::begin() {
+  if (lock) return true;
+
+  for (auto& host : hosts) {
+    for (auto& waiter : host.waiters) {
+      waiter.signal = xSemaphoreCreateBinary();
+      if (!waiter.signal) return false;
+    }
+    host.stats.sinceUs = micros();
+  }
+
+  lock = xSemaphoreCreateMutex();
+  return lock != nullptr;
+}
+
+// Reihenfolge: Priorität, dann früheste Deadline (0 = keine), dann Ankunft
+bool SpiArbiter::before(const Waiter& a, const Waiter& b) {
+  if (a.device->priority != b.device->priority) return a.device->priority > b.device->priority;
+  if (a.deadlineUs && b.deadlineUs && a.deadlineUs != b.deadlineUs) {
+    return (int32_t)(a.deadlineUs - b.deadlineUs) < 0;
+  }
+  if (a.deadlineUs != b.deadlineUs) return a.deadlineUs != 0;
+  return (int32_t)(a.sequence - b.sequence) < 0;
+}
+
+int8_t SpiArbiter::nextWaiter(Host& host) {
+  int8_t best = -1;
+  for (int8_t i = 0; i < SPI_ARBITER_MAX_WAITERS; i++) {
+    if (!host.waiters[i].used) continue;
+    if (best < 0 || before(host.waiters[i], host.waiters[best])) best = i;
+  }
+  return best;
+}
+
+void SpiArbiter::grant(Host& host, const SpiDevice* device, TaskHandle_t task, uint32_t now) {
+  if (host.lastDevice && host.lastDevice != device &&
+      (host.lastDevice->clockHz != device->clockHz || host.lastDevice->mode != device->mode)) {
+    host.stats.switches++;
+  }
+  host.owner = device;
+  host.lastDevice = device;
+  host.ownerTask = task;
+  host.drain = nullptr;
+  host.depth = 1;
+  host.grantedAt = now;
+  host.stats.transactions++;
+}
+
+bool SpiArbiter::acquire(const SpiDevice& device, uint32_t deadlineUs) {
+  if (!lock || device.host >= SPI_ARBITER_HOSTS) return true;  // Vor begin(): kein Arbiter
+
+  Host& host = hosts[device.host];
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  const uint32_t start = micros();
+  int8_t slot = -1;
+
+  while (slot < 0) {
+    xSemaphoreTake(lock, portMAX_DELAY);
+
+    if (!host.owner) {
+      grant(host, &device, self, start);
+      xSemaphoreGive(lock);
+      return true;
+    }
+    if (host.ownerTask == self && host.owner == &device) {
+      host.depth++;  // Verschachtelt im selben Task
+      xSemaphoreGive(lock);
+      return true;
+    }
+    if (host.ownerTask == self) {
+      // Eigener Task hält den Host mit einem anderen Gerät: abschließen
+      // lassen und neu versuchen, ohne Abschluss wäre Warten ein Deadlock
+      SpiDrainFn drain = host.drain;
+      void* context = host.drainContext;
+      const char* holder = host.owner->name;
+      xSemaphoreGive(lock);
+      if (!drain) {
+        Serial.printf("❌ SPI-Arbiter: %s angefordert, derselbe Task hält den Host mit %s\n",
+                      device.name, holder);
+        return false;
+      }
+      drain(context);
+      continue;
+    }
+
+    for (int8_t i = 0; i < SPI_ARBITER_MAX_WAITERS; i++) {
+      if (host.waiters[i].used) continue;
+      Waiter& waiter = host.waiters[i];
+      waiter.device = &device;
+      waiter.deadlineUs = deadlineUs;
+      waiter.sequence = host.sequence++;
+      waiter.used = true;
+      host.stats.contended++;
+      slot = i;
+      break;
+    }
+    xSemaphoreGive(lock);
+
+    if (slot < 0) vTaskDelay(1);  // Alle Plätze belegt
+  }
+
+  // release() übergibt den Bus direkt an diesen Platz
+  xSemaphoreTake(host.waiters[slot].signal, portMAX_DELAY);
+
+  const uint32_t now = micros();
+  const uint32_t waited = now - start;
+  xSemaphoreTake(lock, portMAX_DELAY);
+  host.ownerTask = self;
+  host.stats.waitTotalUs += waited;
+  if (waited > host.stats.waitMaxUs) host.stats.waitMaxUs = waited;
+  if (deadlineUs && (int32_t)(now - deadlineUs) > 0) host.stats.deadlineMisses++;
+  xSemaphoreGive(lock);
+  return true;
+}
+
+void SpiArbiter::release(const SpiDevice& device) {
+  if (!lock || device.host >= SPI_ARBITER_HOSTS) return;
+
+  Host& host = hosts[device.host];
+  xSemaphoreTake(lock, portMAX_DELAY);
+
+  if (host.owner != &device) {
+    xSemaphoreGive(lock);
+    return;
+  }
+  if (--host.depth > 0) {
+    xSemaphoreGive(lock);
+    return;
+  }
+
+  const uint32_t now = micros();
+  host.stats.busyUs += now - host.grantedAt;
+  host.owner = nullptr;
+  host.ownerTask = nullptr;
+  host.drain = nullptr;
+
+  int8_t next = nextWaiter(host);
+  if (next >= 0) {
+    Waiter& waiter = host.waiters[next];
+    grant(host, waiter.device, nullptr, now);  // ownerTask setzt der Wartende selbst
+    waiter.used = false;
+    xSemaphoreGive(waiter.signal);
+  }
+  xSemaphoreGive(lock);
+}
+
+void SpiArbiter::setDrain(const SpiDevice& device, SpiDrainFn drain, void* context) {
+  if (!lock || device.host >= SPI_ARBITER_HOSTS) return;
+
+  Host& host = hosts[device.host];
+  xSemaphoreTake(lock, portMAX_DELAY);
+  if (host.owner == &device && host.ownerTask == xTaskGetCurrentTaskHandle()) {
+    host.drain = drain;
+    host.drainContext = context;
+  }
+  xSemaphoreGive(lock);
+}
+
+bool SpiArbiter::yieldRequested(const SpiDevice& device) {
+  if (!lock || device.host >= SPI_ARBITER_HOSTS) return false;
+
+  Host& host = hosts[device.host];
+  bool requested = false;
+  const uint32_t now = micros();
+
+  xSemaphoreTake(lock, portMAX_DELAY);
+  for (auto& waiter : host.waiters) {
+    if (!waiter.used) continue;
+    if (waiter.device->priority > device.priority ||
+        (waiter.deadlineUs && (int32_t)(now - waiter.deadlineUs) >= 0)) {
+      requested = true;
+      break;
+    }
+  }
+  xSemaphoreGive(lock);
+  return requested;
+}
+
+bool SpiArbiter::yield(const SpiDevice& device) {
+  if (!yieldRequested(device)) return false;
+
+  release(device);
+  acquire(device);
+
+  xSemaphoreTake(lock, portMAX_DELAY);
+  hosts[device.host].stats.yields++;
+  xSemaphoreGive(lock);
+  return true;
+}
+
+SpiBusStats SpiArbiter::getStats(uint8_t host) {
+  SpiBusStats stats = {};
+  if (!lock || host >= SPI_ARBITER_HOSTS) return stats;
+
+  xSemaphoreTake(lock, portMAX_DELAY);
+  stats = hosts[host].stats;
+  if (hosts[host].owner) stats.busyUs += micros() - hosts[host].grantedAt;  // Laufende Belegung
+  xSemaphoreGive(lock);
+  return stats;
+}
+
+float SpiArbiter::getUtilization(uint8_t host) {
+  SpiBusStats stats = getStats(host);
+  uint32_t window = micros() - stats.sinceUs;
+  return window ? stats.busyUs * 100.0f / window : 0.0f;
+}
+
+void SpiArbiter::resetStats() {
+  if (!lock) return;
+
+  xSemaphoreTake(lock, portMAX_DELAY);
+  for (auto& host : hosts) {
+    host.stats = SpiBusStats();
+    host.stats.sinceUs = micros();
+    if (host.owner) host.grantedAt = host.stats.sinceUs;
+  }
+  xSemaphoreGive(lock);
+}
+
+void SpiArbiter::printStats() {
+  for (uint8_t id = 0; id < SPI_ARBITER_HOSTS; id++) {
+    SpiBusStats stats = getStats(id);
+    if (stats.transactions == 0) continue;
+
+    Serial.printf("SPI %s: %.1f%% belegt, %lu Transaktionen (%lu mit Wartezeit)\n",
+                  id == HSPI ? "HSPI" : id == VSPI ? "VSPI" : "Host",
+                  getUtilization(id), (unsigned long)stats.transactions,
+                  (unsigned long)stats.contended);
+    Serial.printf("  Warten: Ø %lu µs, max %lu µs | Yields: %lu | Taktwechsel: %lu | Deadline verpasst: %lu\n",
+                  stats.contended ? (unsigned long)(stats.waitTotalUs / stats.contended) : 0UL,
+                  (unsigned long)stats.waitMaxUs, (unsigned long)stats.yields,
+                  (unsigned long)stats.switches, (unsigned long)stats.deadlineMisses);
+  }
+}
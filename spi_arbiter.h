@@ -0,0 +1,127 @@
+/**
+ * spi_arbiter.h - SPI Bus-Arbiter
+ *
+ * Vergibt jeden physischen SPI-Host (HSPI/VSPI) exklusiv an ein Gerät.
+ * Wartende Geräte werden nach Priorität bedient, bei gleicher Priorität
+ * die früheste Deadline zuerst. Lange Display-Übertragungen rufen
+ * zwischen zwei Chunks yield() auf und geben den Bus ab, sobald ein
+ * dringenderes Gerät wartet - die Touch-Latenz ist so auf einen Chunk
+ * (Flush-Band bzw. DMA-Streifen) begrenzt.
+ *
+ * Takt und Modus setzt SPIClass::beginTransaction() pro Gerät; der
+ * Arbiter garantiert, dass sich Transaktionen auf einem Host nicht
+ * überlappen, und zählt die dabei nötigen Takt-/Moduswechsel.
+ *
+ * Ein Besitzer, der den Host nur noch für laufenden DMA hält (Strip-
+ * Renderer nach render()), hinterlegt mit setDrain() eine Abschluss-
+ * Funktion. Fordert derselbe Task ein anderes Gerät am Host an, schließt
+ * acquire() damit zuerst ab, statt auf sich selbst zu warten.
+ */
+
+#ifndef SPI_ARBITER_H
+#define SPI_ARBITER_H
+
+#include <Arduino.h>
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define SPI_ARBITER_HOSTS        4   // Host-IDs 0..3 (ESP32: HSPI = 2, VSPI = 3)
+#define SPI_ARBITER_MAX_WAITERS  4   // Gleichzeitig wartende Tasks pro Host
+
+enum SpiPriority : uint8_t {
+  SPI_PRIORITY_BULK = 0,       // Hintergrund (Assets, Screenshots)
+  SPI_PRIORITY_NORMAL = 1,     // Display
+  SPI_PRIORITY_REALTIME = 2    // Touch-Samples
+};
+
+// ============================================
+// DATENSTRUKTUREN
+// ============================================
+
+// Schließt die laufende Übertragung des Besitzers ab und ruft release()
+typedef void (*SpiDrainFn)(void* context);
+
+struct SpiDevice {
+  const char* name;
+  uint8_t host;        // HSPI / VSPI
+  uint8_t priority;    // SpiPriority
+  uint32_t clockHz;
+  uint8_t mode;        // SPI_MODE0..3
+};
+
+struct SpiBusStats {
+  uint32_t transactions;    // Vergaben des Busses
+  uint32_t contended;       // davon mit Wartezeit
+  uint32_t yields;          // Chunk-Grenzen, an denen abgegeben wurde
+  uint32_t switches;        // Takt-/Moduswechsel zwischen Geräten
+  uint32_t deadlineMisses;  // Bus erst nach der Deadline erhalten
+  uint32_t waitMaxUs;
+  uint64_t waitTotalUs;
+  uint64_t busyUs;          // Summe der Belegungszeiten
+  uint32_t sinceUs;         // Beginn des Messfensters
+};
+
+// ============================================
+// ARBITER
+// ============================================
+
+class SpiArbiter {
+public:
+  SpiArbiter();
+  bool begin();
+
+  // Blockiert bis der Host frei ist. deadlineUs (micros()) 0 = keine.
+  // false = derselbe Task hält den Host mit einem anderen Gerät ohne
+  // Abschluss-Funktion (Warten wäre ein Deadlock)
+  bool acquire(const SpiDevice& device, uint32_t deadlineUs = 0);
+  void release(const SpiDevice& device);
+
+  // Nur der Besitzer: Abschluss-Funktion bis zum release() hinterlegen
+  void setDrain(const SpiDevice& device, SpiDrainFn drain, void* context);
+
+  // Wartet ein Gerät mit höherer Priorität oder abgelaufener Deadline?
+  bool yieldRequested(const SpiDevice& device);
+  // Bus kurz abgeben und wieder anfordern, true = wurde abgegeben.
+  // Der Aufrufer beendet vorher seine Transaktion (endWrite).
+  bool yield(const SpiDevice& device);
+
+  SpiBusStats getStats(uint8_t host);
+  float getUtilization(uint8_t host);   // Prozent seit resetStats()
+  void resetStats();
+  void printStats();
+
+private:
+  struct Waiter {
+    SemaphoreHandle_t signal;   // Übergabe des Busses an genau diesen Wartenden
+    const SpiDevice* device;
+    uint32_t deadlineUs;
+    uint32_t sequence;
+    bool used;
+  };
+
+  struct Host {
+    const SpiDevice* owner;
+    const SpiDevice* lastDevice;
+    TaskHandle_t ownerTask;
+    SpiDrainFn drain;           // Abschluss des Besitzers (setDrain), nullptr = keiner
+    void* drainContext;
+    uint8_t depth;
+    uint32_t grantedAt;
+    uint32_t sequence;
+    Waiter waiters[SPI_ARBITER_MAX_WAITERS];
+    SpiBusStats stats;
+  };
+
+  SemaphoreHandle_t lock;
+  Host hosts[SPI_ARBITER_HOSTS];
+
+  void grant(Host& host, const SpiDevice* device, TaskHandle_t task, uint32_t now);
+  int8_t nextWaiter(Host& host);
+  static bool before(const Waiter& a, const Waiter& b);
+};
+
+extern SpiArbiter spiArbiter;
+
+#endif // SPI_ARBITER_H
@@ -0,0 +1,77 @@
+/**
+ * spsc_ring.h - Lock-freier Single-Producer/Single-Consumer Ringpuffer
+ *
+ * Genau ein Schreiber (z.B. Sampling-Task) und genau ein Leser
+ * (z.B. loop()) dürfen ohne Mutex gleichzeitig zugreifen.
+ * Kapazität muss eine Zweierpotenz sein. Bei vollem Puffer wird das
+ * neue Element verworfen und gezählt (dropped()).
+ *
+ * Reines C++ (std::atomic) - auch auf dem Host verwendbar.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+template <typename T, size_t Capacity>
+class SpscRing {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "SpscRing: Kapazität muss eine Zweierpotenz sein");
+
+private:
+  T items[Capacity];
+  std::atomic<uint32_t> head;     // Nur vom Producer geschrieben
+  std::atomic<uint32_t> tail;     // Nur vom Consumer geschrieben
+  std::atomic<uint32_t> overflow; // Nur vom Producer geschrieben
+
+public:
+  SpscRing() : head(0), tail(0), overflow(0) {}
+
+  // Producer-Seite
+  bool push(const T& item) {
+    const uint32_t h = head.load(std::memory_order_relaxed);
+    const uint32_t t = tail.load(std::memory_order_acquire);
+    if (h - t >= Capacity) {
+      overflow.store(overflow.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return false;
+    }
+    items[h & (Capacity - 1)] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer-Seite: bis zu 'maxItems' Elemente am Stück entnehmen
+  size_t pop(T* out, size_t maxItems) {
+    const uint32_t t = tail.load(std::memory_order_relaxed);
+    const uint32_t h = head.load(std::memory_order_acquire);
+    size_t count = h - t;
+    if (count > maxItems) count = maxItems;
+    for (size_t i = 0; i < count; i++) {
+      out[i] = items[(t + i) & (Capacity - 1)];
+    }
+    tail.store(t + count, std::memory_order_release);
+    return count;
+  }
+
+  bool pop(T* out) {
+    return pop(out, 1) == 1;
+  }
+
+  // Consumer-Seite: alles verwerfen
+  void clear() {
+    tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+  size_t size() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+
+  bool empty() const { return size() == 0; }
+  static constexpr size_t capacity() { return Capacity; }
+  uint32_t dropped() const { return overflow.load(std::memory_order_relaxed); }
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,163 @@
+/**
+ * strip_renderer.cpp - DMA Ping-Pong Strip-Renderer
+ */
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <esp_heap_caps.h>
+#include "strip_renderer.h"
+#include "spi_arbiter.h"
+
+StripRenderer::StripRenderer()
+  : tft(nullptr), device(nullptr), buffers{ nullptr, nullptr }, width(0), stripRows(0), bufferPixels(0),
+    dmaAvailable(false), dmaActive(false), writing(false), swapBytes(false),
+    submitted(0), completed(0), frameStart(0), frameStats() {}
+
+bool StripRenderer::begin(TFT_eSPI* display, const SpiDevice* bus, bool useDMA, uint16_t maxRows,
+                          uint8_t ramShare) {
+  end();
+  tft = display;
+  device = bus;
+  dmaAvailable = useDMA;
+  dmaActive = useDMA;
+
+  // Streifenhöhe aus freiem internem DMA-RAM (Breite rotationsunabhängig)
+  const int16_t maxWidth = max(tft->width(), tft->height());
+  const uint32_t budget = heap_caps_get_largest_free_block(MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL) / ramShare;
+  uint32_t rows = budget / (2UL * maxWidth * sizeof(uint16_t));
+  if (rows > maxRows) rows = maxRows;
+  if (rows < STRIP_MIN_ROWS) {
+    Serial.printf("❌ Strip-Renderer: zu wenig DMA-RAM (%lu Bytes)\n", (unsigned long)budget);
+    return false;
+  }
+  stripRows = rows;
+  bufferPixels = (uint32_t)maxWidth * stripRows;
+
+  if (!allocate(tft->width())) {
+    Serial.println("❌ Strip-Renderer: Puffer konnten nicht angelegt werden");
+    stripRows = 0;
+    bufferPixels = 0;
+    return false;
+  }
+
+  Serial.printf("Strip-Renderer: 2 x %d Zeilen (%lu Bytes), %s\n", stripRows,
+                (unsigned long)(2 * bufferPixels * sizeof(uint16_t)),
+                dmaActive ? "DMA Ping-Pong" : "blockierend");
+  return true;
+}
+
+void StripRenderer::end() {
+  sync();
+  release();
+  stripRows = 0;
+}
+
+bool StripRenderer::allocate(int16_t newWidth) {
+  release();
+  for (int i = 0; i < 2; i++) {
+    buffers[i] = new TFT_eSprite(tft);
+    buffers[i]->setColorDepth(16);
+    buffers[i]->setAttribute(PSRAM_ENABLE, false);  // PSRAM ist nicht DMA-fähig
+    if (!buffers[i]->createSprite(newWidth, bufferPixels / newWidth)) {
+      release();
+      return false;
+    }
+  }
+  width = newWidth;
+  return true;
+}
+
+void StripRenderer::release() {
+  for (int i = 0; i < 2; i++) {
+    if (!buffers[i]) continue;
+    buffers[i]->deleteSprite();
+    delete buffers[i];
+    buffers[i] = nullptr;
+  }
+  width = 0;
+}
+
+uint32_t StripRenderer::render(DamageRenderFn render, void* context, int16_t y, int16_t h) {
+  if (!tft || stripRows == 0) return 0;
+  sync();  // Vorheriger Frame muss vollständig draußen sein
+
+  // Rotationswechsel: Puffer auf die neue Breite umlegen (gleiche Pixelzahl)
+  if (tft->width() != width && !allocate(tft->width())) return 0;
+
+  const int16_t bottom = min((int16_t)(y + h), (int16_t)tft->height());
+  const uint16_t bandRows = bufferPixels / width;
+  uint32_t renderMicros = 0;
+  uint32_t strips = 0;
+
+  frameStart = micros();
+  swapBytes = tft->getSwapBytes();
+  tft->setSwapBytes(false);  // Sprite-Puffer liegt bereits in Display-Byte-Reihenfolge
+  spiArbiter.acquire(*device);
+  tft->startWrite();
+  writing = true;
+
+  for (int16_t bandY = y; bandY < bottom; bandY += bandRows) {
+    const int16_t rows = min((int16_t)bandRows, (int16_t)(bottom - bandY));
+    TFT_eSprite* canvas = buffers[strips & 1];
+
+    // Zeichnen, während der andere Puffer noch per DMA läuft
+    uint32_t start = micros();
+    canvas->setViewport(0, -bandY, width, bandY + rows, true);
+    render(*canvas, context);
+    canvas->resetViewport();
+    renderMicros += micros() - start;
+
+    // Chunk-Grenze: laufenden Streifen abschließen und wartendes Touch-Sample vorlassen
+    if (spiArbiter.yieldRequested(*device)) {
+      if (dmaActive) tft->dmaWait();
+      tft->endWrite();
+      spiArbiter.yield(*device);
+      tft->startWrite();
+    }
+
+    uint16_t* pixels = (uint16_t*)canvas->getPointer();
+    if (dmaActive) {
+      tft->pushImageDMA(0, bandY, width, rows, pixels);  // Wartet auf den vorherigen Streifen
+    } else {
+      tft->pushImage(0, bandY, width, rows, pixels);
+    }
+    strips++;
+  }
+
+  frameStats.strips = strips;
+  frameStats.renderMicros = renderMicros;
+  submitted++;
+  if (!dmaActive) {
+    complete();
+  } else {
+    spiArbiter.setDrain(*device, drainFrame, this);  // Touch im selben Task vor waitFrame()
+  }
+  return submitted;
+}
+
+void StripRenderer::drainFrame(void* renderer) {
+  ((StripRenderer*)renderer)->complete();
+}
+
+void StripRenderer::complete() {
+  if (!writing) return;
+  if (dmaActive) tft->dmaWait();
+  tft->endWrite();
+  spiArbiter.release(*device);
+  tft->setSwapBytes(swapBytes);
+  writing = false;
+  completed = submitted;
+  frameStats.frames++;
+  frameStats.frameMicros = micros() - frameStart;
+}
+
+bool StripRenderer::poll(uint32_t fence) {
+  if (fence <= completed) return true;
+  if (writing && !tft->dmaBusy()) complete();
+  return fence <= completed;
+}
+
+void StripRenderer::wait(uint32_t fence) {
+  if (fence <= completed) return;
+  complete();
+}
@@ -0,0 +1,86 @@
+/**
+ * strip_renderer.h - DMA Ping-Pong Strip-Renderer
+ *
+ * Rendert einen Bildschirmbereich in Streifen voller Breite. Zwei
+ * DMA-fähige Puffer wechseln sich ab: die CPU zeichnet Streifen N,
+ * während Streifen N-1 per pushImageDMA übertragen wird.
+ *
+ * render() liefert einen Fence. Erst wenn poll()/wait() für diesen
+ * Fence true melden, ist der Frame vollständig auf dem Display und
+ * der SPI-Bus wieder frei. Bis dahin hält der Renderer den Host (CS
+ * bleibt für den letzten DMA-Streifen low); fordert derselbe Task ein
+ * anderes Gerät am Host an (Touch), schließt der Arbiter den Frame
+ * vorher über drainFrame() ab. Ohne DMA (HW_DISPLAY_DMA false oder
+ * initDMA fehlgeschlagen) wird blockierend übertragen, der Fence ist
+ * dann sofort erreicht.
+ */
+
+#ifndef STRIP_RENDERER_H
+#define STRIP_RENDERER_H
+
+#include <stdint.h>
+#include "damage_tracker.h"  // DamageRenderFn
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define STRIP_MIN_ROWS  8   // Darunter lohnt sich Ping-Pong nicht
+
+struct StripRendererStats {
+  uint32_t frames;
+  uint32_t strips;          // Streifen im letzten Frame
+  uint32_t renderMicros;    // CPU-Zeit im Render-Callback (letzter Frame)
+  uint32_t frameMicros;     // Start bis Fence erreicht (letzter Frame)
+};
+
+// ============================================
+// STRIP RENDERER
+// ============================================
+
+class StripRenderer {
+public:
+  StripRenderer();
+
+  // Puffer anlegen. bus: Display am Bus-Arbiter, maxRows: Profil-Obergrenze,
+  // ramShare: höchstens 1/ramShare des größten freien DMA-Blocks für beide Puffer
+  bool begin(TFT_eSPI* display, const SpiDevice* bus, bool useDMA, uint16_t maxRows, uint8_t ramShare);
+  void end();
+
+  // Bereich [y, y+h) in voller Breite rendern und übertragen
+  uint32_t render(DamageRenderFn render, void* context, int16_t y, int16_t h);
+
+  bool poll(uint32_t fence);   // true = Frame vollständig übertragen
+  void wait(uint32_t fence);
+  void sync() { wait(submitted); }
+
+  bool isDMA() const { return dmaActive; }
+  void setDMA(bool enable) { sync(); dmaActive = enable && dmaAvailable; }
+  bool isDMAAvailable() const { return dmaAvailable; }
+  uint16_t rows() const { return stripRows; }
+  bool ready() const { return stripRows > 0; }   // false = begin() fehlgeschlagen
+  const StripRendererStats& stats() const { return frameStats; }
+
+private:
+  TFT_eSPI* tft;
+  const SpiDevice* device;
+  TFT_eSprite* buffers[2];
+  int16_t width;
+  uint16_t stripRows;
+  uint32_t bufferPixels;    // Pixel pro Puffer (für Breitenwechsel)
+  bool dmaAvailable;
+  bool dmaActive;
+  bool writing;             // startWrite() aktiv, Frame in Übertragung
+  bool swapBytes;
+  uint32_t submitted;
+  uint32_t completed;
+  uint32_t frameStart;
+  StripRendererStats frameStats;
+
+  bool allocate(int16_t newWidth);
+  void release();
+  void complete();
+  static void drainFrame(void* renderer);
+};
+
+#endif // STRIP_RENDERER_H
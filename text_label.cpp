@@ -0,0 +1,89 @@
+/**
+ * text_label.cpp - Zellenweiser Vergleich und Teil-Neuzeichnen
+ */
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <string.h>
+#include "text_label.h"
+#include "glyph_atlas.h"
+#include "damage_tracker.h"  // DAMAGE_WINDOW_BYTES
+
+TextLabel::TextLabel(int16_t x, int16_t y, uint8_t font, uint16_t fg, uint16_t bg)
+  : x(x), y(y), font(font), fg(fg), bg(bg), valid(false), length(0), shown(), advance(),
+    counters() {}
+
+void TextLabel::setPosition(int16_t newX, int16_t newY) {
+  if (newX == x && newY == y) return;
+  x = newX;
+  y = newY;
+  valid = false;
+}
+
+void TextLabel::setColors(uint16_t newFg, uint16_t newBg) {
+  if (newFg == fg && newBg == bg) return;
+  fg = newFg;
+  bg = newBg;
+  valid = false;
+}
+
+uint8_t TextLabel::update(TFT_eSPI& tft, GlyphAtlas& atlas, const char* text) {
+  // Neuer Text mit Glyphen-Positionen (Proportional-Fonts: eine breitere
+  // Ziffer verschiebt alles dahinter)
+  char next[TEXT_LABEL_MAX_CHARS + 1];
+  int16_t position[TEXT_LABEL_MAX_CHARS + 1];
+  uint8_t nextLength = 0;
+  position[0] = 0;
+  while (text[nextLength] && nextLength < TEXT_LABEL_MAX_CHARS) {
+    const char glyph[2] = { text[nextLength], '\0' };
+    next[nextLength] = text[nextLength];
+    position[nextLength + 1] = position[nextLength] + tft.textWidth(glyph, font);
+    nextLength++;
+  }
+  next[nextLength] = '\0';
+
+  const uint64_t atlasBytes = atlas.stats().bytes;
+  uint32_t bytes = 0;
+  uint8_t cells = 0;
+
+  // Läufe geänderter Zellen zeichnen
+  uint8_t i = 0;
+  while (i < nextLength) {
+    uint8_t end = i;
+    while (end < nextLength &&
+           !(valid && end < length && shown[end] == next[end] &&
+             advance[end] == position[end] && advance[end + 1] == position[end + 1])) {
+      end++;
+    }
+    if (end == i) {
+      i++;
+      continue;
+    }
+    const char saved = next[end];
+    next[end] = '\0';
+    atlas.drawString(tft, next + i, x + position[i], y, font, fg, bg);
+    next[end] = saved;
+    cells += end - i;
+    i = end;
+  }
+
+  // Überstand des alten Textes mit Hintergrund füllen
+  const int16_t oldWidth = valid ? advance[length] : 0;
+  if (oldWidth > position[nextLength]) {
+    const int16_t height = tft.fontHeight(font);
+    tft.fillRect(x + position[nextLength], y, oldWidth - position[nextLength], height, bg);
+    bytes += (uint32_t)(oldWidth - position[nextLength]) * height * 2 + DAMAGE_WINDOW_BYTES;
+  }
+  bytes += (uint32_t)(atlas.stats().bytes - atlasBytes);
+
+  memcpy(shown, next, nextLength + 1);
+  memcpy(advance, position, (nextLength + 1) * sizeof(int16_t));
+  length = nextLength;
+  valid = true;
+
+  counters.updates++;
+  counters.cells += cells;
+  counters.lastBytes = bytes;
+  counters.totalBytes += bytes;
+  return cells;
+}
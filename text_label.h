@@ -0,0 +1,62 @@
+/**
+ * text_label.h - Textfeld, das nur geänderte Zeichen neu zeichnet
+ *
+ * Das Label merkt sich den zuletzt gezeigten Text, Font, Farben und die
+ * x-Position jeder Glyphe. update() vergleicht Zelle für Zelle: nur
+ * Zeichen, die sich selbst oder deren Position sich geändert hat,
+ * werden mit deckendem Hintergrund über den Glyphen-Atlas gezeichnet
+ * (ein Fenster pro zusammenhängendem Lauf). Wird der Text kürzer, füllt
+ * ein Rechteck nur den überstehenden Rest. Vorher wird nichts gelöscht,
+ * es flackert nicht.
+ *
+ *   static TextLabel samples(10, 25, 2, TFT_WHITE, TFT_BLACK);
+ *   hardware.updateLabel(samples, "Samples: 17");   // "17" -> "18": 1 Zelle
+ *
+ * Nach fillScreen() o.ä. invalidate(): das nächste update() zeichnet
+ * den ganzen Text. Textgröße 1, Ursprung oben links.
+ */
+
+#ifndef TEXT_LABEL_H
+#define TEXT_LABEL_H
+
+#include <stdint.h>
+
+#define TEXT_LABEL_MAX_CHARS  40   // Länger wird abgeschnitten
+
+struct TextLabelStats {
+  uint32_t updates;
+  uint32_t cells;          // Neu gezeichnete Zeichen
+  uint32_t lastBytes;      // SPI-Bytes des letzten update()
+  uint64_t totalBytes;
+};
+
+class TFT_eSPI;
+class GlyphAtlas;
+
+class TextLabel {
+public:
+  TextLabel(int16_t x, int16_t y, uint8_t font, uint16_t fg, uint16_t bg);
+
+  void setPosition(int16_t x, int16_t y);
+  void setColors(uint16_t fg, uint16_t bg);
+  void invalidate() { valid = false; }
+
+  // Zeichnet die Differenz zum letzten Text, liefert die Zahl der Zellen
+  uint8_t update(TFT_eSPI& tft, GlyphAtlas& atlas, const char* text);
+
+  const char* text() const { return shown; }
+  int16_t width() const { return valid ? advance[length] : 0; }
+  const TextLabelStats& stats() const { return counters; }
+
+private:
+  int16_t x, y;
+  uint8_t font;
+  uint16_t fg, bg;
+  bool valid;
+  uint8_t length;
+  char shown[TEXT_LABEL_MAX_CHARS + 1];
+  int16_t advance[TEXT_LABEL_MAX_CHARS + 1];  // x-Offset je Zeichen, [length] = Breite
+  TextLabelStats counters;
+};
+
+#endif // TEXT_LABEL_H
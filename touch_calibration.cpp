@@ -0,0 +1,50 @@
+/**
+ * touch_calibration.cpp - NVS Persistenz der Touch-Kalibrierung
+ */
+
+#include "config.h"
+#include "hardware_hal.h"
+#include "touch_calibration.h"
+#include <Preferences.h>
+
+bool touchCalibrationLoad(TouchCalibrationData* data) {
+  Preferences prefs;
+  if (!prefs.begin(TOUCH_CAL_NVS_NAMESPACE, true)) {
+    return false;
+  }
+
+  size_t length = prefs.getBytes(TOUCH_CAL_NVS_KEY, data, sizeof(TouchCalibrationData));
+  prefs.end();
+
+  if (length != sizeof(TouchCalibrationData)) {
+    return false;
+  }
+
+  if (!touchCalIsValid(*data)) {
+    Serial.println("Touch-Kalibrierung in NVS ungültig (Version/CRC) - verwende Profil-Werte");
+    return false;
+  }
+  return true;
+}
+
+bool touchCalibrationSave(TouchCalibrationData* data) {
+  data->version = TOUCH_CAL_VERSION;
+  data->crc = touchCalChecksum(*data);
+
+  Preferences prefs;
+  if (!prefs.begin(TOUCH_CAL_NVS_NAMESPACE, false)) {
+    return false;
+  }
+
+  size_t written = prefs.putBytes(TOUCH_CAL_NVS_KEY, data, sizeof(TouchCalibrationData));
+  prefs.end();
+  return written == sizeof(TouchCalibrationData);
+}
+
+void touchCalibrationClear() {
+  Preferences prefs;
+  if (prefs.begin(TOUCH_CAL_NVS_NAMESPACE, false)) {
+    prefs.remove(TOUCH_CAL_NVS_KEY);
+    prefs.end();
+  }
+}
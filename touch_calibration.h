@@ -0,0 +1,230 @@
+/**
+ * touch_calibration.h - Affine Touch-Kalibrierung
+ *
+ * Aus 3 oder 5 Zielpunkten (gemittelte Rohwerte + Soll-Position)
+ * wird per Least-Squares eine affine Matrix gelöst. Sie deckt
+ * Skalierung, Offset, Rotation, Scherung und Achsentausch in einem
+ * Schritt ab und ersetzt die Compile-Time Konstanten des Profils.
+ *
+ * Persistenz: NVS-Blob mit Version und CRC32 (touch_calibration.cpp).
+ * Solver, Mittelung und CRC sind reines C++ ohne Arduino-Abhängigkeit.
+ */
+
+#ifndef TOUCH_CALIBRATION_H
+#define TOUCH_CALIBRATION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "touch_transform.h"
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define TOUCH_CAL_VERSION       1
+#define TOUCH_CAL_MAX_POINTS    5
+#define TOUCH_CAL_MAX_SAMPLES   32   // Rohwerte pro Zielpunkt
+#define TOUCH_CAL_MIN_SAMPLES   8    // Mindestens nötig für einen Zielpunkt
+#define TOUCH_CAL_MARGIN        20   // Abstand der Ziele vom Rand (Pixel)
+#define TOUCH_CAL_NVS_NAMESPACE "hw_touch"
+#define TOUCH_CAL_NVS_KEY       "cal"
+
+// ============================================
+// DATENSTRUKTUREN
+// ============================================
+
+// Ein Zielpunkt: gemittelter Rohwert + Soll-Bildschirmposition
+struct TouchCalPoint {
+  int32_t rawX, rawY;
+  int32_t screenX, screenY;
+};
+
+// Persistierter Datensatz (NVS-Blob)
+struct TouchCalibrationData {
+  uint16_t version;
+  uint8_t rotation;           // Rotation während der Kalibrierung
+  uint8_t points;             // Anzahl verwendeter Zielpunkte (3 oder 5)
+  TouchTransform transform;   // Gelöste Matrix für 'rotation'
+  uint32_t crc;               // CRC32 über alle vorherigen Bytes
+};
+
+// ============================================
+// ZIELPUNKTE
+// ============================================
+
+// Position des Zielpunkts 'index' für 3 bzw. 5 Punkte
+// 3 Punkte: oben links, oben rechts, unten Mitte (nicht kollinear)
+// 5 Punkte: vier Ecken + Mitte
+inline void touchCalTarget(int index, int count, int16_t width, int16_t height,
+                           int32_t* x, int32_t* y) {
+  const int32_t l = TOUCH_CAL_MARGIN, r = width - 1 - TOUCH_CAL_MARGIN;
+  const int32_t t = TOUCH_CAL_MARGIN, b = height - 1 - TOUCH_CAL_MARGIN;
+
+  if (count == 3) {
+    switch (index) {
+      case 0:  *x = l;         *y = t; break;
+      case 1:  *x = r;         *y = t; break;
+      default: *x = width / 2; *y = b; break;
+    }
+    return;
+  }
+
+  switch (index) {
+    case 0:  *x = l;         *y = t;          break;
+    case 1:  *x = r;         *y = t;          break;
+    case 2:  *x = r;         *y = b;          break;
+    case 3:  *x = l;         *y = b;          break;
+    default: *x = width / 2; *y = height / 2; break;
+  }
+}
+
+// ============================================
+// MITTELUNG
+// ============================================
+
+// Getrimmter Mittelwert: sortiert und verwirft je ein Viertel oben/unten,
+// damit einzelne Ausreißer (Prellen, Abheben) das Ergebnis nicht verfälschen.
+// Sortiert 'values' in-place.
+inline int32_t touchCalTrimmedMean(int16_t* values, int count) {
+  if (count <= 0) return 0;
+
+  for (int i = 1; i < count; i++) {
+    int16_t v = values[i];
+    int j = i - 1;
+    while (j >= 0 && values[j] > v) {
+      values[j + 1] = values[j];
+      j--;
+    }
+    values[j + 1] = v;
+  }
+
+  const int trim = count / 4;
+  int32_t sum = 0;
+  for (int i = trim; i < count - trim; i++) sum += values[i];
+  return sum / (count - 2 * trim);
+}
+
+// ============================================
+// SOLVER
+// ============================================
+
+// Least-Squares Lösung von  screen = a*rawX + b*rawY + c  für X und Y.
+// Bei 3 Punkten exakt, bei 5 Punkten ausgleichend.
+// false, wenn die Punkte (nahezu) kollinear sind.
+inline bool touchCalSolve(const TouchCalPoint* pts, int count,
+                          int16_t width, int16_t height, TouchTransform* out) {
+  if (count < 3) return false;
+
+  // Normalengleichungen, Rohwerte um den Schwerpunkt zentriert (numerisch stabiler)
+  double mx = 0, my = 0;
+  for (int i = 0; i < count; i++) { mx += pts[i].rawX; my += pts[i].rawY; }
+  mx /= count;
+  my /= count;
+
+  double sxx = 0, sxy = 0, syy = 0;
+  double sxX = 0, syX = 0, sX = 0;
+  double sxY = 0, syY = 0, sY = 0;
+  for (int i = 0; i < count; i++) {
+    const double x = pts[i].rawX - mx, y = pts[i].rawY - my;
+    sxx += x * x; sxy += x * y; syy += y * y;
+    sxX += x * pts[i].screenX; syX += y * pts[i].screenX; sX += pts[i].screenX;
+    sxY += x * pts[i].screenY; syY += y * pts[i].screenY; sY += pts[i].screenY;
+  }
+
+  const double det = sxx * syy - sxy * sxy;
+  if (det < 1e-6 * (sxx * syy + 1.0)) return false;
+
+  const double a = (sxX * syy - syX * sxy) / det;
+  const double b = (syX * sxx - sxX * sxy) / det;
+  const double d = (sxY * syy - syY * sxy) / det;
+  const double e = (syY * sxx - sxY * sxy) / det;
+  const double c = sX / count - a * mx - b * my;
+  const double f = sY / count - d * mx - e * my;
+
+  // Q16, +0x8000 im Offset: Rundung auf den nächsten Pixel
+  out->xx = (int32_t)(a * 65536.0 + (a < 0 ? -0.5 : 0.5));
+  out->xy = (int32_t)(b * 65536.0 + (b < 0 ? -0.5 : 0.5));
+  out->x0 = (int32_t)(c * 65536.0 + 0x8000);
+  out->yx = (int32_t)(d * 65536.0 + (d < 0 ? -0.5 : 0.5));
+  out->yy = (int32_t)(e * 65536.0 + (e < 0 ? -0.5 : 0.5));
+  out->y0 = (int32_t)(f * 65536.0 + 0x8000);
+  out->maxX = width - 1;
+  out->maxY = height - 1;
+  return true;
+}
+
+// Größter Restfehler (Pixel) der Matrix über alle Zielpunkte
+inline int32_t touchCalMaxError(const TouchCalPoint* pts, int count, const TouchTransform& t) {
+  int32_t worst = 0;
+  for (int i = 0; i < count; i++) {
+    int x, y;
+    t.apply(pts[i].rawX, pts[i].rawY, &x, &y);
+    int32_t dx = x - pts[i].screenX, dy = y - pts[i].screenY;
+    if (dx < 0) dx = -dx;
+    if (dy < 0) dy = -dy;
+    if (dx > worst) worst = dx;
+    if (dy > worst) worst = dy;
+  }
+  return worst;
+}
+
+// ============================================
+// ROTATION
+// ============================================
+
+// Matrix von der Kalibrier-Rotation auf eine andere Rotation übertragen.
+// Ein Rotationsschritt (TFT_eSPI, ILI9341/ST7789): (x, y) -> (y, w-1-x)
+inline TouchTransform touchCalRotate(TouchTransform t, uint8_t fromRotation, uint8_t toRotation) {
+  uint8_t steps = (toRotation - fromRotation) & 3;
+  while (steps--) {
+    const int32_t w = t.maxX + 1;
+    TouchTransform n;
+    n.xx = t.yx;
+    n.xy = t.yy;
+    n.x0 = t.y0;
+    // Offset enthält +0x8000 Rundung: bei Negation erneut ausgleichen
+    n.yx = -t.xx;
+    n.yy = -t.xy;
+    n.y0 = ((w - 1) << 16) - t.x0 + 0x10000;
+    n.maxX = t.maxY;
+    n.maxY = t.maxX;
+    t = n;
+  }
+  return t;
+}
+
+// ============================================
+// CRC & VALIDIERUNG
+// ============================================
+
+inline uint32_t touchCalCrc32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+inline uint32_t touchCalChecksum(const TouchCalibrationData& data) {
+  return touchCalCrc32((const uint8_t*)&data, offsetof(TouchCalibrationData, crc));
+}
+
+inline bool touchCalIsValid(const TouchCalibrationData& data) {
+  return data.version == TOUCH_CAL_VERSION &&
+         data.rotation < 4 &&
+         data.points >= 3 && data.points <= TOUCH_CAL_MAX_POINTS &&
+         data.crc == touchCalChecksum(data);
+}
+
+// ============================================
+// NVS PERSISTENZ (touch_calibration.cpp)
+// ============================================
+
+bool touchCalibrationLoad(TouchCalibrationData* data);
+bool touchCalibrationSave(TouchCalibrationData* data);  // Setzt Version + CRC
+void touchCalibrationClear();
+
+#endif // TOUCH_CALIBRATION_H
@@ -0,0 +1,129 @@
+/**
+ * touch_filter.h - Touch Rauschfilter (Rohwert-Ebene)
+ *
+ * Sitzt zwischen dem XPT2046-Auslesen und der Koordinaten-Transformation.
+ * Stufen (jeweils über das Profil abschaltbar):
+ *
+ *   1. Druck-Gate   z < HW_TOUCH_THRESHOLD  -> nicht gedrückt
+ *   2. Median-of-N  N = 1/3/5, verwirft einzelne Ausreißer
+ *   3. IIR-Glättung y += (x - y) >> shift   (Q4 intern)
+ *   4. Dead-Band    Ausgabe folgt erst ab einer Mindeständerung
+ *
+ * Nur Integer-Arithmetik, feste Kosten pro Stufe (Sortiernetz statt Sortieren).
+ * Reines C++ - auch auf dem Host verwendbar.
+ */
+
+#ifndef TOUCH_FILTER_H
+#define TOUCH_FILTER_H
+
+#include <stdint.h>
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define TOUCH_FILTER_MAX_MEDIAN 5
+
+struct TouchFilterConfig {
+  uint16_t threshold;  // Mindestdruck (0 = Gate aus)
+  uint8_t median;      // Fenstergröße 1, 3 oder 5 (1 = aus)
+  uint8_t iirShift;    // Glättung: 0 = aus, 1 = 1/2, 2 = 1/4, ...
+  uint8_t deadband;    // Rohwert-Einheiten (0 = aus)
+};
+
+// ============================================
+// FILTER
+// ============================================
+
+class TouchFilter {
+public:
+  explicit TouchFilter(const TouchFilterConfig& config) : cfg(config) {
+    if (cfg.median != 1 && cfg.median != 3 && cfg.median != 5) cfg.median = 1;
+    reset();
+  }
+
+  // Bei Pen-Up aufrufen: nächste Berührung startet ohne Verlauf
+  void reset() {
+    primed = false;
+  }
+
+  const TouchFilterConfig& config() const { return cfg; }
+
+  // false = Druck zu gering (Berührung verworfen, Filter zurückgesetzt)
+  bool process(int16_t rawX, int16_t rawY, uint16_t z, int16_t* outX, int16_t* outY) {
+    // 1. Druck-Gate
+    if (z < cfg.threshold || z == 0) {
+      primed = false;
+      return false;
+    }
+
+    if (!primed) {
+      // Fenster und Zustände mit dem ersten Wert füllen - keine Einschwingphase
+      for (uint8_t i = 0; i < TOUCH_FILTER_MAX_MEDIAN; i++) {
+        windowX[i] = rawX;
+        windowY[i] = rawY;
+      }
+      windowPos = 0;
+      smoothX = (int32_t)rawX << 4;
+      smoothY = (int32_t)rawY << 4;
+      outputX = rawX;
+      outputY = rawY;
+      primed = true;
+    }
+
+    // 2. Median-of-N
+    windowX[windowPos] = rawX;
+    windowY[windowPos] = rawY;
+    windowPos = (windowPos + 1) % cfg.median;
+    int32_t mx = median(windowX);
+    int32_t my = median(windowY);
+
+    // 3. IIR (Q4, damit kleine Schritte nicht durch den Shift verloren gehen)
+    smoothX += ((mx << 4) - smoothX) >> cfg.iirShift;
+    smoothY += ((my << 4) - smoothY) >> cfg.iirShift;
+    int32_t sx = (smoothX + 8) >> 4;
+    int32_t sy = (smoothY + 8) >> 4;
+
+    // 4. Dead-Band
+    if (sx - outputX > cfg.deadband || outputX - sx > cfg.deadband) outputX = sx;
+    if (sy - outputY > cfg.deadband || outputY - sy > cfg.deadband) outputY = sy;
+
+    *outX = outputX;
+    *outY = outputY;
+    return true;
+  }
+
+private:
+  TouchFilterConfig cfg;
+  bool primed;
+  uint8_t windowPos;
+  int16_t windowX[TOUCH_FILTER_MAX_MEDIAN];
+  int16_t windowY[TOUCH_FILTER_MAX_MEDIAN];
+  int32_t smoothX, smoothY;
+  int32_t outputX, outputY;
+
+  static inline void sort2(int16_t& a, int16_t& b) {
+    if (a > b) { int16_t t = a; a = b; b = t; }
+  }
+
+  // Sortiernetze: feste Anzahl Vergleiche unabhängig von den Daten
+  int16_t median(const int16_t* window) const {
+    int16_t v[TOUCH_FILTER_MAX_MEDIAN];
+    switch (cfg.median) {
+      case 3:
+        v[0] = window[0]; v[1] = window[1]; v[2] = window[2];
+        sort2(v[0], v[1]); sort2(v[1], v[2]); sort2(v[0], v[1]);
+        return v[1];
+      case 5:
+        v[0] = window[0]; v[1] = window[1]; v[2] = window[2]; v[3] = window[3]; v[4] = window[4];
+        sort2(v[0], v[1]); sort2(v[3], v[4]); sort2(v[0], v[3]);
+        sort2(v[1], v[4]); sort2(v[1], v[2]); sort2(v[2], v[3]);
+        sort2(v[1], v[2]);
+        return v[2];
+      default:
+        return window[0];
+    }
+  }
+};
+
+#endif // TOUCH_FILTER_H
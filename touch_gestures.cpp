@@ -0,0 +1,172 @@
+/**
+ * touch_gestures.cpp - Touch Event & Gesten Engine
+ */
+
+#include "touch_gestures.h"
+
+static int32_t absDiff(int32_t a, int32_t b) {
+  return a > b ? a - b : b - a;
+}
+
+// Chebyshev-Abstand reicht für Schwellen und kommt ohne Wurzel aus
+static int32_t distance(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+  int32_t dx = absDiff(x0, x1), dy = absDiff(y0, y1);
+  return dx > dy ? dx : dy;
+}
+
+TouchGestureEngine::TouchGestureEngine() {
+  reset();
+}
+
+void TouchGestureEngine::reset() {
+  queue.clear();
+  pressed = false;
+  dragging = false;
+  longPressFired = false;
+  downUs = 0;
+  downX = downY = 0;
+  lastX = lastY = 0;
+  reportedX = reportedY = 0;
+  historyHead = 0;
+  historyCount = 0;
+  lastTapValid = false;
+  lastTapUs = 0;
+  lastTapX = lastTapY = 0;
+}
+
+void TouchGestureEngine::emit(TouchEventType type, uint32_t timestampUs, int16_t x, int16_t y,
+                              TouchSwipeDirection direction, uint16_t velocity) {
+  TouchEvent event;
+  event.timestampUs = timestampUs;
+  event.type = type;
+  event.direction = direction;
+  event.x = x;
+  event.y = y;
+  event.dx = x - downX;
+  event.dy = y - downY;
+  event.velocity = velocity;
+  queue.push(event);
+}
+
+void TouchGestureEngine::remember(uint32_t timestampUs, int16_t x, int16_t y) {
+  history[historyHead] = { timestampUs, x, y };
+  historyHead = (historyHead + 1) % TOUCH_GESTURE_HISTORY;
+  if (historyCount < TOUCH_GESTURE_HISTORY) historyCount++;
+}
+
+// Geschwindigkeit über das jüngste Zeitfenster (ältester Eintrag im Fenster)
+uint16_t TouchGestureEngine::velocityAt(uint32_t timestampUs, int16_t x, int16_t y,
+                                        int32_t* vx, int32_t* vy) const {
+  *vx = 0;
+  *vy = 0;
+
+  const HistoryEntry* oldest = nullptr;
+  for (uint8_t i = 1; i <= historyCount; i++) {
+    const HistoryEntry& entry = history[(historyHead + TOUCH_GESTURE_HISTORY - i) % TOUCH_GESTURE_HISTORY];
+    if (timestampUs - entry.timestampUs > TOUCH_GESTURE_VELOCITY_US) break;
+    oldest = &entry;
+  }
+
+  if (!oldest) return 0;
+  uint32_t dt = timestampUs - oldest->timestampUs;
+  if (dt == 0) return 0;
+
+  *vx = (int32_t)((int64_t)(x - oldest->x) * 1000000 / dt);
+  *vy = (int32_t)((int64_t)(y - oldest->y) * 1000000 / dt);
+  int32_t v = distance(0, 0, *vx, *vy);
+  return v > 0xFFFF ? 0xFFFF : (uint16_t)v;
+}
+
+void TouchGestureEngine::feed(uint32_t timestampUs, int16_t x, int16_t y, bool isPressed) {
+  if (!isPressed) {
+    if (pressed) release(timestampUs);
+    return;
+  }
+
+  if (!pressed) {
+    // Neue Berührung
+    pressed = true;
+    dragging = false;
+    longPressFired = false;
+    downUs = timestampUs;
+    downX = reportedX = lastX = x;
+    downY = reportedY = lastY = y;
+    historyCount = 0;
+    remember(timestampUs, x, y);
+    emit(TOUCH_EVENT_DOWN, timestampUs, x, y);
+    return;
+  }
+
+  lastX = x;
+  lastY = y;
+  remember(timestampUs, x, y);
+
+  if (!dragging && distance(x, y, downX, downY) >= TOUCH_GESTURE_MOVE_SLOP) {
+    dragging = true;
+  }
+
+  if (dragging && distance(x, y, reportedX, reportedY) >= TOUCH_GESTURE_MOVE_STEP) {
+    reportedX = x;
+    reportedY = y;
+    emit(TOUCH_EVENT_MOVE, timestampUs, x, y);
+  }
+
+  tick(timestampUs);
+}
+
+void TouchGestureEngine::tick(uint32_t nowUs) {
+  if (!pressed || dragging || longPressFired) return;
+
+  if (nowUs - downUs >= TOUCH_GESTURE_LONG_PRESS_US) {
+    longPressFired = true;
+    emit(TOUCH_EVENT_LONG_PRESS, nowUs, lastX, lastY);
+  }
+}
+
+void TouchGestureEngine::release(uint32_t timestampUs) {
+  int32_t vx, vy;
+  uint16_t velocity = velocityAt(timestampUs, lastX, lastY, &vx, &vy);
+
+  // Long-Press kann auch zwischen zwei Samples fällig geworden sein
+  tick(timestampUs);
+
+  pressed = false;
+  emit(TOUCH_EVENT_UP, timestampUs, lastX, lastY, TOUCH_SWIPE_NONE, velocity);
+
+  if (dragging) {
+    int32_t dx = lastX - downX, dy = lastY - downY;
+    if (distance(0, 0, dx, dy) >= TOUCH_GESTURE_SWIPE_MIN_DIST &&
+        velocity >= TOUCH_GESTURE_SWIPE_MIN_VEL) {
+      TouchSwipeDirection direction;
+      if (absDiff(dx, 0) >= absDiff(dy, 0)) {
+        direction = dx < 0 ? TOUCH_SWIPE_LEFT : TOUCH_SWIPE_RIGHT;
+      } else {
+        direction = dy < 0 ? TOUCH_SWIPE_UP : TOUCH_SWIPE_DOWN;
+      }
+      emit(TOUCH_EVENT_SWIPE, timestampUs, lastX, lastY, direction, velocity);
+    }
+    lastTapValid = false;
+    return;
+  }
+
+  if (longPressFired || timestampUs - downUs > TOUCH_GESTURE_TAP_MAX_US) {
+    lastTapValid = false;
+    return;
+  }
+
+  emit(TOUCH_EVENT_TAP, timestampUs, lastX, lastY);
+
+  // Zweiter Tap kurz nach dem ersten an gleicher Stelle
+  if (lastTapValid &&
+      downUs - lastTapUs <= TOUCH_GESTURE_DOUBLE_GAP_US &&
+      distance(lastX, lastY, lastTapX, lastTapY) <= TOUCH_GESTURE_DOUBLE_DIST) {
+    emit(TOUCH_EVENT_DOUBLE_TAP, timestampUs, lastX, lastY);
+    lastTapValid = false;
+    return;
+  }
+
+  lastTapValid = true;
+  lastTapUs = timestampUs;
+  lastTapX = lastX;
+  lastTapY = lastY;
+}
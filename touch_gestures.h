@@ -0,0 +1,122 @@
+/**
+ * touch_gestures.h - Touch Event & Gesten Engine
+ *
+ * Wandelt den Sample-Strom (Zeit, Position, gedrückt) in typisierte
+ * Events: Down, Move, Up, Tap, Double-Tap, Long-Press und Swipe.
+ * Die Events landen in einer Queue fester Größe (keine Allokation).
+ *
+ * Die Zustandsmaschine liest keine Uhr: alle Zeitpunkte kommen über
+ * feed()/tick() herein. Damit ist sie deterministisch und lässt sich
+ * auf dem Host mit aufgezeichneten Traces exakt nachspielen.
+ */
+
+#ifndef TOUCH_GESTURES_H
+#define TOUCH_GESTURES_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "spsc_ring.h"
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define TOUCH_GESTURE_QUEUE          32       // Zweierpotenz
+#define TOUCH_GESTURE_HISTORY        8        // Positionen für die Geschwindigkeit
+#define TOUCH_GESTURE_MOVE_SLOP      8        // px bis eine Berührung zum Drag wird
+#define TOUCH_GESTURE_MOVE_STEP      2        // px zwischen zwei Move-Events im Drag
+#define TOUCH_GESTURE_TAP_MAX_US     250000   // Max. Dauer eines Taps
+#define TOUCH_GESTURE_DOUBLE_GAP_US  300000   // Max. Abstand zweier Taps
+#define TOUCH_GESTURE_DOUBLE_DIST    20       // Max. Abstand zweier Taps (px)
+#define TOUCH_GESTURE_LONG_PRESS_US  600000   // Haltedauer für Long-Press
+#define TOUCH_GESTURE_SWIPE_MIN_DIST 40       // px
+#define TOUCH_GESTURE_SWIPE_MIN_VEL  300      // px/s
+#define TOUCH_GESTURE_VELOCITY_US    100000   // Zeitfenster der Geschwindigkeit
+
+// ============================================
+// EVENTS
+// ============================================
+
+enum TouchEventType : uint8_t {
+  TOUCH_EVENT_DOWN = 0,
+  TOUCH_EVENT_MOVE,
+  TOUCH_EVENT_UP,
+  TOUCH_EVENT_TAP,
+  TOUCH_EVENT_DOUBLE_TAP,
+  TOUCH_EVENT_LONG_PRESS,
+  TOUCH_EVENT_SWIPE
+};
+
+enum TouchSwipeDirection : uint8_t {
+  TOUCH_SWIPE_NONE = 0,
+  TOUCH_SWIPE_LEFT,
+  TOUCH_SWIPE_RIGHT,
+  TOUCH_SWIPE_UP,
+  TOUCH_SWIPE_DOWN
+};
+
+struct TouchEvent {
+  uint32_t timestampUs;
+  TouchEventType type;
+  TouchSwipeDirection direction;  // Nur bei SWIPE
+  int16_t x, y;                   // Aktuelle Position
+  int16_t dx, dy;                 // Verschiebung seit DOWN
+  uint16_t velocity;              // px/s (SWIPE, UP)
+};
+
+typedef SpscRing<TouchEvent, TOUCH_GESTURE_QUEUE> TouchEventQueue;
+
+// ============================================
+// ENGINE
+// ============================================
+
+class TouchGestureEngine {
+public:
+  TouchGestureEngine();
+
+  void reset();
+
+  // Ein Sample einspeisen (Bildschirmkoordinaten). Bei pressed=false
+  // werden x/y ignoriert und die letzte Position verwendet.
+  void feed(uint32_t timestampUs, int16_t x, int16_t y, bool pressed);
+
+  // Zeit fortschreiben ohne neues Sample (Long-Press bei ruhendem Finger)
+  void tick(uint32_t nowUs);
+
+  bool poll(TouchEvent* event) { return queue.pop(event); }
+  size_t poll(TouchEvent* events, size_t maxEvents) { return queue.pop(events, maxEvents); }
+  uint32_t droppedEvents() const { return queue.dropped(); }
+  bool isPressed() const { return pressed; }
+
+private:
+  struct HistoryEntry {
+    uint32_t timestampUs;
+    int16_t x, y;
+  };
+
+  TouchEventQueue queue;
+
+  bool pressed;
+  bool dragging;
+  bool longPressFired;
+  uint32_t downUs;
+  int16_t downX, downY;
+  int16_t lastX, lastY;          // Letzte Sample-Position
+  int16_t reportedX, reportedY;  // Position des letzten Move-Events
+
+  HistoryEntry history[TOUCH_GESTURE_HISTORY];
+  uint8_t historyHead;
+  uint8_t historyCount;
+
+  bool lastTapValid;
+  uint32_t lastTapUs;
+  int16_t lastTapX, lastTapY;
+
+  void emit(TouchEventType type, uint32_t timestampUs, int16_t x, int16_t y,
+            TouchSwipeDirection direction = TOUCH_SWIPE_NONE, uint16_t velocity = 0);
+  void remember(uint32_t timestampUs, int16_t x, int16_t y);
+  uint16_t velocityAt(uint32_t timestampUs, int16_t x, int16_t y, int32_t* vx, int32_t* vy) const;
+  void release(uint32_t timestampUs);
+};
+
+#endif // TOUCH_GESTURES_H
@@ -0,0 +1,283 @@
+/**
+ * touch_i2c.cpp - Burst-Reads und Slot-Zuordnung der I2C Touch-Controller
+ */
+
+#include "touch_i2c.h"
+#include <string.h>
+
+// Ein Touch-Controller pro Board: INT-Flag und Schutz der Slots zwischen
+// IO-Task (update) und Lesern in anderen Tasks
+static volatile bool touchI2cPending = false;
+static volatile uint32_t touchI2cIrqCount = 0;
+static portMUX_TYPE touchI2cMux = portMUX_INITIALIZER_UNLOCKED;
+
+static void IRAM_ATTR touchI2cIrqHandler() {
+  touchI2cPending = true;
+  touchI2cIrqCount++;
+}
+
+TouchI2c::TouchI2c()
+  : wire(nullptr), controller(0), deviceAddress(0), regBytes(1), limit(0), irqPin(-1),
+    intervalUs(0), lastReadUs(0), chip(""), slots(), active(0), counters() {}
+
+bool TouchI2c::begin(TwoWire& bus, uint8_t controllerId, uint8_t address, int8_t irq, int8_t rst,
+                     uint8_t maxPoints, uint16_t rateHz) {
+  end();
+  wire = &bus;
+  controller = controllerId;
+  regBytes = controller == HW_TOUCH_CTRL_GT911 ? 2 : 1;
+  limit = min(max(maxPoints, (uint8_t)1), hwTouchMaxPoints(controller));
+  intervalUs = rateHz ? 1000000UL / rateHz : 0;
+  counters = TouchI2cStats();
+  reset(rst);
+
+  bool found = false;
+  if (address) {
+    found = probe(address);
+  } else if (controller == HW_TOUCH_CTRL_GT911) {
+    found = probe(TOUCH_I2C_ADDR_GT911) || probe(TOUCH_I2C_ADDR_GT911_B);
+  } else if (controller == HW_TOUCH_CTRL_FT6236) {
+    found = probe(TOUCH_I2C_ADDR_FT6236);
+  } else if (controller == HW_TOUCH_CTRL_CST816S) {
+    found = probe(TOUCH_I2C_ADDR_CST816S);
+  }
+  if (!found) {
+    wire = nullptr;
+    return false;
+  }
+
+  irqPin = irq;
+  if (irqPin >= 0) {
+    pinMode(irqPin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(irqPin), touchI2cIrqHandler, FALLING);
+  }
+  touchI2cPending = true;   // Bericht eines schon aufliegenden Fingers abholen
+  return true;
+}
+
+void TouchI2c::end() {
+  if (irqPin >= 0) {
+    detachInterrupt(digitalPinToInterrupt(irqPin));
+    irqPin = -1;
+  }
+  portENTER_CRITICAL(&touchI2cMux);
+  active = 0;
+  portEXIT_CRITICAL(&touchI2cMux);
+  wire = nullptr;
+}
+
+// Hardware-Reset vor dem Probe: der CST816S antwortet im Auto-Sleep
+// nicht, GT911 und FT6236 starten nach dem Puls mit sauberem Zustand
+void TouchI2c::reset(int8_t rst) {
+  if (rst < 0) return;
+  pinMode(rst, OUTPUT);
+  digitalWrite(rst, LOW);
+  delay(10);
+  digitalWrite(rst, HIGH);
+  delay(50);   // Firmware-Start des Controllers
+}
+
+// Chip-ID lesen: antwortet der Controller, gilt er als gefunden
+bool TouchI2c::probe(uint8_t candidate) {
+  deviceAddress = candidate;
+  uint8_t id[4];
+
+  if (controller == HW_TOUCH_CTRL_GT911) {
+    if (!readRegisters(GT911_REG_PRODUCT_ID, id, 4)) return false;
+    chip = memcmp(id, "911", 3) == 0 ? "GT911" : "GT9xx";
+  } else if (controller == HW_TOUCH_CTRL_FT6236) {
+    if (!readRegisters(FT6236_REG_CHIP_ID, id, 1)) return false;
+    chip = id[0] == 0x06 ? "FT6206" : id[0] == 0x36 ? "FT6236" : id[0] == 0x64 ? "FT6336U" : "FT62xx";
+  } else if (controller == HW_TOUCH_CTRL_CST816S) {
+    // Im Auto-Sleep keine Antwort: reset() in begin() hat ihn geweckt
+    if (!readRegisters(CST816S_REG_CHIP_ID, id, 1)) return false;
+    chip = id[0] == 0xB4 ? "CST816S" : id[0] == 0xB5 ? "CST816T" : id[0] == 0xB6 ? "CST816D" : "CST8xx";
+    writeRegister(CST816S_REG_AUTO_SLEEP, 0x01);
+  } else {
+    return false;
+  }
+  counters.errors = 0;   // Fehlversuche an der Ausweichadresse zählen nicht
+  return true;
+}
+
+// ============================================
+// I2C
+// ============================================
+
+// Registeradresse, Repeated Start, alle Bytes: eine Transaktion
+bool TouchI2c::readRegisters(uint16_t reg, uint8_t* data, uint8_t length) {
+  counters.transactions++;
+  wire->beginTransmission(deviceAddress);
+  if (regBytes == 2) wire->write((uint8_t)(reg >> 8));
+  wire->write((uint8_t)reg);
+  if (wire->endTransmission(false) != 0 ||
+      wire->requestFrom(deviceAddress, (size_t)length, true) != length) {
+    counters.errors++;
+    return false;
+  }
+  for (uint8_t i = 0; i < length; i++) data[i] = (uint8_t)wire->read();
+  return true;
+}
+
+bool TouchI2c::writeRegister(uint16_t reg, uint8_t value) {
+  counters.transactions++;
+  wire->beginTransmission(deviceAddress);
+  if (regBytes == 2) wire->write((uint8_t)(reg >> 8));
+  wire->write((uint8_t)reg);
+  wire->write(value);
+  if (wire->endTransmission() != 0) {
+    counters.errors++;
+    return false;
+  }
+  return true;
+}
+
+// ============================================
+// BERICHTE
+// ============================================
+
+// Status und alle Punkte in einem Burst, Layout je Controller
+int TouchI2c::fetch(TouchI2cPoint* raw) {
+  uint8_t buffer[1 + TOUCH_I2C_MAX_POINTS * GT911_POINT_BYTES];
+  uint8_t count = 0;
+
+  if (controller == HW_TOUCH_CTRL_GT911) {
+    if (!readRegisters(GT911_REG_STATUS, buffer, 1 + limit * GT911_POINT_BYTES)) return -1;
+    if (!(buffer[0] & 0x80)) return -1;       // Noch kein neuer Bericht
+    writeRegister(GT911_REG_STATUS, 0);       // Quittung: Controller darf den nächsten schreiben
+    count = min((uint8_t)(buffer[0] & 0x0F), limit);
+    for (uint8_t i = 0; i < count; i++) {
+      const uint8_t* p = buffer + 1 + i * GT911_POINT_BYTES;
+      raw[i].trackId = p[0];
+      raw[i].x = (int16_t)(p[1] | (p[2] << 8));
+      raw[i].y = (int16_t)(p[3] | (p[4] << 8));
+      raw[i].size = (uint16_t)(p[5] | (p[6] << 8));
+    }
+  } else if (controller == HW_TOUCH_CTRL_FT6236) {
+    if (!readRegisters(FT6236_REG_STATUS, buffer, 1 + limit * FT6236_POINT_BYTES)) return -1;
+    uint8_t reported = buffer[0] & 0x0F;
+    if (reported > hwTouchMaxPoints(controller)) reported = 0;   // 0x0F nach dem Einschalten
+    for (uint8_t i = 0; i < min(reported, limit); i++) {
+      const uint8_t* p = buffer + 1 + i * FT6236_POINT_BYTES;
+      if ((p[0] >> 6) == 1) continue;         // Event "Lift Up": Finger ist weg
+      raw[count].trackId = p[2] >> 4;
+      raw[count].x = (int16_t)(((p[0] & 0x0F) << 8) | p[1]);
+      raw[count].y = (int16_t)(((p[2] & 0x0F) << 8) | p[3]);
+      raw[count].size = p[4];
+      count++;
+    }
+  } else {
+    if (!readRegisters(CST816S_REG_GESTURE, buffer, CST816S_REPORT_BYTES)) return -1;
+    if (buffer[1]) {
+      raw[0].trackId = 0;
+      raw[0].x = (int16_t)(((buffer[2] & 0x0F) << 8) | buffer[3]);
+      raw[0].y = (int16_t)(((buffer[4] & 0x0F) << 8) | buffer[5]);
+      raw[0].size = 0;
+      count = 1;
+    }
+  }
+
+  counters.reads++;
+  counters.points += count;
+  return count;
+}
+
+// Bekannte Track-IDs behalten ihren Slot, neue Finger nehmen den
+// kleinsten freien; nicht mehr gemeldete Slots werden frei. Ein eben
+// frei gewordener Slot geht erst an einen neuen Finger, wenn kein
+// anderer frei ist (sonst erbt er die Spur des abgehobenen).
+void TouchI2c::track(const TouchI2cPoint* raw, uint8_t rawCount) {
+  TouchI2cPoint next[TOUCH_I2C_MAX_POINTS];
+  bool placed[TOUCH_I2C_MAX_POINTS] = {};
+  uint8_t nextActive = 0;
+
+  for (uint8_t i = 0; i < rawCount; i++) {
+    for (uint8_t s = 0; s < limit; s++) {
+      const uint8_t bit = 1 << s;
+      if ((active & bit) && !(nextActive & bit) && slots[s].trackId == raw[i].trackId) {
+        next[s] = raw[i];
+        nextActive |= bit;
+        placed[i] = true;
+        break;
+      }
+    }
+  }
+  for (uint8_t i = 0; i < rawCount; i++) {
+    if (placed[i]) continue;
+    for (uint8_t s = 0; s < limit; s++) {
+      const uint8_t bit = 1 << s;
+      if (!(nextActive & bit) && !(active & bit)) {
+        next[s] = raw[i];
+        nextActive |= bit;
+        placed[i] = true;
+        break;
+      }
+    }
+  }
+  for (uint8_t i = 0; i < rawCount; i++) {
+    if (placed[i]) continue;
+    for (uint8_t s = 0; s < limit; s++) {
+      const uint8_t bit = 1 << s;
+      if (!(nextActive & bit)) {
+        next[s] = raw[i];
+        nextActive |= bit;
+        break;
+      }
+    }
+  }
+
+  portENTER_CRITICAL(&touchI2cMux);
+  for (uint8_t s = 0; s < limit; s++) {
+    if (!(nextActive & (1 << s))) continue;
+    slots[s] = next[s];
+    slots[s].slot = s;
+  }
+  active = nextActive;
+  portEXIT_CRITICAL(&touchI2cMux);
+}
+
+bool TouchI2c::update() {
+  if (!wire) return false;
+  const uint32_t now = micros();
+  if (!touchI2cPending) {
+    // Ohne Berührung weckt nur die INT-Flanke; aufliegende Finger mit der
+    // Abtastrate nachlesen, damit das Abheben ankommt
+    if (irqPin >= 0 && !active) return false;
+    if (now - lastReadUs < intervalUs) return false;
+  }
+  touchI2cPending = false;
+  lastReadUs = now;
+  counters.interrupts = touchI2cIrqCount;
+
+  TouchI2cPoint raw[TOUCH_I2C_MAX_POINTS];
+  const int rawCount = fetch(raw);
+  if (rawCount < 0) return false;
+  track(raw, (uint8_t)rawCount);
+  return true;
+}
+
+// ============================================
+// ABFRAGE
+// ============================================
+
+uint8_t TouchI2c::count() const {
+  portENTER_CRITICAL(&touchI2cMux);
+  uint8_t bits = active, n = 0;
+  portEXIT_CRITICAL(&touchI2cMux);
+  for (; bits; bits &= bits - 1) n++;
+  return n;
+}
+
+uint8_t TouchI2c::points(TouchI2cPoint* out, uint8_t maxPoints) const {
+  uint8_t n = 0;
+  portENTER_CRITICAL(&touchI2cMux);
+  for (uint8_t s = 0; s < limit && n < maxPoints; s++) {
+    if (active & (1 << s)) out[n++] = slots[s];
+  }
+  portEXIT_CRITICAL(&touchI2cMux);
+  return n;
+}
+
+bool TouchI2c::primary(TouchI2cPoint* point) const {
+  return points(point, 1) == 1;
+}
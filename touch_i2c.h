@@ -0,0 +1,123 @@
+/**
+ * touch_i2c.h - Kapazitive Touch-Controller am I2C-Bus (GT911, FT6236, CST816S)
+ *
+ * Die INT-Leitung des Controllers weckt den Treiber: ohne Berührung
+ * entsteht kein I2C-Verkehr. Ein Bericht wird mit einem einzigen
+ * Burst-Read geholt (Status und alle Punkte ab dem ersten Register),
+ * nicht Punkt für Punkt. Solange Finger aufliegen, liest update()
+ * höchstens mit der Abtastrate, damit auch das Abheben ankommt.
+ *
+ * Die Track-IDs der Controller werden auf feste Slots abgebildet: ein
+ * Finger behält seinen Slot, bis er abhebt, neue Finger belegen den
+ * kleinsten freien. getTouchPoints() liefert damit pro Index immer
+ * denselben Finger.
+ *
+ *   touchI2c.begin(Wire, HW_TOUCH_CTRL_GT911, 0, irq, rst, 5, 200);
+ *   if (touchI2c.update()) n = touchI2c.points(points, 5);
+ */
+
+#ifndef TOUCH_I2C_H
+#define TOUCH_I2C_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "hardware_profile.h"  // HW_TOUCH_CTRL_*, hwTouchMaxPoints()
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define TOUCH_I2C_MAX_POINTS    5      // GT911; FT6236 2, CST816S 1
+#define TOUCH_I2C_NO_SLOT       0xFF
+
+// Standard-Adressen (GT911 alternativ 0x14, je nach INT-Pegel beim Reset)
+#define TOUCH_I2C_ADDR_GT911    0x5D
+#define TOUCH_I2C_ADDR_GT911_B  0x14
+#define TOUCH_I2C_ADDR_FT6236   0x38
+#define TOUCH_I2C_ADDR_CST816S  0x15
+
+// GT911: 16-Bit Registeradressen, Big-Endian
+#define GT911_REG_PRODUCT_ID    0x8140   // "911\0"
+#define GT911_REG_STATUS        0x814E   // Bit 7 Buffer bereit, Bit 0-3 Punkte
+#define GT911_POINT_BYTES       8        // Track-ID, X, Y, Größe (LE), reserviert
+
+// FT6236: Status und zwei Punkte ab 0x02
+#define FT6236_REG_STATUS       0x02     // Bit 0-3 Punkte
+#define FT6236_REG_CHIP_ID      0xA3     // 0x06 FT6206, 0x36 FT6236, 0x64 FT6336U
+#define FT6236_POINT_BYTES      6        // XH (Event, X 11:8), XL, YH (ID, Y 11:8), YL, Gewicht, Bereich
+
+// CST816S: Geste, Fingerzahl und ein Punkt ab 0x01
+#define CST816S_REG_GESTURE     0x01
+#define CST816S_REG_CHIP_ID     0xA7     // 0xB4 CST816S
+#define CST816S_REG_AUTO_SLEEP  0xFE     // != 0: kein Auto-Sleep
+#define CST816S_REPORT_BYTES    6        // Geste, Finger, XH, XL, YH, YL
+
+// ============================================
+// DATENSTRUKTUREN
+// ============================================
+
+struct TouchI2cPoint {
+  uint8_t slot;        // Stabiler Index solange der Finger aufliegt
+  uint8_t trackId;     // ID des Controllers
+  int16_t x, y;        // Controller-Koordinaten (Panel, Rotation 0)
+  uint16_t size;       // Kontaktfläche bzw. Gewicht, 0 = unbekannt
+};
+
+struct TouchI2cStats {
+  uint32_t interrupts;     // INT-Flanken
+  uint32_t reads;          // Burst-Reads (ein Bericht pro Read)
+  uint32_t transactions;   // Alle I2C-Transaktionen inkl. Quittung (GT911)
+  uint32_t points;         // Gemeldete Punkte über alle Berichte
+  uint32_t errors;         // NACK oder zu wenige Bytes
+};
+
+// ============================================
+// TREIBER
+// ============================================
+
+class TouchI2c {
+public:
+  TouchI2c();
+
+  // address 0 = Standard des Controllers; irq < 0 = Polling mit rateHz;
+  // rst >= 0 wird vor dem Probe gepulst (weckt den CST816S aus dem Auto-Sleep)
+  bool begin(TwoWire& bus, uint8_t controller, uint8_t address, int8_t irq, int8_t rst,
+             uint8_t maxPoints, uint16_t rateHz);
+  void end();
+  bool ready() const { return wire != nullptr; }
+
+  bool update();    // true = neuer Bericht gelesen
+  uint8_t count() const;
+  uint8_t points(TouchI2cPoint* out, uint8_t maxPoints) const;   // Nach Slot sortiert
+  bool primary(TouchI2cPoint* point) const;                      // Kleinster belegter Slot
+
+  uint8_t address() const { return deviceAddress; }
+  const char* chipName() const { return chip; }
+  const TouchI2cStats& stats() const { return counters; }
+
+private:
+  void reset(int8_t rst);
+  bool probe(uint8_t candidate);
+  bool readRegisters(uint16_t reg, uint8_t* data, uint8_t length);
+  bool writeRegister(uint16_t reg, uint8_t value);
+  int fetch(TouchI2cPoint* raw);   // -1 = kein neuer Bericht
+  void track(const TouchI2cPoint* raw, uint8_t rawCount);
+
+  TwoWire* wire;
+  uint8_t controller;
+  uint8_t deviceAddress;
+  uint8_t regBytes;                // 2 beim GT911
+  uint8_t limit;                   // Punkte pro Burst-Read
+  int8_t irqPin;
+  uint32_t intervalUs;
+  uint32_t lastReadUs;
+  const char* chip;
+  TouchI2cPoint slots[TOUCH_I2C_MAX_POINTS];
+  uint8_t active;                  // Bitmaske belegter Slots
+  TouchI2cStats counters;
+};
+
+static_assert(hwTouchMaxPoints(HW_TOUCH_CTRL_GT911) <= TOUCH_I2C_MAX_POINTS,
+              "TOUCH_I2C_MAX_POINTS zu klein für den GT911");
+
+#endif // TOUCH_I2C_H
@@ -0,0 +1,164 @@
+/**
+ * touch_sampler.cpp - Interrupt-gesteuertes Touch-Sampling (XPT2046)
+ */
+
+#include "config.h"
+#include "hardware_hal.h"
+#include "touch_sampler.h"
+#include <SPI.h>
+#include <XPT2046_Touchscreen.h>
+
+static TouchSamplerConfig sampler;   // Von touchSamplerStart() bis Stop
+static TouchSampleRing sampleRing;
+static TouchFilter sampleFilter(TouchFilterConfig{ 0, 1, 0, 0 });
+static TaskHandle_t samplerTask = nullptr;
+static SemaphoreHandle_t samplerDone = nullptr;   // Task hat sich beendet
+static std::atomic<bool> samplerStopping(false);
+static TickType_t samplePeriod = 1;
+static uint32_t samplePeriodUs = 5000;
+
+// Letzter Rohwert gepackt: X (Bit 0-11), Y (Bit 12-23), Pen-Down (Bit 31)
+static std::atomic<uint32_t> latestPacked(0);
+static std::atomic<uint32_t> latestTimestamp(0);
+static std::atomic<uint16_t> latestZ(0);
+
+static void IRAM_ATTR touchIrqHandler() {
+  BaseType_t woken = pdFALSE;
+  if (samplerTask) {
+    vTaskNotifyGiveFromISR(samplerTask, &woken);
+  }
+  if (woken) {
+    portYIELD_FROM_ISR();
+  }
+}
+
+static void publishSample(const TouchSample& sample) {
+  uint32_t packed = ((uint32_t)sample.rawX & 0x0FFF) |
+                    (((uint32_t)sample.rawY & 0x0FFF) << 12) |
+                    (sample.z ? 0x80000000UL : 0);
+  latestTimestamp.store(sample.timestampUs, std::memory_order_relaxed);
+  latestZ.store(sample.z, std::memory_order_relaxed);
+  latestPacked.store(packed, std::memory_order_release);
+  sampleRing.push(sample);
+}
+
+static void touchSamplerTask(void* param) {
+  // Stop setzt erst das Flag und benachrichtigt dann: eine hier verworfene
+  // Benachrichtigung ist damit immer schon am Flag sichtbar
+  while (!samplerStopping.load()) {
+    // Schlafen bis PENIRQ fällt - kein SPI-Verkehr ohne Berührung
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (samplerStopping.load()) break;
+
+    TickType_t lastWake = xTaskGetTickCount();
+    sampleFilter.reset();
+    while (!samplerStopping.load()) {
+      // Deadline: Sample muss innerhalb einer Periode gelesen sein
+      spiArbiter.acquire(*sampler.device, micros() + samplePeriodUs);
+      TS_Point p = sampler.touch->getPoint();
+      spiArbiter.release(*sampler.device);
+
+      // Gefilterte Rohwerte; unter der Druckschwelle gilt der Stift als abgehoben
+      TouchSample sample;
+      sample.timestampUs = micros();
+      if (sampleFilter.process(p.x, p.y, p.z, &sample.rawX, &sample.rawY)) {
+        sample.z = p.z;
+      } else {
+        sample.rawX = p.x;
+        sample.rawY = p.y;
+        sample.z = 0;
+      }
+      publishSample(sample);
+
+      // Stift abgehoben: Pen-Up Markierung ist gesendet, zurück in den Schlaf
+      if (sample.z == 0) break;
+
+      vTaskDelayUntil(&lastWake, samplePeriod);
+    }
+
+    // PENIRQ toggelt während der Wandlungen - diese Benachrichtigungen verwerfen
+    ulTaskNotifyTake(pdTRUE, 0);
+  }
+
+  // Nur zwischen zwei Samples: der SPI-Arbiter ist hier immer freigegeben
+  xSemaphoreGive(samplerDone);
+  vTaskDelete(nullptr);
+}
+
+bool touchSamplerStart(const TouchSamplerConfig& config, uint16_t rateHz) {
+  if (samplerTask) return true;
+  if (rateHz == 0 || config.irq < 0) return false;
+
+  sampler = config;
+  sampleFilter = TouchFilter(config.filter);
+
+  samplePeriod = pdMS_TO_TICKS(1000 / rateHz);
+  if (samplePeriod == 0) samplePeriod = 1;
+  samplePeriodUs = 1000000UL / rateHz;
+
+  sampleRing.clear();
+  latestPacked.store(0);
+  samplerStopping.store(false);
+  if (!samplerDone) samplerDone = xSemaphoreCreateBinary();
+
+  if (xTaskCreate(touchSamplerTask, "touch_sampler", TOUCH_SAMPLER_STACK, nullptr,
+                  TOUCH_SAMPLER_PRIORITY, &samplerTask) != pdPASS) {
+    samplerTask = nullptr;
+    Serial.println("ERROR: Touch-Sampling Task konnte nicht gestartet werden");
+    return false;
+  }
+
+  // Ersetzt den ISR der XPT2046-Bibliothek auf dem IRQ-Pin
+  pinMode(sampler.irq, INPUT);
+  attachInterrupt(digitalPinToInterrupt(sampler.irq), touchIrqHandler, FALLING);
+
+  // Stift liegt bereits auf: sofort mit dem Sampling beginnen
+  if (digitalRead(sampler.irq) == LOW) {
+    xTaskNotifyGive(samplerTask);
+  }
+
+  Serial.printf("Touch-Sampling (IRQ) aktiv: %d Hz auf GPIO %d\n", rateHz, sampler.irq);
+  return true;
+}
+
+void touchSamplerStop() {
+  if (!samplerTask) return;
+
+  // Kooperativ beenden: der Task liest sein Sample zu Ende, gibt den
+  // Arbiter frei und löscht sich selbst (höchstens eine Sample-Periode)
+  detachInterrupt(digitalPinToInterrupt(sampler.irq));
+  samplerStopping.store(true);
+  xTaskNotifyGive(samplerTask);
+  xSemaphoreTake(samplerDone, portMAX_DELAY);
+  samplerTask = nullptr;
+  latestPacked.store(0);
+
+  // Bibliotheks-ISR für den Polling-Betrieb wiederherstellen
+  sampler.touch->begin(*sampler.bus);
+  Serial.println("Touch-Sampling (IRQ) beendet - Polling aktiv");
+}
+
+bool touchSamplerActive() {
+  return samplerTask != nullptr;
+}
+
+bool touchSamplerPenDown() {
+  return (latestPacked.load(std::memory_order_acquire) & 0x80000000UL) != 0;
+}
+
+bool touchSamplerLatest(TouchSample* sample) {
+  uint32_t packed = latestPacked.load(std::memory_order_acquire);
+  sample->rawX = packed & 0x0FFF;
+  sample->rawY = (packed >> 12) & 0x0FFF;
+  sample->z = latestZ.load(std::memory_order_relaxed);
+  sample->timestampUs = latestTimestamp.load(std::memory_order_relaxed);
+  return (packed & 0x80000000UL) != 0;
+}
+
+size_t touchSamplerRead(TouchSample* samples, size_t maxSamples) {
+  return sampleRing.pop(samples, maxSamples);
+}
+
+uint32_t touchSamplerDropped() {
+  return sampleRing.dropped();
+}
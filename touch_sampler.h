@@ -0,0 +1,65 @@
+/**
+ * touch_sampler.h - Interrupt-gesteuertes Touch-Sampling
+ *
+ * Die PENIRQ-Flanke (HwTouchConfig::irq) weckt einen hochpriorisierten Task,
+ * der den XPT2046 nur solange mit fester Rate abtastet, wie der Stift
+ * aufliegt. Die Rohwerte durchlaufen den Touch-Filter (touch_filter.h)
+ * und landen mit Zeitstempel in einem lock-freien SPSC-Ringpuffer.
+ * Der Anwender holt sie blockweise ab.
+ * Ohne Berührung entsteht keinerlei SPI-Verkehr.
+ */
+
+#ifndef TOUCH_SAMPLER_H
+#define TOUCH_SAMPLER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "spsc_ring.h"
+#include "touch_filter.h"
+
+class XPT2046_Touchscreen;
+class SPIClass;
+struct SpiDevice;
+
+// ============================================
+// KONFIGURATION
+// ============================================
+
+#define TOUCH_SAMPLE_BUFFER     64    // Zweierpotenz
+#define TOUCH_SAMPLER_PRIORITY  5     // Über loop() (1)
+#define TOUCH_SAMPLER_STACK     3072
+
+// ============================================
+// DATENSTRUKTUREN
+// ============================================
+
+struct TouchSample {
+  uint32_t timestampUs;   // micros() beim Auslesen
+  int16_t rawX, rawY;     // Rohwerte des Controllers
+  uint16_t z;             // Druck, 0 = Stift abgehoben (Pen-Up Markierung)
+};
+
+typedef SpscRing<TouchSample, TOUCH_SAMPLE_BUFFER> TouchSampleRing;
+
+// Geräte und Filter des aktiven Profils (HardwareManager), gültig bis Stop
+struct TouchSamplerConfig {
+  XPT2046_Touchscreen* touch;
+  SPIClass* bus;               // Für touch.begin() nach dem Stop
+  const SpiDevice* device;     // Bus-Arbiter
+  int8_t irq;                  // PENIRQ
+  TouchFilterConfig filter;
+};
+
+// ============================================
+// API (touch_sampler.cpp)
+// ============================================
+
+bool touchSamplerStart(const TouchSamplerConfig& config, uint16_t rateHz);
+void touchSamplerStop();
+bool touchSamplerActive();
+bool touchSamplerPenDown();
+bool touchSamplerLatest(TouchSample* sample);   // Letzter Wert ohne SPI-Zugriff
+size_t touchSamplerRead(TouchSample* samples, size_t maxSamples);
+uint32_t touchSamplerDropped();
+
+#endif // TOUCH_SAMPLER_H
@@ -0,0 +1,133 @@
+/**
+ * touch_transform.h - Festkomma Touch-Transformation
+ *
+ * Rohwerte des Touch-Controllers werden über eine affine Abbildung
+ * in Bildschirmkoordinaten umgerechnet (Q16 Festkomma):
+ *
+ *   x = (xx * rawX + xy * rawY + x0) >> 16
+ *   y = (yx * rawX + yy * rawY + y0) >> 16
+ *
+ * Pro Rotation existiert eine Matrix, die HW_DEFINE_PROFILE zur
+ * Compile-Zeit aus den Profil-Makros (HW_TOUCH_MIN/MAX_*,
+ * HW_TOUCH_INVERT_*_ROTn, HW_TOUCH_MAP_*) ableitet und im Profil ablegt
+ * (HwTouchConfig::transforms). Zur Laufzeit bleiben nur noch
+ * Multiplikationen, Additionen und ein Shift - keine Division.
+ *
+ * Ohne Profil-Makros: jedes Profil der Tabelle bringt seine Matrizen mit.
+ */
+
+#ifndef TOUCH_TRANSFORM_H
+#define TOUCH_TRANSFORM_H
+
+#include <stdint.h>
+
+// ============================================
+// TRANSFORMATIONS-MATRIX
+// ============================================
+
+struct TouchTransform {
+  int32_t xx, xy, x0;   // Bildschirm-X aus Rohwerten (Q16)
+  int32_t yx, yy, y0;   // Bildschirm-Y aus Rohwerten (Q16)
+  int16_t maxX, maxY;   // Clamp-Grenzen (width-1, height-1)
+
+  // Rohwerte -> Bildschirmkoordinaten (begrenzt auf den Bildschirm)
+  inline void apply(int32_t rawX, int32_t rawY, int* x, int* y) const {
+    int32_t tx = (xx * rawX + xy * rawY + x0) >> 16;
+    int32_t ty = (yx * rawX + yy * rawY + y0) >> 16;
+    *x = tx < 0 ? 0 : (tx > maxX ? maxX : tx);
+    *y = ty < 0 ? 0 : (ty > maxY ? maxY : ty);
+  }
+};
+
+// ============================================
+// COMPILE-TIME ABLEITUNG AUS DEM PROFIL
+// ============================================
+
+// Referenz-Mapping eines Profils (switch + map() + Invertierung, ohne
+// Clamp): Quelle der Matrix und Vergleich für Benchmark und Host-Test.
+// HW_DEFINE_PROFILE erzeugt es pro Profil aus den HW_TOUCH_MAP_* Makros.
+typedef void (*TouchReferenceMap)(uint8_t rotation, long rawX, long rawY, long& tx, long& ty);
+
+namespace TouchTransformDetail {
+
+  // constexpr-Variante von Arduino map() - verdeckt ::map() auch
+  // innerhalb der HW_TOUCH_MAP_* Makros des Profils
+  constexpr long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+  }
+
+  // Map: Typ aus HW_DEFINE_PROFILE mit apply() (Referenz-Mapping),
+  // screenWidth()/screenHeight() und dem Rohwert-Bereich minX..maxY
+  template <typename Map>
+  constexpr long refX(uint8_t rotation, long rawX, long rawY) {
+    long tx = 0, ty = 0;
+    Map::apply(rotation, rawX, rawY, tx, ty);
+    return tx;
+  }
+
+  template <typename Map>
+  constexpr long refY(uint8_t rotation, long rawX, long rawY) {
+    long tx = 0, ty = 0;
+    Map::apply(rotation, rawX, rawY, tx, ty);
+    return ty;
+  }
+
+  // Matrix aus drei Stützpunkten des Referenz-Mappings ableiten.
+  // Die Endpunkte von map() sind exakt, daher sind die Steigungen exakt.
+  // +0x8000 im Offset: Rundung auf den nächsten Pixel statt Abschneiden.
+  template <typename Map>
+  constexpr TouchTransform derive(uint8_t rotation) {
+    const long x0 = Map::minX, x1 = Map::maxX;
+    const long y0 = Map::minY, y1 = Map::maxY;
+
+    const long xx = ((refX<Map>(rotation, x1, y0) - refX<Map>(rotation, x0, y0)) * 65536) / (x1 - x0);
+    const long xy = ((refX<Map>(rotation, x0, y1) - refX<Map>(rotation, x0, y0)) * 65536) / (y1 - y0);
+    const long yx = ((refY<Map>(rotation, x1, y0) - refY<Map>(rotation, x0, y0)) * 65536) / (x1 - x0);
+    const long yy = ((refY<Map>(rotation, x0, y1) - refY<Map>(rotation, x0, y0)) * 65536) / (y1 - y0);
+
+    return TouchTransform{
+      (int32_t)xx, (int32_t)xy,
+      (int32_t)(refX<Map>(rotation, x0, y0) * 65536 - xx * x0 - xy * y0 + 0x8000),
+      (int32_t)yx, (int32_t)yy,
+      (int32_t)(refY<Map>(rotation, x0, y0) * 65536 - yx * x0 - yy * y0 + 0x8000),
+      (int16_t)(Map::screenWidth(rotation) - 1),
+      (int16_t)(Map::screenHeight(rotation) - 1)
+    };
+  }
+
+  constexpr long clampTo(long v, long hi) {
+    return v < 0 ? 0 : (v > hi ? hi : v);
+  }
+
+  // Abweichung Matrix vs. Referenz an einem Rohpunkt (nach Clamp)
+  template <typename Map>
+  constexpr long deviation(uint8_t rotation, long rawX, long rawY) {
+    const TouchTransform t = derive<Map>(rotation);
+    const long mx = clampTo((t.xx * rawX + t.xy * rawY + t.x0) >> 16, t.maxX);
+    const long my = clampTo((t.yx * rawX + t.yy * rawY + t.y0) >> 16, t.maxY);
+    const long rx = clampTo(refX<Map>(rotation, rawX, rawY), t.maxX);
+    const long ry = clampTo(refY<Map>(rotation, rawX, rawY), t.maxY);
+    const long dx = mx > rx ? mx - rx : rx - mx;
+    const long dy = my > ry ? my - ry : ry - my;
+    return dx > dy ? dx : dy;
+  }
+
+  // Ecken + Mitte des kalibrierten Bereichs dürfen max. 1 Pixel abweichen.
+  // Profil-Mapping muss affin sein (map() + Invertierung), sonst stimmt die Matrix nicht.
+  template <typename Map>
+  constexpr bool matchesReference() {
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+      if (deviation<Map>(rotation, Map::minX, Map::minY) > 1 ||
+          deviation<Map>(rotation, Map::maxX, Map::minY) > 1 ||
+          deviation<Map>(rotation, Map::minX, Map::maxY) > 1 ||
+          deviation<Map>(rotation, Map::maxX, Map::maxY) > 1 ||
+          deviation<Map>(rotation, (Map::minX + Map::maxX) / 2, (Map::minY + Map::maxY) / 2) > 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+} // namespace TouchTransformDetail
+
+#endif // TOUCH_TRANSFORM_H